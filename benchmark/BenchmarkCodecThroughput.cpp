@@ -0,0 +1,447 @@
+/*
+ * Measures the throughput of Opus encode -> decode round-trips over a corpus of WAV-files with an increasing number of threads,
+ * to determine the number of concurrent channels a machine sustains.
+ *
+ * The WAV-files (16 bit PCM or 32 bit float, 8, 12, 16, 24 or 48 kHz, any number of channels) are memory-mapped and shared by all threads.
+ * Every thread owns its own encoder and decoder, configured like the ProcessorOpus, and processes every file of the corpus once,
+ * starting with a different file.
+ *
+ * For every number of threads, the frames per second (in total and per thread), the scaling-efficiency relative to a single thread,
+ * the number of streams which could be coded in real-time and the percentiles of the encoding- and decoding-time per frame are reported.
+ *
+ * Usage: BenchmarkCodecThroughput <directory> [maximum threads] [frame-duration in ms] [bitrate] [complexity]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include <memory>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ProcessorOpus.h"
+#include "opus_multistream.h"
+
+/*!
+ * A read-only memory-mapping of a whole file
+ */
+class MappedFile
+{
+public:
+    MappedFile(const std::string& fileName) : data(nullptr), size(0)
+    {
+#ifdef _WIN32
+        fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        mappingHandle = nullptr;
+        if(fileHandle == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+        {
+            return;
+        }
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(mappingHandle == nullptr)
+        {
+            return;
+        }
+        data = (const unsigned char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        size = data != nullptr ? (size_t)fileSize.QuadPart : 0;
+#else
+        const int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+        if(fileDescriptor < 0)
+        {
+            return;
+        }
+        struct stat fileStatus;
+        if(fstat(fileDescriptor, &fileStatus) == 0 && fileStatus.st_size > 0)
+        {
+            void* mapping = mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+            if(mapping != MAP_FAILED)
+            {
+                data = (const unsigned char*)mapping;
+                size = fileStatus.st_size;
+            }
+        }
+        //the mapping stays valid after closing the file
+        close(fileDescriptor);
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifdef _WIN32
+        if(data != nullptr)
+            UnmapViewOfFile(data);
+        if(mappingHandle != nullptr)
+            CloseHandle(mappingHandle);
+        if(fileHandle != INVALID_HANDLE_VALUE)
+            CloseHandle(fileHandle);
+#else
+        if(data != nullptr)
+            munmap((void*)data, size);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data;
+    size_t size;
+
+private:
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#endif
+};
+
+/*!
+ * The audio-data of a memory-mapped WAV-file
+ */
+struct WavFile
+{
+    std::string name;
+    std::unique_ptr<MappedFile> file;
+    unsigned int sampleRate;
+    unsigned int channels;
+    bool isFloat;
+    //points into the mapped file
+    const unsigned char* samples;
+    unsigned int numberOfFrames;
+};
+
+static uint32_t readLittleEndian(const unsigned char* data, const unsigned int bytes)
+{
+    uint32_t value = 0;
+    for(unsigned int i = 0; i < bytes; i++)
+    {
+        value |= (uint32_t)data[i] << (8 * i);
+    }
+    return value;
+}
+
+/*!
+ * Parses the RIFF-chunks of the mapped file
+ *
+ * \return whether the file is a supported WAV-file
+ */
+static bool parseWavFile(WavFile& wav)
+{
+    const unsigned char* data = wav.file->data;
+    const size_t size = wav.file->size;
+    if(data == nullptr || size < 12 || memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WAVE", 4) != 0)
+    {
+        return false;
+    }
+    unsigned int formatTag = 0;
+    unsigned int bitsPerSample = 0;
+    wav.channels = 0;
+    wav.samples = nullptr;
+    size_t position = 12;
+    while(position + 8 <= size)
+    {
+        const uint32_t chunkSize = readLittleEndian(data + position + 4, 4);
+        const unsigned char* chunk = data + position + 8;
+        const size_t available = std::min<size_t>(chunkSize, size - position - 8);
+        if(memcmp(data + position, "fmt ", 4) == 0 && available >= 16)
+        {
+            formatTag = readLittleEndian(chunk, 2);
+            wav.channels = readLittleEndian(chunk + 2, 2);
+            wav.sampleRate = readLittleEndian(chunk + 4, 4);
+            bitsPerSample = readLittleEndian(chunk + 14, 2);
+            //WAVE_FORMAT_EXTENSIBLE stores the actual format in the first two bytes of the sub-format GUID
+            if(formatTag == 0xFFFE && available >= 26)
+            {
+                formatTag = readLittleEndian(chunk + 24, 2);
+            }
+        }
+        else if(memcmp(data + position, "data", 4) == 0 && wav.channels > 0)
+        {
+            wav.samples = chunk;
+            wav.numberOfFrames = available / (wav.channels * (bitsPerSample / 8));
+        }
+        //chunks are padded to an even size
+        position += 8 + chunkSize + (chunkSize & 1);
+    }
+    wav.isFloat = formatTag == 3 && bitsPerSample == 32;
+    const bool isPCM16 = formatTag == 1 && bitsPerSample == 16;
+    const bool isOpusRate = wav.sampleRate == 8000 || wav.sampleRate == 12000 || wav.sampleRate == 16000 || wav.sampleRate == 24000 || wav.sampleRate == 48000;
+    return wav.samples != nullptr && (wav.isFloat || isPCM16) && isOpusRate && wav.channels <= 255;
+}
+
+static std::vector<std::string> listWavFiles(const std::string& directory)
+{
+    std::vector<std::string> fileNames;
+#ifdef _WIN32
+    WIN32_FIND_DATAA entry;
+    const HANDLE search = FindFirstFileA((directory + "\\*.wav").c_str(), &entry);
+    if(search != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            fileNames.push_back(directory + "\\" + entry.cFileName);
+        }
+        while(FindNextFileA(search, &entry));
+        FindClose(search);
+    }
+#else
+    DIR* dir = opendir(directory.c_str());
+    if(dir != nullptr)
+    {
+        while(const struct dirent* entry = readdir(dir))
+        {
+            const std::string name = entry->d_name;
+            if(name.size() > 4 && (name.compare(name.size() - 4, 4, ".wav") == 0 || name.compare(name.size() - 4, 4, ".WAV") == 0))
+            {
+                fileNames.push_back(directory + "/" + name);
+            }
+        }
+        closedir(dir);
+    }
+#endif
+    std::sort(fileNames.begin(), fileNames.end());
+    return fileNames;
+}
+
+/*!
+ * The encoder and decoder of a single thread, mono and stereo files use the plain Opus-encoder, more channels the multistream-encoder
+ */
+class Codec
+{
+public:
+    Codec(const WavFile& wav, const OpusEncoderSettings& settings, const unsigned int frameSize) :
+        encoder(nullptr), decoder(nullptr), multistreamEncoder(), multistreamDecoder(nullptr)
+    {
+        int errorCode = OPUS_OK;
+        bool configured = false;
+        if(wav.channels > 2)
+        {
+            //a single thread per codec, the threads of the benchmark already use all cores
+            multistreamEncoder.reset(new OpusMultistreamEncoder(wav.sampleRate, wav.channels, OPUS_APPLICATION_VOIP, 1));
+            configured = multistreamEncoder->getErrorCode() == OPUS_OK && multistreamEncoder->applySettings(settings, frameSize);
+            multistreamDecoder = opus_multistream_decoder_create(wav.sampleRate, wav.channels, multistreamEncoder->getNumberOfStreams(),
+                                                                 multistreamEncoder->getNumberOfCoupledStreams(), multistreamEncoder->getMapping(), &errorCode);
+        }
+        else
+        {
+            encoder = opus_encoder_create(wav.sampleRate, wav.channels, OPUS_APPLICATION_VOIP, &errorCode);
+            configured = errorCode == OPUS_OK && ProcessorOpus::applyEncoderSettings(encoder, settings, frameSize, wav.sampleRate);
+            decoder = opus_decoder_create(wav.sampleRate, wav.channels, &errorCode);
+        }
+        if(!configured || errorCode != OPUS_OK)
+        {
+            std::cerr << "Failed to create the codec for " << wav.name << std::endl;
+            exit(1);
+        }
+    }
+
+    ~Codec()
+    {
+        if(encoder != nullptr)
+            opus_encoder_destroy(encoder);
+        if(decoder != nullptr)
+            opus_decoder_destroy(decoder);
+        if(multistreamDecoder != nullptr)
+            opus_multistream_decoder_destroy(multistreamDecoder);
+    }
+
+    int encode(const WavFile& wav, const unsigned char* samples, const unsigned int frameSize, unsigned char* packet, const unsigned int maximumSize)
+    {
+        if(multistreamEncoder)
+        {
+            return wav.isFloat ? multistreamEncoder->encode((const float*)samples, frameSize, packet, maximumSize) :
+                multistreamEncoder->encode((const opus_int16*)samples, frameSize, packet, maximumSize);
+        }
+        return wav.isFloat ? opus_encode_float(encoder, (const float*)samples, frameSize, packet, maximumSize) :
+            opus_encode(encoder, (const opus_int16*)samples, frameSize, packet, maximumSize);
+    }
+
+    int decode(const WavFile& wav, const unsigned char* packet, const int packetSize, unsigned char* samples, const unsigned int frameSize)
+    {
+        if(multistreamDecoder != nullptr)
+        {
+            return wav.isFloat ? opus_multistream_decode_float(multistreamDecoder, packet, packetSize, (float*)samples, frameSize, 0) :
+                opus_multistream_decode(multistreamDecoder, packet, packetSize, (opus_int16*)samples, frameSize, 0);
+        }
+        return wav.isFloat ? opus_decode_float(decoder, packet, packetSize, (float*)samples, frameSize, 0) :
+            opus_decode(decoder, packet, packetSize, (opus_int16*)samples, frameSize, 0);
+    }
+
+private:
+    OpusEncoder* encoder;
+    OpusDecoder* decoder;
+    std::unique_ptr<OpusMultistreamEncoder> multistreamEncoder;
+    OpusMSDecoder* multistreamDecoder;
+};
+
+struct ThreadResult
+{
+    unsigned long frames;
+    //the durations in nanoseconds of every encoded and decoded frame
+    std::vector<uint32_t> encodingTimes;
+    std::vector<uint32_t> decodingTimes;
+};
+
+static void runThread(const std::vector<WavFile>* corpus, const unsigned int threadIndex, const OpusEncoderSettings settings,
+                      const unsigned int frameDuration, ThreadResult* result)
+{
+    //the maximum size of a multistream-packet of 255 channels
+    std::vector<unsigned char> packet(255 * 1275);
+    std::vector<unsigned char> decoded;
+    result->frames = 0;
+    for(unsigned int i = 0; i < corpus->size(); i++)
+    {
+        //start with a different file per thread, so the threads do not read the same pages at the same time
+        const WavFile& wav = (*corpus)[(i + threadIndex) % corpus->size()];
+        const unsigned int frameSize = wav.sampleRate * frameDuration / 1000;
+        const unsigned int frameBytes = frameSize * wav.channels * (wav.isFloat ? 4 : 2);
+        //the codec is created per file, like on a new call
+        Codec codec(wav, settings, frameSize);
+        decoded.resize(frameBytes);
+        for(unsigned int frame = 0; frame + frameSize <= wav.numberOfFrames; frame += frameSize)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const int packetSize = codec.encode(wav, wav.samples + (size_t)frame / frameSize * frameBytes, frameSize, packet.data(), packet.size());
+            const auto encoded = std::chrono::steady_clock::now();
+            if(packetSize < 0 || codec.decode(wav, packet.data(), packetSize, decoded.data(), frameSize) != (int)frameSize)
+            {
+                std::cerr << "Coding failed for " << wav.name << std::endl;
+                exit(1);
+            }
+            const auto end = std::chrono::steady_clock::now();
+            result->encodingTimes.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(encoded - start).count());
+            result->decodingTimes.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - encoded).count());
+            result->frames++;
+        }
+    }
+}
+
+/*!
+ * \return the percentile in microseconds, the values are sorted
+ */
+static double getPercentile(std::vector<uint32_t>& values, const double percentile)
+{
+    if(values.empty())
+    {
+        return 0;
+    }
+    const size_t index = std::min(values.size() - 1, (size_t)(percentile / 100.0 * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index] / 1000.0;
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        std::cerr << "Usage: BenchmarkCodecThroughput <directory> [maximum threads] [frame-duration in ms] [bitrate] [complexity]" << std::endl;
+        return 1;
+    }
+    const unsigned int maximumThreads = argc > 2 ? atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    const unsigned int frameDuration = argc > 3 ? atoi(argv[3]) : 20;
+    OpusEncoderSettings settings;
+    if(argc > 4)
+    {
+        settings.bitrate = atoi(argv[4]);
+    }
+    if(argc > 5)
+    {
+        settings.complexity = atoi(argv[5]);
+    }
+    if(maximumThreads == 0 || (frameDuration != 10 && frameDuration != 20 && frameDuration != 40 && frameDuration != 60))
+    {
+        std::cerr << "Invalid number of threads or frame-duration (10, 20, 40 or 60 ms)!" << std::endl;
+        return 1;
+    }
+
+    std::vector<WavFile> corpus;
+    unsigned long corpusFrames = 0;
+    for(const std::string& fileName : listWavFiles(argv[1]))
+    {
+        WavFile wav;
+        wav.name = fileName;
+        wav.file.reset(new MappedFile(fileName));
+        if(!parseWavFile(wav))
+        {
+            std::cerr << "Skipping unsupported file: " << fileName << std::endl;
+            continue;
+        }
+        corpusFrames += wav.numberOfFrames * 1000ul / wav.sampleRate / frameDuration;
+        corpus.push_back(std::move(wav));
+    }
+    if(corpus.empty())
+    {
+        std::cerr << "No supported WAV-files found in " << argv[1] << std::endl;
+        return 1;
+    }
+    std::cout << "Encoding and decoding " << corpus.size() << " files (" << (corpusFrames * frameDuration / 1000) << " s of audio) per thread in frames of "
+            << frameDuration << " ms" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(14) << "frames/s" << std::setw(18) << "frames/s/thread" << std::setw(12) << "scaling"
+            << std::setw(12) << "real-time" << std::setw(26) << "encode p50/p99/max [us]" << std::setw(26) << "decode p50/p99/max [us]" << std::endl;
+
+    //powers of two up to the maximum number of threads
+    std::vector<unsigned int> threadCounts;
+    for(unsigned int numberOfThreads = 1; numberOfThreads < maximumThreads; numberOfThreads *= 2)
+    {
+        threadCounts.push_back(numberOfThreads);
+    }
+    threadCounts.push_back(maximumThreads);
+
+    double singleThreadThroughput = 0;
+    for(const unsigned int numberOfThreads : threadCounts)
+    {
+        std::vector<ThreadResult> results(numberOfThreads);
+        std::vector<std::thread> threads;
+        const auto start = std::chrono::steady_clock::now();
+        for(unsigned int t = 0; t < numberOfThreads; t++)
+        {
+            threads.push_back(std::thread(runThread, &corpus, t, settings, frameDuration, &results[t]));
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        unsigned long frames = 0;
+        std::vector<uint32_t> encodingTimes, decodingTimes;
+        for(ThreadResult& result : results)
+        {
+            frames += result.frames;
+            encodingTimes.insert(encodingTimes.end(), result.encodingTimes.begin(), result.encodingTimes.end());
+            decodingTimes.insert(decodingTimes.end(), result.decodingTimes.begin(), result.decodingTimes.end());
+        }
+        const double throughput = frames / seconds;
+        if(numberOfThreads == 1)
+        {
+            singleThreadThroughput = throughput;
+        }
+        //the number of streams, which could be encoded and decoded in real-time
+        const double realTimeStreams = throughput * frameDuration / 1000.0;
+        std::ostringstream encodeTimes, decodeTimes;
+        encodeTimes << std::fixed << std::setprecision(1) << getPercentile(encodingTimes, 50) << "/" << getPercentile(encodingTimes, 99) << "/" << getPercentile(encodingTimes, 100);
+        decodeTimes << std::fixed << std::setprecision(1) << getPercentile(decodingTimes, 50) << "/" << getPercentile(decodingTimes, 99) << "/" << getPercentile(decodingTimes, 100);
+        std::cout << std::setw(8) << numberOfThreads << std::fixed << std::setprecision(0) << std::setw(14) << throughput
+                << std::setw(18) << (throughput / numberOfThreads) << std::setprecision(2) << std::setw(12) << (throughput / (numberOfThreads * singleThreadThroughput))
+                << std::setprecision(0) << std::setw(12) << realTimeStreams << std::setw(26) << encodeTimes.str() << std::setw(26) << decodeTimes.str() << std::endl;
+    }
+    return 0;
+}
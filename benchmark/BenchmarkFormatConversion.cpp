@@ -0,0 +1,117 @@
+/*
+ * Measures the time per buffer required to convert between sample-formats with the scalar and the vectorized implementations.
+ *
+ * Usage: BenchmarkFormatConversion [number of buffers per measurement]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+#include "FormatConverter.h"
+#include "ProcessorL16.h"
+
+//20 ms of stereo audio at 48 kHz
+static const unsigned int NUMBER_OF_SAMPLES = 1920;
+
+//prevents the compiler from optimizing away the measured operations
+static volatile unsigned int sink = 0;
+
+/*!
+ * \return the average time in nanoseconds per buffer to convert with the given instruction-set
+ */
+static double measure(const unsigned int numberOfBuffers, const AudioFormat sourceFormat, const AudioFormat targetFormat, const FormatConverter::InstructionSet instructionSet)
+{
+    FormatConverter converter(sourceFormat, targetFormat, instructionSet);
+    //the source-samples are silence, the conversion-time does not depend on the values
+    const std::vector<uint8_t> source(NUMBER_OF_SAMPLES * getAudioFormatSize(sourceFormat), 0);
+    std::vector<uint8_t> target(NUMBER_OF_SAMPLES * getAudioFormatSize(targetFormat));
+    //warm up caches and branch-predictors
+    for(unsigned int i = 0; i < numberOfBuffers / 10; i++)
+    {
+        converter.convert(source.data(), target.data(), NUMBER_OF_SAMPLES);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for(unsigned int i = 0; i < numberOfBuffers; i++)
+    {
+        converter.convert(source.data(), target.data(), NUMBER_OF_SAMPLES);
+        sink += target[i % target.size()];
+    }
+    const auto duration = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / (double)numberOfBuffers;
+}
+
+/*!
+ * \return the average time in nanoseconds per buffer to swap the byte-order of the 16 bit samples (see ProcessorL16)
+ */
+static double measureByteSwap(const unsigned int numberOfBuffers, const FormatConverter::InstructionSet instructionSet)
+{
+    std::vector<uint16_t> samples(NUMBER_OF_SAMPLES, 0x1234);
+    for(unsigned int i = 0; i < numberOfBuffers / 10; i++)
+    {
+        ProcessorL16::swapByteOrder(samples.data(), NUMBER_OF_SAMPLES, instructionSet);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for(unsigned int i = 0; i < numberOfBuffers; i++)
+    {
+        ProcessorL16::swapByteOrder(samples.data(), NUMBER_OF_SAMPLES, instructionSet);
+        sink += samples[i % samples.size()];
+    }
+    const auto duration = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / (double)numberOfBuffers;
+}
+
+static const char* getName(const FormatConverter::InstructionSet instructionSet)
+{
+    switch(instructionSet)
+    {
+        case FormatConverter::InstructionSet::SSE2:
+            return "SSE2";
+        case FormatConverter::InstructionSet::AVX2:
+            return "AVX2";
+        case FormatConverter::InstructionSet::NEON:
+            return "NEON";
+        default:
+            return "scalar";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned int numberOfBuffers = argc > 1 ? atoi(argv[1]) : 20000;
+    const FormatConverter::InstructionSet supportedSet = FormatConverter::getSupportedInstructionSet();
+    std::cout << "Converting " << NUMBER_OF_SAMPLES << " samples per buffer, supported instruction-set: " << getName(supportedSet) << std::endl;
+
+    struct Conversion
+    {
+        const char* name;
+        AudioFormat source;
+        AudioFormat target;
+    };
+    const std::vector<Conversion> conversions = {
+        {"int16 -> float32", AudioFormat::SIGNED_INT_16, AudioFormat::FLOAT_32},
+        {"float32 -> int16", AudioFormat::FLOAT_32, AudioFormat::SIGNED_INT_16},
+        {"int24 -> int32", AudioFormat::SIGNED_INT_24, AudioFormat::SIGNED_INT_32},
+        {"int32 -> int24", AudioFormat::SIGNED_INT_32, AudioFormat::SIGNED_INT_24},
+        {"int24 -> float32", AudioFormat::SIGNED_INT_24, AudioFormat::FLOAT_32},
+        {"float32 -> int24", AudioFormat::FLOAT_32, AudioFormat::SIGNED_INT_24},
+        {"float64 -> float32", AudioFormat::FLOAT_64, AudioFormat::FLOAT_32}
+    };
+    std::cout << std::setw(20) << "conversion" << std::setw(14) << "scalar [ns]" << std::setw(14) << "vector [ns]" << std::setw(10) << "speedup" << std::endl;
+    for(const Conversion& conversion : conversions)
+    {
+        const double scalar = measure(numberOfBuffers, conversion.source, conversion.target, FormatConverter::InstructionSet::SCALAR);
+        const double vectorized = measure(numberOfBuffers, conversion.source, conversion.target, supportedSet);
+        std::cout << std::setw(20) << conversion.name << std::fixed << std::setprecision(1) << std::setw(14) << scalar
+                << std::setw(14) << vectorized << std::setw(9) << (scalar / vectorized) << "x" << std::endl;
+    }
+    const double scalarSwap = measureByteSwap(numberOfBuffers, FormatConverter::InstructionSet::SCALAR);
+    const double vectorizedSwap = measureByteSwap(numberOfBuffers, supportedSet);
+    std::cout << std::setw(20) << "int16 byte-swap" << std::fixed << std::setprecision(1) << std::setw(14) << scalarSwap
+            << std::setw(14) << vectorizedSwap << std::setw(9) << (scalarSwap / vectorizedSwap) << "x" << std::endl;
+    //read and written once
+    std::cout << "Byte-swap throughput: " << (2.0 * NUMBER_OF_SAMPLES * sizeof(uint16_t) / vectorizedSwap) << " GB/s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,187 @@
+/*
+ * Compares the number of mono 8 kHz channels a single CPU-core can encode and decode in real-time
+ * with the G.711 codec (for every supported instruction-set) and the Opus codec (for several complexities).
+ *
+ * The input is a synthesized speech-like signal, so the results are reproducible without any audio-files.
+ *
+ * Usage: BenchmarkG711 [seconds of audio] [frame-duration in ms]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <string>
+
+#include "G711.h"
+#include "ProcessorOpus.h"
+
+static const unsigned int SAMPLE_RATE = 8000;
+static const double PI = 3.14159265358979323846;
+
+/*!
+ * A vowel-like signal with a varying pitch and syllables of 200 ms, separated by noise
+ */
+static std::vector<int16_t> createSpeech(const unsigned int numberOfSamples)
+{
+    std::vector<int16_t> samples(numberOfSamples);
+    uint32_t randomState = 1;
+    double phase = 0;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        const double time = i / (double)SAMPLE_RATE;
+        const double pitch = 120 + 30 * sin(2 * PI * 0.7 * time);
+        phase += 2 * PI * pitch / SAMPLE_RATE;
+        const double syllable = fmod(time, 0.3);
+        randomState = randomState * 1664525 + 1013904223;
+        double value = 0.02 * (int32_t)randomState / 2147483648.0;
+        if(syllable < 0.2)
+        {
+            for(unsigned int harmonic = 1; harmonic <= 12; harmonic++)
+            {
+                value += 0.25 * sin(PI * syllable / 0.2) * sin(harmonic * phase) / harmonic;
+            }
+        }
+        samples[i] = (int16_t)(value * 32767.0);
+    }
+    return samples;
+}
+
+struct Result
+{
+    std::string name;
+    //the CPU-time to encode and decode in nanoseconds per second of audio
+    double encodeNanoseconds;
+    double decodeNanoseconds;
+    //the size of the encoded audio in bytes
+    unsigned long encodedBytes;
+};
+
+static Result measureG711(const std::vector<int16_t>& samples, const unsigned int frameSize, const G711::Law law,
+                          const FormatConverter::InstructionSet instructionSet, const unsigned int repetitions)
+{
+    const G711 codec(law, instructionSet);
+    const unsigned int numberOfFrames = samples.size() / frameSize;
+    std::vector<uint8_t> encoded(samples.size());
+    std::vector<int16_t> decoded(samples.size());
+    const double seconds = numberOfFrames * frameSize * repetitions / (double)SAMPLE_RATE;
+
+    auto start = std::chrono::steady_clock::now();
+    for(unsigned int r = 0; r < repetitions; r++)
+    {
+        for(unsigned int frame = 0; frame < numberOfFrames; frame++)
+        {
+            codec.encode(samples.data() + frame * frameSize, encoded.data() + frame * frameSize, frameSize);
+        }
+    }
+    const auto encodeDuration = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    for(unsigned int r = 0; r < repetitions; r++)
+    {
+        for(unsigned int frame = 0; frame < numberOfFrames; frame++)
+        {
+            codec.decode(encoded.data() + frame * frameSize, decoded.data() + frame * frameSize, frameSize);
+        }
+    }
+    const auto decodeDuration = std::chrono::steady_clock::now() - start;
+
+    const char* instructionSets[] = {"scalar", "SSE2", "AVX2", "NEON"};
+    Result result;
+    result.name = std::string(law == G711::Law::MU_LAW ? "G.711 mu-law " : "G.711 A-law ") + instructionSets[(int)codec.getInstructionSet()];
+    result.encodeNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(encodeDuration).count() / seconds;
+    result.decodeNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(decodeDuration).count() / seconds;
+    result.encodedBytes = numberOfFrames * frameSize;
+    return result;
+}
+
+static Result measureOpus(const std::vector<int16_t>& samples, const unsigned int frameSize, const int complexity)
+{
+    int errorCode = OPUS_OK;
+    OpusEncoder* encoder = opus_encoder_create(SAMPLE_RATE, 1, OPUS_APPLICATION_VOIP, &errorCode);
+    OpusDecoder* decoder = opus_decoder_create(SAMPLE_RATE, 1, &errorCode);
+    OpusEncoderSettings settings;
+    settings.complexity = complexity;
+    settings.bitrate = 16000;
+    if(errorCode != OPUS_OK || !ProcessorOpus::applyEncoderSettings(encoder, settings, frameSize, SAMPLE_RATE))
+    {
+        std::cerr << "Failed to create Opus-codec!" << std::endl;
+        exit(1);
+    }
+    const unsigned int numberOfFrames = samples.size() / frameSize;
+    std::vector<std::vector<unsigned char>> packets(numberOfFrames, std::vector<unsigned char>(1275));
+    std::vector<int> sizes(numberOfFrames);
+    std::vector<int16_t> decoded(frameSize);
+    const double seconds = numberOfFrames * frameSize / (double)SAMPLE_RATE;
+    Result result{"Opus complexity " + std::to_string(complexity), 0, 0, 0};
+
+    auto start = std::chrono::steady_clock::now();
+    for(unsigned int frame = 0; frame < numberOfFrames; frame++)
+    {
+        sizes[frame] = opus_encode(encoder, samples.data() + frame * frameSize, frameSize, packets[frame].data(), packets[frame].size());
+        if(sizes[frame] < 0)
+        {
+            std::cerr << "Encoding failed: " << opus_strerror(sizes[frame]) << std::endl;
+            exit(1);
+        }
+        result.encodedBytes += sizes[frame];
+    }
+    const auto encodeDuration = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    for(unsigned int frame = 0; frame < numberOfFrames; frame++)
+    {
+        if(opus_decode(decoder, packets[frame].data(), sizes[frame], decoded.data(), frameSize, 0) < 0)
+        {
+            std::cerr << "Decoding failed!" << std::endl;
+            exit(1);
+        }
+    }
+    const auto decodeDuration = std::chrono::steady_clock::now() - start;
+
+    result.encodeNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(encodeDuration).count() / seconds;
+    result.decodeNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(decodeDuration).count() / seconds;
+    opus_encoder_destroy(encoder);
+    opus_decoder_destroy(decoder);
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned int seconds = argc > 1 ? atoi(argv[1]) : 30;
+    const unsigned int frameDuration = argc > 2 ? atoi(argv[2]) : 20;
+    const unsigned int frameSize = SAMPLE_RATE * frameDuration / 1000;
+    if(seconds == 0 || frameSize == 0)
+    {
+        std::cerr << "Usage: BenchmarkG711 [seconds of audio] [frame-duration in ms]" << std::endl;
+        return 1;
+    }
+    const std::vector<int16_t> speech = createSpeech(seconds * SAMPLE_RATE);
+    //G.711 is too fast to be measured precisely on a single pass
+    const unsigned int repetitions = 100;
+
+    std::vector<Result> results;
+    for(const G711::Law law : {G711::Law::MU_LAW, G711::Law::A_LAW})
+    {
+        for(const FormatConverter::InstructionSet instructionSet : {FormatConverter::InstructionSet::SCALAR, FormatConverter::getSupportedInstructionSet()})
+        {
+            results.push_back(measureG711(speech, frameSize, law, instructionSet, repetitions));
+        }
+    }
+    for(const int complexity : {0, 5, 10})
+    {
+        results.push_back(measureOpus(speech, frameSize, complexity));
+    }
+
+    std::cout << "Encoding and decoding " << seconds << " s of mono audio at 8 kHz in frames of " << frameDuration << " ms on a single core" << std::endl;
+    std::cout << std::setw(22) << "codec" << std::setw(14) << "bitrate [b/s]" << std::setw(16) << "encode [ns/s]" << std::setw(16) << "decode [ns/s]"
+            << std::setw(18) << "channels per core" << std::endl;
+    for(const Result& result : results)
+    {
+        //the number of channels one core can encode and decode in real-time
+        const double channelsPerCore = 1e9 / (result.encodeNanoseconds + result.decodeNanoseconds);
+        std::cout << std::setw(22) << result.name << std::fixed << std::setprecision(0) << std::setw(14) << (result.encodedBytes * 8.0 / seconds)
+                << std::setw(16) << result.encodeNanoseconds << std::setw(16) << result.decodeNanoseconds << std::setw(18) << channelsPerCore << std::endl;
+    }
+    return 0;
+}
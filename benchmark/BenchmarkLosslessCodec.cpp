@@ -0,0 +1,121 @@
+/*
+ * Measures the compression-ratio and the time to encode and decode a buffer of 128 frames (BUFFER_128) of multichannel 24 bit audio at 48 kHz
+ * with the lossless codec for every supported instruction-set, compared to the duration of the buffer.
+ *
+ * The input is a synthesized music-like signal, so the results are reproducible without any audio-files.
+ *
+ * Usage: BenchmarkLosslessCodec [number of channels] [seconds of audio]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "LosslessCodec.h"
+
+static const unsigned int SAMPLE_RATE = 48000;
+static const unsigned int BITS_PER_SAMPLE = 24;
+static const unsigned int BUFFER_FRAMES = 128;
+static const double PI = 3.14159265358979323846;
+
+/*!
+ * Chords with a different root per channel, changing every second, with a decaying envelope and a noise-floor of -96 dB
+ */
+static std::vector<int32_t> createMusic(const unsigned int channels, const unsigned int numberOfFrames)
+{
+    const double fullScale = (1 << (BITS_PER_SAMPLE - 1)) - 1;
+    std::vector<int32_t> samples(channels * numberOfFrames);
+    uint32_t randomState = 1;
+    for(unsigned int i = 0; i < numberOfFrames; i++)
+    {
+        const double time = i / (double)SAMPLE_RATE;
+        const double envelope = exp(-2 * fmod(time, 1.0));
+        const unsigned int chord = (unsigned int)time % 4;
+        for(unsigned int channel = 0; channel < channels; channel++)
+        {
+            const double root = 110.0 * pow(2.0, (channel + chord * 5) / 12.0);
+            double value = 0;
+            for(const double interval : {1.0, 1.25, 1.5, 2.0})
+            {
+                value += 0.2 * envelope * sin(2 * PI * root * interval * time);
+            }
+            randomState = randomState * 1664525 + 1013904223;
+            samples[i * channels + channel] = (int32_t)(value * fullScale) + (int32_t)(randomState >> 25) - 64;
+        }
+    }
+    return samples;
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned int channels = argc > 1 ? atoi(argv[1]) : 8;
+    const unsigned int seconds = argc > 2 ? atoi(argv[2]) : 10;
+    if(channels == 0 || seconds == 0)
+    {
+        std::cerr << "Usage: BenchmarkLosslessCodec [number of channels] [seconds of audio]" << std::endl;
+        return 1;
+    }
+    const std::vector<int32_t> music = createMusic(channels, seconds * SAMPLE_RATE);
+    const unsigned int numberOfBuffers = seconds * SAMPLE_RATE / BUFFER_FRAMES;
+    const double bufferMicroseconds = BUFFER_FRAMES * 1e6 / SAMPLE_RATE;
+
+    std::cout << "Encoding and decoding " << seconds << " s of " << channels << " channels with " << BITS_PER_SAMPLE << " bit at " << SAMPLE_RATE
+            << " Hz in buffers of " << BUFFER_FRAMES << " frames (" << std::fixed << std::setprecision(0) << bufferMicroseconds << " us)" << std::endl;
+    std::cout << std::setw(10) << "SIMD" << std::setw(8) << "ratio" << std::setw(16) << "encode [us]" << std::setw(18) << "max. encode [us]"
+            << std::setw(16) << "decode [us]" << std::setw(18) << "% of buffer time" << std::endl;
+    const char* instructionSets[] = {"scalar", "SSE2", "AVX2", "NEON"};
+    std::vector<FormatConverter::InstructionSet> candidates{FormatConverter::InstructionSet::SCALAR};
+    if(FormatConverter::getSupportedInstructionSet() == FormatConverter::InstructionSet::AVX2)
+    {
+        candidates.push_back(FormatConverter::InstructionSet::SSE2);
+    }
+    if(FormatConverter::getSupportedInstructionSet() != FormatConverter::InstructionSet::SCALAR)
+    {
+        candidates.push_back(FormatConverter::getSupportedInstructionSet());
+    }
+    for(const FormatConverter::InstructionSet instructionSet : candidates)
+    {
+        LosslessCodec codec(channels, BITS_PER_SAMPLE, instructionSet);
+        std::vector<uint8_t> encoded(codec.getMaximumEncodedSize(BUFFER_FRAMES) * numberOfBuffers);
+        std::vector<unsigned int> sizes(numberOfBuffers);
+        std::vector<int32_t> decoded(channels * BUFFER_FRAMES);
+        unsigned long totalSize = 0;
+        double maximumEncodeMicroseconds = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for(unsigned int buffer = 0; buffer < numberOfBuffers; buffer++)
+        {
+            const auto bufferStart = std::chrono::steady_clock::now();
+            sizes[buffer] = codec.encode(music.data() + buffer * BUFFER_FRAMES * channels, BUFFER_FRAMES, encoded.data() + totalSize,
+                                         encoded.size() - totalSize);
+            maximumEncodeMicroseconds = std::max(maximumEncodeMicroseconds,
+                                                 std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - bufferStart).count());
+            totalSize += sizes[buffer];
+        }
+        const double encodeMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / numberOfBuffers;
+
+        unsigned long position = 0;
+        start = std::chrono::steady_clock::now();
+        for(unsigned int buffer = 0; buffer < numberOfBuffers; buffer++)
+        {
+            if(codec.decode(encoded.data() + position, sizes[buffer], decoded.data(), BUFFER_FRAMES) != BUFFER_FRAMES ||
+               !std::equal(decoded.begin(), decoded.end(), music.begin() + buffer * BUFFER_FRAMES * channels))
+            {
+                std::cerr << "Decoded audio differs from the original!" << std::endl;
+                return 1;
+            }
+            position += sizes[buffer];
+        }
+        const double decodeMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / numberOfBuffers;
+
+        const double ratio = totalSize / (numberOfBuffers * BUFFER_FRAMES * channels * BITS_PER_SAMPLE / 8.0);
+        std::cout << std::setw(10) << instructionSets[(int)codec.getInstructionSet()] << std::setprecision(3) << std::setw(8) << ratio << std::setprecision(1)
+                << std::setw(16) << encodeMicroseconds << std::setw(18) << maximumEncodeMicroseconds << std::setw(16) << decodeMicroseconds
+                << std::setw(18) << (encodeMicroseconds + decodeMicroseconds) * 100 / bufferMicroseconds << std::endl;
+    }
+    return 0;
+}
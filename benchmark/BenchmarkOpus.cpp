@@ -0,0 +1,183 @@
+/*
+ * Measures the encoding-time per frame and the size of the encoded audio of the Opus-encoder
+ * over a grid of complexities and bitrates.
+ *
+ * The reference corpus consists of synthesized speech-like, music-like and noise signals (mono, 48 kHz),
+ * so the results are reproducible without any audio-files.
+ *
+ * Usage: BenchmarkOpus [seconds of audio per signal] [frame-duration in ms]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <string>
+
+#include "ProcessorOpus.h"
+
+static const unsigned int SAMPLE_RATE = 48000;
+static const double PI = 3.14159265358979323846;
+
+struct Signal
+{
+    std::string name;
+    std::vector<opus_int16> samples;
+};
+
+static opus_int16 toSample(const double value)
+{
+    const double scaled = value * 32767.0;
+    return (opus_int16)(scaled > 32767.0 ? 32767.0 : (scaled < -32768.0 ? -32768.0 : scaled));
+}
+
+/*!
+ * A vowel-like signal with a varying pitch, syllables of 200 ms and pauses with noisy fricatives
+ */
+static Signal createSpeech(const unsigned int numberOfSamples)
+{
+    Signal signal{"speech", std::vector<opus_int16>(numberOfSamples)};
+    uint32_t randomState = 1;
+    double phase = 0;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        const double time = i / (double)SAMPLE_RATE;
+        const double pitch = 120 + 30 * sin(2 * PI * 0.7 * time);
+        phase += 2 * PI * pitch / SAMPLE_RATE;
+        const double syllable = fmod(time, 0.3);
+        randomState = randomState * 1664525 + 1013904223;
+        const double noise = (int32_t)randomState / 2147483648.0;
+        double value = 0;
+        if(syllable < 0.2)
+        {
+            const double envelope = sin(PI * syllable / 0.2);
+            for(unsigned int harmonic = 1; harmonic <= 12; harmonic++)
+            {
+                value += sin(harmonic * phase) / harmonic;
+            }
+            value *= 0.25 * envelope;
+        }
+        else
+        {
+            value = 0.02 * noise;
+        }
+        signal.samples[i] = toSample(value + 0.001 * noise);
+    }
+    return signal;
+}
+
+/*!
+ * A sequence of chords of harmonic tones with vibrato
+ */
+static Signal createMusic(const unsigned int numberOfSamples)
+{
+    Signal signal{"music", std::vector<opus_int16>(numberOfSamples)};
+    const double chords[][3] = {{261.63, 329.63, 392.0}, {220.0, 261.63, 329.63}, {174.61, 220.0, 261.63}, {196.0, 246.94, 293.66}};
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        const double time = i / (double)SAMPLE_RATE;
+        const double* chord = chords[(i / SAMPLE_RATE) % 4];
+        const double vibrato = 1 + 0.003 * sin(2 * PI * 5 * time);
+        double value = 0;
+        for(unsigned int tone = 0; tone < 3; tone++)
+        {
+            for(unsigned int harmonic = 1; harmonic <= 6; harmonic++)
+            {
+                value += sin(2 * PI * chord[tone] * harmonic * vibrato * time) / (harmonic * harmonic);
+            }
+        }
+        signal.samples[i] = toSample(value * 0.15);
+    }
+    return signal;
+}
+
+/*!
+ * White noise at -20 dBFS
+ */
+static Signal createNoise(const unsigned int numberOfSamples)
+{
+    Signal signal{"noise", std::vector<opus_int16>(numberOfSamples)};
+    uint32_t randomState = 7;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        randomState = randomState * 1664525 + 1013904223;
+        signal.samples[i] = toSample(0.17 * (int32_t)randomState / 2147483648.0);
+    }
+    return signal;
+}
+
+struct Result
+{
+    //the average encoding-time per frame in microseconds
+    double microsecondsPerFrame;
+    //the total size of the encoded frames in bytes
+    unsigned long encodedBytes;
+};
+
+static Result encode(const Signal& signal, const OpusEncoderSettings& settings, const unsigned int frameSize)
+{
+    int errorCode = OPUS_OK;
+    OpusEncoder* encoder = opus_encoder_create(SAMPLE_RATE, 1, OPUS_APPLICATION_VOIP, &errorCode);
+    if(errorCode != OPUS_OK || !ProcessorOpus::applyEncoderSettings(encoder, settings, frameSize, SAMPLE_RATE))
+    {
+        std::cerr << "Failed to create encoder!" << std::endl;
+        exit(1);
+    }
+    //the maximum size of an Opus-packet
+    std::vector<unsigned char> packet(1275);
+    const unsigned int numberOfFrames = signal.samples.size() / frameSize;
+    Result result{0, 0};
+    const auto start = std::chrono::steady_clock::now();
+    for(unsigned int frame = 0; frame < numberOfFrames; frame++)
+    {
+        const opus_int32 size = opus_encode(encoder, signal.samples.data() + frame * frameSize, frameSize, packet.data(), packet.size());
+        if(size < 0)
+        {
+            std::cerr << "Encoding failed: " << opus_strerror(size) << std::endl;
+            exit(1);
+        }
+        result.encodedBytes += size;
+    }
+    const auto duration = std::chrono::steady_clock::now() - start;
+    result.microsecondsPerFrame = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / (1000.0 * numberOfFrames);
+    opus_encoder_destroy(encoder);
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned int seconds = argc > 1 ? atoi(argv[1]) : 10;
+    const unsigned int frameDuration = argc > 2 ? atoi(argv[2]) : 20;
+    const unsigned int frameSize = SAMPLE_RATE * frameDuration / 1000;
+    if(seconds == 0 || frameSize == 0)
+    {
+        std::cerr << "Usage: BenchmarkOpus [seconds of audio per signal] [frame-duration in ms]" << std::endl;
+        return 1;
+    }
+    const std::vector<Signal> corpus = {createSpeech(seconds * SAMPLE_RATE), createMusic(seconds * SAMPLE_RATE), createNoise(seconds * SAMPLE_RATE)};
+    const int complexities[] = {0, 2, 5, 8, 10};
+    const int bitrates[] = {12000, 24000, 32000, 64000, 128000};
+
+    std::cout << "Encoding " << seconds << " s of mono audio at 48 kHz in frames of " << frameDuration << " ms (VBR)" << std::endl;
+    std::cout << std::setw(8) << "signal" << std::setw(12) << "complexity" << std::setw(14) << "target [b/s]"
+            << std::setw(14) << "time [us]" << std::setw(14) << "size [bytes]" << std::setw(16) << "actual [b/s]" << std::endl;
+    for(const Signal& signal : corpus)
+    {
+        for(const int complexity : complexities)
+        {
+            for(const int bitrate : bitrates)
+            {
+                OpusEncoderSettings settings;
+                settings.complexity = complexity;
+                settings.bitrate = bitrate;
+                const Result result = encode(signal, settings, frameSize);
+                std::cout << std::setw(8) << signal.name << std::setw(12) << complexity << std::setw(14) << bitrate
+                        << std::fixed << std::setprecision(1) << std::setw(14) << result.microsecondsPerFrame
+                        << std::setw(14) << result.encodedBytes << std::setprecision(0) << std::setw(16) << (result.encodedBytes * 8.0 / seconds) << std::endl;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+/*
+ * Measures the per-buffer overhead of the dynamic process chain of the AudioInterface
+ * compared to a StaticProcessorChain of the same processors at a buffer-size of 64 frames.
+ *
+ * Usage: BenchmarkProcessorChain [number of buffers per measurement]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+
+#include "AudioInterface.h"
+#include "ProcessorChain.h"
+
+/*!
+ * AudioInterface without an audio-device, the processing is triggered manually
+ */
+class BenchmarkAudioInterface : public AudioInterface
+{
+public:
+    void runInput(void* buffer, unsigned int size)
+    {
+        processAudioInput(buffer, size, &streamData);
+    }
+
+    void runOutput(void* buffer, unsigned int size)
+    {
+        processAudioOutput(buffer, size, &streamData);
+    }
+
+    StreamData streamData;
+
+protected:
+    auto vStartRecordingMode() -> void { }
+    auto vStartPlaybackMode() -> void { }
+    auto vStartDuplexMode() -> void { }
+    auto vSetConfiguration(AudioConfiguration audioConfiguration) -> void { }
+    auto vSuspend() -> void { }
+    auto vResume() -> void { }
+    auto vStop() -> void { }
+    auto vReset() -> void { }
+    auto vSetDefaultAudioConfig() -> void { }
+    auto vPrepareForExecution() -> bool { return true; }
+    auto vGetBufferSize() -> unsigned int { return static_cast<unsigned int>(audioConfiguration.bufferSize); }
+};
+
+/*!
+ * Processor doing no work at all, to measure the pure overhead of calling a processor
+ */
+class NullProcessor final : public AudioProcessor
+{
+public:
+    NullProcessor(const std::string name) : AudioProcessor(name)
+    { }
+
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, void *userData)
+    {
+        return inputBufferByteSize;
+    }
+
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, void *userData)
+    {
+        return outputBufferByteSize;
+    }
+};
+
+/*!
+ * Processor applying a fixed gain to 16 bit samples, as an example for a cheap processor
+ */
+class GainProcessor final : public AudioProcessor
+{
+public:
+    GainProcessor(const std::string name) : AudioProcessor(name)
+    { }
+
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, void *userData)
+    {
+        applyGain((int16_t*)inputBuffer, inputBufferByteSize / sizeof(int16_t));
+        return inputBufferByteSize;
+    }
+
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, void *userData)
+    {
+        applyGain((int16_t*)outputBuffer, outputBufferByteSize / sizeof(int16_t));
+        return outputBufferByteSize;
+    }
+
+private:
+    static void applyGain(int16_t* samples, const unsigned int numberOfSamples)
+    {
+        //gain of 0.5 in Q15
+        for(unsigned int i = 0; i < numberOfSamples; i++)
+        {
+            samples[i] = (int16_t)((samples[i] * 16384) >> 15);
+        }
+    }
+};
+
+static AudioConfiguration createConfiguration()
+{
+    AudioConfiguration audioConfig = {0};
+    audioConfig.inputDeviceChannels = 2;
+    audioConfig.outputDeviceChannels = 2;
+    audioConfig.sampleRate = 48000;
+    audioConfig.bufferSize = BufferSizes::BUFFER_64;
+    audioConfig.audioFormat = AudioFormat::SIGNED_INT_16;
+    return audioConfig;
+}
+
+/*!
+ * \return the average time in nanoseconds to process one buffer on input and output
+ */
+static double measure(BenchmarkAudioInterface& audioInterface, const unsigned int numberOfBuffers)
+{
+    audioInterface.setConfiguration(createConfiguration());
+    audioInterface.prepareForExecution();
+    const unsigned int bufferSize = static_cast<unsigned int>(BufferSizes::BUFFER_64) * sizeof(int16_t) * 2;
+    int16_t inputBuffer[static_cast<unsigned int>(BufferSizes::BUFFER_64) * 2];
+    int16_t outputBuffer[static_cast<unsigned int>(BufferSizes::BUFFER_64) * 2];
+    for(unsigned int i = 0; i < static_cast<unsigned int>(BufferSizes::BUFFER_64) * 2; i++)
+    {
+        inputBuffer[i] = (int16_t)(i * 311);
+    }
+    //warm up caches and branch-predictors
+    for(unsigned int i = 0; i < numberOfBuffers / 10; i++)
+    {
+        audioInterface.runInput(inputBuffer, bufferSize);
+        audioInterface.runOutput(outputBuffer, bufferSize);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for(unsigned int i = 0; i < numberOfBuffers; i++)
+    {
+        audioInterface.runInput(inputBuffer, bufferSize);
+        audioInterface.runOutput(outputBuffer, bufferSize);
+    }
+    const auto duration = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / (double)numberOfBuffers;
+}
+
+template<typename Processor>
+static void benchmark(const std::string& processorName, const unsigned int numberOfBuffers)
+{
+    BenchmarkAudioInterface dynamicChain;
+    dynamicChain.addProcessor(new Processor("1"));
+    dynamicChain.addProcessor(new Processor("2"));
+    dynamicChain.addProcessor(new Processor("3"));
+    dynamicChain.addProcessor(new Processor("4"));
+    const double dynamicTime = measure(dynamicChain, numberOfBuffers);
+
+    BenchmarkAudioInterface staticChain;
+    staticChain.setProcessorChain(new StaticProcessorChain<Processor, Processor, Processor, Processor>(
+        new Processor("1"), new Processor("2"), new Processor("3"), new Processor("4")));
+    const double staticTime = measure(staticChain, numberOfBuffers);
+
+    std::cout << std::setw(16) << processorName << std::setw(14) << std::fixed << std::setprecision(1) << dynamicTime
+            << std::setw(13) << staticTime << std::setw(16) << (dynamicTime - staticTime) << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned int numberOfBuffers = argc > 1 ? (unsigned int)atoi(argv[1]) : 1000000;
+    std::cout << "4 processors, 64 frames of 16 bit stereo, input and output per buffer:" << std::endl;
+    std::cout << std::setw(16) << "processors" << std::setw(14) << "dynamic [ns]" << std::setw(13) << "static [ns]" << std::setw(16) << "difference [ns]" << std::endl;
+    benchmark<NullProcessor>("no-op", numberOfBuffers);
+    benchmark<GainProcessor>("gain", numberOfBuffers);
+    return 0;
+}
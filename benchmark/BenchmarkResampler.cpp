@@ -0,0 +1,72 @@
+/*
+ * Measures the time per buffer required to resample between common sample-rates for every quality-level,
+ * with the scalar and the vectorized implementation.
+ *
+ * Usage: BenchmarkResampler [number of buffers per measurement]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+
+#include "Resampler.h"
+
+//prevents the compiler from optimizing away the measured operations
+static volatile float sink = 0;
+
+/*!
+ * \return the average time in nanoseconds to resample a buffer of 10 ms mono audio
+ */
+static double measure(const unsigned int numberOfBuffers, const unsigned int inputRate, const unsigned int outputRate,
+                      const Resampler::Quality quality, const FormatConverter::InstructionSet instructionSet)
+{
+    const unsigned int bufferFrames = inputRate / 100;
+    Resampler resampler(inputRate, outputRate, 1, quality, bufferFrames, instructionSet);
+    std::vector<float> input(bufferFrames);
+    for(unsigned int i = 0; i < bufferFrames; i++)
+    {
+        input[i] = (float)sin(i * 0.1);
+    }
+    std::vector<float> output(resampler.getMaximumOutputFrames(bufferFrames));
+    //warm up caches and branch-predictors
+    for(unsigned int i = 0; i < numberOfBuffers / 10; i++)
+    {
+        resampler.process(input.data(), bufferFrames, output.data());
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for(unsigned int i = 0; i < numberOfBuffers; i++)
+    {
+        resampler.process(input.data(), bufferFrames, output.data());
+        sink += output[0];
+    }
+    const auto duration = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / (double)numberOfBuffers;
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned int numberOfBuffers = argc > 1 ? atoi(argv[1]) : 5000;
+    const FormatConverter::InstructionSet supportedSet = FormatConverter::getSupportedInstructionSet();
+    std::cout << "Resampling 10 ms of mono audio per buffer" << std::endl;
+
+    const std::vector<std::pair<unsigned int, unsigned int>> rates = {{44100, 48000}, {48000, 44100}, {48000, 16000}, {16000, 48000}};
+    const char* qualities[] = {"low", "medium", "high", "best"};
+    std::cout << std::setw(16) << "rates" << std::setw(9) << "quality" << std::setw(7) << "taps"
+            << std::setw(14) << "scalar [ns]" << std::setw(14) << "vector [ns]" << std::setw(10) << "speedup" << std::endl;
+    for(const auto& rate : rates)
+    {
+        for(unsigned int quality = 0; quality < 4; quality++)
+        {
+            const Resampler resampler(rate.first, rate.second, 1, static_cast<Resampler::Quality>(quality), 1);
+            const double scalar = measure(numberOfBuffers, rate.first, rate.second, static_cast<Resampler::Quality>(quality), FormatConverter::InstructionSet::SCALAR);
+            const double vectorized = measure(numberOfBuffers, rate.first, rate.second, static_cast<Resampler::Quality>(quality), supportedSet);
+            std::cout << std::setw(7) << rate.first << " -> " << std::setw(5) << rate.second << std::setw(9) << qualities[quality]
+                    << std::setw(7) << resampler.getFilterLength() << std::fixed << std::setprecision(1) << std::setw(14) << scalar
+                    << std::setw(14) << vectorized << std::setw(9) << (scalar / vectorized) << "x" << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Measures the additional time per package required to protect (encrypt) and unprotect (decrypt) RTP-packages with SRTP.
+ *
+ * Usage: BenchmarkSRTP [number of packages per measurement]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+#include "rtp/SRTPContext.h"
+
+static const uint8_t masterKey[SRTP_MASTER_KEY_SIZE] = {0};
+static const uint8_t masterSalt[SRTP_MASTER_SALT_SIZE] = {0};
+
+//prevents the compiler from optimizing away the measured operations
+static volatile unsigned int sink = 0;
+
+/*!
+ * \return the average time in nanoseconds per package to execute the given operation
+ */
+template<typename Operation>
+static double measure(const unsigned int numberOfPackages, Operation operation)
+{
+    //warm up caches and branch-predictors
+    for(unsigned int i = 0; i < numberOfPackages / 10; i++)
+    {
+        operation();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for(unsigned int i = 0; i < numberOfPackages; i++)
+    {
+        operation();
+    }
+    const auto duration = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / (double)numberOfPackages;
+}
+
+static void benchmark(const bool useHardwareAcceleration, const unsigned int numberOfPackages)
+{
+    const SRTPContext context(masterKey, masterSalt, useHardwareAcceleration);
+    std::cout << (context.isHardwareAccelerated() ? "AES-NI/PCLMULQDQ" : "portable") << " implementation:" << std::endl;
+    std::cout << std::setw(10) << "payload" << std::setw(12) << "RTP [ns]" << std::setw(14) << "protect [ns]" << std::setw(16) << "unprotect [ns]" << std::endl;
+
+    //typical payload-sizes, e.g. 20 ms of G.711 (160 bytes) up to 20 ms of 16 bit stereo 16 kHz PCM (1280 bytes)
+    const std::vector<unsigned int> payloadSizes = {20, 80, 160, 320, 640, 1280};
+    for(const unsigned int payloadSize : payloadSizes)
+    {
+        RTPPackageHandler package(payloadSize);
+        const std::vector<char> payload(payloadSize, 'x');
+        const unsigned int rtpSize = RTP_HEADER_MIN_SIZE + payloadSize;
+
+        //the baseline is the creation of the plain RTP-package
+        const double baseline = measure(numberOfPackages, [&]()
+        {
+            package.createNewRTPPackage(payload.data(), payloadSize);
+            sink += ((const uint8_t*)package.getWorkBuffer())[rtpSize - 1];
+        });
+        const double protect = measure(numberOfPackages, [&]()
+        {
+            package.createNewRTPPackage(payload.data(), payloadSize);
+            unsigned int packageSize = rtpSize;
+            context.protect(package, packageSize, 0);
+            sink += packageSize;
+        });
+        const double roundTrip = measure(numberOfPackages, [&]()
+        {
+            package.createNewRTPPackage(payload.data(), payloadSize);
+            unsigned int packageSize = rtpSize;
+            context.protect(package, packageSize, 0);
+            if(!context.unprotect(package, packageSize, 0))
+            {
+                std::cerr << "Failed to unprotect package!" << std::endl;
+                exit(1);
+            }
+            sink += packageSize;
+        });
+        std::cout << std::setw(10) << payloadSize << std::setw(12) << std::fixed << std::setprecision(1) << baseline
+                << std::setw(14) << (protect - baseline) << std::setw(16) << (roundTrip - protect) << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned int numberOfPackages = argc > 1 ? atoi(argv[1]) : 200000;
+    if(AESGCM::isHardwareAccelerationSupported())
+    {
+        benchmark(true, numberOfPackages);
+    }
+    benchmark(false, numberOfPackages);
+    return 0;
+}
@@ -0,0 +1,112 @@
+#ifndef AESGCM_H
+#define	AESGCM_H
+
+#include <stdint.h>
+
+/*!
+ * AES-128 in Galois/Counter Mode (GCM, NIST SP 800-38D) with 96 bit IVs and 128 bit authentication-tags,
+ * as used by SRTP (RFC 7714).
+ *
+ * On x86 CPUs supporting the AES-NI and PCLMULQDQ instructions, these are used for encryption and authentication.
+ * Otherwise a portable table-based implementation is used, which is considerably slower and not resistant to cache-timing attacks.
+ *
+ * All operations work in-place on the given data and do not allocate any memory.
+ */
+class AESGCM
+{
+public:
+    /*!
+     * The size of the key in bytes
+     */
+    static const unsigned int KEY_SIZE = 16;
+
+    /*!
+     * The size of the initialization-vector in bytes
+     */
+    static const unsigned int IV_SIZE = 12;
+
+    /*!
+     * The size of the authentication-tag in bytes
+     */
+    static const unsigned int TAG_SIZE = 16;
+
+    /*!
+     * \param key The KEY_SIZE bytes of the AES-key
+     *
+     * \param useHardwareAcceleration Whether to use the AES-NI/PCLMULQDQ instructions, if available
+     */
+    AESGCM(const uint8_t* key, const bool useHardwareAcceleration = true);
+
+    /*!
+     * Encrypts the data in-place and calculates the authentication-tag over the additional data and the cipher-text
+     *
+     * \param iv The IV_SIZE bytes of the initialization-vector, must never be re-used with the same key
+     *
+     * \param additionalData The data to authenticate, but not to encrypt
+     *
+     * \param additionalDataSize The size of the additional data in bytes
+     *
+     * \param data The plain-text which is overwritten with the cipher-text
+     *
+     * \param dataSize The size of the data in bytes
+     *
+     * \param tag Is set to the TAG_SIZE bytes of the authentication-tag
+     */
+    void encrypt(const uint8_t* iv, const uint8_t* additionalData, const unsigned int additionalDataSize, uint8_t* data, const unsigned int dataSize, uint8_t* tag) const;
+
+    /*!
+     * Verifies the authentication-tag and decrypts the data in-place, if it is authentic
+     *
+     * \param iv The IV_SIZE bytes of the initialization-vector used to encrypt the data
+     *
+     * \param additionalData The authenticated, but not encrypted data
+     *
+     * \param additionalDataSize The size of the additional data in bytes
+     *
+     * \param data The cipher-text which is overwritten with the plain-text
+     *
+     * \param dataSize The size of the data in bytes
+     *
+     * \param tag The TAG_SIZE bytes of the received authentication-tag
+     *
+     * \return whether the tag is valid. If not, the data is left unchanged
+     */
+    bool decrypt(const uint8_t* iv, const uint8_t* additionalData, const unsigned int additionalDataSize, uint8_t* data, const unsigned int dataSize, const uint8_t* tag) const;
+
+    /*!
+     * Encrypts a single 16 byte block with the raw AES block-cipher, e.g. for key-derivation
+     */
+    void encryptBlock(const uint8_t* input, uint8_t* output) const;
+
+    /*!
+     * \return whether this instance uses the AES-NI/PCLMULQDQ instructions
+     */
+    bool isHardwareAccelerated() const;
+
+    /*!
+     * \return whether the CPU supports the instructions required for the hardware accelerated implementation
+     */
+    static bool isHardwareAccelerationSupported();
+
+private:
+    //the 11 round-keys of AES-128, in the byte-order expected by AES-NI
+    uint8_t roundKeys[11 * 16];
+    //the hash-key H = E(K, 0^128)
+    uint8_t hashKey[16];
+    //the multiples of H for the 4-bit table-based GHASH, high and low 64 bits
+    uint64_t hashTableHigh[16];
+    uint64_t hashTableLow[16];
+    //H, H^2, H^3 and H^4 in the bit-reflected representation used by the PCLMULQDQ-based GHASH
+    uint8_t hashKeyPowers[4 * 16];
+    bool hardwareAccelerated;
+
+    void expandKey(const uint8_t* key);
+    void encryptBlockSoftware(const uint8_t* input, uint8_t* output) const;
+    void multiplyHashKey(uint8_t* block) const;
+    void ghashSoftware(uint8_t* hash, const uint8_t* data, const unsigned int dataSize) const;
+    void ctrSoftware(const uint8_t* counterBlock, uint8_t* data, const unsigned int dataSize) const;
+    void calculateTagSoftware(const uint8_t* counterBlock, const uint8_t* additionalData, const unsigned int additionalDataSize,
+                              const uint8_t* cipherText, const unsigned int dataSize, uint8_t* tag) const;
+};
+
+#endif	/* AESGCM_H */
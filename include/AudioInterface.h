@@ -2,9 +2,15 @@
 #define	AUDIOINTERFACE_H
 
 #include "AudioProcessor.h"
+#include "AudioRingBuffer.h"
+#include "ProcessorChain.h"
 #include <vector>
 #include <memory>
 #include <iostream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 
 /*!
@@ -65,6 +71,7 @@ public:
 
     /*!
      * Called when an AudioConfiguration is set and before the audio processing starts.
+     * Configures the AudioProcessors and allocates the working-buffers for the process chain.
      */
     auto prepareForExecution() -> bool;
 
@@ -99,6 +106,13 @@ public:
 	 */
     auto removeAudioProcessor(std::string nameOfAudioProcessor) -> bool;
 
+	/*!
+	 * Sets a fixed chain of AudioProcessors (e.g. a StaticProcessorChain), which is executed instead of the AudioProcessors
+	 * added with addProcessor(). This avoids the overhead of the dynamic process chain for chains known at compile-time.
+	 * \param processorChain The chain to use, nullptr to use the dynamic process chain. The AudioInterface takes ownership.
+	 */
+	auto setProcessorChain(ProcessorChain *processorChain) -> void;
+
 	/*!
 	 * Clear the process chain - removes all AudioProcessors.
 	 */
@@ -129,6 +143,27 @@ public:
 	 */
 	auto setOutputStream(std::shared_ptr<std::ostream> outputStream) -> void;
 
+	/*!
+	 * Enables or disables the pipelined processing, must be set before the processing is started.
+	 *
+	 * In pipelined mode, the audio-callback only copies the audio-data into and out of lock-free ring-buffers
+	 * and a dedicated thread runs the AudioProcessors one buffer ahead of the audio-device.
+	 * This adds the duration of one buffer to the output-latency, but slow processors no longer delay the audio-callback.
+	 */
+	auto setPipelinedProcessing(bool enabled) -> void;
+
+	/*!
+	 * Sets the number of audio-frames passed to the AudioProcessors per call, must be set before the processing is started.
+	 *
+	 * The audio-data of the device is collected in a FIFO and passed to the AudioProcessors in blocks of the given size,
+	 * so an audio-callback runs the processors zero or several times. This decouples the buffer-size of the device (and thereby the latency)
+	 * from the frame-size required by a codec, e.g. 20 ms (960 frames at 48 kHz) for Opus with a device-buffer of 256 frames.
+	 * On output, the processed blocks are collected and passed to the device in the buffer-size of the device.
+	 *
+	 * \param frames The number of frames per block, zero (the default) to process the buffers of the device directly
+	 */
+	auto setProcessingFrames(unsigned int frames) -> void;
+
 protected:
 	virtual auto vStartRecordingMode() -> void = 0;
 	virtual auto vStartPlaybackMode() -> void = 0;
@@ -144,13 +179,60 @@ protected:
 
 	/*!
 	 * Is called when the speakers are ready to play audio data.
+	 * Runs the AudioProcessors directly or reads the already processed data in pipelined mode.
+	 * The AudioProcessors are passed the StreamData of the output, which is filled in per call
 	 */
-    auto processAudioOutput(void *outputBuffer, unsigned int outputBufferByteSize, void *userData) -> void;;
+	auto handleAudioOutput(void *outputBuffer, unsigned int outputBufferByteSize) -> void;
 
 	/*!
 	 * Is called when data is available from the microphone.
+	 * Runs the AudioProcessors directly or passes the data to the processing-thread in pipelined mode.
+	 * The AudioProcessors are passed the StreamData of the input, which is filled in per call
+	 */
+	auto handleAudioInput(void *inputBuffer, unsigned int inputBufferByteSize) -> void;
+
+	/*!
+	 * Collects the output-data of the AudioProcessors in blocks of processingFrames and fills the output-buffer of the device.
+	 * Processes the output-buffer directly, if no reblocking is required.
+	 */
+	auto reblockAudioOutput(void *outputBuffer, unsigned int outputBufferByteSize, StreamData *userData) -> void;
+
+	/*!
+	 * Collects the input-data of the device and passes every complete block of processingFrames to the AudioProcessors.
+	 * Processes the input-buffer directly, if no reblocking is required.
+	 */
+	auto reblockAudioInput(void *inputBuffer, unsigned int inputBufferByteSize, StreamData *userData) -> void;
+
+	/*!
+	 * Runs the output-data through the AudioProcessors.
+	 */
+    auto processAudioOutput(void *outputBuffer, unsigned int outputBufferByteSize, StreamData *userData) -> void;
+
+	/*!
+	 * Runs the input-data through the AudioProcessors.
 	 */
-	auto processAudioInput(void *inputBuffer, unsigned int inputBufferByteSize, void *userData) -> void;;
+	auto processAudioInput(void *inputBuffer, unsigned int inputBufferByteSize, StreamData *userData) -> void;
+
+	/*!
+	 * Starts the processing-thread, if pipelined processing is enabled.
+	 * \param processOutput Whether the thread produces output-data
+	 */
+	auto startProcessingThread(bool processOutput) -> void;
+
+	/*!
+	 * Stops the processing-thread and waits for it to finish.
+	 */
+	auto stopProcessingThread() -> void;
+
+	/*!
+	 * Wakes the processing-thread, called from the audio-callback after accessing the pipeline-buffers
+	 */
+	auto notifyProcessingThread() -> void;
+
+	/*!
+	 * The method executed by the processing-thread.
+	 */
+	auto runProcessingThread(bool processOutput) -> void;
     
 	/*!
 	 * Is called before the processing starts. 
@@ -170,17 +252,88 @@ protected:
 	 */
     auto disposeAudioProcessors() -> bool;
 
+	/*!
+	 * Determines the maximum buffer-sizes required by the process chain for the current AudioConfiguration
+	 * (see AudioProcessor#getMaximumInputSize()) and allocates the working-buffers accordingly.
+	 * A second buffer per direction is only allocated, if any AudioProcessor can't process its data in-place.
+	 *
+	 * \param bufferFrames The number of audio-frames per buffer of the audio-device
+	 */
+	auto allocateWorkingBuffers(unsigned int bufferFrames) -> void;
+
+	/*!
+	 * Frees all working-buffers
+	 */
+	auto freeWorkingBuffers() -> void;
+
 	bool isAudioConfigSet { false };
 	bool isExecutionReady { false };
 
+	//the alignment of the working-buffers in bytes, a cache-line
+	static const unsigned int WORKING_BUFFER_ALIGNMENT { 64 };
+
+	//the memory holding all working-buffers
+	char* workingBufferMemory { nullptr };
 	void* workingBufferInput { nullptr };
-	int maxSizeWorkingBufferInput{ 25000 };	// TODO This should be dynamic
+	//the buffer to write into for processors not working in-place, nullptr if all processors work in-place
+	void* alternateBufferInput { nullptr };
+	unsigned int maxSizeWorkingBufferInput { 0 };
+	//the number of bytes provided by the audio-device per input-buffer
+	unsigned int deviceBufferSizeInput { 0 };
+	//the output working-buffers, nullptr if the output is processed directly in the buffer of the audio-device
+	void* workingBufferOutput { nullptr };
+	void* alternateBufferOutput { nullptr };
+	unsigned int maxSizeWorkingBufferOutput { 0 };
+	//the number of bytes requested by the audio-device per output-buffer
+	unsigned int deviceBufferSizeOutput { 0 };
+
+	//the number of frames passed to the AudioProcessors per call, zero to pass the buffers of the device
+	unsigned int processingFrames { 0 };
+	//the number of frames actually passed to the AudioProcessors per call, the buffer-size of the device without reblocking
+	unsigned int blockFrames { 0 };
+	//the number of bytes passed to the AudioProcessors per call, equal to the device-buffers without reblocking
+	unsigned int processingBufferSizeInput { 0 };
+	unsigned int processingBufferSizeOutput { 0 };
+	//the FIFOs collecting the blocks of processingFrames, nullptr if no reblocking is required or the pipeline-buffers are used
+	std::unique_ptr<AudioRingBuffer> reblockingInput;
+	std::unique_ptr<AudioRingBuffer> reblockingOutput;
+	//the block the output-processors run in before it is written to the FIFO
+	std::unique_ptr<char[]> reblockingBufferOutput;
+
+	//the number of input-buffers the processing-thread may lag behind the audio-callback
+	static const unsigned int PIPELINE_INPUT_BUFFERS { 4 };
+
+	//the information about the current buffer passed to the AudioProcessors from the audio-callback, one per direction.
+	//The processing-thread uses its own StreamData in pipelined mode
+	StreamData inputStreamData { 0, 0, false };
+	StreamData outputStreamData { 0, 0, false };
+
+	bool isPipelined { false };
+	std::unique_ptr<AudioRingBuffer> pipelineInput;
+	std::unique_ptr<AudioRingBuffer> pipelineOutput;
+	//the buffer the processing-thread runs the output-processors in
+	std::unique_ptr<char[]> pipelineBufferOutput;
+	std::thread processingThread;
+	std::atomic<bool> processingThreadRunning { false };
+	//signalled by the audio-callback whenever it wrote input into or read output from the pipeline
+	std::mutex processingMutex;
+	std::condition_variable processingSignal;
+	std::atomic<bool> processingRequested { false };
+	//the number of input-buffers dropped and output-buffers not ready in time
+	std::atomic<unsigned long> pipelineOverruns { 0 };
+	std::atomic<unsigned long> pipelineUnderruns { 0 };
 
 	AudioConfiguration audioConfiguration { 0 };
 	
 	std::vector< std::unique_ptr<AudioProcessor> > audioProcessors;
-
-	std::shared_ptr< std::ostream > outputStream{ &std::cout };
+	//the fixed chain executed instead of the audioProcessors, if set
+	std::unique_ptr<ProcessorChain> processorChain;
+	//whether all audioProcessors work in-place, so the processors can be called without checking
+	bool isInputChainInPlace { true };
+	bool isOutputChainInPlace { true };
+
+	//std::cout must not be deleted with the last reference
+	std::shared_ptr< std::ostream > outputStream{ &std::cout, [](std::ostream*) {} };
 };
 
 #endif
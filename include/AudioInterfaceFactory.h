@@ -3,11 +3,10 @@
 
 #include "AudioInterface.h"
 #include "RTAudioWrapper.h"
+#include "Parameters.h"
+#include "ConfigurationMode.h"
 
 
-//Initialize names
-enum class AudioProcessorNames { RTAUDIOWRAPPER };
-
 /*!
  * Factory-class to provide an audio-handler object without needing to know the details of the implementation.
  */
@@ -16,6 +15,15 @@ class AudioInterfaceFactory
 public:
     /*! Name for the RtAudioWrapper */
     static const std::string RTAUDIO_WRAPPER;
+    /*! Name for the FileAudioWrapper, reading from and writing to WAV-files instead of a sound-device */
+    static const std::string FILE_AUDIO;
+
+    static const Parameter* PROCESSING_FRAMES;
+    static const Parameter* PIPELINED_PROCESSING;
+    static const Parameter* FILE_AUDIO_INPUT;
+    static const Parameter* FILE_AUDIO_OUTPUT;
+    static const Parameter* FILE_AUDIO_UNPACED;
+    static const Parameter* FILE_AUDIO_LOOP;
 
     /*!
      * \param name The name of the audio-handler to create
@@ -24,6 +32,18 @@ public:
      * \throw an invalid-argument exception, if there was no audio-handler for the given name
      */
     static auto getAudioHandler(const std::string name, const AudioConfiguration& audioConfig)->std::unique_ptr<AudioInterface>;
+    /*!
+     * Creates the audio-handler and applies the processing-settings (see AudioInterface#setProcessingFrames()
+     * and AudioInterface#setPipelinedProcessing()) from the configuration.
+     * The FileAudioWrapper is created with the files and the pacing from the configuration
+     *
+     * \param name The name of the audio-handler to create
+     * \param audioConfig The audio-configuration to initialize the handler with
+     * \param configMode The ConfigurationMode to retrieve the processing-settings from
+     * \return an unique-pointer to the created handler
+     * \throw an invalid-argument exception, if there was no audio-handler for the given name
+     */
+    static auto getAudioHandler(const std::string name, const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)->std::unique_ptr<AudioInterface>;
     /*!
      * \param name The name of the audio-handler to create
      * \return an unique-pointer to the created handler
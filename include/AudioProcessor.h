@@ -4,6 +4,20 @@
 #include <string>
 #include "configuration.h"
 
+/*!
+ * Information about the currently processed audio-buffer, passed along the processor-chain
+ */
+struct StreamData
+{
+    //the number of audio-frames (samples per channel) in the current buffer
+    unsigned int nBufferFrames;
+    //the maximum size of the buffer in bytes
+    unsigned int maxBufferSize;
+    //whether the current buffer contains silence, which is neither encoded nor sent (see ProcessorComfortNoise).
+    //If set, the buffer contains the comfort-noise payload instead of audio-data
+    bool isSilentPackage;
+};
+
 /*!
  * Abstract super-type for all classes used for intermediate handling of the input/output stream.
  *
@@ -41,6 +55,60 @@ public:
      */
     virtual bool cleanUp();
 
+    /*!
+     * Overwrite this method, if this AudioProcessor writes more bytes into the buffer than it is passed on input,
+     * e.g. to convert to a larger sample-format
+     *
+     * \param audioConfig The valid AudioConfiguration
+     *
+     * \param inputBufferByteSize The maximum number of bytes passed to #processInputData()
+     *
+     * \return the maximum number of bytes returned by #processInputData(), defaults to inputBufferByteSize
+     */
+    virtual unsigned int getMaximumInputSize(const AudioConfiguration& audioConfig, const unsigned int inputBufferByteSize) const;
+
+    /*!
+     * Overwrite this method, if this AudioProcessor writes more bytes into the buffer than it is passed on output,
+     * e.g. a decoder not producing the device-format
+     *
+     * \param audioConfig The valid AudioConfiguration
+     *
+     * \param outputBufferByteSize The maximum number of bytes passed to #processOutputData()
+     *
+     * \return the maximum number of bytes returned by #processOutputData(), defaults to outputBufferByteSize
+     */
+    virtual unsigned int getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const;
+
+    /*!
+     * Overwrite this method, if this AudioProcessor can't read and write the same buffer.
+     * If so, #processInputDataOutOfPlace() and #processOutputDataOutOfPlace() are called instead of the in-place methods.
+     *
+     * \return whether the data is processed in-place, defaults to true
+     */
+    virtual bool isProcessingInPlace() const;
+
+    /*!
+     * Processes the input-data from the source-buffer into a separate target-buffer.
+     *
+     * The default implementation copies the data into the target-buffer and processes it in-place
+     *
+     * \param sourceBuffer The buffer to read the data from
+     *
+     * \param inputBufferByteSize The actual number of valid bytes stored in the source-buffer
+     *
+     * \param targetBuffer The buffer to write the data to, holds at least #getMaximumInputSize() bytes
+     *
+     * \param userData Any additional data
+     *
+     * \return the number of valid bytes in the targetBuffer
+     */
+    virtual unsigned int processInputDataOutOfPlace(const void *sourceBuffer, const unsigned int inputBufferByteSize, void *targetBuffer, StreamData *userData);
+
+    /*!
+     * Processes the output-data from the source-buffer into a separate target-buffer, see #processInputDataOutOfPlace()
+     */
+    virtual unsigned int processOutputDataOutOfPlace(const void *sourceBuffer, const unsigned int outputBufferByteSize, void *targetBuffer, StreamData *userData);
+
 
     /*!
      * The actual processing methods. processInputData is the counterpart of processInputData
@@ -53,7 +121,7 @@ public:
      *
      * \return the new number of valid bytes in the inputBuffer, maximal StreamData#maxBufferSize
      */
-    virtual unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, void *userData) = 0;
+    virtual unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData) = 0;
 
     /*!
      * The actual processing methods. processInputData is the counterpart of processInputData
@@ -66,7 +134,7 @@ public:
      *
      * \return the new number of valid bytes in the outputBuffer, maximal StreamData#maxBufferSize
      */
-    virtual unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, void *userData) = 0;
+    virtual unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData) = 0;
 private:
     const std::string name;
 };
@@ -20,6 +20,16 @@ class AudioProcessorFactory
 public:
     static const std::string OPUS_CODEC;
     static const std::string WAV_WRITER;
+    static const std::string COMFORT_NOISE;
+    static const std::string FORMAT_CONVERSION;
+    static const std::string RESAMPLER;
+    static const std::string VOICE_ACTIVITY_DETECTION;
+    static const std::string G711_MU_LAW;
+    static const std::string G711_A_LAW;
+    static const std::string G722_CODEC;
+    static const std::string L16_PCM;
+    static const std::string LOSSLESS_CODEC;
+    static const std::string OGG_OPUS_RECORDER;
 
     /*!
      * Returns the AudioProcessor for the given name
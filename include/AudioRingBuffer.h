@@ -0,0 +1,81 @@
+#ifndef AUDIORINGBUFFER_H
+#define	AUDIORINGBUFFER_H
+
+#include <atomic>
+
+/*!
+ * Lock-free ring-buffer of bytes for exactly one writing and one reading thread (single-producer, single-consumer).
+ *
+ * Neither reading nor writing allocates memory, blocks or calls into the operating system,
+ * so this buffer can be used from the real-time audio-callback.
+ *
+ * Data is always read and written as a whole, i.e. a read or write of a partial audio-buffer is never performed.
+ */
+class AudioRingBuffer
+{
+public:
+    /*!
+     * \param capacity The minimum number of bytes the buffer can hold, is rounded up to the next power of two
+     */
+    AudioRingBuffer(unsigned int capacity);
+
+    ~AudioRingBuffer();
+
+    /*!
+     * Writes the data into the buffer. Must only be called from the writing thread
+     *
+     * \param data The data to write
+     *
+     * \param size The number of bytes to write
+     *
+     * \return whether the data was written, false if there is not enough space for all of the data
+     */
+    bool write(const void* data, const unsigned int size);
+
+    /*!
+     * Reads data from the buffer. Must only be called from the reading thread
+     *
+     * \param data The buffer to read into
+     *
+     * \param size The number of bytes to read
+     *
+     * \return whether the data was read, false if the buffer holds less than size bytes
+     */
+    bool read(void* data, const unsigned int size);
+
+    /*!
+     * \return the number of bytes available for reading
+     */
+    unsigned int getReadableSize() const;
+
+    /*!
+     * \return the number of bytes available for writing
+     */
+    unsigned int getWritableSize() const;
+
+    /*!
+     * \return the number of bytes the buffer can hold
+     */
+    unsigned int getCapacity() const;
+
+    /*!
+     * Discards all data in the buffer. Must not be called, while another thread reads or writes
+     */
+    void clear();
+
+private:
+    //the size of a cache-line, used to separate the indices accessed by different threads
+    static const unsigned int CACHE_LINE_SIZE = 64;
+
+    const unsigned int capacity;
+    char* buffer;
+    //the indices are never wrapped, only the buffer-position is calculated modulo the capacity
+    std::atomic<unsigned int> readIndex;
+    char readIndexPadding[CACHE_LINE_SIZE - sizeof(std::atomic<unsigned int>)];
+    std::atomic<unsigned int> writeIndex;
+    char writeIndexPadding[CACHE_LINE_SIZE - sizeof(std::atomic<unsigned int>)];
+
+    static unsigned int roundUpToPowerOfTwo(unsigned int value);
+};
+
+#endif	/* AUDIORINGBUFFER_H */
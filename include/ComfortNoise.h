@@ -0,0 +1,89 @@
+#ifndef COMFORTNOISE_H
+#define	COMFORTNOISE_H
+
+#include <stdint.h>
+
+/*!
+ * Size of the comfort-noise payload in bytes, only the noise-level is transmitted
+ */
+static const unsigned int COMFORT_NOISE_PAYLOAD_SIZE = 1;
+
+/*!
+ * Analysis and synthesis of comfort-noise (CN) as specified in RFC 3389.
+ *
+ * The payload of a CN-package has the following format:
+ *
+ *  0 1 2 3 4 5 6 7
+ * +-+-+-+-+-+-+-+-+
+ * |0|    level    |
+ * +-+-+-+-+-+-+-+-+
+ *
+ * level: 7 bits
+ *  The noise-level in -dBov (0 to -127 dBov). The reference (0 dBov) is a full-scale square-wave.
+ *
+ * The optional spectral information (reflection coefficients) is not transmitted, so the comfort-noise is white noise.
+ */
+class ComfortNoise
+{
+public:
+    ComfortNoise();
+
+    /*!
+     * \param samples The 16 bit PCM samples
+     *
+     * \param numberOfSamples The number of samples (of all channels)
+     *
+     * \return the noise-level in -dBov
+     */
+    static uint8_t calculateNoiseLevel(const int16_t* samples, const unsigned int numberOfSamples);
+
+    /*!
+     * \param samples The 32 bit float PCM samples
+     *
+     * \param numberOfSamples The number of samples (of all channels)
+     *
+     * \return the noise-level in -dBov
+     */
+    static uint8_t calculateNoiseLevel(const float* samples, const unsigned int numberOfSamples);
+
+    /*!
+     * Fills the buffer with comfort-noise of the given level.
+     *
+     * The level is faded from the level of the previously generated noise to avoid audible steps
+     *
+     * \param samples The buffer to write the 16 bit PCM samples into
+     *
+     * \param numberOfSamples The number of samples (of all channels)
+     *
+     * \param noiseLevel The noise-level in -dBov
+     */
+    void generate(int16_t* samples, const unsigned int numberOfSamples, const uint8_t noiseLevel);
+
+    /*!
+     * Fills the buffer with 32 bit float comfort-noise of the given level
+     */
+    void generate(float* samples, const unsigned int numberOfSamples, const uint8_t noiseLevel);
+
+private:
+    //state of the xorshift random-number generator
+    uint32_t randomState;
+    //the RMS-amplitude relative to full-scale of the last generated sample
+    float currentAmplitude;
+
+    /*!
+     * \return the RMS-amplitude relative to full-scale for the given level in -dBov
+     */
+    static float toAmplitude(const uint8_t noiseLevel);
+
+    /*!
+     * \return the noise-level in -dBov for the mean power relative to full-scale
+     */
+    static uint8_t toNoiseLevel(const double meanPower);
+
+    /*!
+     * \return the next uniformly distributed random value with an RMS of 1
+     */
+    float nextRandom();
+};
+
+#endif	/* COMFORTNOISE_H */
@@ -0,0 +1,103 @@
+#ifndef FILEAUDIOWRAPPER_H
+#define	FILEAUDIOWRAPPER_H
+
+#include <mutex>
+#include <condition_variable>
+
+#include "AudioInterface.h"
+#include "WAVReader.h"
+#include "WAVWriter.h"
+
+/*!
+ * Implementation of AudioInterface reading the audio-input from a WAV-file and writing the audio-output into a WAV-file,
+ * so the processor chain can run without a sound-device, e.g. for throughput- and soak-tests on headless machines.
+ *
+ * The input-file is mapped into memory (see WAVReader), the output is written asynchronously (see WAVWriter) or discarded.
+ * A thread takes the place of the audio-device and runs the processor chain for every buffer, either paced to real-time
+ * or as fast as possible. Without an input-file, silence is recorded.
+ */
+class FileAudioWrapper : public AudioInterface
+{
+public:
+
+	enum class Pacing : char
+	{
+		//a buffer is processed every buffer-duration, like a sound-device would
+		REAL_TIME,
+		//the buffers are processed back-to-back
+		AS_FAST_AS_POSSIBLE
+	};
+
+	/*!
+	 * \param inputFileName The WAV-file to read the audio-input from, empty to record silence
+	 *
+	 * \param outputFileName The WAV-file to write the audio-output into, empty to discard the audio-output
+	 *
+	 * \param pacing Whether to process the buffers in real-time or as fast as possible
+	 *
+	 * \param loopInput Whether to restart the input-file at its end (e.g. for soak-tests) instead of stopping
+	 */
+	FileAudioWrapper(const std::string& inputFileName = "", const std::string& outputFileName = "",
+		const Pacing pacing = Pacing::REAL_TIME, const bool loopInput = false);
+	~FileAudioWrapper();
+
+	/*!
+	 * Blocks until the whole input-file was processed or the processing is stopped.
+	 * Returns immediately, if the processing is not running
+	 */
+	auto waitForEnd() -> void;
+
+	/*!
+	 * \return the number of audio-frames processed since the processing was started
+	 */
+	auto getProcessedFrames() const -> uint64_t;
+
+protected:
+	auto vStartRecordingMode() -> void;
+	auto vStartPlaybackMode() -> void;
+	auto vStartDuplexMode() -> void;
+	auto vSetConfiguration(AudioConfiguration audioConfiguration) -> void;
+	auto vSuspend() -> void;
+	auto vResume() -> void;
+	auto vStop() -> void;
+	auto vReset() -> void;
+	auto vSetDefaultAudioConfig() -> void;
+	auto vPrepareForExecution() -> bool;
+	auto vGetBufferSize() -> unsigned int;
+
+private:
+	const std::string outputFileName;
+	const Pacing pacing;
+	const bool loopInput;
+	std::unique_ptr<WAVReader> inputFile;
+	std::unique_ptr<WAVWriter> outputFile;
+
+	std::thread audioThread;
+	std::atomic<bool> threadRunning { false };
+	std::atomic<bool> isSuspended { false };
+	std::atomic<uint64_t> processedFrames { 0 };
+	//signals the end of the input-file to #waitForEnd()
+	std::mutex endMutex;
+	std::condition_variable endCondition;
+
+	/*!
+	 * Checks the configuration against the input-file, opens the output-file and starts the audio-thread
+	 */
+	auto startAudioThread(bool processInput, bool processOutput) -> void;
+
+	auto stopAudioThread() -> void;
+
+	/*!
+	 * The method executed by the audio-thread, taking the place of the callback of a sound-device.
+	 */
+	auto runAudioThread(bool processInput, bool processOutput) -> void;
+
+	/*!
+	 * Fills the input-buffer with the next samples of the input-file, silence past its end
+	 *
+	 * \return whether the end of the input-file was reached
+	 */
+	auto readInput(char* inputBuffer, unsigned int inputBufferByteSize, uint64_t& position) -> bool;
+};
+
+#endif
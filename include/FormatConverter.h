@@ -0,0 +1,86 @@
+#ifndef FORMATCONVERTER_H
+#define	FORMATCONVERTER_H
+
+#include <stdint.h>
+
+#include "configuration.h"
+
+/*!
+ * Converts interleaved PCM samples from one AudioFormat into another.
+ *
+ * Integer samples are interpreted as fixed-point values in the range [-1, 1), so a conversion keeps the full-scale of the signal,
+ * e.g. a 24 bit sample is converted to a 32 bit sample by shifting it into the upper 24 bits.
+ * Conversions to integer formats round to the nearest value and saturate, conversion from 32 to 24 bit truncates.
+ * The conversion from 64 to 32 bit float adds triangular (TPDF) dither with the amplitude of the least significant bit of 24 bit audio.
+ *
+ * Supported are the conversions between 32 bit float and 16, 24 or 32 bit integer, between 24 and 32 bit integer
+ * and between 64 and 32 bit float. 24 bit samples are packed into 3 bytes (little endian).
+ *
+ * The conversions use the SSE2 or AVX2 (x86) and NEON (ARMv8) instructions, depending on the features of the CPU, which are determined at runtime.
+ */
+class FormatConverter
+{
+public:
+
+    enum class InstructionSet : char
+    {
+        SCALAR,
+        SSE2,
+        AVX2,
+        NEON
+    };
+
+    /*!
+     * \param sourceFormat The format of the samples to convert
+     *
+     * \param targetFormat The format to convert the samples to
+     *
+     * \param instructionSet The instruction-set to use, is reduced to the instruction-set supported by the CPU
+     */
+    FormatConverter(const AudioFormat sourceFormat, const AudioFormat targetFormat, const InstructionSet instructionSet = getSupportedInstructionSet());
+
+    /*!
+     * \return whether the conversion between the given formats is supported
+     */
+    bool isValid() const;
+
+    /*!
+     * Converts the samples from the source- into the target-buffer.
+     *
+     * The buffers must not overlap, except for conversions between equal formats
+     *
+     * \param source The samples in the source-format
+     *
+     * \param target The buffer to write the converted samples into
+     *
+     * \param numberOfSamples The number of samples (of all channels) to convert
+     */
+    void convert(const void* source, void* target, const unsigned int numberOfSamples);
+
+    /*!
+     * \return the instruction-set used by this converter
+     */
+    InstructionSet getInstructionSet() const;
+
+    /*!
+     * \return the most powerful instruction-set supported by this CPU
+     */
+    static InstructionSet getSupportedInstructionSet();
+
+private:
+    //the number of random-number generators, one per vector-lane
+    static const unsigned int DITHER_LANES = 8;
+
+    typedef void (*Kernel)(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState);
+
+    AudioFormat sourceFormat;
+    AudioFormat targetFormat;
+    InstructionSet instructionSet;
+    Kernel kernel;
+    //the states of the xorshift random-number generators for dithering
+    uint32_t randomState[DITHER_LANES];
+
+    static Kernel selectKernel(const AudioFormat sourceFormat, const AudioFormat targetFormat, const InstructionSet instructionSet);
+};
+
+#endif	/* FORMATCONVERTER_H */
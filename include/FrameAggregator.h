@@ -0,0 +1,110 @@
+#ifndef FRAMEAGGREGATOR_H
+#define	FRAMEAGGREGATOR_H
+
+#include <stdint.h>
+
+/*!
+ * Combines several consecutive (encoded) audio-frames into the payload of a single RTP-package,
+ * reducing the package-rate and the header-overhead for small audio-buffers.
+ *
+ * The payload of an aggregated package has the following format:
+ *
+ *  0                   1                   2                   3
+ *  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |  frame count  |     length of frame 1     |        ....       |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |      length of frame N        |      frame 1 ... frame N      |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *
+ * frame count: 8 bits
+ *  The number N of frames in this package
+ *
+ * length of frame: 16 bits
+ *  The size in bytes of the frame, for every frame in this package
+ *
+ * The frames are stored directly after another in the order they were recorded.
+ */
+class FrameAggregator
+{
+public:
+    /*!
+     * The maximum size of an aggregated payload in bytes, limited by the 16 bit frame-lengths (and the size of an UDP-datagram)
+     */
+    static const unsigned int MAXIMUM_PAYLOAD_SIZE = UINT16_MAX;
+
+    /*!
+     * \param framesPerPackage The number of frames to combine into a single package
+     *
+     * \param maximumFrameSize The maximum size in bytes of a single frame
+     */
+    FrameAggregator(const uint8_t framesPerPackage, const unsigned int maximumFrameSize);
+    ~FrameAggregator();
+
+    /*!
+     * Appends the frame to the current package. If the package is complete, the next call to this method starts a new package
+     *
+     * \param frame The frame-data
+     *
+     * \param frameSize The size of the frame in bytes, must be smaller or equals to the maximum frame size
+     *
+     * \return whether the package is complete and can be retrieved via #getPayload()
+     */
+    bool addFrame(const void* frame, const unsigned int frameSize);
+
+    /*!
+     * Discards the frames of the incomplete current package
+     */
+    void reset();
+
+    /*!
+     * \return the payload of the current package
+     */
+    const void* getPayload() const;
+
+    /*!
+     * \return the size in bytes of the payload of the current package
+     */
+    unsigned int getPayloadSize() const;
+
+    /*!
+     * \return the number of frames combined into a single package
+     */
+    uint8_t getFramesPerPackage() const;
+
+    /*!
+     * \return the maximum size in bytes of an aggregated payload with the given number of frames
+     */
+    static unsigned int getMaximumPayloadSize(const uint8_t framesPerPackage, const unsigned int maximumFrameSize);
+
+    /*!
+     * \param payload The aggregated payload
+     *
+     * \param payloadSize The size of the payload in bytes
+     *
+     * \return the number of frames in the given payload, zero if the payload is malformed
+     */
+    static uint8_t getNumberOfFrames(const void* payload, const unsigned int payloadSize);
+
+    /*!
+     * \param payload The aggregated payload
+     *
+     * \param payloadSize The size of the payload in bytes
+     *
+     * \param index The index of the frame to retrieve
+     *
+     * \param frameSize Is set to the size of the frame in bytes
+     *
+     * \return a pointer to the frame with the given index inside the payload, or nullptr if no such frame exists
+     */
+    static const void* getFrame(const void* payload, const unsigned int payloadSize, const uint8_t index, unsigned int& frameSize);
+
+private:
+    const uint8_t framesPerPackage;
+    const unsigned int maximumFrameSize;
+    uint8_t* payloadBuffer;
+    uint8_t numberOfFrames;
+    unsigned int payloadSize;
+};
+
+#endif	/* FRAMEAGGREGATOR_H */
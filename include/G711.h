@@ -0,0 +1,84 @@
+#ifndef G711_H
+#define	G711_H
+
+#include <stdint.h>
+
+#include "FormatConverter.h"
+
+/*!
+ * The ITU-T G.711 codec, which compresses every 16 bit sample logarithmically into 8 bits, either with the μ-law (PCMU) or the A-law (PCMA).
+ *
+ * The results are bit-exact to the reference implementation of ITU-T G.191.
+ *
+ * The decoding uses a lookup-table, the encoding uses the SSE2 or AVX2 (x86) and NEON (ARMv8) instructions, depending on the features of the CPU.
+ * The vectorized encoder obtains the segment and the mantissa of the compressed sample from the exponent and mantissa of the sample converted to float.
+ */
+class G711
+{
+public:
+
+    enum class Law : char
+    {
+        //μ-law, used in North America and Japan
+        MU_LAW,
+        //A-law, used in Europe and the rest of the world
+        A_LAW
+    };
+
+    /*!
+     * \param law The companding-law to use
+     *
+     * \param instructionSet The instruction-set to use, is reduced to the instruction-set supported by the CPU
+     */
+    G711(const Law law, const FormatConverter::InstructionSet instructionSet = FormatConverter::getSupportedInstructionSet());
+
+    /*!
+     * Compresses the 16 bit samples into 8 bit samples
+     *
+     * \param samples The 16 bit PCM samples
+     *
+     * \param encoded The buffer to write the compressed samples into, may be the same as the samples
+     *
+     * \param numberOfSamples The number of samples (of all channels)
+     */
+    void encode(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples) const;
+
+    /*!
+     * Expands the 8 bit samples into 16 bit samples
+     *
+     * \param encoded The compressed samples
+     *
+     * \param samples The buffer to write the 16 bit samples into, may be the same as the compressed samples
+     *
+     * \param numberOfSamples The number of samples (of all channels)
+     */
+    void decode(const uint8_t* encoded, int16_t* samples, const unsigned int numberOfSamples) const;
+
+    Law getLaw() const;
+
+    /*!
+     * \return the instruction-set used to encode
+     */
+    FormatConverter::InstructionSet getInstructionSet() const;
+
+    /*!
+     * \return the μ-law code of a single sample
+     */
+    static uint8_t encodeMuLaw(const int16_t sample);
+
+    /*!
+     * \return the A-law code of a single sample
+     */
+    static uint8_t encodeALaw(const int16_t sample);
+
+private:
+    typedef void (*Kernel)(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples);
+
+    Law law;
+    FormatConverter::InstructionSet instructionSet;
+    Kernel encodeKernel;
+    //the 256 16 bit samples for the codes of this law
+    const int16_t* decodingTable;
+};
+
+#endif	/* G711_H */
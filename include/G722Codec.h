@@ -0,0 +1,130 @@
+#ifndef G722CODEC_H
+#define	G722CODEC_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "FormatConverter.h"
+
+/*!
+ * The ITU-T G.722 wideband codec at 64 kbit/s, encoding a single channel of 16 kHz audio.
+ *
+ * The signal is split by a quadrature mirror filter (QMF) into a low and a high sub-band of 8 kHz each,
+ * which are encoded with 6 bit and 2 bit sub-band ADPCM, so every pair of samples is encoded into a single byte.
+ *
+ * The 24-tap QMF filter banks use the SSE2 (x86) and NEON (ARMv8) instructions, depending on the features of the CPU,
+ * the results are identical to the scalar filters. The ADPCM is sequential by nature and stays scalar.
+ *
+ * NOTE: For historical reasons, the RTP clock-rate of G.722 is 8000 Hz (RFC 3551, section 4.5.2), although the audio is sampled at 16 kHz,
+ * so the RTP timestamp advances by one per encoded byte, see #RTP_CLOCK_RATE.
+ */
+class G722Codec
+{
+public:
+    //the sample-rate of the audio
+    static const unsigned int SAMPLE_RATE = 16000;
+    //the clock-rate of the RTP timestamps
+    static const unsigned int RTP_CLOCK_RATE = 8000;
+
+    /*!
+     * \param instructionSet The instruction-set to use for the QMF, is reduced to the instruction-set supported by the CPU.
+     *  The filters are too short to benefit from AVX2, so SSE2 is used instead
+     */
+    G722Codec(const FormatConverter::InstructionSet instructionSet = FormatConverter::getSupportedInstructionSet());
+
+    /*!
+     * Encodes the 16 bit samples of a single channel
+     *
+     * \param samples The 16 bit PCM samples at 16 kHz
+     *
+     * \param encoded The buffer to write the encoded bytes into, may be the same as the samples
+     *
+     * \param numberOfSamples The number of samples, must be even
+     *
+     * \return the number of encoded bytes, half the number of samples
+     */
+    unsigned int encode(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples);
+
+    /*!
+     * Decodes the bytes into 16 bit samples of a single channel
+     *
+     * \param encoded The encoded bytes
+     *
+     * \param samples The buffer to write the samples into, may be the same as the encoded bytes
+     *
+     * \param numberOfBytes The number of encoded bytes
+     *
+     * \return the number of decoded samples, twice the number of bytes
+     */
+    unsigned int decode(const uint8_t* encoded, int16_t* samples, const unsigned int numberOfBytes);
+
+    /*!
+     * Resets the encoder and decoder to their initial state
+     */
+    void reset();
+
+    /*!
+     * \return the instruction-set used for the QMF filter banks
+     */
+    FormatConverter::InstructionSet getInstructionSet() const;
+
+    /*!
+     * Calculates the two filter-outputs for every pair of samples
+     *
+     * \param signal The signal, 22 samples of history followed by the samples of all pairs
+     *
+     * \param numberOfPairs The number of pairs of samples
+     *
+     * \param firstCoefficients The 24 coefficients of the first filter, applied to the 24 samples ending with the pair
+     *
+     * \param secondCoefficients The 24 coefficients of the second filter
+     *
+     * \param first The output of the first filter per pair
+     *
+     * \param second The output of the second filter per pair
+     */
+    typedef void (*FilterKernel)(const int16_t* signal, const unsigned int numberOfPairs, const int16_t* firstCoefficients,
+                                 const int16_t* secondCoefficients, int32_t* first, int32_t* second);
+
+private:
+    //the number of QMF coefficients
+    static const unsigned int QMF_TAPS = 24;
+
+    //the state of the ADPCM of a sub-band
+    struct Band
+    {
+        //the predicted signal and the output of the pole- and zero-section of the predictor
+        int s;
+        int sp;
+        int sz;
+        //the reconstructed signals, the pole-coefficients and the partially reconstructed signals
+        int r[3];
+        int a[3];
+        int ap[3];
+        int p[3];
+        //the quantized differences and the zero-coefficients
+        int d[7];
+        int b[7];
+        int bp[7];
+        int sg[7];
+        //the logarithmic and the linear quantizer scale-factor
+        int nb;
+        int det;
+    };
+
+    FormatConverter::InstructionSet instructionSet;
+    FilterKernel filterKernel;
+    //the low and high band of the encoder and the decoder
+    Band encoderBands[2];
+    Band decoderBands[2];
+    //the history and the samples of the current call of the transmit- and receive-QMF
+    std::vector<int16_t> encoderSignal;
+    std::vector<int16_t> decoderSignal;
+    std::vector<int32_t> firstOutputs;
+    std::vector<int32_t> secondOutputs;
+
+    static void resetBand(Band& band, const int det);
+    static void updatePredictor(Band& band, const int d);
+};
+
+#endif	/* G722CODEC_H */
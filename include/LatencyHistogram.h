@@ -0,0 +1,78 @@
+#ifndef LATENCYHISTOGRAM_H
+#define	LATENCYHISTOGRAM_H
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+
+/*!
+ * Histogram of durations in nanoseconds with logarithmic buckets (as in HdrHistogram), to determine percentiles of e.g. processing-times.
+ *
+ * Values below 64 ns are counted exactly, above every power of two is split into 32 linear buckets, so the relative error of a
+ * percentile is at most 1/32 (about 3%). Values above 2^40 ns (about 18 minutes) are counted in the last bucket.
+ *
+ * The buckets are allocated in the constructor, so recording a value neither allocates nor locks and can be called from the real-time audio-thread.
+ * A histogram must only be recorded into from a single thread at a time, but can be read from any other thread while recording.
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    /*!
+     * Counts the given duration
+     *
+     * \param nanoseconds The duration in nanoseconds
+     */
+    void record(const uint64_t nanoseconds);
+
+    /*!
+     * \return the number of recorded values
+     */
+    uint64_t getCount() const;
+
+    /*!
+     * \return the sum of all recorded values in nanoseconds
+     */
+    uint64_t getTotal() const;
+
+    /*!
+     * \return the largest recorded value in nanoseconds
+     */
+    uint64_t getMaximum() const;
+
+    /*!
+     * \param percentile The percentile from 0 to 100, e.g. 99.9
+     *
+     * \return the largest value of the bucket containing the given percentile in nanoseconds, at most the maximum, zero if no value was recorded
+     */
+    uint64_t getPercentile(const double percentile) const;
+
+    /*!
+     * Removes all recorded values. Values recorded concurrently may be lost
+     */
+    void reset();
+
+private:
+    //the number of linear sub-buckets per power of two
+    static const unsigned int SUB_BUCKET_BITS = 5;
+    static const unsigned int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    //the largest power of two with its own buckets
+    static const unsigned int MAXIMUM_EXPONENT = 40;
+    static const unsigned int NUMBER_OF_BUCKETS = 2 * SUB_BUCKET_COUNT + (MAXIMUM_EXPONENT - SUB_BUCKET_BITS - 1) * SUB_BUCKET_COUNT;
+
+    //the buckets are only written by the recording thread, so the counters are updated without read-modify-write instructions
+    std::vector<std::atomic<uint64_t>> buckets;
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> maximum;
+
+    static unsigned int getBucketIndex(const uint64_t value);
+
+    /*!
+     * \return the largest value counted in the bucket with the given index
+     */
+    static uint64_t getBucketLimit(const unsigned int index);
+};
+
+#endif	/* LATENCYHISTOGRAM_H */
@@ -0,0 +1,154 @@
+#ifndef LOSSLESSCODEC_H
+#define	LOSSLESSCODEC_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "FormatConverter.h"
+
+/*!
+ * A low-latency lossless audio-codec in the style of FLAC: linear prediction plus Rice coding of the prediction residual.
+ *
+ * Every buffer of audio-frames is encoded into a single, independent frame, so lost packages don't affect the following packages.
+ * Every channel is encoded separately with the predictor requiring the fewest bits:
+ * - the fixed polynomial predictors of order 0 to 4,
+ * - LPC predictors of order 1 to #MAXIMUM_ORDER, calculated with the Levinson-Durbin recursion on the Tukey-windowed autocorrelation,
+ * - a constant value or the verbatim samples, if the prediction does not reduce the size.
+ *
+ * The residuals of the candidates are calculated with the SSE2/AVX2 (x86) and NEON (ARMv8) instructions, depending on the features of the CPU.
+ * The vectorized prediction uses double-precision arithmetic, which is exact for the products of the (up to) 24 bit samples and the 15 bit coefficients,
+ * so the encoded frames are identical to the scalar implementation and the decoder reconstructs the samples bit-exact.
+ *
+ * Frame format (big-endian bit-stream, padded to full bytes):
+ * - 16 bit number of audio-frames
+ * - per channel: 2 bit type (0 = verbatim, 1 = constant, 2 = predicted), 2 bit reserved, 4 bit predictor order
+ *   - verbatim: all samples, constant: a single sample
+ *   - predicted: 4 bit shift, 4 bit coefficient precision - 1, order x coefficients, order x warm-up samples, 5 bit Rice parameter, Rice coded residuals
+ */
+class LosslessCodec
+{
+public:
+    //the maximum order of the LPC predictor, enough for the short blocks of low-latency audio
+    static const unsigned int MAXIMUM_ORDER = 8;
+
+    /*!
+     * \param channels The number of interleaved channels
+     *
+     * \param bitsPerSample The number of significant bits per sample, 16 or 24
+     *
+     * \param instructionSet The instruction-set to use, is reduced to the instruction-set supported by the CPU
+     */
+    LosslessCodec(const unsigned int channels, const unsigned int bitsPerSample,
+                  const FormatConverter::InstructionSet instructionSet = FormatConverter::getSupportedInstructionSet());
+
+    /*!
+     * Encodes a buffer of interleaved samples into a single frame
+     *
+     * \param samples The sign-extended samples of all channels
+     *
+     * \param numberOfFrames The number of audio-frames (samples per channel), at most 65535
+     *
+     * \param encoded The buffer to write the frame into
+     *
+     * \param maximumSize The size of the buffer in bytes, see #getMaximumEncodedSize()
+     *
+     * \return the size of the frame in bytes, 0 if the buffer is too small
+     */
+    unsigned int encode(const int32_t* samples, const unsigned int numberOfFrames, uint8_t* encoded, const unsigned int maximumSize);
+
+    /*!
+     * Decodes a frame into interleaved samples
+     *
+     * \param encoded The encoded frame
+     *
+     * \param encodedSize The size of the frame in bytes
+     *
+     * \param samples The buffer to write the samples of all channels into
+     *
+     * \param maximumFrames The maximum number of audio-frames fitting into the buffer
+     *
+     * \return the number of decoded audio-frames, 0 if the frame is invalid or too large
+     */
+    unsigned int decode(const uint8_t* encoded, const unsigned int encodedSize, int32_t* samples, const unsigned int maximumFrames);
+
+    /*!
+     * \return the maximum size in bytes of an encoded frame with the given number of audio-frames
+     */
+    unsigned int getMaximumEncodedSize(const unsigned int numberOfFrames) const;
+
+    /*!
+     * \return the instruction-set used to calculate the residuals
+     */
+    FormatConverter::InstructionSet getInstructionSet() const;
+
+private:
+    /*!
+     * Calculates the residual of a predictor for the samples [order, numberOfSamples)
+     *
+     * \param signal The samples converted to double
+     *
+     * \param numberOfSamples The number of samples
+     *
+     * \param coefficients The predictor-coefficients, the first coefficient is applied to the previous sample
+     *
+     * \param order The number of coefficients
+     *
+     * \param scale The factor to scale the prediction with, 2^-shift
+     *
+     * \param residual The residual to write, starting with the sample at index order
+     */
+    typedef void (*ResidualKernel)(const double* signal, const unsigned int numberOfSamples, const double* coefficients, const unsigned int order,
+                                   const double scale, int32_t* residual);
+
+    //the maximum precision of the quantized LPC coefficients in bits, including the sign
+    static const unsigned int MAXIMUM_PRECISION = 15;
+
+    //a predictor-candidate for a channel
+    struct Predictor
+    {
+        unsigned int order;
+        unsigned int shift;
+        unsigned int precision;
+        int32_t coefficients[MAXIMUM_ORDER];
+    };
+
+    const unsigned int channels;
+    const unsigned int bitsPerSample;
+    FormatConverter::InstructionSet instructionSet;
+    ResidualKernel residualKernel;
+
+    //the samples of the current channel as integers and doubles
+    std::vector<int32_t> channelSamples;
+    std::vector<double> signal;
+    //the Tukey-window for the current number of frames
+    std::vector<double> window;
+    std::vector<double> windowedSignal;
+    //the residuals of the current and the best candidate
+    std::vector<int32_t> residual;
+    std::vector<int32_t> bestResidual;
+
+    void updateWindow(const unsigned int numberOfFrames);
+
+    /*!
+     * Calculates the LPC predictors of all orders for the current channel
+     *
+     * \return the maximum order calculated
+     */
+    unsigned int calculateLPC(const unsigned int numberOfFrames, double lpc[MAXIMUM_ORDER][MAXIMUM_ORDER]);
+
+    /*!
+     * Calculates the residual for the predictor and its size in bits
+     *
+     * \param riceParameter Is set to the optimal Rice parameter
+     */
+    uint64_t evaluatePredictor(const Predictor& predictor, const unsigned int numberOfFrames, unsigned int& riceParameter);
+
+    static bool quantizeCoefficients(const double* lpc, const unsigned int order, const unsigned int precision, Predictor& predictor);
+
+    /*!
+     * \return the precision of the LPC coefficients for short blocks, which don't benefit from precise coefficients
+     */
+    static unsigned int getCoefficientPrecision(const unsigned int numberOfFrames);
+};
+
+#endif	/* LOSSLESSCODEC_H */
@@ -0,0 +1,185 @@
+#ifndef OGGOPUSWRITER_H
+#define	OGGOPUSWRITER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#include "AudioRingBuffer.h"
+
+/*!
+ * Muxes already encoded Opus-packets into an Ogg/Opus-file (RFC 7845) without blocking the real-time audio-thread.
+ *
+ * The packets are recorded as they are sent or received, so a call can be recorded without decoding and re-encoding
+ * at a fraction of the storage of a WAV-file. As with the WAVWriter, the audio-thread only copies the packets into a lock-free
+ * AudioRingBuffer, a background thread packs them into Ogg-pages and writes them into the file.
+ *
+ * The granule-positions are counted in 48 kHz samples from the durations stored in the packets' TOC-bytes.
+ * Buffers without a packet (silence or lost packets) are recorded as packets with empty frames of the duration of the previous packet,
+ * which the decoder conceals, so the timing of the recording is kept.
+ * More than two channels are recorded as multistream-packets with the Vorbis channel-mapping (see OpusMultistreamEncoder).
+ */
+class OggOpusWriter
+{
+public:
+    /*!
+     * Opens the file, writes the Opus-headers and starts the writing thread
+     *
+     * \param fileName The name of the Ogg-file to create
+     *
+     * \param channels The number of channels of the encoded audio
+     *
+     * \param sampleRate The sample-rate of the audio before encoding in Hz, only informational
+     *
+     * \param preSkip The number of 48 kHz samples the decoder discards at the start (the encoder's look-ahead), see #getPreSkip()
+     *
+     * \param bufferDuration The duration of audio in ms at the maximum bitrate, the ring-buffer can hold until the packets are written
+     */
+    OggOpusWriter(const std::string& fileName, const unsigned int channels, const unsigned int sampleRate, const unsigned int preSkip = 0,
+                  const unsigned int bufferDuration = 2000);
+
+    /*!
+     * Writes the remaining packets and closes the file
+     */
+    ~OggOpusWriter();
+
+    /*!
+     * \return whether the file was opened successfully
+     */
+    bool isOpen() const;
+
+    /*!
+     * Queues an Opus-packet for writing into the file. Does not block, so it can be called from the real-time audio-thread.
+     * Must only be called from a single thread
+     *
+     * \param packet The Opus-packet, as created by opus_encode() or opus_multistream_encode()
+     *
+     * \param size The size of the packet in bytes
+     *
+     * \return whether the packet was queued, false if the file is not open, the packet is too large or the ring-buffer is full
+     */
+    bool write(const void* packet, const unsigned int size);
+
+    /*!
+     * Queues a buffer without an Opus-packet, e.g. a silent or a lost packet, which is recorded with the duration of the previous packet.
+     * Does not block and must only be called from the thread calling #write()
+     *
+     * \return whether the silence was queued
+     */
+    bool writeSilence();
+
+    /*!
+     * Writes all queued packets, the last page and closes the file
+     */
+    void close();
+
+    /*!
+     * \return the number of packets written into the file
+     */
+    uint64_t getWrittenPackets() const;
+
+    /*!
+     * \return the number of packets, which were dropped, because the ring-buffer was full or they were invalid
+     */
+    uint64_t getDroppedPackets() const;
+
+    /*!
+     * \return the granule-position of the last written packet, i.e. the recorded duration in 48 kHz samples
+     */
+    uint64_t getGranulePosition() const;
+
+    /*!
+     * Queries the look-ahead (OPUS_GET_LOOKAHEAD) of an encoder with the given configuration.
+     * The streams of a multistream-encoder have the same look-ahead as a single encoder
+     *
+     * \param sampleRate The sample-rate of the encoder in Hz
+     *
+     * \param channels The number of channels of the encoder
+     *
+     * \param application The Opus application-mode, e.g. OPUS_APPLICATION_VOIP
+     *
+     * \return the pre-skip in 48 kHz samples for packets of such an encoder, zero if no such encoder can be created
+     */
+    static unsigned int getPreSkip(const unsigned int sampleRate, const unsigned int channels, const int application);
+
+private:
+    //the largest packet, which fits into a single Ogg-page
+    static const unsigned int MAXIMUM_PACKET_SIZE = 254 * 255;
+    //the maximum number of lacing-values of an Ogg-page
+    static const unsigned int MAXIMUM_SEGMENTS = 255;
+    //the duration of audio in 48 kHz samples after which a page is completed, so a crash loses at most about one second
+    static const unsigned int PAGE_DURATION = 48000;
+    //the maximum bitrate of an Opus-stream per channel in bytes per second, used to size the ring-buffer
+    static const unsigned int MAXIMUM_BYTES_PER_SECOND = 256000 / 8;
+    //the interval the writing thread checks the ring-buffer for new packets in ms
+    static const unsigned int WRITE_INTERVAL = 20;
+
+    FILE* file;
+    //the number of Opus-streams per packet, more than one for multistream-packets
+    unsigned int streams;
+    const uint32_t serialNumber;
+    uint32_t pageSequenceNumber;
+    AudioRingBuffer ringBuffer;
+    //the packet with its size-prefix, as queued by the audio-thread
+    std::vector<uint8_t> queueBuffer;
+    //the packet read by the writing thread
+    std::vector<uint8_t> packetBuffer;
+    //the lacing-values and the contents of the current page
+    std::vector<uint8_t> pageSegments;
+    std::vector<uint8_t> pageBody;
+    uint64_t pageStartPosition;
+    std::atomic<uint64_t> granulePosition;
+    //the TOC-byte and duration of the previous packet, to record silence with
+    uint8_t previousTOC;
+    unsigned int previousDuration;
+    std::atomic<uint64_t> writtenPackets;
+    std::atomic<uint64_t> droppedPackets;
+    std::atomic<bool> threadRunning;
+    std::thread writeThread;
+
+    /*!
+     * Writes the OpusHead- and the OpusTags-page
+     */
+    bool writeHeaders(const unsigned int channels, const unsigned int sampleRate, const unsigned int preSkip);
+
+    /*!
+     * Writes a single Ogg-page with the given lacing-values and contents
+     *
+     * \param headerType The flags of the page (beginning or end of the stream)
+     *
+     * \param position The granule-position of the last packet completed on this page
+     */
+    bool writePage(const uint8_t headerType, const uint64_t position, const std::vector<uint8_t>& segments, const std::vector<uint8_t>& body);
+
+    /*!
+     * Writes the current page and starts a new one
+     */
+    void flushPage(const uint8_t headerType);
+
+    /*!
+     * Adds a packet to the current page, completing the page first, if it is full
+     */
+    void addPacket(const uint8_t* packet, const unsigned int size, const unsigned int duration);
+
+    /*!
+     * Creates a packet of empty frames with the duration of the previous packet in #packetBuffer
+     *
+     * \return the size of the packet, zero if no packet was recorded yet
+     */
+    unsigned int createSilencePacket();
+
+    /*!
+     * Adds all packets in the ring-buffer to the pages
+     */
+    void writeBufferedPackets();
+
+    /*!
+     * Method called in the parallel thread, writing the buffered packets into the file
+     */
+    void runThread();
+};
+
+#endif	/* OGGOPUSWRITER_H */
@@ -0,0 +1,162 @@
+#ifndef OPUSMULTISTREAMENCODER_H
+#define	OPUSMULTISTREAMENCODER_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "opus.h"
+
+struct OpusEncoderSettings;
+
+/*!
+ * Encodes more than two channels into Opus multistream-packets, which can be decoded by an OpusMSDecoder (opus_multistream_decoder_create).
+ *
+ * The channels are mapped to mono and coupled (stereo) streams with the Vorbis channel-order (mapping family 1, RFC 7845) for up to 8 channels,
+ * e.g. 5.1 surround is encoded into two coupled and two mono streams. More channels are encoded as one mono stream per channel (mapping family 255).
+ *
+ * In contrast to an OpusMSEncoder, every stream has its own encoder, so the streams can be encoded in parallel by worker-threads.
+ * The streams are combined into a single packet with the self-delimiting framing of RFC 6716, Appendix B.
+ */
+class OpusMultistreamEncoder
+{
+public:
+    /*!
+     * \param sampleRate The sample-rate (8000, 12000, 16000, 24000 or 48000)
+     *
+     * \param channels The number of interleaved channels (1 - 255)
+     *
+     * \param application The Opus application-mode, e.g. OPUS_APPLICATION_VOIP
+     *
+     * \param numberOfThreads The number of threads to encode the streams with, including the calling thread.
+     *  0 to encode less than PARALLEL_STREAMS_THRESHOLD streams in the calling thread and more streams with a thread per stream,
+     *  up to the number of CPU-cores. With more than one thread, the calling thread waits for the workers to finish every packet,
+     *  so the encoder should then be run by the processing-thread of the pipelined mode (see AudioInterface::setPipelinedProcessing())
+     *  instead of the audio-callback
+     */
+    /*!
+     * The minimum number of streams to be encoded by worker-threads, if the number of threads is chosen automatically.
+     * For fewer streams, the overhead of waking up the workers and the blocking of the calling thread outweigh the gain
+     */
+    static const unsigned int PARALLEL_STREAMS_THRESHOLD = 8;
+
+    OpusMultistreamEncoder(const unsigned int sampleRate, const unsigned int channels, const int application, const unsigned int numberOfThreads = 0);
+
+    ~OpusMultistreamEncoder();
+
+    /*!
+     * \return OPUS_OK, if all encoders were created successfully, the Opus error-code otherwise
+     */
+    int getErrorCode() const;
+
+    unsigned int getNumberOfStreams() const;
+
+    unsigned int getNumberOfCoupledStreams() const;
+
+    /*!
+     * \return the mapping of the channels to the decoded streams, as required by opus_multistream_decoder_create
+     */
+    const unsigned char* getMapping() const;
+
+    /*!
+     * \return the number of threads encoding the streams, including the calling thread
+     */
+    unsigned int getNumberOfThreads() const;
+
+    /*!
+     * Applies the settings to the encoders of all streams.
+     *
+     * The bitrate is distributed to the streams proportional to their number of channels
+     *
+     * \return whether all settings were accepted
+     */
+    bool applySettings(const OpusEncoderSettings& settings, const unsigned int frameSize);
+
+    /*!
+     * Encodes one frame of interleaved 16 bit samples
+     *
+     * \param pcm The samples of all channels
+     *
+     * \param frameSize The number of frames per channel
+     *
+     * \param data The buffer to write the multistream-packet into
+     *
+     * \param maximumSize The size of the buffer in bytes
+     *
+     * \return the size of the packet in bytes or an Opus error-code (negative)
+     */
+    int encode(const opus_int16* pcm, const unsigned int frameSize, unsigned char* data, const unsigned int maximumSize);
+
+    /*!
+     * Encodes one frame of interleaved 32 bit float samples
+     */
+    int encode(const float* pcm, const unsigned int frameSize, unsigned char* data, const unsigned int maximumSize);
+
+    /*!
+     * Determines the standard channel-mapping for the given number of channels
+     *
+     * \param channels The number of channels
+     *
+     * \param streams Is set to the total number of streams
+     *
+     * \param coupledStreams Is set to the number of coupled (stereo) streams
+     *
+     * \param mapping Is set to the mapping of every channel to the decoded streams
+     */
+    static void getChannelMapping(const unsigned int channels, unsigned int& streams, unsigned int& coupledStreams, std::vector<unsigned char>& mapping);
+
+    /*!
+     * Converts an Opus-packet into the self-delimiting framing, which additionally stores the size of the last frame.
+     *
+     * \return the size of the converted packet or OPUS_BUFFER_TOO_SMALL/OPUS_INVALID_PACKET
+     */
+    static int toSelfDelimited(const unsigned char* packet, const int packetSize, unsigned char* target, const unsigned int maximumSize);
+
+private:
+    //the maximum size of the packet of a single stream (three frames of 1275 bytes for 60 ms plus framing)
+    static const unsigned int MAXIMUM_STREAM_PACKET_SIZE = 3 * 1275 + 7;
+    //the maximum number of frames per channel (60 ms at 48 kHz)
+    static const unsigned int MAXIMUM_FRAME_SIZE = 2880;
+
+    struct Stream
+    {
+        OpusEncoder* encoder;
+        //the input channels encoded by this stream
+        unsigned int firstChannel;
+        unsigned int secondChannel;
+        unsigned int numberOfChannels;
+        //the deinterleaved samples of this stream
+        std::vector<opus_int16> intSamples;
+        std::vector<float> floatSamples;
+        std::vector<unsigned char> packet;
+        //the size of the encoded packet or the error-code
+        int packetSize;
+    };
+
+    const unsigned int sampleRate;
+    const unsigned int channels;
+    std::vector<Stream> streams;
+    unsigned int coupledStreams;
+    std::vector<unsigned char> mapping;
+    int errorCode;
+
+    //the parameters of the current job, the streams are distributed round-robin to the threads
+    const opus_int16* intInput;
+    const float* floatInput;
+    unsigned int frameSize;
+    std::vector<std::thread> workers;
+    std::mutex jobMutex;
+    std::condition_variable jobStarted;
+    std::condition_variable jobFinished;
+    //incremented for every job, so the workers can detect a new job
+    unsigned long jobNumber;
+    unsigned int pendingWorkers;
+    bool running;
+
+    void runWorker(const unsigned int threadIndex);
+    void encodeStreams(const unsigned int threadIndex);
+    int encodeAll(unsigned char* data, const unsigned int maximumSize);
+};
+
+#endif	/* OPUSMULTISTREAMENCODER_H */
@@ -0,0 +1,258 @@
+#ifndef PARITYFEC_H
+#define	PARITYFEC_H
+
+#include <vector>
+
+#include "RTPPackageHandler.h"
+
+/*!
+ * Size of the FEC-header in bytes, preceding the parity-data in the payload of a FEC-package
+ */
+static const unsigned int FEC_HEADER_SIZE = 12;
+
+/*!
+ * The payload of a FEC-package starts with a FEC-header, loosely modeled after RFC 5109 and FlexFEC
+ * (draft-ietf-payload-flexible-fec-scheme), but protecting a fixed group of consecutive packages:
+ *
+ *  0                   1                   2                   3
+ *  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |            SN base            |  group size   |  PT recovery  |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |        length recovery        |           reserved            |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |                          TS recovery                          |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |                 parity of the protected payloads              |
+ * |                             ....                              |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *
+ * SN base: 16 bits
+ *  The sequence number of the first media-package protected by this FEC-package
+ *
+ * group size: 8 bits
+ *  The number of consecutive media-packages (starting with SN base) protected by this FEC-package
+ *
+ * PT recovery: 8 bits
+ *  The XOR of the marker-bit and payload-type of all protected RTP-headers
+ *
+ * length recovery: 16 bits
+ *  The XOR of the payload-sizes of all protected media-packages
+ *
+ * TS recovery: 32 bits
+ *  The XOR of the timestamps of all protected RTP-headers
+ *
+ * The parity-data is the XOR of all protected payloads, each padded with zeroes to the size of the largest payload.
+ */
+struct FECHeader
+{
+private:
+    uint8_t data[FEC_HEADER_SIZE];
+
+public:
+
+    FECHeader() : data{0}
+    {
+    }
+
+    inline uint16_t getBaseSequenceNumber() const
+    {
+        return (data[0] << 8) | data[1];
+    }
+
+    inline void setBaseSequenceNumber(const uint16_t sequenceNumber)
+    {
+        data[0] = (uint8_t) (sequenceNumber >> 8);
+        data[1] = (uint8_t) (sequenceNumber & 0xFF);
+    }
+
+    inline uint8_t getGroupSize() const
+    {
+        return data[2];
+    }
+
+    inline void setGroupSize(const uint8_t groupSize)
+    {
+        data[2] = groupSize;
+    }
+
+    inline uint8_t getPayloadTypeRecovery() const
+    {
+        return data[3];
+    }
+
+    inline void setPayloadTypeRecovery(const uint8_t payloadTypeRecovery)
+    {
+        data[3] = payloadTypeRecovery;
+    }
+
+    inline uint16_t getLengthRecovery() const
+    {
+        return (data[4] << 8) | data[5];
+    }
+
+    inline void setLengthRecovery(const uint16_t lengthRecovery)
+    {
+        data[4] = (uint8_t) (lengthRecovery >> 8);
+        data[5] = (uint8_t) (lengthRecovery & 0xFF);
+    }
+
+    inline uint32_t getTimestampRecovery() const
+    {
+        return ((uint32_t)data[8] << 24) | (data[9] << 16) | (data[10] << 8) | data[11];
+    }
+
+    inline void setTimestampRecovery(const uint32_t timestampRecovery)
+    {
+        data[8] = (uint8_t) (timestampRecovery >> 24);
+        data[9] = (uint8_t) (timestampRecovery >> 16);
+        data[10] = (uint8_t) (timestampRecovery >> 8);
+        data[11] = (uint8_t) (timestampRecovery & 0xFF);
+    }
+
+    /*!
+     * \return whether the media-package with the given sequence number is protected by this FEC-package
+     */
+    inline bool isProtected(const uint16_t sequenceNumber) const
+    {
+        return (uint16_t)(sequenceNumber - getBaseSequenceNumber()) < getGroupSize();
+    }
+};
+
+/*!
+ * Generates XOR-based parity FEC-packages for groups of consecutive RTP-packages.
+ *
+ * For every group of K media-packages a single FEC-package is created, which allows the receiver to recover
+ * any single lost package of the group with an overhead of roughly 1/K of the bandwidth.
+ */
+class ParityFEC
+{
+public:
+    /*!
+     * \param groupSize The number K of media-packages protected by a single FEC-package
+     *
+     * \param maximumPayloadSize The maximum size in bytes of the payload of a single media-package
+     */
+    ParityFEC(const uint8_t groupSize, const unsigned int maximumPayloadSize);
+    ~ParityFEC();
+
+    /*!
+     * Adds the given media-package to the parity of the current group
+     *
+     * \param header The RTPHeader of the media-package
+     *
+     * \param payload The payload of the media-package
+     *
+     * \param payloadSize The size of the payload in bytes
+     *
+     * \return whether the group is complete and the FEC-payload can be retrieved via #getFECPayload()
+     */
+    bool addPackage(const RTPHeader* header, const void* payload, const unsigned int payloadSize);
+
+    /*!
+     * \return the payload (FEC-header and parity-data) of the FEC-package for the last completed group
+     */
+    const void* getFECPayload() const;
+
+    /*!
+     * \return the size in bytes of the FEC-payload for the last completed group
+     */
+    unsigned int getFECPayloadSize() const;
+
+    /*!
+     * \return the number of media-packages protected by a single FEC-package
+     */
+    uint8_t getGroupSize() const;
+
+    /*!
+     * Calculates destination = destination XOR source for the given number of bytes.
+     *
+     * Uses SSE2 or NEON instructions, if available
+     */
+    static void xorBuffers(void* destination, const void* source, const unsigned int size);
+
+private:
+    const uint8_t groupSize;
+    const unsigned int maximumPayloadSize;
+    //buffer holding the FEC-header and the parity-data
+    char* fecBuffer;
+    unsigned int parityDataSize;
+    uint8_t numberOfPackages;
+};
+
+/*!
+ * Recovers lost media-packages from FEC-packages independent of the RTPBuffer.
+ *
+ * This is required for aggregated packages (see FrameAggregator), which are split into several buffer-entries with their own
+ * frame-numbers, so the RTPBuffer can't recover the package-level sequence numbers protected by the FEC-packages.
+ * Keeps a copy of the recently received media-packages, a lost package is recovered, when the FEC-package of its group arrives
+ * and all other packages of the group were received.
+ */
+class ParityFECRecovery
+{
+public:
+    /*!
+     * \param maximumPayloadSize The maximum size in bytes of the payload of a single media-package
+     */
+    ParityFECRecovery(const unsigned int maximumPayloadSize);
+
+    /*!
+     * Stores a copy of the received media-package
+     *
+     * \param header The RTPHeader of the media-package
+     *
+     * \param payload The payload of the media-package
+     *
+     * \param payloadSize The size of the payload in bytes
+     *
+     * \return whether the package is new, false if a package with the same sequence number was already received or recovered
+     */
+    bool addPackage(const RTPHeader* header, const void* payload, const unsigned int payloadSize);
+
+    /*!
+     * Tries to recover a lost media-package of the group protected by the given FEC-package
+     *
+     * \param fecPayload The payload (FEC-header and parity-data) of the FEC-package
+     *
+     * \param fecPayloadSize The size of the FEC-payload in bytes
+     *
+     * \return whether exactly one package of the group was lost and has been recovered,
+     * it can be retrieved via #getRecoveredHeader() and #getRecoveredPayload()
+     */
+    bool recoverPackage(const void* fecPayload, const unsigned int fecPayloadSize);
+
+    /*!
+     * \return the RTPHeader of the last recovered package
+     */
+    const RTPHeader& getRecoveredHeader() const;
+
+    /*!
+     * \return the payload of the last recovered package
+     */
+    const void* getRecoveredPayload() const;
+
+    /*!
+     * \return the size in bytes of the payload of the last recovered package
+     */
+    unsigned int getRecoveredPayloadSize() const;
+
+private:
+    //enough packages for the largest possible group, a divisor of 2^16 to keep the slots across sequence number wrap-arounds
+    static const unsigned int HISTORY_SIZE = 256;
+
+    struct StoredPackage
+    {
+        bool isValid;
+        RTPHeader header;
+        std::vector<char> payload;
+    };
+
+    const unsigned int maximumPayloadSize;
+    //the stored packages, indexed by their sequence number modulo HISTORY_SIZE
+    std::vector<StoredPackage> history;
+    unsigned int recoveredIndex;
+
+    bool isStored(const uint16_t sequenceNumber) const;
+};
+
+#endif	/* PARITYFEC_H */
@@ -0,0 +1,202 @@
+#ifndef PROCESSORCHAIN_H
+#define	PROCESSORCHAIN_H
+
+#include <array>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "AudioProcessor.h"
+
+/*!
+ * A fixed chain of AudioProcessors, which is executed by the AudioInterface as a whole
+ * instead of calling every processor of the dynamic process chain separately.
+ *
+ * See StaticProcessorChain
+ */
+class ProcessorChain
+{
+public:
+    virtual ~ProcessorChain()
+    { }
+
+    /*!
+     * Configures all processors of the chain
+     *
+     * \return whether all processors were configured successfully
+     */
+    virtual bool configure(const AudioConfiguration& audioConfig) = 0;
+
+    /*!
+     * Cleans up all processors of the chain
+     */
+    virtual bool cleanUp() = 0;
+
+    /*!
+     * \return the maximum size in bytes of the data between any two processors on input, see AudioProcessor#getMaximumInputSize()
+     */
+    virtual unsigned int getMaximumInputSize(const AudioConfiguration& audioConfig, const unsigned int inputBufferByteSize) const = 0;
+
+    /*!
+     * \return the maximum size in bytes of the data between any two processors on output, see AudioProcessor#getMaximumOutputSize()
+     */
+    virtual unsigned int getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const = 0;
+
+    /*!
+     * Runs the input-data through all processors, in the order of the chain
+     *
+     * \return the number of valid bytes in the buffer after the last processor
+     */
+    virtual unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData) = 0;
+
+    /*!
+     * Runs the output-data through all processors, in reverse order of the chain
+     *
+     * \return the number of valid bytes in the buffer after the first processor
+     */
+    virtual unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData) = 0;
+
+    /*!
+     * \return the names of all processors, in the order of the chain
+     */
+    virtual const std::vector<std::string> getProcessorNames() const = 0;
+};
+
+/*!
+ * A ProcessorChain composed at compile-time from the given AudioProcessor-types, e.g.
+ *
+ *  StaticProcessorChain<ProcessorOpus, ProcessorRTP>(new ProcessorOpus(...), new ProcessorRTP(...))
+ *
+ * The processors are called with their concrete types, so there is no virtual dispatch per processor and buffer
+ * and the compiler can inline the processing-methods. Only the call into the chain itself is virtual.
+ *
+ * All processors must work in-place (see AudioProcessor#isProcessingInPlace()).
+ * Chains of processors selected at runtime use the dynamic process chain of the AudioInterface.
+ */
+template<typename... Processors>
+class StaticProcessorChain final : public ProcessorChain
+{
+public:
+    /*!
+     * \param chainProcessors The processors in the order of the input-chain, the chain takes ownership of them
+     */
+    StaticProcessorChain(Processors*... chainProcessors) : processors(std::unique_ptr<Processors>(chainProcessors)...),
+        processorList{{chainProcessors...}}
+    { }
+
+    bool configure(const AudioConfiguration& audioConfig)
+    {
+        for(AudioProcessor* processor : processorList)
+        {
+            if(!processor->isProcessingInPlace())
+            {
+                std::cerr << "Audio-processor '" << processor->getName() << "' can't be used in a static chain, since it does not work in-place!" << std::endl;
+                return false;
+            }
+            if(!processor->configure(audioConfig))
+            {
+                std::cerr << "Initializing of audio-processor '" << processor->getName() << "' failed." << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool cleanUp()
+    {
+        bool result = true;
+        for(AudioProcessor* processor : processorList)
+        {
+            result = processor->cleanUp() && result;
+        }
+        return result;
+    }
+
+    unsigned int getMaximumInputSize(const AudioConfiguration& audioConfig, const unsigned int inputBufferByteSize) const
+    {
+        unsigned int bufferSize = inputBufferByteSize;
+        unsigned int maximumSize = bufferSize;
+        for(const AudioProcessor* processor : processorList)
+        {
+            bufferSize = processor->getMaximumInputSize(audioConfig, bufferSize);
+            maximumSize = bufferSize > maximumSize ? bufferSize : maximumSize;
+        }
+        return maximumSize;
+    }
+
+    unsigned int getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const
+    {
+        unsigned int bufferSize = outputBufferByteSize;
+        unsigned int maximumSize = bufferSize;
+        for(auto it = processorList.rbegin(); it != processorList.rend(); ++it)
+        {
+            bufferSize = (*it)->getMaximumOutputSize(audioConfig, bufferSize);
+            maximumSize = bufferSize > maximumSize ? bufferSize : maximumSize;
+        }
+        return maximumSize;
+    }
+
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData)
+    {
+        return processInput<0>(inputBuffer, inputBufferByteSize, userData);
+    }
+
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData)
+    {
+        return processOutput<sizeof...(Processors)>(outputBuffer, outputBufferByteSize, userData);
+    }
+
+    const std::vector<std::string> getProcessorNames() const
+    {
+        std::vector<std::string> names;
+        for(const AudioProcessor* processor : processorList)
+        {
+            names.push_back(processor->getName());
+        }
+        return names;
+    }
+
+private:
+    std::tuple<std::unique_ptr<Processors>...> processors;
+    //the processors as base-type for the methods not called per buffer
+    const std::array<AudioProcessor*, sizeof...(Processors)> processorList;
+
+    template<std::size_t Index>
+    inline typename std::enable_if<(Index < sizeof...(Processors)), unsigned int>::type
+    processInput(void *buffer, const unsigned int bufferSize, StreamData *userData)
+    {
+        typedef typename std::tuple_element<Index, std::tuple<Processors...>>::type Processor;
+        //the qualified call is not dispatched virtually
+        const unsigned int newSize = std::get<Index>(processors)->Processor::processInputData(buffer, bufferSize, userData);
+        return processInput<Index + 1>(buffer, newSize, userData);
+    }
+
+    template<std::size_t Index>
+    inline typename std::enable_if<(Index == sizeof...(Processors)), unsigned int>::type
+    processInput(void *buffer, const unsigned int bufferSize, StreamData *userData)
+    {
+        return bufferSize;
+    }
+
+    //Index is the number of processors remaining, the processor at Index - 1 is called next
+    template<std::size_t Index>
+    inline typename std::enable_if<(Index > 0), unsigned int>::type
+    processOutput(void *buffer, const unsigned int bufferSize, StreamData *userData)
+    {
+        typedef typename std::tuple_element<Index - 1, std::tuple<Processors...>>::type Processor;
+        const unsigned int newSize = std::get<Index - 1>(processors)->Processor::processOutputData(buffer, bufferSize, userData);
+        return processOutput<Index - 1>(buffer, newSize, userData);
+    }
+
+    template<std::size_t Index>
+    inline typename std::enable_if<(Index == 0), unsigned int>::type
+    processOutput(void *buffer, const unsigned int bufferSize, StreamData *userData)
+    {
+        return bufferSize;
+    }
+};
+
+#endif	/* PROCESSORCHAIN_H */
@@ -0,0 +1,61 @@
+#ifndef PROCESSORCOMFORTNOISE_H
+#define	PROCESSORCOMFORTNOISE_H
+
+#include "AudioProcessor.h"
+#include "ComfortNoise.h"
+#include "Parameters.h"
+
+/*!
+ * AudioProcessor for discontinuous transmission (DTX) with comfort-noise as specified in RFC 3389.
+ *
+ * On input, every buffer quieter than the silence-threshold (after a short hangover) is marked as StreamData#isSilentPackage
+ * and replaced by the comfort-noise payload. Codecs skip silent buffers and ProcessorRTP only sends a CN-package
+ * at the start of the silence and periodically afterwards.
+ *
+ * On output, comfort-noise of the received level is synthesized for every silent buffer.
+ *
+ * This processor needs to be added before any codec, so it is the first processor on input and the last one on output.
+ */
+class ProcessorComfortNoise : public AudioProcessor
+{
+public:
+    ProcessorComfortNoise(const std::string name);
+
+    bool configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode);
+
+    /*!
+     * Supports 16 bit signed integer and 32 bit float PCM samples
+     */
+    unsigned int getSupportedAudioFormats() const;
+    unsigned int getSupportedSampleRates() const;
+    const std::vector<int> getSupportedBufferSizes(unsigned int sampleRate) const;
+
+    /*!
+     * Determines whether the input-buffer is silent and replaces silent buffers with the comfort-noise payload
+     */
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData);
+
+    /*!
+     * Synthesizes comfort-noise for silent output-buffers
+     */
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData);
+
+private:
+    //the noise-level in -dBov, at or below which (i.e. values greater or equal) audio is considered silence
+    static const unsigned int DEFAULT_SILENCE_THRESHOLD = 50;
+    //the lowest noise-level representable in the comfort-noise payload
+    static const unsigned int MAXIMUM_SILENCE_THRESHOLD = 127;
+    //the duration of silence before sending is suppressed, so the end of words is not cut off
+    static const unsigned int HANGOVER_MILLISECONDS = 200;
+    static const Parameter* SILENCE_THRESHOLD;
+
+    ComfortNoise comfortNoise;
+    bool isFloatFormat;
+    unsigned int inputChannels;
+    unsigned int outputChannels;
+    unsigned int silenceThreshold;
+    unsigned int hangoverFrames;
+    unsigned int silentFrames;
+};
+
+#endif	/* PROCESSORCOMFORTNOISE_H */
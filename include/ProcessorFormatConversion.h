@@ -0,0 +1,82 @@
+#ifndef PROCESSORFORMATCONVERSION_H
+#define	PROCESSORFORMATCONVERSION_H
+
+#include <vector>
+
+#include "AudioProcessor.h"
+#include "FormatConverter.h"
+
+/*!
+ * AudioProcessor converting between the sample-format of the audio-device and the format required by the following processors,
+ * e.g. to feed a codec working with 32 bit float samples from a device recording 16 or 24 bit integer samples.
+ *
+ * On input, the samples are converted from the device-format into the processing-format, on output vice versa.
+ * The conversion is vectorized, see FormatConverter.
+ *
+ * This processor needs to be added before the processors requiring the converted format,
+ * so it is the first processor on input and the last one on output.
+ */
+class ProcessorFormatConversion : public AudioProcessor
+{
+public:
+    /*!
+     * \param name The name of this processor
+     *
+     * \param processingFormat The sample-format passed to the following processors
+     */
+    ProcessorFormatConversion(const std::string name, const AudioFormat processingFormat = AudioFormat::FLOAT_32);
+
+    bool configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode);
+
+    bool cleanUp();
+
+    /*!
+     * Supports all formats which can be converted into the processing-format
+     */
+    unsigned int getSupportedAudioFormats() const;
+    unsigned int getSupportedSampleRates() const;
+    const std::vector<int> getSupportedBufferSizes(unsigned int sampleRate) const;
+
+    unsigned int getMaximumInputSize(const AudioConfiguration& audioConfig, const unsigned int inputBufferByteSize) const;
+    unsigned int getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const;
+
+    /*!
+     * The conversion between formats of different sizes can't be done in-place
+     */
+    bool isProcessingInPlace() const;
+
+    /*!
+     * Converts the input-buffer from the device-format into the processing-format
+     */
+    unsigned int processInputDataOutOfPlace(const void *sourceBuffer, const unsigned int inputBufferByteSize, void *targetBuffer, StreamData *userData);
+
+    /*!
+     * Converts the output-buffer from the processing-format into the device-format
+     */
+    unsigned int processOutputDataOutOfPlace(const void *sourceBuffer, const unsigned int outputBufferByteSize, void *targetBuffer, StreamData *userData);
+
+    /*!
+     * Converts via an intermediate buffer, the input-buffer must hold #getMaximumInputSize() bytes
+     */
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData);
+
+    /*!
+     * Converts via an intermediate buffer, the output-buffer must hold #getMaximumOutputSize() bytes
+     */
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData);
+
+private:
+    const AudioFormat processingFormat;
+    AudioFormat deviceFormat;
+    FormatConverter inputConverter;
+    FormatConverter outputConverter;
+    //the buffer for the in-place conversion, allocated on configuration
+    std::vector<char> conversionBuffer;
+
+    /*!
+     * \return the number of bytes required for the given number of bytes in the source-format, rounded up to whole samples
+     */
+    static unsigned int getConvertedSize(const unsigned int byteSize, const AudioFormat sourceFormat, const AudioFormat targetFormat);
+};
+
+#endif	/* PROCESSORFORMATCONVERSION_H */
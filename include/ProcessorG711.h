@@ -0,0 +1,65 @@
+#ifndef PROCESSORG711_H
+#define	PROCESSORG711_H
+
+#include <iostream>
+#include <memory>
+
+#include "AudioProcessor.h"
+#include "RTPManager.h"
+#include "G711.h"
+
+/*!
+ * AudioProcessor encoding the audio-input with the G.711 codec and decoding the audio-output, see G711.
+ *
+ * G.711 is defined for 8 kHz, so a ProcessorResampler needs to be added before this processor for other sample-rates.
+ * Every sample is compressed into a single byte, resulting in 64 kbit/s per channel.
+ * The encoded packages need to be sent with the payload-type returned by #getSupportedPlayloadType().
+ */
+class ProcessorG711 : public AudioProcessor
+{
+public:
+    /*!
+     * \param name The name of this processor
+     *
+     * \param law The companding-law to use, μ-law (PCMU) or A-law (PCMA)
+     */
+    ProcessorG711(const std::string name, const G711::Law law);
+
+    bool configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode);
+
+    /*!
+     * G.711 only supports 16 bit signed integer PCM samples
+     */
+    unsigned int getSupportedAudioFormats() const;
+    unsigned int getSupportedSampleRates() const;
+    const std::vector<int> getSupportedBufferSizes(unsigned int sampleRate) const;
+
+    /*!
+     * \return the RTP payload-type of the configured law, PCMU or PCMA
+     */
+    PayloadType getSupportedPlayloadType() const;
+
+    /*!
+     * The decoded output is twice the size of the encoded package
+     */
+    unsigned int getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const;
+
+    /*!
+     * Encodes the 16 bit samples in-place, halving the size of the buffer
+     */
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData);
+
+    /*!
+     * Decodes the package in-place, doubling the size of the buffer
+     */
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData);
+
+private:
+    //the only sample-rate defined by RFC 3551 for PCMU and PCMA
+    static const unsigned int SAMPLE_RATE = 8000;
+
+    const G711 codec;
+    unsigned int outputChannels;
+};
+
+#endif	/* PROCESSORG711_H */
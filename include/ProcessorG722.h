@@ -0,0 +1,70 @@
+#ifndef PROCESSORG722_H
+#define	PROCESSORG722_H
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "AudioProcessor.h"
+#include "RTPManager.h"
+#include "G722Codec.h"
+
+/*!
+ * AudioProcessor encoding the audio-input with the G.722 wideband codec at 64 kbit/s and decoding the audio-output, see G722Codec.
+ *
+ * G.722 is defined for 16 kHz, so a ProcessorResampler needs to be added before this processor for other sample-rates.
+ * Every channel is encoded separately, the bytes of the channels are interleaved (RFC 3551, section 4.1).
+ * The encoded packages need to be sent with the payload-type returned by #getSupportedPlayloadType()
+ * and timestamped with the clock-rate returned by #getRTPClockRate().
+ */
+class ProcessorG722 : public AudioProcessor
+{
+public:
+    ProcessorG722(const std::string name);
+
+    bool configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode);
+
+    /*!
+     * G.722 only supports 16 bit signed integer PCM samples
+     */
+    unsigned int getSupportedAudioFormats() const;
+    unsigned int getSupportedSampleRates() const;
+
+    /*!
+     * Any even buffer-size is supported, since pairs of samples are encoded into a single byte
+     */
+    const std::vector<int> getSupportedBufferSizes(unsigned int sampleRate) const;
+
+    PayloadType getSupportedPlayloadType() const;
+
+    /*!
+     * \return the RTP clock-rate of G.722, which is 8000 Hz for the audio sampled at 16 kHz (RFC 3551, section 4.5.2)
+     */
+    unsigned int getRTPClockRate() const;
+
+    /*!
+     * Every encoded byte is decoded into two 16 bit samples
+     */
+    unsigned int getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const;
+
+    /*!
+     * Encodes the 16 bit samples in-place into a quarter of the size of the buffer
+     */
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData);
+
+    /*!
+     * Decodes the package in-place into four times the size of the package
+     */
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData);
+
+private:
+    //a codec per channel
+    std::vector<G722Codec> codecs;
+    unsigned int inputChannels;
+    unsigned int outputChannels;
+    //the deinterleaved samples and bytes of all channels
+    std::vector<int16_t> channelSamples;
+    std::vector<uint8_t> channelBytes;
+};
+
+#endif	/* PROCESSORG722_H */
@@ -0,0 +1,84 @@
+#ifndef PROCESSORL16_H
+#define	PROCESSORL16_H
+
+#include <stdint.h>
+#include <iostream>
+#include <memory>
+
+#include "AudioProcessor.h"
+#include "RTPManager.h"
+#include "FormatConverter.h"
+
+/*!
+ * AudioProcessor converting uncompressed 16 bit samples between the host byte-order and the network byte-order (big-endian)
+ * required for the L16 payload (RFC 3551, section 4.5.11), so raw PCM can be exchanged with other RTP endpoints.
+ *
+ * The static payload-types L16_1 and L16_2 are defined for mono and stereo audio at 44.1 kHz.
+ * On little-endian hosts, the bytes are swapped in-place with SSE2/AVX2 (x86) or NEON (ARMv8) instructions, depending on the features of the CPU,
+ * on big-endian hosts the samples are already in network byte-order.
+ *
+ * This processor needs to be the last processor before the ProcessorRTP, replacing any codec.
+ */
+class ProcessorL16 : public AudioProcessor
+{
+public:
+    /*!
+     * \param name The name of this processor
+     *
+     * \param instructionSet The instruction-set to use, is reduced to the instruction-set supported by the CPU
+     */
+    ProcessorL16(const std::string name, const FormatConverter::InstructionSet instructionSet = FormatConverter::getSupportedInstructionSet());
+
+    bool configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode);
+
+    /*!
+     * L16 only supports 16 bit signed integer PCM samples
+     */
+    unsigned int getSupportedAudioFormats() const;
+
+    /*!
+     * The static L16 payload-types are only defined for 44.1 kHz
+     */
+    unsigned int getSupportedSampleRates() const;
+    const std::vector<int> getSupportedBufferSizes(unsigned int sampleRate) const;
+
+    /*!
+     * \return L16_1 for mono and L16_2 for stereo input
+     */
+    PayloadType getSupportedPlayloadType() const;
+
+    /*!
+     * Converts the samples from host to network byte-order
+     */
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData);
+
+    /*!
+     * Converts the samples from network to host byte-order
+     */
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData);
+
+    /*!
+     * Swaps the two bytes of every sample in-place
+     *
+     * \param samples The samples to swap
+     *
+     * \param numberOfSamples The number of samples (of all channels)
+     *
+     * \param instructionSet The instruction-set to use, is reduced to the instruction-set supported by the CPU
+     */
+    static void swapByteOrder(uint16_t* samples, const unsigned int numberOfSamples, const FormatConverter::InstructionSet instructionSet);
+
+private:
+    typedef void (*Kernel)(uint16_t* samples, const unsigned int numberOfSamples);
+
+    //the sample-rate of the static L16 payload-types
+    static const unsigned int SAMPLE_RATE = 44100;
+
+    Kernel kernel;
+    unsigned int inputChannels;
+    unsigned int outputChannels;
+
+    static Kernel selectKernel(const FormatConverter::InstructionSet instructionSet);
+};
+
+#endif	/* PROCESSORL16_H */
@@ -0,0 +1,68 @@
+#ifndef PROCESSORLOSSLESS_H
+#define	PROCESSORLOSSLESS_H
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "AudioProcessor.h"
+#include "RTPManager.h"
+#include "LosslessCodec.h"
+
+/*!
+ * AudioProcessor compressing the audio-input losslessly with linear prediction and Rice coding and decoding the audio-output, see LosslessCodec.
+ *
+ * Intended for high-fidelity links with enough bandwidth (e.g. in a LAN), where the audio must not be altered by a lossy codec,
+ * but uncompressed multichannel audio would take too much bandwidth. Typical music is reduced to about half of the size of the PCM samples.
+ *
+ * Every package is encoded independently, so lost packages don't affect the decoding of the following packages.
+ * The encoded packages need to be sent with the (dynamic) payload-type returned by #getSupportedPlayloadType()
+ */
+class ProcessorLossless : public AudioProcessor
+{
+public:
+    ProcessorLossless(const std::string name);
+
+    bool configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode);
+
+    /*!
+     * The codec supports 16 bit and packed 24 bit signed integer samples, which is validated in #configure()
+     */
+    unsigned int getSupportedAudioFormats() const;
+    unsigned int getSupportedSampleRates() const;
+    const std::vector<int> getSupportedBufferSizes(unsigned int sampleRate) const;
+
+    PayloadType getSupportedPlayloadType() const;
+
+    /*!
+     * The encoded package of an unpredictable signal (e.g. white noise) is a few bytes larger than the samples
+     */
+    unsigned int getMaximumInputSize(const AudioConfiguration& audioConfig, const unsigned int inputBufferByteSize) const;
+
+    /*!
+     * A package is decoded into at most a full buffer of samples
+     */
+    unsigned int getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const;
+
+    /*!
+     * Encodes the samples in-place into a single lossless frame
+     */
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData);
+
+    /*!
+     * Decodes the lossless frame in-place into the original samples
+     */
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData);
+
+private:
+    std::unique_ptr<LosslessCodec> encoder;
+    std::unique_ptr<LosslessCodec> decoder;
+    unsigned int inputChannels;
+    unsigned int outputChannels;
+    //the size of a sample in bytes, 2 or 3
+    unsigned int sampleSize;
+    //the sign-extended samples of all channels
+    std::vector<int32_t> samples;
+};
+
+#endif	/* PROCESSORLOSSLESS_H */
@@ -0,0 +1,74 @@
+#ifndef PROCESSOROGGOPUS_H
+#define	PROCESSOROGGOPUS_H
+
+#include <memory>
+
+#include "AudioProcessor.h"
+#include "RTPManager.h"
+#include "OggOpusWriter.h"
+#include "Parameters.h"
+#include "opus.h"
+
+/*!
+ * AudioProcessor recording the encoded Opus-packets of the communication into Ogg/Opus-files, see OggOpusWriter.
+ *
+ * This processor needs to be placed between the ProcessorOpus and the ProcessorRTP, so it records the outgoing packets
+ * after encoding and the incoming packets from the jitter-buffer before decoding. Unlike the ProcessorWAV, nothing is decoded or re-encoded,
+ * so a recording costs almost no CPU and a fraction of the storage.
+ *
+ * Both directions can be recorded separately, with the destination files specified by user-input.
+ * The pre-skip of the input-recording is the look-ahead of the local encoder, the encoder of the remote side is unknown,
+ * so no samples are skipped for the output-recording
+ */
+class ProcessorOggOpus : public AudioProcessor
+{
+public:
+    /*!
+     * \param opusApplication The application-mode of the local Opus-encoder, its look-ahead is recorded as pre-skip
+     */
+    ProcessorOggOpus(const std::string name, const int opusApplication = OPUS_APPLICATION_VOIP);
+
+    bool configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode);
+
+    /*!
+     * The packets are recorded as they are, independent of the format of the encoded samples
+     */
+    unsigned int getSupportedAudioFormats() const;
+
+    /*!
+     * This recorder supports all/any buffer-size
+     */
+    const std::vector<int> getSupportedBufferSizes(unsigned int sampleRate) const;
+
+    /*!
+     * All sample-rates are supported
+     */
+    unsigned int getSupportedSampleRates() const;
+
+    PayloadType getSupportedPlayloadType() const;
+
+    /*!
+     * If input-recording is active, queues the encoded packet for writing to the input-recording file
+     */
+    unsigned int processInputData(void* inputBuffer, const unsigned int inputBufferByteSize, StreamData* userData);
+
+    /*!
+     * If output-recording is active, queues the received packet for writing to the output-recording file
+     */
+    unsigned int processOutputData(void* outputBuffer, const unsigned int outputBufferByteSize, StreamData* userData);
+
+private:
+    const int opusApplication;
+    std::unique_ptr<OggOpusWriter> inputWriter;
+    std::unique_ptr<OggOpusWriter> outputWriter;
+
+    static const Parameter* INPUT_FILE_NAME;
+    static const Parameter* OUTPUT_FILE_NAME;
+
+    /*!
+     * Queues the packet, silent and lost packets are recorded as silence
+     */
+    static void record(OggOpusWriter& writer, const void* packet, const unsigned int size, const StreamData* userData);
+};
+
+#endif	/* PROCESSOROGGOPUS_H */
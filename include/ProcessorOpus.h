@@ -2,10 +2,13 @@
 
 #define PROCESSOROPUS_H
 #include "AudioProcessor.h"
+#include "Parameters.h"
+#include "OpusMultistreamEncoder.h"
 #include "opus.h"
-#include ""
+#include "opus_multistream.h"
 
 #include <iostream>
+#include <memory>
 
 enum class OpusCodingModes 
 {
@@ -14,6 +17,45 @@ enum class OpusCodingModes
 	APPLICATION_RESTRICTED_LOWDELAY = OPUS_APPLICATION_RESTRICTED_LOWDELAY
 };
 
+/*!
+ * The bitrate-modes of the Opus-encoder
+ */
+enum class OpusBitrateMode
+{
+    //constant bitrate, every packet has the same size
+    CBR = 0,
+    //unconstrained variable bitrate (default)
+    VBR = 1,
+    //variable bitrate, which does not exceed the target bitrate over the size of one packet
+    CONSTRAINED_VBR = 2
+};
+
+/*!
+ * The controls of the Opus-encoder, which are applied via opus_encoder_ctl().
+ *
+ * The default values are the defaults of the Opus library
+ */
+struct OpusEncoderSettings
+{
+    //the target bitrate in bits per second, OPUS_AUTO to determine it from the sample-rate and the number of channels
+    int bitrate;
+    //the computational complexity from 0 (lowest CPU-usage) to 10 (best quality)
+    int complexity;
+    OpusBitrateMode bitrateMode;
+    //the maximum audio bandwidth, one of the OPUS_BANDWIDTH_* values
+    int maximumBandwidth;
+    //the duration of the encoded frames, one of the OPUS_FRAMESIZE_* values. OPUS_FRAMESIZE_ARG uses the size of the buffer
+    int frameDuration;
+    //whether to add in-band forward error-correction (only in the SILK-modes)
+    bool inbandFEC;
+    //whether to use discontinuous transmission, which encodes silence with packets of 1 or 2 bytes
+    bool dtx;
+    //the expected packet-loss in percent, higher values increase the robustness (and the bitrate of the FEC)
+    int expectedPacketLoss;
+
+    OpusEncoderSettings();
+};
+
 class ProcessorOpus : public AudioProcessor
 {
 public:
@@ -24,28 +66,85 @@ public:
     //returns supported Sample Rates by Opus: Opus supports this sampleRates: 8000, 12000, 16000, 24000, or 48000.
     unsigned int getSupportedSampleRates() const;
 
-    //configure the Opus Processor, this creates OpusEncoder and OpusDecoderObject and initializes private variables: outputDeviceChannels, rtaudioFormat and ErrorCode
-    bool configure(const AudioConfiguration& audioConfig);
+    //configure the Opus Processor, this creates OpusEncoder and OpusDecoderObject and stores the audio-configuration
+    bool configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode);
 
     //encodes the Data in inputBuffer(only Signed 16bit or float 32bit PCM and one frame supported) and writes the encoded Data in inputBuffer
     //supported size of one frame(2.5, 5, 10, 20, 40 or 60 ms) of audio data; at 48 kHz the permitted values are 120, 240, 480(10ms), 960(20ms), 1920, and 2880(60ms)
     //returns lenght of encodedPacket in Bytes
-    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, void *userData);
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData);
 
     //decodes the Data in outputBuffer and writes it to the outputBuffer(only Signed 16bit or float 32bit PCM and one frame supported)
     //supported size of one frame(2.5, 5, 10, 20, 40 or 60 ms) of audio data; at 48 kHz the permitted values are 120, 240, 480(10ms), 960(20ms), 1920, and 2880(60ms)
     //returns size of outputBuffer in Bytes
-    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, void *userData);
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData);
 
     //destructor: destroys OpusEncoder and OpusDecoderObject
     ~ProcessorOpus();
 
+    /*!
+     * Applies the settings to the encoder
+     *
+     * \param encoder The Opus-encoder to configure
+     *
+     * \param settings The values of the encoder-controls
+     *
+     * \param frameSize The number of frames per encoded buffer, must match the frame-duration, if set.
+     * 0, if the size of the buffers is not yet known
+     *
+     * \param sampleRate The sample-rate of the encoder
+     *
+     * \return whether all settings were accepted by the encoder
+     */
+    static bool applyEncoderSettings(OpusEncoder* encoder, const OpusEncoderSettings& settings, const unsigned int frameSize, const unsigned int sampleRate);
+
+    /*!
+     * \param frameDuration One of the OPUS_FRAMESIZE_* values
+     *
+     * \param sampleRate The sample-rate of the encoder
+     *
+     * \return the number of frames encoded per packet for the given frame-duration, 0 for OPUS_FRAMESIZE_ARG
+     */
+    static unsigned int getFrameDurationFrames(const int frameDuration, const unsigned int sampleRate);
+
 private:
+    static const Parameter* BITRATE;
+    static const Parameter* COMPLEXITY;
+    static const Parameter* BITRATE_MODE;
+    static const Parameter* BANDWIDTH;
+    static const Parameter* FRAME_DURATION;
+    static const Parameter* INBAND_FEC;
+    static const Parameter* DTX;
+    static const Parameter* PACKET_LOSS;
+    static const Parameter* ENCODER_THREADS;
+
+    /*!
+     * Reads the encoder-settings from the configuration-mode
+     *
+     * \return whether all values are valid
+     */
+    static bool readEncoderSettings(const std::shared_ptr<ConfigurationMode> configMode, OpusEncoderSettings& settings);
+
+    /*!
+     * Checks the configured frame-duration against the number of frames of the processing-block,
+     * which is only known when the processors are called (e.g. with reblocking, see AudioInterface#setProcessingFrames()).
+     * On mismatch, the encoder falls back to encode the whole block
+     *
+     * \return whether the encoder is configured correctly for the given number of frames
+     */
+    bool checkFrameDuration(const unsigned int numberOfFrames);
+
 	OpusEncoder *OpusEncoderObject;
 	OpusDecoder *OpusDecoderObject;
+	//used instead of the OpusEncoder/OpusDecoder for more than two channels
+	std::unique_ptr<OpusMultistreamEncoder> multistreamEncoder;
+	OpusMSDecoder *multistreamDecoder;
 	OpusCodingModes OpusApplication;
 	AudioConfiguration audioConfig;
-	int encodeErrorCode;
-	int decodeErrorCode;
+	OpusEncoderSettings encoderSettings;
+	//the number of frames required by the configured frame-duration, 0 to encode any number of frames
+	unsigned int frameDurationFrames;
+	//the result of creating the encoder and decoder
+	int errorCode;
 };
 #endif
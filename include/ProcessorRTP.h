@@ -6,6 +6,11 @@
 #include "RTPPackageHandler.h"
 #include "NetworkWrapper.h"
 #include "RTPBufferHandler.h"
+#include "ParityFEC.h"
+#include "FrameAggregator.h"
+#include "SRTPContext.h"
+#include "ComfortNoise.h"
+#include "Parameters.h"
 
 /*!
  * AudioProcessor wrapping/unwrapping audio-frames in/out of a RTP-package
@@ -13,6 +18,14 @@
  * This implementation uses a seperate thread (see RTPListener) to receive packages.
  * This was implemented to avoid blocking the audio-loop while waiting for packages.
  * The received RTPPackages are buffered in an RTPBuffer
+ *
+ * Silent buffers (see StreamData#isSilentPackage) are not sent. Instead a comfort-noise package (RFC 3389) is sent
+ * at the start of the silence and whenever the noise-level changes or the refresh-interval elapsed (DTX).
+ * The first audio-package after a silence has the marker-bit set.
+ *
+ * To measure the end-to-end (mouth-to-ear) latency, the audio-packages can carry the time their first sample was captured
+ * in a header-extension (see PackageTiming). The components of the latency of the received packages are recorded in the Statistics,
+ * the output-device delay is approximated by the duration of one audio-buffer.
  */
 class ProcessorRTP : public AudioProcessor
 {
@@ -27,9 +40,29 @@ public:
      * \param buffer The RTPBuffer to read packages from
      * 
      * \param payloadType The payload-type for the RTP packages
+     *
+     * \param fecGroupSize The number of RTP packages protected by a single FEC-package, zero disables FEC.
+     * Can be overridden by the parameter FEC_GROUP_SIZE
+     *
+     * \param maxPackageDuration The maximum duration (ptime) in milliseconds of audio-data combined into a single RTP-package
+     * (see FrameAggregator), zero sends every audio-frame in its own package. The RTPListener must be configured accordingly
+     *
+     * \param srtpContext The SRTP-context to encrypt the sent packages with, nullptr sends unencrypted RTP-packages.
+     * The RTPListener must be configured with the according context of the remote device
+     *
+     * \param sendCaptureTime Whether to send the capture-time of the audio-packages in a header-extension,
+     * so the remote device can measure the end-to-end latency
+     *
+     * \param fecSRTPContext The SRTP-context to encrypt the FEC-packages with, required if FEC and SRTP are enabled.
+     * Since the FEC-packages share the SSRC of the media-packages but use their own sequence numbers,
+     * this context must be created from a different master-key than srtpContext, so no IV is used twice with the same key
      */
     ProcessorRTP(const std::string name, std::shared_ptr<NetworkWrapper> networkwrapper, 
-                 std::shared_ptr<RTPBufferHandler> buffer, const PayloadType payloadType);
+                 std::shared_ptr<RTPBufferHandler> buffer, const PayloadType payloadType, const uint8_t fecGroupSize = 0,
+                 const unsigned short maxPackageDuration = 0, std::shared_ptr<SRTPContext> srtpContext = nullptr,
+                 const bool sendCaptureTime = false, std::shared_ptr<SRTPContext> fecSRTPContext = nullptr);
+
+    bool configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode);
 
     unsigned int getSupportedAudioFormats() const;
     unsigned int getSupportedSampleRates() const;
@@ -40,11 +73,88 @@ public:
 
     bool cleanUp();
 private:
+    static const Parameter* FEC_GROUP_SIZE;
+
     std::shared_ptr<NetworkWrapper> networkObject;
     RTPPackageHandler *rtpPackage = nullptr;
     std::shared_ptr<RTPBufferHandler> rtpBuffer;
     const PayloadType payloadType;
+    uint8_t fecGroupSize;
+    RTPPackageHandler *fecPackage = nullptr;
+    ParityFEC *parityFEC = nullptr;
+    const unsigned short maxPackageDuration;
+    unsigned int sampleRate = 0;
+    FrameAggregator *frameAggregator = nullptr;
+    std::shared_ptr<SRTPContext> srtpContext;
+    std::shared_ptr<SRTPContext> fecSRTPContext;
+    //the 32 bit SRTP package-indices (rollover-counter and sequence number) of the last sent media- and FEC-package
+    uint32_t mediaPackageIndex = 0;
+    uint32_t fecPackageIndex = 0;
+    const bool sendCaptureTime;
+    //the wall-clock time the first frame of the next package was captured, zero if no frame is pending
+    uint64_t packageCaptureTime = 0;
+    //the number of milliseconds after which the comfort-noise is re-sent during silence
+    static const unsigned int COMFORT_NOISE_INTERVAL = 200;
+    //the minimum change of the noise-level in dB to send a new comfort-noise package
+    static const unsigned int COMFORT_NOISE_LEVEL_CHANGE = 3;
+    //whether the last input-buffer was silent
+    bool isSendingSilence = false;
+    uint8_t sentNoiseLevel = 0;
+    //the number of frames since the last sent comfort-noise package
+    unsigned int framesSinceComfortNoise = 0;
+    //whether the last received package was a comfort-noise package
+    bool isReceivingSilence = false;
+    uint8_t receivedNoiseLevel = 0;
     
-    void initPackageHandler(unsigned int maxBufferSize);
+    void initPackageHandler(const StreamData *userData);
+
+    /*!
+     * Checks whether the frames combined within the maximum package-duration fit into a single package,
+     * whose size is limited by the 16 bit lengths of the aggregated frames (see FrameAggregator)
+     *
+     * \return whether the maximum package-duration is valid for the given configuration
+     */
+    bool checkPackageDuration(const AudioConfiguration& audioConfig) const;
+
+    /*!
+     * Sends a RTP-package with the given payload
+     */
+    void sendPackage(const void *payload, unsigned int payloadSize, const PayloadType payloadType);
+
+    /*!
+     * Handles a silent input-buffer, only sending a comfort-noise package, if required
+     *
+     * \param noiseLevel The noise-level of the silent buffer in -dBov
+     *
+     * \param numberOfFrames The number of audio-frames in the silent buffer
+     */
+    void sendComfortNoise(const uint8_t noiseLevel, const unsigned int numberOfFrames);
+
+    /*!
+     * Adds the last sent RTP-package to the current FEC-group and sends the FEC-package, if the group is complete
+     */
+    void sendFECPackage(const void *payload, unsigned int payloadSize);
+
+    /*!
+     * Sends the RTP-package stored in the given handler, encrypting it if SRTP is enabled
+     *
+     * \param package The handler holding the package to send
+     *
+     * \param packageSize The size of the RTP-package in bytes
+     *
+     * \param context The SRTP-context of the stream, nullptr to send the package unencrypted
+     *
+     * \param packageIndex The SRTP package-index of the previous package of this stream, is updated for the sent package
+     *
+     * \return the number of bytes sent
+     */
+    unsigned int sendRTPPackage(RTPPackageHandler& package, unsigned int packageSize, const SRTPContext* context, uint32_t& packageIndex);
+
+    /*!
+     * Records the output-device delay and the mouth-to-ear latency of the package read from the RTPBuffer
+     *
+     * \param numberOfFrames The number of audio-frames in the output-buffer
+     */
+    void recordLatency(const unsigned int numberOfFrames);
 };
 #endif
@@ -0,0 +1,79 @@
+#ifndef PROCESSORRESAMPLER_H
+#define	PROCESSORRESAMPLER_H
+
+#include <memory>
+#include <vector>
+
+#include "AudioProcessor.h"
+#include "Parameters.h"
+#include "Resampler.h"
+
+/*!
+ * AudioProcessor converting between the sample-rate of the audio-device and the sample-rate required by the following processors,
+ * e.g. to use a device only supporting 44.1 kHz with the Opus-codec, which only accepts 8, 12, 16, 24 or 48 kHz.
+ *
+ * On input, the audio is resampled from the device-rate to the processing-rate, on output vice versa.
+ * The number of frames per buffer changes with the ratio and may vary between buffers (e.g. 441 frames at 44.1 kHz yield 480 or 481 frames at 48 kHz).
+ *
+ * This processor only supports 32 bit float samples, so it needs to be added directly after a ProcessorFormatConversion
+ * (or first, if the device uses 32 bit float samples) and before any codec.
+ */
+class ProcessorResampler : public AudioProcessor
+{
+public:
+    ProcessorResampler(const std::string name);
+
+    bool configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode);
+
+    bool cleanUp();
+
+    /*!
+     * Supports only 32 bit float PCM samples
+     */
+    unsigned int getSupportedAudioFormats() const;
+    unsigned int getSupportedSampleRates() const;
+    const std::vector<int> getSupportedBufferSizes(unsigned int sampleRate) const;
+
+    unsigned int getMaximumInputSize(const AudioConfiguration& audioConfig, const unsigned int inputBufferByteSize) const;
+    unsigned int getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const;
+
+    /*!
+     * The resampling can only be done in-place, if the rates of the device and the processing are equal
+     */
+    bool isProcessingInPlace() const;
+
+    /*!
+     * Resamples the input-buffer from the device-rate to the processing-rate
+     */
+    unsigned int processInputDataOutOfPlace(const void *sourceBuffer, const unsigned int inputBufferByteSize, void *targetBuffer, StreamData *userData);
+
+    /*!
+     * Resamples the output-buffer from the processing-rate to the device-rate
+     */
+    unsigned int processOutputDataOutOfPlace(const void *sourceBuffer, const unsigned int outputBufferByteSize, void *targetBuffer, StreamData *userData);
+
+    /*!
+     * Resamples via an intermediate buffer, the input-buffer must hold #getMaximumInputSize() bytes
+     */
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData);
+
+    /*!
+     * Resamples via an intermediate buffer, the output-buffer must hold #getMaximumOutputSize() bytes
+     */
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData);
+
+private:
+    static const unsigned int DEFAULT_PROCESSING_RATE = 48000;
+    static const Parameter* PROCESSING_RATE;
+    static const Parameter* QUALITY;
+
+    unsigned int inputChannels;
+    unsigned int outputChannels;
+    //nullptr, if no resampling is required
+    std::unique_ptr<Resampler> inputResampler;
+    std::unique_ptr<Resampler> outputResampler;
+    //the buffer for the in-place resampling, allocated on configuration
+    std::vector<float> resamplingBuffer;
+};
+
+#endif	/* PROCESSORRESAMPLER_H */
@@ -0,0 +1,56 @@
+#ifndef PROCESSORVOICEACTIVITYDETECTION_H
+#define	PROCESSORVOICEACTIVITYDETECTION_H
+
+#include <memory>
+
+#include "AudioProcessor.h"
+#include "Parameters.h"
+#include "VoiceActivityDetector.h"
+
+/*!
+ * AudioProcessor suppressing the encoding and sending of audio-buffers without speech, see VoiceActivityDetector.
+ *
+ * On input, every buffer without speech is marked as StreamData#isSilentPackage and replaced by the comfort-noise payload (see ComfortNoise),
+ * so codecs skip the buffer and ProcessorRTP only sends a comfort-noise package at the start of the silence and periodically afterwards.
+ * Unlike the fixed threshold of ProcessorComfortNoise, the detection adapts to the level of the background noise.
+ *
+ * On output, silent buffers are filled with silence, unless a ProcessorComfortNoise already synthesized comfort-noise.
+ *
+ * This processor needs to be added before any codec (and before a ProcessorComfortNoise), after any format-conversion or resampling.
+ */
+class ProcessorVoiceActivityDetection : public AudioProcessor
+{
+public:
+    ProcessorVoiceActivityDetection(const std::string name);
+
+    bool configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode);
+
+    /*!
+     * Supports 16 bit signed integer and 32 bit float PCM samples
+     */
+    unsigned int getSupportedAudioFormats() const;
+    unsigned int getSupportedSampleRates() const;
+    const std::vector<int> getSupportedBufferSizes(unsigned int sampleRate) const;
+
+    /*!
+     * Detects whether the input-buffer contains speech and replaces buffers without speech with the comfort-noise payload
+     */
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData);
+
+    /*!
+     * Fills silent output-buffers with silence
+     */
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData);
+
+private:
+    //the power in dB above the noise-floor at which audio is considered speech
+    static const unsigned int DEFAULT_THRESHOLD = 9;
+    static const Parameter* THRESHOLD;
+
+    std::unique_ptr<VoiceActivityDetector> detector;
+    bool isFloatFormat;
+    unsigned int inputChannels;
+    unsigned int outputChannels;
+};
+
+#endif	/* PROCESSORVOICEACTIVITYDETECTION_H */
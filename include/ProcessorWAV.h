@@ -8,9 +8,10 @@
 #ifndef PROCESSORWAV_H
 #define	PROCESSORWAV_H
 
+#include <memory>
+
 #include "AudioProcessor.h"
-#include <stdio.h>
-#include "wavfile.h"
+#include "WAVWriter.h"
 #include "Parameters.h"
 
 /**
@@ -18,6 +19,8 @@
  *
  * Both the audio-input and the audio-output can be logged separately, with the destination files
  * specified by user-input
+ *
+ * The audio-thread only copies the samples into a ring-buffer, the files are written by a background-thread, see WAVWriter
  */
 class ProcessorWAV : public AudioProcessor
 {
@@ -28,7 +31,7 @@ public:
     bool configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode);
 
     /*!
-     * The wav implementation only supports 16bit signed integer PCM samples
+     * All audio-formats are written as they are
      */
     unsigned int getSupportedAudioFormats() const;
 
@@ -38,24 +41,26 @@ public:
     const std::vector<int> getSupportedBufferSizes(unsigned int sampleRate) const;
 
     /*!
-     * The wav implementation only supports the 44.1kHz sample-rate
+     * All sample-rates are supported
      */
     unsigned int getSupportedSampleRates() const;
     
     PayloadType getSupportedPlayloadType() const;
 
     /*!
-     * If input-logging is active, writes the audio-input to the input-logging file
+     * If input-logging is active, queues the audio-input for writing to the input-logging file.
+     * Silent packages are logged as silence of the package's duration
      */
     unsigned int processInputData(void* inputBuffer, const unsigned int inputBufferByteSize, StreamData* userData);
 
     /*!
-     * If output-logging is active, writes the audio-output to the output-logging file
+     * If output-logging is active, queues the audio-output for writing to the output-logging file.
+     * Silent packages are logged as silence of the package's duration
      */
     unsigned int processOutputData(void* outputBuffer, const unsigned int outputBufferByteSize, StreamData* userData);
 private:
-    FILE* writeInputFile;
-    FILE* writeOutputFile;
+    std::unique_ptr<WAVWriter> inputWriter;
+    std::unique_ptr<WAVWriter> outputWriter;
     
     static const Parameter* INPUT_FILE_NAME;
     static const Parameter* OUTPUT_FILE_NAME;
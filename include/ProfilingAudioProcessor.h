@@ -5,10 +5,14 @@
 #include <chrono>
 
 #include "AudioProcessor.h"
+#include "LatencyHistogram.h"
 
 /*!
  * AudioProcessor which wraps another processor profiling the method-calls to the AudioProcessor#processInputData()
  * and AudioProcessor#processOutputData() methods
+ *
+ * The durations of the calls are measured with the monotonic std::chrono::steady_clock in nanoseconds and counted in a histogram
+ * per direction, so the outliers (which cause buffer-underruns of the audio-device) are visible in the percentiles.
  */
 class ProfilingAudioProcessor : public AudioProcessor
 {
@@ -17,17 +21,21 @@ public:
 
     ~ProfilingAudioProcessor();
     /*!
-     * Returns the total duration of the AudioProcessor#processInputData() for the profiled AudioProcessor
+     * Returns the total duration in microseconds of the AudioProcessor#processInputData() for the profiled AudioProcessor
      */
     unsigned long getTotalInputTime() const;
     /*!
-     * Returns the total duration of the AudioProcessor#processOutputData() for the profiled AudioProcessor
+     * Returns the total duration in microseconds of the AudioProcessor#processOutputData() for the profiled AudioProcessor
      */
     unsigned long getTotalOutputTime() const;
     /*!
-     * Returns the total number of tracked method-calls
+     * Returns the durations of the calls to AudioProcessor#processInputData() in nanoseconds
      */
-    unsigned long getTotalCount() const;
+    const LatencyHistogram& getInputHistogram() const;
+    /*!
+     * Returns the durations of the calls to AudioProcessor#processOutputData() in nanoseconds
+     */
+    const LatencyHistogram& getOutputHistogram() const;
     void reset();
 
     /*!
@@ -37,16 +45,19 @@ public:
     unsigned int getSupportedAudioFormats() const;
     const std::vector<int> getSupportedBufferSizes(unsigned int sampleRate) const;
     unsigned int getSupportedSampleRates() const;
+    unsigned int getMaximumInputSize(const AudioConfiguration& audioConfig, const unsigned int inputBufferByteSize) const;
+    unsigned int getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const;
+    bool isProcessingInPlace() const;
     unsigned int processInputData(void* inputBuffer, const unsigned int inputBufferByteSize, StreamData* userData);
     unsigned int processOutputData(void* outputBuffer, const unsigned int outputBufferByteSize, StreamData* userData);
+    unsigned int processInputDataOutOfPlace(const void* sourceBuffer, const unsigned int inputBufferByteSize, void* targetBuffer, StreamData* userData);
+    unsigned int processOutputDataOutOfPlace(const void* sourceBuffer, const unsigned int outputBufferByteSize, void* targetBuffer, StreamData* userData);
 private:
     AudioProcessor* profiledProcessor;
-    unsigned long outputProcessingTime;
-    unsigned long inputProcessingTime;
-    unsigned long count;
+    LatencyHistogram inputHistogram;
+    LatencyHistogram outputHistogram;
 
-    void addTimeInputProcessing(long ms);
-    void addTimeOutputProcessing(long ms);
+    static uint64_t getElapsedNanoseconds(const std::chrono::steady_clock::time_point start);
 };
 
 #endif
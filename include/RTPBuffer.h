@@ -9,6 +9,7 @@
 #define	RTPBUFFER_H
 
 #include "RTPBufferHandler.h"
+#include "ParityFEC.h"
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -51,6 +52,15 @@ public:
      */
     RTPBufferStatus readPackage(RTPPackageHandler &package);
 
+    /*!
+     * Adds a FEC-package to the buffer and tries to recover a lost package of the protected group
+     *
+     * \param package The FEC-package to add
+     *
+     * \param contentSize The size in bytes of the FEC-payload
+     */
+    RTPBufferStatus addFECPackage(const RTPPackageHandler &package, unsigned int contentSize);
+
     /*!
      * Returns the size of the buffer, the number of stored elements
      */
@@ -83,6 +93,10 @@ private:
          * The timestamp (in milliseconds) this package was received
          */
         unsigned int receptionTimestamp;
+        /*!
+         * The capture-time and send-delay read from the header-extension of the package
+         */
+        PackageTiming timing;
         /*!
          * The package size in bytes (size of the content)
          */
@@ -96,7 +110,7 @@ private:
          */
         void *packageContent;
 
-        RTPBufferPackage() : isValid(false), header(), receptionTimestamp(0), contentSize(0), bufferSize(0), packageContent(nullptr)
+        RTPBufferPackage() : isValid(false), header(), receptionTimestamp(0), timing(), contentSize(0), bufferSize(0), packageContent(nullptr)
         {
 
         }
@@ -107,10 +121,23 @@ private:
         }
     };
 
+    /*!
+     * The maximum number of FEC-packages to keep for recovery
+     */
+    static const uint8_t FEC_BUFFER_CAPACITY = 4;
+
     /*!
      * The ring-buffer containing the packages
      */
     RTPBuffer::RTPBufferPackage *ringBuffer;
+    /*!
+     * The most recently received FEC-packages
+     */
+    RTPBuffer::RTPBufferPackage fecBuffer[FEC_BUFFER_CAPACITY];
+    /*!
+     * The index to write the next FEC-package to
+     */
+    uint8_t nextFECWriteIndex;
     /*!
      * The maximum entries in the buffer, size of the array
      */
@@ -150,6 +177,27 @@ private:
      */
     uint16_t calculateIndex(uint16_t index, uint16_t offset);
 
+    /*!
+     * Copies the given content into the buffer-entry, (re)allocating its buffer if necessary
+     */
+    void copyPackageContent(RTPBufferPackage &bufferPackage, const void *content, unsigned int contentSize);
+
+    /*!
+     * Tries to recover the missing package with the given sequence number from the stored FEC-packages.
+     * Recovery succeeds, if the package is protected by a FEC-package and all other packages of that group are still available.
+     *
+     * NOTE: must be called with the mutex locked
+     *
+     * \return whether the package was recovered
+     */
+    bool recoverPackage(uint16_t sequenceNumber);
+
+    /*!
+     * Returns the index in the ring-buffer the package with the given sequence number is (or was) stored in,
+     * or -1 if the sequence number is out of the range of the buffer
+     */
+    int getPackageIndex(uint16_t sequenceNumber) const;
+
     void lockMutex();
 
     void unlockMutex();
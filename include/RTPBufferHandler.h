@@ -60,6 +60,20 @@ public:
      */
     virtual RTPBufferStatus readPackage(RTPPackageHandler &package) = 0;
 
+    /*!
+     * Adds a FEC-package (see ParityFEC) to the buffer, to be used to recover lost packages.
+     *
+     * The default implementation simply discards the package
+     *
+     * \param package The FEC-package to add
+     *
+     * \param contentSize The size of the FEC-payload in the package
+     */
+    virtual RTPBufferStatus addFECPackage(const RTPPackageHandler &package, unsigned int contentSize)
+    {
+        return RTPBufferStatus::RTP_BUFFER_ALL_OKAY;
+    }
+
     /*!
      * Returns the number of currently buffered packages
      */
@@ -14,6 +14,9 @@
 #include "ParticipantDatabase.h"
 #include "RTPBufferHandler.h"
 #include "NetworkWrapper.h"
+#include "FrameAggregator.h"
+#include "SRTPContext.h"
+#include "ParityFEC.h"
 
 /*!
  * Listening-thread for incoming RTP-packages
@@ -33,8 +36,17 @@ public:
      * \param receiveBufferSize The maximum size (in bytes) a RTP-package can fill, according to the configuration
      *
      * \param stopCallback The callback to be executed after receiving a RTCP GOODBYE-package
+     *
+     * \param aggregatedFrames Whether the received packages combine several audio-frames (see FrameAggregator),
+     * which are split into separate entries in the RTPBuffer
+     *
+     * \param srtpContext The SRTP-context to decrypt and authenticate the received packages with, nullptr to receive unencrypted RTP-packages
+     *
+     * \param fecSRTPContext The SRTP-context to decrypt and authenticate the received FEC-packages with, matching the one of the remote ProcessorRTP.
+     * If SRTP is enabled without this context, FEC-packages are discarded
      */
-    RTPListener(std::shared_ptr<NetworkWrapper> wrapper, std::shared_ptr<RTPBufferHandler> buffer, unsigned int receiveBufferSize, std::function<void ()> stopCallback);
+    RTPListener(std::shared_ptr<NetworkWrapper> wrapper, std::shared_ptr<RTPBufferHandler> buffer, unsigned int receiveBufferSize, std::function<void ()> stopCallback,
+                const bool aggregatedFrames = false, std::shared_ptr<SRTPContext> srtpContext = nullptr, std::shared_ptr<SRTPContext> fecSRTPContext = nullptr);
     RTPListener(const RTPListener& orig);
     virtual ~RTPListener();
 
@@ -52,6 +64,22 @@ private:
     std::shared_ptr<NetworkWrapper> wrapper;
     std::shared_ptr<RTPBufferHandler> buffer;
     RTPPackageHandler rtpHandler;
+    //holds a single audio-frame split from an aggregated package
+    RTPPackageHandler frameHandler;
+    const bool aggregatedFrames;
+    //the number of frames in the last aggregated audio-package, a comfort-noise package is split into as many frames
+    uint8_t lastFramesPerPackage = 1;
+    //the extended sequence number of the next expected aggregated package and the number in the RTPBuffer of its first frame
+    bool hasFrameNumberBase = false;
+    uint32_t nextPackageSequenceNumber = 0;
+    uint16_t nextFrameNumber = 0;
+    //the RTPBuffer stores the split frames, so lost aggregated packages are recovered on package-level
+    ParityFECRecovery fecRecovery;
+    std::shared_ptr<SRTPContext> srtpContext;
+    std::shared_ptr<SRTPContext> fecSRTPContext;
+    //the highest SRTP package-indices received for media- and FEC-packages
+    uint32_t mediaPackageIndex = 0;
+    uint32_t fecPackageIndex = 0;
     std::thread receiveThread;
     bool threadRunning = false;
     bool firstPackage = false;
@@ -74,10 +102,59 @@ private:
      */
     float calculateInterarrivalJitter(uint32_t sentTimestamp, uint32_t receptionTimestamp);
     
+    /*!
+     * Records the sending- and network-delay of the received package, if it contains a capture-time (see PackageTiming)
+     *
+     * \param receptionTime The wall-clock time in nanoseconds the package was received
+     */
+    void recordLatency(const uint64_t receptionTime) const;
+
     /*!
      * Calculates the new extended highest sequence number for the received package
      */
     uint32_t calculateExtendedHighestSequenceNumber(const uint16_t receivedSequenceNumber) const;
+
+    /*!
+     * Writes the received package into the RTPBuffer, see #addFramesToBuffer() for aggregated packages
+     *
+     * \param payloadSize The size in bytes of the received payload
+     */
+    RTPBufferStatus addToBuffer(const unsigned int payloadSize);
+
+    /*!
+     * Writes an aggregated package into the RTPBuffer, splitting it into one entry per audio-frame.
+     *
+     * The frames of an aggregated package are numbered consecutively, starting with the number following the last frame
+     * of the previous package, so the number of frames may change between packages.
+     * Lost (or late) packages are assumed to contain as many frames as the last received package and leave a gap of that size.
+     * A comfort-noise package is copied into the same number of frames as the last audio-package
+     *
+     * \param header The RTPHeader of the aggregated package
+     *
+     * \param payload The aggregated payload
+     *
+     * \param payloadSize The size in bytes of the payload
+     *
+     * \param timing The timing of the package, assigned to all of its frames
+     */
+    RTPBufferStatus addFramesToBuffer(const RTPHeader& header, const void* payload, const unsigned int payloadSize, const PackageTiming& timing);
+
+    /*!
+     * Handles the received FEC-package. For aggregated packages, the lost package is recovered and then split into its frames,
+     * since the FEC-packages protect the sequence numbers of the packages, not of the frames stored in the RTPBuffer
+     *
+     * \param contentSize The size in bytes of the FEC-payload
+     */
+    void addFECPackage(const unsigned int contentSize);
+
+    /*!
+     * Authenticates and decrypts the received SRTP-package in-place
+     *
+     * \param receivedSize The size of the received package, is decreased by the size of the authentication-tag
+     *
+     * \return whether the package is authentic
+     */
+    bool unprotectPackage(int& receivedSize);
 };
 
 #endif	/* RTPLISTENER_H */
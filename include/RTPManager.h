@@ -11,6 +11,7 @@
 #include <random> // random generator objects
 #include <chrono> // clock, tick
 #include <string.h> //memcpy
+#include <vector>
 
 
 //For htons/htonl and ntohs/ntohl
@@ -30,6 +31,15 @@ static const unsigned int RTP_HEADER_MIN_SIZE = 12;
  */
 static const unsigned int RTP_HEADER_MAX_SIZE = 72;
 
+/*!
+ * Minimum size of a RTP header-extension in bytes, the profile- and the length-field
+ */
+static const unsigned int RTP_HEADER_EXTENSION_MIN_SIZE = 4;
+
+/*!
+ * The profile of a header-extension with one-byte element-headers, as specified in RFC 8285 (section 4.2)
+ */
+static const uint16_t RTP_HEADER_EXTENSION_ONE_BYTE_PROFILE = 0xBEDE;
 
 
 /*!
@@ -78,6 +88,11 @@ enum PayloadType
     //OPUS variable bandwidth - https://en.wikipedia.org/wiki/Opus_%28audio_format%29
     //RFC 7587 (RTP Payload Format for Opus, see: https://ietf.org/rfc/rfc7587.txt) defines the opus payload-type as dynamic
     OPUS = 112,
+    //Parity forward error correction, see ParityFEC.h
+    //FEC-packages are sent with a dynamic payload-type, similar to RFC 5109 and FlexFEC (draft-ietf-payload-flexible-fec-scheme)
+    FEC = 113,
+    //Lossless compressed PCM (linear prediction and Rice coding), see LosslessCodec.h, sent with a dynamic payload-type
+    LOSSLESS = 114,
     //dummy payload-type to accept all types
     ALL = -1
 
@@ -252,17 +267,17 @@ public:
     
     inline void setExtension(bool extension)
     {
-        data[0] = data[0] | (extension << shiftExtension);
+        data[0] = (data[0] & ~(1 << shiftExtension)) | (extension << shiftExtension);
     }
     
     inline uint8_t getCSRCCount() const
     {
-        return data[0] & 0x7;
+        return data[0] & 0xF;
     }
     
     inline void setCSRCCount(uint8_t csrcCount)
     {
-        data[0] = data[0] | (csrcCount & 0x7);
+        data[0] = (data[0] & ~0xF) | (csrcCount & 0xF);
     }
     
     inline bool isMarked() const
@@ -325,6 +340,85 @@ public:
     }
 };
 
+/*!
+ * The RTP header-extension is specified in RFC 3550 (section 5.3.1) and has the following format:
+ *
+ *  0                   1                   2                   3
+ *  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |      defined by profile       |           length              |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |                        header extension                       |
+ * |                             ....                              |
+ *
+ * The length counts the 32 bit words of the extension, without the first four bytes.
+ *
+ * This is a copy of the extension of a package (see RTPPackageHandler#getRTPHeaderExtension()), not its in-memory layout
+ */
+struct RTPHeaderExtension
+{
+private:
+    //data[0-1]
+    //16 bit profile-defined field
+
+    //data[2-3]
+    //16 bit length field
+    uint8_t data[RTP_HEADER_EXTENSION_MIN_SIZE];
+
+    //the contents of the extension
+    std::vector<uint8_t> extension;
+
+public:
+
+    RTPHeaderExtension(uint16_t length) : data{0}, extension(length * sizeof(uint32_t))
+    {
+        data[2] = (uint8_t) (length >> 8);
+        data[3] = (uint8_t) (length & 0xFF);
+    }
+
+    inline uint16_t getProfile() const
+    {
+        return (data[0] << 8) | data[1];
+    }
+
+    inline void setProfile(uint16_t profile)
+    {
+        data[0] = (uint8_t) (profile >> 8);
+        data[1] = (uint8_t) (profile & 0xFF);
+    }
+
+    inline uint16_t getLength() const
+    {
+        return (data[2] << 8) | data[3];
+    }
+
+    inline void* getExtension()
+    {
+        return extension.data();
+    }
+
+    inline const void* getExtension() const
+    {
+        return extension.data();
+    }
+};
+
+/*!
+ * The timing-information of an audio-package, transmitted in a header-extension to measure the end-to-end (mouth-to-ear) latency.
+ *
+ * The extension uses the one-byte element-headers of RFC 8285 with a single element (ID 1) of 12 bytes:
+ * the capture-time in the 64 bit NTP-format (as in RTCP sender-reports) and the 32 bit send-delay in microseconds.
+ * The capture-time is taken from the wall-clock (see RTPPackageHandler#getWallClockTime()), so the clocks of both devices
+ * must be synchronized (e.g. via NTP) for the network-delay to be meaningful.
+ */
+struct PackageTiming
+{
+    //the wall-clock time in nanoseconds the first sample of the package was captured, zero if unknown
+    uint64_t captureTime;
+    //the delay in microseconds between capturing and sending the package (buffering, encoding and packetization on the sender)
+    uint32_t sendDelay;
+};
+
 class RTPPackageHandler
 {
 public:
@@ -352,6 +446,24 @@ public:
      */
     const void* createNewRTPPackage(const void* audioData, unsigned int payloadSize);
 
+    /*!
+     * Generates a new RTP-package with the given payload-type instead of the default one, e.g. for comfort-noise packages
+     * which share the sequence numbers with the audio-packages
+     *
+     * \param captureTime The wall-clock time in nanoseconds the first sample of the payload was captured (see #getWallClockTime()),
+     * which is sent in a header-extension (see PackageTiming). Zero (the default) sends no header-extension
+     */
+    const void* createNewRTPPackage(const void* audioData, unsigned int payloadSize, PayloadType payloadType, const uint64_t captureTime = 0);
+
+    /*!
+     * Writes the given header and the timing-information into the internal buffer, e.g. to restore a buffered package.
+     * The header-extension is only written, if the capture-time is set.
+     * The RTPHeader does not hold the CSRC-list, so the CSRC count of the written header is reset to zero
+     *
+     * \return a pointer to the position of the payload in the internal buffer
+     */
+    void* writeRTPPackageHeader(const RTPHeader& header, const PackageTiming& timing);
+
     /*!
      * Returns a pointer to the payload of the internal RTP-package
      */
@@ -363,11 +475,17 @@ public:
     const RTPHeader* getRTPPackageHeader() const;
     
     /*!
-     * Returns a RTPHeaderExtension pointer to the extension in the stored RTP-package. 
-     * If no such extension exists, nullptr is returned.
+     * Returns a copy of the header-extension of the stored RTP-package.
+     * If no such extension exists, an empty extension is returned.
      */
     const RTPHeaderExtension getRTPHeaderExtension() const;
 
+    /*!
+     * Reads the timing-information from the header-extension of the stored RTP-package.
+     * If the package has no such extension, the capture-time is zero
+     */
+    PackageTiming getPackageTiming() const;
+
     /*!
      * Gets the maximum size for the RTP package (header + body)
      */
@@ -423,6 +541,11 @@ public:
      * Returns the current RTP timestamp for the internal clock
      */
     uint32_t getCurrentRTPTimestamp() const;
+
+    /*!
+     * Returns the current wall-clock time in nanoseconds since the UNIX-epoch, the clock the capture-times (see PackageTiming) are taken from
+     */
+    static uint64_t getWallClockTime();
     
     /*!
      * This method tries to determine whether the received buffer holds an RTP package.
@@ -441,6 +564,10 @@ private:
     // A buffer that can store a whole RTP-Package
     void *workBuffer;
 
+    //the ID and the size in bytes of the capture-time element in the header-extension (see PackageTiming)
+    static const uint8_t CAPTURE_TIME_ELEMENT_ID = 1;
+    static const unsigned int CAPTURE_TIME_ELEMENT_SIZE = 12;
+
     unsigned int getRandomNumber();
     unsigned int createStartingTimestamp();
     unsigned int getAudioSourceId();
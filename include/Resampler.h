@@ -0,0 +1,126 @@
+#ifndef RESAMPLER_H
+#define	RESAMPLER_H
+
+#include <vector>
+
+#include "FormatConverter.h"
+
+/*!
+ * Converts the sample-rate of interleaved 32 bit float samples by an arbitrary rational ratio.
+ *
+ * The resampler uses a polyphase FIR-filter: the ratio is reduced to outputRate / inputRate = L / M,
+ * the input is (conceptually) upsampled by L, low-pass filtered with a Kaiser-windowed sinc and downsampled by M.
+ * Only the L sub-filters (phases) required for the output-samples are evaluated,
+ * using SSE2, AVX2 or NEON for the dot-products (see FormatConverter#getSupportedInstructionSet()).
+ *
+ * The quality determines the length of the filter and therefore the steepness of the transition band, the stop-band attenuation and the CPU-usage.
+ * When downsampling, the cut-off frequency is lowered to the new Nyquist-frequency and the filter is lengthened accordingly.
+ *
+ * The resampler is stateful, so consecutive buffers of a stream are resampled without discontinuities.
+ * The output is delayed by half the filter-length, see #getDelay().
+ * No memory is allocated after construction.
+ */
+class Resampler
+{
+public:
+
+    enum class Quality : char
+    {
+        //16 taps, ~50 dB stop-band attenuation
+        LOW,
+        //32 taps, ~70 dB stop-band attenuation
+        MEDIUM,
+        //64 taps, ~90 dB stop-band attenuation
+        HIGH,
+        //128 taps, ~110 dB stop-band attenuation
+        BEST
+    };
+
+    /*!
+     * The maximum number of phases, i.e. the numerator of the reduced ratio.
+     * This allows for all ratios between the common audio sample-rates
+     */
+    static const unsigned int MAXIMUM_PHASES = 1024;
+
+    /*!
+     * \param inputRate The sample-rate of the input in Hz
+     *
+     * \param outputRate The sample-rate to convert to in Hz
+     *
+     * \param channels The number of interleaved channels
+     *
+     * \param quality The quality of the resampling-filter
+     *
+     * \param maximumInputFrames The maximum number of frames passed to #process()
+     *
+     * \param instructionSet The instruction-set to use, is reduced to the instruction-set supported by the CPU
+     */
+    Resampler(const unsigned int inputRate, const unsigned int outputRate, const unsigned int channels, const Quality quality,
+              const unsigned int maximumInputFrames, const FormatConverter::InstructionSet instructionSet = FormatConverter::getSupportedInstructionSet());
+
+    /*!
+     * \return whether the ratio is supported, i.e. the rates are non-zero and the reduced ratio has at most MAXIMUM_PHASES phases
+     */
+    bool isValid() const;
+
+    /*!
+     * Resamples the given input-frames
+     *
+     * \param input The interleaved input-samples
+     *
+     * \param inputFrames The number of input-frames, at most the maximumInputFrames given on construction
+     *
+     * \param output The buffer to write the interleaved output-samples into, holds at least #getMaximumOutputFrames() frames
+     *
+     * \return the number of output-frames written
+     */
+    unsigned int process(const float* input, const unsigned int inputFrames, float* output);
+
+    /*!
+     * \return the maximum number of output-frames generated for the given number of input-frames
+     */
+    unsigned int getMaximumOutputFrames(const unsigned int inputFrames) const;
+
+    /*!
+     * \return the delay of the output in input-frames
+     */
+    unsigned int getDelay() const;
+
+    /*!
+     * Clears the filter-history, e.g. after an interruption of the stream
+     */
+    void reset();
+
+    /*!
+     * \return the number of taps per phase
+     */
+    unsigned int getFilterLength() const;
+
+    FormatConverter::InstructionSet getInstructionSet() const;
+
+private:
+    typedef float (*DotProduct)(const float* samples, const float* coefficients, const unsigned int length);
+
+    //the reduced ratio outputRate / inputRate = interpolation / decimation
+    unsigned int interpolation;
+    unsigned int decimation;
+    unsigned int channels;
+    unsigned int filterLength;
+    unsigned int maximumInputFrames;
+    FormatConverter::InstructionSet instructionSet;
+    DotProduct dotProduct;
+    //the coefficients of all phases, filterLength per phase
+    std::vector<float> coefficients;
+    //the planar history of every channel, filterLength + maximumInputFrames samples per channel
+    std::vector<float> history;
+    //the number of valid samples per channel in the history
+    unsigned int historySize;
+    //the index of the first history-sample of the next output-frame
+    unsigned int position;
+    //the phase of the next output-frame
+    unsigned int phase;
+
+    void designFilter(const Quality quality);
+};
+
+#endif	/* RESAMPLER_H */
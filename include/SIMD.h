@@ -0,0 +1,44 @@
+#ifndef SIMD_H
+#define	SIMD_H
+
+/*
+ * Common definitions for the vectorized (SSE2, AVX2 or NEON) kernels.
+ *
+ * On x86, the kernels for all instruction-sets are compiled into the same binary and their use is decided at runtime,
+ * so the compiler must be allowed to generate the extended instructions for the marked functions only.
+ * On AArch64, NEON is mandatory and always used.
+ */
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SIMD_X86 1
+#include <emmintrin.h>  //SSE2
+#include <immintrin.h>  //AVX2
+#ifdef _MSC_VER
+#define SIMD_TARGET_SSE2
+#define SIMD_TARGET_AVX2
+#else
+//compile the vectorized functions for the extended instruction-sets, their use is decided at runtime
+#define SIMD_TARGET_SSE2 __attribute__((target("sse2")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__)
+//NEON is mandatory for ARMv8 (AArch64)
+#define SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+/*!
+ * The CPU is only queried on the first call, since querying is expensive (especially in virtual machines)
+ *
+ * \return whether the CPU supports SSE2, always false on other architectures than x86
+ */
+bool cpuSupportsSSE2();
+
+/*!
+ * The CPU is only queried on the first call, since querying is expensive (especially in virtual machines)
+ *
+ * \return whether the CPU and the operating system support AVX2, always false on other architectures than x86
+ */
+bool cpuSupportsAVX2();
+
+#endif	/* SIMD_H */
@@ -0,0 +1,171 @@
+#ifndef SRTPCONTEXT_H
+#define	SRTPCONTEXT_H
+
+#include "RTPPackageHandler.h"
+#include "AESGCM.h"
+
+/*!
+ * Size of the SRTP master-key in bytes
+ */
+static const unsigned int SRTP_MASTER_KEY_SIZE = AESGCM::KEY_SIZE;
+
+/*!
+ * Size of the SRTP master-salt in bytes
+ */
+static const unsigned int SRTP_MASTER_SALT_SIZE = 12;
+
+/*!
+ * Size of the authentication-tag appended to every SRTP-package in bytes
+ */
+static const unsigned int SRTP_AUTH_TAG_SIZE = AESGCM::TAG_SIZE;
+
+/*!
+ * Cryptographic context for SRTP (RFC 3711) using AEAD_AES_128_GCM as specified in RFC 7714.
+ *
+ * The payload of a package is encrypted in-place and the authentication-tag is appended directly after the payload,
+ * so the package-buffer needs to hold SRTP_AUTH_TAG_SIZE additional bytes. The RTP-header (including CSRCs and header-extension)
+ * is authenticated, but not encrypted.
+ *
+ * The 12 byte IV of every package is derived from the SSRC, the rollover-counter (ROC) and the sequence number:
+ *
+ *  0  0  0  0  0  0  0  0  0  0  1  1
+ *  0  1  2  3  4  5  6  7  8  9  0  1
+ * +--+--+--+--+--+--+--+--+--+--+--+--+
+ * |00|00|    SSRC   |     ROC   | SEQ |---+
+ * +--+--+--+--+--+--+--+--+--+--+--+--+   |
+ *                                         |
+ * +--+--+--+--+--+--+--+--+--+--+--+--+   |
+ * |         session salt              |--XOR
+ * +--+--+--+--+--+--+--+--+--+--+--+--+   |
+ *                                         |
+ * +--+--+--+--+--+--+--+--+--+--+--+--+   |
+ * |         initialization vector     |<--+
+ * +--+--+--+--+--+--+--+--+--+--+--+--+
+ *
+ * The session-key and session-salt are derived from the master-key and master-salt with the AES-CM key-derivation
+ * of RFC 3711 (section 4.3.3) and a key-derivation-rate of zero.
+ *
+ * Since the IV must never repeat for the same key, every stream (SSRC) must use its own sequence numbers
+ * and both directions of a communication should use different master-keys. Streams sharing the SSRC with separate
+ * sequence numbers (like the FEC-packages of ProcessorRTP) require their own master-key.
+ */
+class SRTPContext
+{
+public:
+    /*!
+     * \param masterKey The SRTP_MASTER_KEY_SIZE bytes of the master-key
+     *
+     * \param masterSalt The SRTP_MASTER_SALT_SIZE bytes of the master-salt
+     *
+     * \param useHardwareAcceleration Whether to use the AES-NI/PCLMULQDQ instructions, if available
+     */
+    SRTPContext(const uint8_t* masterKey, const uint8_t* masterSalt, const bool useHardwareAcceleration = true);
+
+    /*!
+     * Creates a context from the already derived session-key and -salt, e.g. to verify the test-vectors of RFC 7714
+     *
+     * \param sessionKey The AESGCM::KEY_SIZE bytes of the session-key
+     *
+     * \param sessionSalt The AESGCM::IV_SIZE bytes of the session-salt
+     *
+     * \param useHardwareAcceleration Whether to use the AES-NI/PCLMULQDQ instructions, if available
+     */
+    static SRTPContext fromSessionKeys(const uint8_t* sessionKey, const uint8_t* sessionSalt, const bool useHardwareAcceleration = true);
+
+    /*!
+     * Encrypts the payload of the RTP-package in-place and appends the authentication-tag
+     *
+     * \param package The buffer holding the RTP-package
+     *
+     * \param packageSize The size of the RTP-package in bytes, is increased by SRTP_AUTH_TAG_SIZE
+     *
+     * \param maximumPackageSize The size of the package-buffer in bytes
+     *
+     * \param rolloverCounter The number of times, the 16 bit sequence number of this stream wrapped around
+     *
+     * \return whether the package was protected, false if the package is malformed or the buffer too small for the tag
+     */
+    bool protect(void* package, unsigned int& packageSize, const unsigned int maximumPackageSize, const uint32_t rolloverCounter) const;
+
+    /*!
+     * Protects the RTP-package stored in the work-buffer of the given RTPPackageHandler
+     */
+    bool protect(RTPPackageHandler& package, unsigned int& packageSize, const uint32_t rolloverCounter) const;
+
+    /*!
+     * Verifies the authentication-tag and decrypts the payload of the SRTP-package in-place
+     *
+     * \param package The buffer holding the SRTP-package
+     *
+     * \param packageSize The size of the SRTP-package in bytes, is decreased by SRTP_AUTH_TAG_SIZE
+     *
+     * \param rolloverCounter The estimated rollover-counter of the stream, see #estimatePackageIndex()
+     *
+     * \return whether the package is authentic. If not, the package must be discarded
+     */
+    bool unprotect(void* package, unsigned int& packageSize, const uint32_t rolloverCounter) const;
+
+    /*!
+     * Unprotects the SRTP-package stored in the work-buffer of the given RTPPackageHandler
+     */
+    bool unprotect(RTPPackageHandler& package, unsigned int& packageSize, const uint32_t rolloverCounter) const;
+
+    /*!
+     * \return whether the AES-NI/PCLMULQDQ instructions are used
+     */
+    bool isHardwareAccelerated() const;
+
+    /*!
+     * Estimates the 32 bit package-index (rollover-counter and sequence number) of a received package,
+     * as specified in RFC 3711 (section 3.3.1 and appendix A)
+     *
+     * \param highestIndex The highest package-index received so far
+     *
+     * \param sequenceNumber The sequence number of the received package
+     *
+     * \return the estimated package-index, the upper 16 bits are the rollover-counter
+     */
+    static uint32_t estimatePackageIndex(const uint32_t highestIndex, const uint16_t sequenceNumber);
+
+    /*!
+     * The AES-CM pseudo-random function of the SRTP key-derivation (RFC 3711, section 4.3.3) with a key-derivation-rate of zero
+     *
+     * \param masterKey The SRTP_MASTER_KEY_SIZE bytes of the master-key
+     *
+     * \param masterSalt The master-salt, aligned to the first byte of the 112 bit salt-field
+     *
+     * \param masterSaltSize The size of the master-salt in bytes, 12 for AEAD_AES_128_GCM and at most 14
+     *
+     * \param label The label of the derived key, 0x00 for the encryption-key and 0x02 for the salt
+     *
+     * \param output The buffer to write the derived key into
+     *
+     * \param outputSize The number of bytes to derive, at most 16
+     */
+    static void deriveKey(const uint8_t* masterKey, const uint8_t* masterSalt, const unsigned int masterSaltSize, const uint8_t label,
+                          uint8_t* output, const unsigned int outputSize);
+
+private:
+    uint8_t sessionKey[AESGCM::KEY_SIZE];
+    uint8_t sessionSalt[AESGCM::IV_SIZE];
+    const AESGCM cipher;
+
+    //the last argument only distinguishes this constructor from the one taking the master-keys
+    SRTPContext(const uint8_t* sessionKey, const uint8_t* sessionSalt, const bool useHardwareAcceleration, const bool);
+
+    /*!
+     * Derives the session-key and -salt from the master-key and -salt
+     *
+     * \return the session-key
+     */
+    static const uint8_t* deriveSessionKeys(const uint8_t* masterKey, const uint8_t* masterSalt, uint8_t* sessionKey, uint8_t* sessionSalt);
+
+    /*!
+     * \return the size of the RTP-header including CSRCs and header-extension, or zero if the package is malformed
+     */
+    static unsigned int getHeaderSize(const uint8_t* package, const unsigned int packageSize);
+
+    void createIV(const uint8_t* package, const uint32_t rolloverCounter, uint8_t* iv) const;
+};
+
+#endif	/* SRTPCONTEXT_H */
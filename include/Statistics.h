@@ -11,10 +11,17 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <array>
+#include <atomic>
 
 #include "ProfilingAudioProcessor.h"
+#include "LatencyHistogram.h"
 /*!
  * Class to collect and print statistical information
+ *
+ * The counters are updated from several threads (e.g. the audio-thread and the RTPListener), so every thread increments
+ * its own shard of the counters with relaxed atomic operations. The shards are aligned to cache-lines, so the threads neither
+ * contend for a lock nor for a cache-line. Reading a counter sums up all shards.
  */
 class Statistics
 {
@@ -36,6 +43,28 @@ public:
     static const int TOTAL_ELAPSED_MILLISECONDS{13};
     static const int RTP_BUFFER_MAXIMUM_USAGE{14};
     static const int RTP_BUFFER_LIMIT{15};
+    static const int COUNTER_PACKAGES_RECOVERED{16};
+    static const int COUNTER_BUFFERS_SUPPRESSED{17};
+    static const int NUMBER_OF_COUNTERS{20};
+
+    //the components of the end-to-end (mouth-to-ear) latency of the received audio,
+    //measured with the capture-times sent in the RTP header-extension (see PackageTiming)
+    //capturing, encoding and packetization on the remote device, as reported in the header-extension
+    static const int LATENCY_SENDING{0};
+    //from sending the package on the remote device to its reception, requires synchronized clocks
+    static const int LATENCY_NETWORK{1};
+    //the time a package is held in the jitter-buffer
+    static const int LATENCY_JITTER_BUFFER{2};
+    //from reading the package out of the jitter-buffer to its playback by the sound-device
+    static const int LATENCY_OUTPUT{3};
+    //from capturing the first sample on the remote device to its playback, requires synchronized clocks
+    static const int LATENCY_MOUTH_TO_EAR{4};
+    static const int NUMBER_OF_LATENCIES{5};
+
+    /*!
+     * The values of all counters at one point in time, indexed by the counter-keys
+     */
+    typedef std::array<long, NUMBER_OF_COUNTERS> CounterSnapshot;
 
     /*!
      * Increments the given counter by the value provided
@@ -47,7 +76,8 @@ public:
     static void incrementCounter(int counterIndex, long byValue = 1);
 
     /*!
-     * Sets the given counter to the value provided
+     * Sets the given counter to the value provided.
+     * Must not be called concurrently with other updates of the same counter
      *
      * \param counterIndex The key to the counter
      *
@@ -73,6 +103,39 @@ public:
      */
     static long readCounter(int counterIndex);
 
+    /*!
+     * Reads all counters, e.g. to display live statistics while running.
+     *
+     * Every value is the sum of all increments made before the snapshot was taken, but the counters are read one after another,
+     * so counters updated while taking the snapshot may be off by the updates of the last few packages
+     *
+     * \return The current values of all counters
+     */
+    static CounterSnapshot takeSnapshot();
+
+    /*!
+     * Sets all counters to zero and removes all recorded latencies, e.g. before starting a new session.
+     * Must not be called concurrently with updates of the counters
+     */
+    static void resetCounters();
+
+    /*!
+     * Records a component of the end-to-end latency for a single package.
+     * Every latency must only be recorded from a single thread (see LatencyHistogram)
+     *
+     * \param latencyIndex The key of the latency-component
+     *
+     * \param nanoseconds The duration to record in nanoseconds
+     */
+    static void recordLatency(int latencyIndex, uint64_t nanoseconds);
+
+    /*!
+     * \param latencyIndex The key of the latency-component
+     *
+     * \return the histogram of all recorded durations for the given latency-component
+     */
+    static const LatencyHistogram& getLatency(int latencyIndex);
+
     /*!
      * Prints some general statistical information to stdout
      */
@@ -103,8 +166,25 @@ public:
     static void removeAllProfilers();
 
 private:
+    //the number of shards, more threads share the shards
+    static const unsigned int NUMBER_OF_SHARDS = 8;
+
+    /*!
+     * The counters updated by a single thread, aligned to a cache-line, so no two threads write to the same cache-line
+     */
+    struct alignas(64) CounterShard
+    {
+        std::atomic<long> counters[NUMBER_OF_COUNTERS];
+    };
 
-    static long counters[20];
+    static CounterShard shards[NUMBER_OF_SHARDS];
+
+    static LatencyHistogram latencies[NUMBER_OF_LATENCIES];
+
+    /*!
+     * \return the shard of the calling thread
+     */
+    static CounterShard& getShard();
 
     static double prettifyPercentage(double percentage);
 
@@ -120,6 +200,14 @@ private:
      * Internal helper-method to print audio-processor profiling results to given output-stream
      */
     static void printAudioProcessorStatistic(std::ostream& outputStream);
+    /*!
+     * Internal helper-method to print the percentiles of the processing-times of one direction
+     */
+    static void printLatencies(std::ostream& outputStream, const std::string& direction, const LatencyHistogram& histogram);
+    /*!
+     * Internal helper-method to print the percentiles of a component of the end-to-end latency
+     */
+    static void printEndToEndLatency(std::ostream& outputStream, const std::string& component, const LatencyHistogram& histogram);
 };
 
 
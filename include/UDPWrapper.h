@@ -4,14 +4,34 @@
 #include "configuration.h"
 #include "NetworkWrapper.h"
 #include <string.h> //for strerror
+#include <stdexcept>
 
 /*!
  * NetworkWrapper implementation using the UDP protocol
+ *
+ * If the remote address is an IPv4 or IPv6 multicast address, packages are sent to the multicast group
+ * and the group is joined to receive the packages sent to it.
  */
 class UDPWrapper : public NetworkWrapper
 {
 public:
-    UDPWrapper(unsigned short portIncoming, const std::string remoteIPAddress, unsigned short portOutgoing);
+    /*!
+     * \param portIncoming The local port to listen on
+     *
+     * \param remoteIPAddress The address to send to, may be a multicast group
+     *
+     * \param portOutgoing The remote port to send to
+     *
+     * \param multicastTTL The time-to-live for packages sent to a multicast group, zero uses the system default
+     *
+     * \param multicastLoopback Whether packages sent to a multicast group are also received locally
+     *
+     * \param multicastSourceAddress The only source to receive multicast packages from, empty for any source
+     *
+     * \throw a runtime-error, if the remote address is a multicast group, which could not be joined
+     */
+    UDPWrapper(unsigned short portIncoming, const std::string remoteIPAddress, unsigned short portOutgoing,
+               unsigned char multicastTTL = 0, bool multicastLoopback = false, const std::string multicastSourceAddress = "");
 
     UDPWrapper(const NetworkConfiguration& networkConfig);
 
@@ -24,6 +44,7 @@ public:
     std::wstring getLastError() const;
 private:
     bool isIPv6;
+    bool isMulticast;
     int Socket;
     //we define a union of an IPv4 and an IPv6 address
     //because the two addresses have different size(16 bytes and 24 bytes) and therefore we can guarantee to hold enough space
@@ -43,6 +64,13 @@ private:
     void initializeNetwork();
 
     void initializeNetworkConfig(unsigned short localPort, const std::string remoteIPAddress, unsigned short remotePort);
+
+    /*!
+     * Sets the multicast options for sending and joins the multicast group of the remote address
+     *
+     * \return whether the multicast group was joined
+     */
+    bool initializeMulticast(unsigned char multicastTTL, bool multicastLoopback, const std::string multicastSourceAddress);
     
     /*!
      * \returns the size of the socket-address depending on the IP-version used
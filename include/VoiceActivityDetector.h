@@ -0,0 +1,107 @@
+#ifndef VOICEACTIVITYDETECTOR_H
+#define	VOICEACTIVITYDETECTOR_H
+
+#include <stdint.h>
+
+#include "FormatConverter.h"
+
+/*!
+ * Lightweight voice activity detection (VAD) for interleaved 16 bit integer or 32 bit float samples.
+ *
+ * Every buffer is classified by three features, which are computed in a single (vectorized) pass over the samples:
+ * - the mean power relative to full-scale
+ * - the normalized autocorrelation of adjacent samples, which is high for voiced speech (dominated by low frequencies)
+ *   and close to zero for white noise
+ * - the zero-crossing rate, which is low for voiced and high for unvoiced speech and noise
+ *
+ * The power of the background noise is tracked by following the minima of the power quickly and rising slowly.
+ * A buffer contains speech, if its power exceeds the noise-floor by the threshold, or by half the threshold for voiced (highly correlated) buffers.
+ * After speech, buffers are still classified as speech for a short hangover, so the end of words is not cut off.
+ */
+class VoiceActivityDetector
+{
+public:
+
+    struct Features
+    {
+        //the mean power relative to full-scale
+        float power;
+        //the autocorrelation of adjacent samples (of the same channel) normalized by the power, in the range [-1, 1]
+        float correlation;
+        //the ratio of adjacent samples with different signs
+        float zeroCrossingRate;
+    };
+
+    /*!
+     * \param sampleRate The sample-rate in Hz
+     *
+     * \param channels The number of interleaved channels
+     *
+     * \param threshold The power in dB above the noise-floor at which audio is considered speech
+     *
+     * \param instructionSet The instruction-set to use, is reduced to the instruction-set supported by the CPU
+     */
+    VoiceActivityDetector(const unsigned int sampleRate, const unsigned int channels, const float threshold,
+                          const FormatConverter::InstructionSet instructionSet = FormatConverter::getSupportedInstructionSet());
+
+    /*!
+     * Classifies the samples and updates the noise-floor
+     *
+     * \param samples The 16 bit PCM samples
+     *
+     * \param numberOfFrames The number of frames (samples per channel)
+     *
+     * \return whether the samples contain speech
+     */
+    bool isSpeech(const int16_t* samples, const unsigned int numberOfFrames);
+
+    /*!
+     * Classifies the 32 bit float samples and updates the noise-floor
+     */
+    bool isSpeech(const float* samples, const unsigned int numberOfFrames);
+
+    /*!
+     * \return the features of the samples
+     */
+    Features calculateFeatures(const int16_t* samples, const unsigned int numberOfFrames) const;
+
+    /*!
+     * \return the features of the 32 bit float samples
+     */
+    Features calculateFeatures(const float* samples, const unsigned int numberOfFrames) const;
+
+    /*!
+     * \return the current estimate of the noise-floor in dB relative to full-scale
+     */
+    float getNoiseFloor() const;
+
+    FormatConverter::InstructionSet getInstructionSet() const;
+
+private:
+    //the sums over all samples, accumulated by the (vectorized) kernels
+    struct Sums
+    {
+        float squares;
+        float products;
+        unsigned int zeroCrossings;
+    };
+    typedef Sums (*Int16Kernel)(const int16_t* samples, const unsigned int numberOfSamples, const unsigned int lag);
+    typedef Sums (*FloatKernel)(const float* samples, const unsigned int numberOfSamples, const unsigned int lag);
+
+    const unsigned int sampleRate;
+    const unsigned int channels;
+    const float threshold;
+    FormatConverter::InstructionSet instructionSet;
+    Int16Kernel int16Kernel;
+    FloatKernel floatKernel;
+    float noiseFloor;
+    //the number of frames the hangover lasts
+    unsigned int hangoverFrames;
+    //the number of frames since the last buffer detected as speech
+    unsigned int framesSinceSpeech;
+
+    Features toFeatures(const Sums& sums, const unsigned int numberOfFrames) const;
+    bool classify(const Features& features, const unsigned int numberOfFrames);
+};
+
+#endif	/* VOICEACTIVITYDETECTOR_H */
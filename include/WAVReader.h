@@ -0,0 +1,76 @@
+#ifndef WAVREADER_H
+#define	WAVREADER_H
+
+#include <stdint.h>
+#include <string>
+
+#include "configuration.h"
+
+/*!
+ * Read-only access to the samples of a WAV-file, which is mapped into memory instead of being read,
+ * so even long files are available without copying and the operating system reads ahead as the samples are accessed.
+ *
+ * Supports PCM (8 to 32 bit) and IEEE float (32 and 64 bit) samples, also with the WAVE_FORMAT_EXTENSIBLE header.
+ * The samples are accessed as stored in the file, i.e. 8 bit samples are unsigned.
+ */
+class WAVReader
+{
+public:
+    /*!
+     * Maps the file into memory and parses the header
+     *
+     * \param fileName The name of the WAV-file
+     */
+    WAVReader(const std::string& fileName);
+
+    ~WAVReader();
+
+    /*!
+     * \return whether the file was mapped and contains supported audio-data
+     */
+    bool isOpen() const;
+
+    AudioFormat getAudioFormat() const;
+
+    unsigned int getSampleRate() const;
+
+    unsigned int getChannels() const;
+
+    /*!
+     * \return the interleaved samples of the data-chunk
+     */
+    const uint8_t* getData() const;
+
+    /*!
+     * \return the size of the audio-data in bytes, a multiple of the size of an audio-frame
+     */
+    uint64_t getDataSize() const;
+
+    /*!
+     * \return the number of audio-frames (samples per channel)
+     */
+    uint64_t getNumberOfFrames() const;
+
+private:
+    const uint8_t* mapping;
+    uint64_t mappingSize;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+    AudioFormat format;
+    unsigned int sampleRate;
+    unsigned int channels;
+    const uint8_t* data;
+    uint64_t dataSize;
+
+    bool mapFile(const std::string& fileName);
+    void unmapFile();
+
+    /*!
+     * Reads the fmt- and locates the data-chunk
+     */
+    bool parseHeader();
+};
+
+#endif	/* WAVREADER_H */
@@ -0,0 +1,135 @@
+#ifndef WAVWRITER_H
+#define	WAVWRITER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#include "configuration.h"
+#include "AudioRingBuffer.h"
+
+/*!
+ * Writes audio into a WAV-file without blocking the real-time audio-thread.
+ *
+ * The audio-thread only copies the samples into a preallocated lock-free AudioRingBuffer,
+ * a background thread writes the buffered samples with large sequential writes into the file.
+ * On Linux, the disk-space is allocated in advance (fallocate) in steps of several seconds of audio.
+ *
+ * All AudioFormats, sample-rates and numbers of channels are supported. Formats with more than 16 bit or more than two channels
+ * are written with the WAVE_FORMAT_EXTENSIBLE header, 8 bit samples are converted to unsigned, as required by the WAV-format.
+ *
+ * The sizes in the header are updated after every write, so the file stays valid (missing at most the last write)
+ * if the application crashes.
+ */
+class WAVWriter
+{
+public:
+    /*!
+     * Opens the file and starts the writing thread
+     *
+     * \param fileName The name of the WAV-file to create
+     *
+     * \param format The format of the samples
+     *
+     * \param sampleRate The sample-rate in Hz
+     *
+     * \param channels The number of interleaved channels
+     *
+     * \param bufferDuration The duration of audio in ms, the ring-buffer can hold until the data is written into the file
+     */
+    WAVWriter(const std::string& fileName, const AudioFormat format, const unsigned int sampleRate, const unsigned int channels,
+              const unsigned int bufferDuration = 2000);
+
+    /*!
+     * Writes the remaining samples and closes the file
+     */
+    ~WAVWriter();
+
+    /*!
+     * \return whether the file was opened successfully
+     */
+    bool isOpen() const;
+
+    /*!
+     * Queues the samples for writing into the file. Does not block, so it can be called from the real-time audio-thread.
+     * Must only be called from a single thread
+     *
+     * \param samples The interleaved samples
+     *
+     * \param size The size in bytes
+     *
+     * \return whether the samples were queued, false if the file is not open or the ring-buffer is full
+     */
+    bool write(const void* samples, const unsigned int size);
+
+    /*!
+     * Queues the given number of silent audio-frames for writing into the file, e.g. for a silent package without audio-data.
+     * Does not block, so it can be called from the real-time audio-thread. Must only be called from the thread calling write()
+     *
+     * \param numberOfFrames The number of audio-frames (a sample of all channels) of silence
+     *
+     * \return whether the silence was queued, false if the file is not open or the ring-buffer is full
+     */
+    bool writeSilence(const unsigned int numberOfFrames);
+
+    /*!
+     * Writes all queued samples into the file, stops the writing thread and closes the file
+     */
+    void close();
+
+    /*!
+     * \return the number of bytes of audio-data written into the file
+     */
+    uint64_t getWrittenBytes() const;
+
+    /*!
+     * \return the number of bytes, which were dropped, because the ring-buffer was full
+     */
+    uint64_t getDroppedBytes() const;
+
+private:
+    //the largest block written at once
+    static const unsigned int MAXIMUM_WRITE_SIZE = 256 * 1024;
+    //the interval the writing thread checks the ring-buffer for new samples in ms
+    static const unsigned int WRITE_INTERVAL = 20;
+    //the duration of audio in s, the disk-space is allocated for in advance
+    static const unsigned int PREALLOCATION_DURATION = 10;
+
+    FILE* file;
+    const AudioFormat format;
+    //the size of an audio-frame (a sample of all channels) in bytes
+    const unsigned int frameSize;
+    const unsigned int bytesPerSecond;
+    //the position of the size-field of the data-chunk
+    unsigned int dataSizeOffset;
+    AudioRingBuffer ringBuffer;
+    //the block the writing thread reads from the ring-buffer into
+    std::vector<char> writeBuffer;
+    std::atomic<uint64_t> writtenBytes;
+    std::atomic<uint64_t> droppedBytes;
+    uint64_t preallocatedBytes;
+    std::atomic<bool> threadRunning;
+    std::thread writeThread;
+
+    bool writeHeader(const unsigned int sampleRate, const unsigned int channels);
+
+    /*!
+     * Sets the sizes of the RIFF- and the data-chunk to the audio written so far
+     */
+    void updateHeader();
+
+    /*!
+     * Writes all samples in the ring-buffer into the file
+     */
+    void writeBufferedSamples();
+
+    /*!
+     * Method called in the parallel thread, writing the buffered samples into the file
+     */
+    void runThread();
+};
+
+#endif	/* WAVWRITER_H */
@@ -25,6 +25,12 @@ struct NetworkConfiguration
     std::string remoteIPAddress;
     //Remote port
     unsigned short remotePort;
+    //Time-to-live (maximum number of hops) for packages sent to a multicast remote address, zero uses the system default of 1
+    unsigned char multicastTTL;
+    //Whether packages sent to a multicast remote address are also received by the local device
+    bool multicastLoopback;
+    //Only receive multicast packages from this source address (source-specific multicast), empty to receive from all sources
+    std::string multicastSourceAddress;
 };
 
 enum class AudioFormat 
@@ -33,10 +39,30 @@ enum class AudioFormat
 	SIGNED_INT_16 = 2,
 	SIGNED_INT_24 = 3,
 	SIGNED_INT_32 = 4,
-	FLOAT_32 = 4,
+	FLOAT_32 = 5,
 	FLOAT_64 = 6
 };
 
+/*!
+ * \return the size of a single sample of the given format in bytes
+ */
+inline unsigned int getAudioFormatSize(const AudioFormat format)
+{
+    switch(format)
+    {
+        case AudioFormat::SIGNED_INT_8:
+            return 1;
+        case AudioFormat::SIGNED_INT_16:
+            return 2;
+        case AudioFormat::SIGNED_INT_24:
+            return 3;
+        case AudioFormat::FLOAT_64:
+            return 8;
+        default:
+            return 4;
+    }
+}
+
 enum class BufferSizes
 {
 	BUFFER_64 = 64,
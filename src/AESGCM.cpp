@@ -0,0 +1,552 @@
+#include "AESGCM.h"
+
+#include <string.h> //memcpy, memset
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define AESGCM_X86 1
+#include <wmmintrin.h>  //AES-NI, PCLMULQDQ
+#include <tmmintrin.h>  //SSSE3 byte-shuffle
+#ifdef _MSC_VER
+#include <intrin.h>
+#define AESGCM_TARGET
+#else
+#include <cpuid.h>
+//compile the accelerated functions for the extended instruction-set, their use is decided at runtime
+#define AESGCM_TARGET __attribute__((target("aes,pclmul,ssse3")))
+#endif
+#endif
+
+static const uint8_t SBOX[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+//reduction-values for the 4-bit table-based GHASH
+static const uint64_t LAST4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+static inline uint8_t xtime(const uint8_t value)
+{
+    return (uint8_t)((value << 1) ^ ((value & 0x80) ? 0x1b : 0x00));
+}
+
+static inline uint32_t load32(const uint8_t* bytes)
+{
+    return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 8) | bytes[3];
+}
+
+static inline void store32(uint8_t* bytes, const uint32_t value)
+{
+    bytes[0] = (uint8_t)(value >> 24);
+    bytes[1] = (uint8_t)(value >> 16);
+    bytes[2] = (uint8_t)(value >> 8);
+    bytes[3] = (uint8_t)value;
+}
+
+static inline uint64_t load64(const uint8_t* bytes)
+{
+    return ((uint64_t)load32(bytes) << 32) | load32(bytes + 4);
+}
+
+static inline void store64(uint8_t* bytes, const uint64_t value)
+{
+    store32(bytes, (uint32_t)(value >> 32));
+    store32(bytes + 4, (uint32_t)value);
+}
+
+//increments the lower 32 bits of the counter-block, as specified for GCM
+static inline void incrementCounter(uint8_t* counterBlock)
+{
+    store32(counterBlock + 12, load32(counterBlock + 12) + 1);
+}
+
+/*!
+ * The combined SubBytes/ShiftRows/MixColumns lookup-tables of the software AES-implementation
+ */
+struct AESTables
+{
+    uint32_t te[4][256];
+
+    AESTables()
+    {
+        for(unsigned int i = 0; i < 256; i++)
+        {
+            const uint8_t s = SBOX[i];
+            const uint8_t s2 = xtime(s);
+            const uint8_t s3 = s2 ^ s;
+            const uint32_t t = ((uint32_t)s2 << 24) | ((uint32_t)s << 16) | ((uint32_t)s << 8) | s3;
+            te[0][i] = t;
+            te[1][i] = (t >> 8) | (t << 24);
+            te[2][i] = (t >> 16) | (t << 16);
+            te[3][i] = (t >> 24) | (t << 8);
+        }
+    }
+};
+
+static const AESTables& getTables()
+{
+    static const AESTables tables;
+    return tables;
+}
+
+#ifdef AESGCM_X86
+AESGCM_TARGET static inline __m128i byteSwap(const __m128i value)
+{
+    return _mm_shuffle_epi8(value, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+AESGCM_TARGET static inline __m128i encryptBlockHardware(__m128i block, const __m128i* roundKeys)
+{
+    block = _mm_xor_si128(block, _mm_loadu_si128(roundKeys));
+    for(unsigned int i = 1; i < 10; i++)
+    {
+        block = _mm_aesenc_si128(block, _mm_loadu_si128(roundKeys + i));
+    }
+    return _mm_aesenclast_si128(block, _mm_loadu_si128(roundKeys + 10));
+}
+
+/*
+ * Carry-less multiplication of two byte-reflected field-elements without reduction, the 256 bit product is returned in low and high
+ */
+AESGCM_TARGET static inline void multiplyUnreduced(const __m128i a, const __m128i b, __m128i& low, __m128i& high)
+{
+    const __m128i middle = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    low = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x00), _mm_slli_si128(middle, 8));
+    high = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x11), _mm_srli_si128(middle, 8));
+}
+
+/*
+ * Reduces the 256 bit product of two byte-reflected field-elements modulo the GCM-polynomial,
+ * see "Intel Carry-Less Multiplication Instruction and its Usage for Computing the GCM Mode" (Gueron, Kounavis)
+ */
+AESGCM_TARGET static inline __m128i reduce(__m128i low, __m128i high)
+{
+    //shift the 256 bit product left by one, since the operands are bit-reflected
+    __m128i carryLow = _mm_srli_epi32(low, 31);
+    __m128i carryHigh = _mm_srli_epi32(high, 31);
+    low = _mm_slli_epi32(low, 1);
+    high = _mm_slli_epi32(high, 1);
+    const __m128i carryOver = _mm_srli_si128(carryLow, 12);
+    carryHigh = _mm_slli_si128(carryHigh, 4);
+    carryLow = _mm_slli_si128(carryLow, 4);
+    low = _mm_or_si128(low, carryLow);
+    high = _mm_or_si128(high, carryHigh);
+    high = _mm_or_si128(high, carryOver);
+
+    //reduce modulo x^128 + x^7 + x^2 + x + 1
+    __m128i reduction = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(low, 31), _mm_slli_epi32(low, 30)), _mm_slli_epi32(low, 25));
+    const __m128i reductionHigh = _mm_srli_si128(reduction, 4);
+    reduction = _mm_slli_si128(reduction, 12);
+    low = _mm_xor_si128(low, reduction);
+    __m128i result = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(low, 1), _mm_srli_epi32(low, 2)), _mm_srli_epi32(low, 7));
+    result = _mm_xor_si128(result, reductionHigh);
+    low = _mm_xor_si128(low, result);
+    return _mm_xor_si128(high, low);
+}
+
+AESGCM_TARGET static inline __m128i multiplyHardware(const __m128i a, const __m128i b)
+{
+    __m128i low, high;
+    multiplyUnreduced(a, b, low, high);
+    return reduce(low, high);
+}
+
+AESGCM_TARGET static void calculateHashKeyPowers(const uint8_t* hashKeyBytes, uint8_t* hashKeyPowers)
+{
+    const __m128i hashKey = byteSwap(_mm_loadu_si128((const __m128i*)hashKeyBytes));
+    __m128i power = hashKey;
+    for(unsigned int i = 0; i < 4; i++)
+    {
+        _mm_storeu_si128((__m128i*)(hashKeyPowers + i * 16), power);
+        power = multiplyHardware(power, hashKey);
+    }
+}
+
+AESGCM_TARGET static __m128i ghashHardware(__m128i hash, const uint8_t* hashKeyPowers, const uint8_t* data, const unsigned int dataSize)
+{
+    const __m128i hashKey = _mm_loadu_si128((const __m128i*)hashKeyPowers);
+    const __m128i hashKey2 = _mm_loadu_si128((const __m128i*)(hashKeyPowers + 16));
+    const __m128i hashKey3 = _mm_loadu_si128((const __m128i*)(hashKeyPowers + 32));
+    const __m128i hashKey4 = _mm_loadu_si128((const __m128i*)(hashKeyPowers + 48));
+    unsigned int offset = 0;
+    //hash four blocks at once: X' = (X + C1) * H^4 + C2 * H^3 + C3 * H^2 + C4 * H,
+    //so the multiplications are independent of each other and only the sum needs to be reduced
+    for(; offset + 64 <= dataSize; offset += 64)
+    {
+        const __m128i* blocks = (const __m128i*)(data + offset);
+        __m128i low, high, productLow, productHigh;
+        multiplyUnreduced(_mm_xor_si128(hash, byteSwap(_mm_loadu_si128(blocks))), hashKey4, low, high);
+        multiplyUnreduced(byteSwap(_mm_loadu_si128(blocks + 1)), hashKey3, productLow, productHigh);
+        low = _mm_xor_si128(low, productLow);
+        high = _mm_xor_si128(high, productHigh);
+        multiplyUnreduced(byteSwap(_mm_loadu_si128(blocks + 2)), hashKey2, productLow, productHigh);
+        low = _mm_xor_si128(low, productLow);
+        high = _mm_xor_si128(high, productHigh);
+        multiplyUnreduced(byteSwap(_mm_loadu_si128(blocks + 3)), hashKey, productLow, productHigh);
+        low = _mm_xor_si128(low, productLow);
+        high = _mm_xor_si128(high, productHigh);
+        hash = reduce(low, high);
+    }
+    for(; offset + 16 <= dataSize; offset += 16)
+    {
+        hash = multiplyHardware(_mm_xor_si128(hash, byteSwap(_mm_loadu_si128((const __m128i*)(data + offset)))), hashKey);
+    }
+    if(offset < dataSize)
+    {
+        //the last block is padded with zeroes
+        uint8_t lastBlock[16] = {0};
+        memcpy(lastBlock, data + offset, dataSize - offset);
+        hash = multiplyHardware(_mm_xor_si128(hash, byteSwap(_mm_loadu_si128((const __m128i*)lastBlock))), hashKey);
+    }
+    return hash;
+}
+
+AESGCM_TARGET static void ctrHardware(const uint8_t* roundKeys, const uint8_t* counterBlock, uint8_t* data, const unsigned int dataSize)
+{
+    const __m128i* keys = (const __m128i*)roundKeys;
+    //keep the counter byte-swapped, so the big-endian 32 bit counter is in the lowest lane
+    __m128i counter = byteSwap(_mm_loadu_si128((const __m128i*)counterBlock));
+    const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+    unsigned int offset = 0;
+    //encrypt four blocks at once to hide the latency of the AES-instructions
+    for(; offset + 64 <= dataSize; offset += 64)
+    {
+        __m128i blocks[4];
+        for(unsigned int i = 0; i < 4; i++)
+        {
+            counter = _mm_add_epi32(counter, one);
+            blocks[i] = _mm_xor_si128(byteSwap(counter), _mm_loadu_si128(keys));
+        }
+        for(unsigned int round = 1; round < 10; round++)
+        {
+            const __m128i key = _mm_loadu_si128(keys + round);
+            for(unsigned int i = 0; i < 4; i++)
+            {
+                blocks[i] = _mm_aesenc_si128(blocks[i], key);
+            }
+        }
+        for(unsigned int i = 0; i < 4; i++)
+        {
+            __m128i* chunk = (__m128i*)(data + offset + i * 16);
+            const __m128i keyStream = _mm_aesenclast_si128(blocks[i], _mm_loadu_si128(keys + 10));
+            _mm_storeu_si128(chunk, _mm_xor_si128(_mm_loadu_si128(chunk), keyStream));
+        }
+    }
+    for(; offset < dataSize; offset += 16)
+    {
+        counter = _mm_add_epi32(counter, one);
+        const __m128i keyStream = encryptBlockHardware(byteSwap(counter), keys);
+        if(offset + 16 <= dataSize)
+        {
+            __m128i* chunk = (__m128i*)(data + offset);
+            _mm_storeu_si128(chunk, _mm_xor_si128(_mm_loadu_si128(chunk), keyStream));
+        }
+        else
+        {
+            uint8_t lastBlock[16];
+            _mm_storeu_si128((__m128i*)lastBlock, keyStream);
+            for(unsigned int i = 0; offset + i < dataSize; i++)
+            {
+                data[offset + i] ^= lastBlock[i];
+            }
+        }
+    }
+}
+
+AESGCM_TARGET static void calculateTagHardware(const uint8_t* roundKeys, const uint8_t* hashKeyPowers, const uint8_t* counterBlock,
+                                               const uint8_t* additionalData, const unsigned int additionalDataSize,
+                                               const uint8_t* cipherText, const unsigned int dataSize, uint8_t* tag)
+{
+    const __m128i hashKey = _mm_loadu_si128((const __m128i*)hashKeyPowers);
+    __m128i hash = _mm_setzero_si128();
+    hash = ghashHardware(hash, hashKeyPowers, additionalData, additionalDataSize);
+    hash = ghashHardware(hash, hashKeyPowers, cipherText, dataSize);
+    //the last block contains the sizes in bits
+    const __m128i lengths = _mm_set_epi64x((int64_t)additionalDataSize * 8, (int64_t)dataSize * 8);
+    hash = multiplyHardware(_mm_xor_si128(hash, lengths), hashKey);
+    const __m128i mask = encryptBlockHardware(_mm_loadu_si128((const __m128i*)counterBlock), (const __m128i*)roundKeys);
+    _mm_storeu_si128((__m128i*)tag, _mm_xor_si128(byteSwap(hash), mask));
+}
+#endif
+
+AESGCM::AESGCM(const uint8_t* key, const bool useHardwareAcceleration) :
+    hardwareAccelerated(useHardwareAcceleration && isHardwareAccelerationSupported())
+{
+    expandKey(key);
+    uint8_t zeroBlock[16] = {0};
+    encryptBlock(zeroBlock, hashKey);
+#ifdef AESGCM_X86
+    if(hardwareAccelerated)
+    {
+        calculateHashKeyPowers(hashKey, hashKeyPowers);
+    }
+#endif
+
+    //pre-calculate the multiples of H for the 4-bit table, see "The Galois/Counter Mode of Operation" (McGrew, Viega)
+    uint64_t high = load64(hashKey);
+    uint64_t low = load64(hashKey + 8);
+    hashTableHigh[0] = hashTableLow[0] = 0;
+    hashTableHigh[8] = high;
+    hashTableLow[8] = low;
+    for(unsigned int i = 4; i > 0; i >>= 1)
+    {
+        const uint64_t reduction = (low & 1) * 0xe1000000U;
+        low = (high << 63) | (low >> 1);
+        high = (high >> 1) ^ (reduction << 32);
+        hashTableHigh[i] = high;
+        hashTableLow[i] = low;
+    }
+    for(unsigned int i = 2; i <= 8; i *= 2)
+    {
+        for(unsigned int j = 1; j < i; j++)
+        {
+            hashTableHigh[i + j] = hashTableHigh[i] ^ hashTableHigh[j];
+            hashTableLow[i + j] = hashTableLow[i] ^ hashTableLow[j];
+        }
+    }
+}
+
+void AESGCM::encrypt(const uint8_t* iv, const uint8_t* additionalData, const unsigned int additionalDataSize, uint8_t* data, const unsigned int dataSize, uint8_t* tag) const
+{
+    //for 96 bit IVs, the initial counter-block is IV || 0^31 || 1
+    uint8_t counterBlock[16];
+    memcpy(counterBlock, iv, IV_SIZE);
+    store32(counterBlock + 12, 1);
+#ifdef AESGCM_X86
+    if(hardwareAccelerated)
+    {
+        ctrHardware(roundKeys, counterBlock, data, dataSize);
+        calculateTagHardware(roundKeys, hashKeyPowers, counterBlock, additionalData, additionalDataSize, data, dataSize, tag);
+        return;
+    }
+#endif
+    ctrSoftware(counterBlock, data, dataSize);
+    calculateTagSoftware(counterBlock, additionalData, additionalDataSize, data, dataSize, tag);
+}
+
+bool AESGCM::decrypt(const uint8_t* iv, const uint8_t* additionalData, const unsigned int additionalDataSize, uint8_t* data, const unsigned int dataSize, const uint8_t* tag) const
+{
+    uint8_t counterBlock[16];
+    memcpy(counterBlock, iv, IV_SIZE);
+    store32(counterBlock + 12, 1);
+    uint8_t expectedTag[TAG_SIZE];
+#ifdef AESGCM_X86
+    if(hardwareAccelerated)
+    {
+        calculateTagHardware(roundKeys, hashKeyPowers, counterBlock, additionalData, additionalDataSize, data, dataSize, expectedTag);
+    }
+    else
+#endif
+    {
+        calculateTagSoftware(counterBlock, additionalData, additionalDataSize, data, dataSize, expectedTag);
+    }
+    //compare in constant time to not leak the position of the first wrong byte
+    uint8_t difference = 0;
+    for(unsigned int i = 0; i < TAG_SIZE; i++)
+    {
+        difference |= expectedTag[i] ^ tag[i];
+    }
+    if(difference != 0)
+    {
+        return false;
+    }
+#ifdef AESGCM_X86
+    if(hardwareAccelerated)
+    {
+        ctrHardware(roundKeys, counterBlock, data, dataSize);
+        return true;
+    }
+#endif
+    ctrSoftware(counterBlock, data, dataSize);
+    return true;
+}
+
+void AESGCM::encryptBlock(const uint8_t* input, uint8_t* output) const
+{
+#ifdef AESGCM_X86
+    if(hardwareAccelerated)
+    {
+        _mm_storeu_si128((__m128i*)output, encryptBlockHardware(_mm_loadu_si128((const __m128i*)input), (const __m128i*)roundKeys));
+        return;
+    }
+#endif
+    encryptBlockSoftware(input, output);
+}
+
+bool AESGCM::isHardwareAccelerated() const
+{
+    return hardwareAccelerated;
+}
+
+bool AESGCM::isHardwareAccelerationSupported()
+{
+#ifdef AESGCM_X86
+    unsigned int features;
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    features = (unsigned int)info[2];
+#else
+    unsigned int eax, ebx, edx;
+    if(!__get_cpuid(1, &eax, &ebx, &features, &edx))
+    {
+        return false;
+    }
+#endif
+    //ECX bit 1: PCLMULQDQ, bit 9: SSSE3, bit 25: AES
+    const unsigned int required = (1 << 1) | (1 << 9) | (1 << 25);
+    return (features & required) == required;
+#else
+    return false;
+#endif
+}
+
+void AESGCM::expandKey(const uint8_t* key)
+{
+    uint32_t words[44];
+    for(unsigned int i = 0; i < 4; i++)
+    {
+        words[i] = load32(key + i * 4);
+    }
+    uint8_t roundConstant = 0x01;
+    for(unsigned int i = 4; i < 44; i++)
+    {
+        uint32_t temp = words[i - 1];
+        if(i % 4 == 0)
+        {
+            //RotWord, SubWord and round-constant
+            temp = ((uint32_t)SBOX[(temp >> 16) & 0xFF] << 24) | ((uint32_t)SBOX[(temp >> 8) & 0xFF] << 16) |
+                   ((uint32_t)SBOX[temp & 0xFF] << 8) | SBOX[temp >> 24];
+            temp ^= (uint32_t)roundConstant << 24;
+            roundConstant = xtime(roundConstant);
+        }
+        words[i] = words[i - 4] ^ temp;
+    }
+    for(unsigned int i = 0; i < 44; i++)
+    {
+        store32(roundKeys + i * 4, words[i]);
+    }
+}
+
+void AESGCM::encryptBlockSoftware(const uint8_t* input, uint8_t* output) const
+{
+    const AESTables& tables = getTables();
+    uint32_t s0 = load32(input) ^ load32(roundKeys);
+    uint32_t s1 = load32(input + 4) ^ load32(roundKeys + 4);
+    uint32_t s2 = load32(input + 8) ^ load32(roundKeys + 8);
+    uint32_t s3 = load32(input + 12) ^ load32(roundKeys + 12);
+    for(unsigned int round = 1; round < 10; round++)
+    {
+        const uint8_t* key = roundKeys + round * 16;
+        const uint32_t t0 = tables.te[0][s0 >> 24] ^ tables.te[1][(s1 >> 16) & 0xFF] ^ tables.te[2][(s2 >> 8) & 0xFF] ^ tables.te[3][s3 & 0xFF] ^ load32(key);
+        const uint32_t t1 = tables.te[0][s1 >> 24] ^ tables.te[1][(s2 >> 16) & 0xFF] ^ tables.te[2][(s3 >> 8) & 0xFF] ^ tables.te[3][s0 & 0xFF] ^ load32(key + 4);
+        const uint32_t t2 = tables.te[0][s2 >> 24] ^ tables.te[1][(s3 >> 16) & 0xFF] ^ tables.te[2][(s0 >> 8) & 0xFF] ^ tables.te[3][s1 & 0xFF] ^ load32(key + 8);
+        const uint32_t t3 = tables.te[0][s3 >> 24] ^ tables.te[1][(s0 >> 16) & 0xFF] ^ tables.te[2][(s1 >> 8) & 0xFF] ^ tables.te[3][s2 & 0xFF] ^ load32(key + 12);
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+    //the last round has no MixColumns
+    const uint8_t* key = roundKeys + 10 * 16;
+    const uint32_t state[4] = {s0, s1, s2, s3};
+    for(unsigned int i = 0; i < 4; i++)
+    {
+        const uint32_t word = ((uint32_t)SBOX[state[i] >> 24] << 24) | ((uint32_t)SBOX[(state[(i + 1) % 4] >> 16) & 0xFF] << 16) |
+                              ((uint32_t)SBOX[(state[(i + 2) % 4] >> 8) & 0xFF] << 8) | SBOX[state[(i + 3) % 4] & 0xFF];
+        store32(output + i * 4, word ^ load32(key + i * 4));
+    }
+}
+
+void AESGCM::multiplyHashKey(uint8_t* block) const
+{
+    uint8_t index = block[15] & 0xF;
+    uint64_t high = hashTableHigh[index];
+    uint64_t low = hashTableLow[index];
+    for(int i = 15; i >= 0; i--)
+    {
+        const uint8_t lowNibble = block[i] & 0xF;
+        const uint8_t highNibble = (block[i] >> 4) & 0xF;
+        uint8_t remainder;
+        if(i != 15)
+        {
+            remainder = (uint8_t)(low & 0xF);
+            low = (high << 60) | (low >> 4);
+            high = (high >> 4) ^ (LAST4[remainder] << 48);
+            high ^= hashTableHigh[lowNibble];
+            low ^= hashTableLow[lowNibble];
+        }
+        remainder = (uint8_t)(low & 0xF);
+        low = (high << 60) | (low >> 4);
+        high = (high >> 4) ^ (LAST4[remainder] << 48);
+        high ^= hashTableHigh[highNibble];
+        low ^= hashTableLow[highNibble];
+    }
+    store64(block, high);
+    store64(block + 8, low);
+}
+
+void AESGCM::ghashSoftware(uint8_t* hash, const uint8_t* data, const unsigned int dataSize) const
+{
+    for(unsigned int offset = 0; offset < dataSize; offset += 16)
+    {
+        //the last block is implicitly padded with zeroes
+        const unsigned int blockSize = dataSize - offset < 16 ? dataSize - offset : 16;
+        for(unsigned int i = 0; i < blockSize; i++)
+        {
+            hash[i] ^= data[offset + i];
+        }
+        multiplyHashKey(hash);
+    }
+}
+
+void AESGCM::ctrSoftware(const uint8_t* counterBlock, uint8_t* data, const unsigned int dataSize) const
+{
+    uint8_t counter[16];
+    uint8_t keyStream[16];
+    memcpy(counter, counterBlock, 16);
+    for(unsigned int offset = 0; offset < dataSize; offset += 16)
+    {
+        incrementCounter(counter);
+        encryptBlockSoftware(counter, keyStream);
+        const unsigned int blockSize = dataSize - offset < 16 ? dataSize - offset : 16;
+        for(unsigned int i = 0; i < blockSize; i++)
+        {
+            data[offset + i] ^= keyStream[i];
+        }
+    }
+}
+
+void AESGCM::calculateTagSoftware(const uint8_t* counterBlock, const uint8_t* additionalData, const unsigned int additionalDataSize,
+                                  const uint8_t* cipherText, const unsigned int dataSize, uint8_t* tag) const
+{
+    uint8_t hash[16] = {0};
+    ghashSoftware(hash, additionalData, additionalDataSize);
+    ghashSoftware(hash, cipherText, dataSize);
+    //the last block contains the sizes in bits
+    uint8_t lengths[16];
+    store64(lengths, (uint64_t)additionalDataSize * 8);
+    store64(lengths + 8, (uint64_t)dataSize * 8);
+    ghashSoftware(hash, lengths, 16);
+    encryptBlockSoftware(counterBlock, tag);
+    for(unsigned int i = 0; i < TAG_SIZE; i++)
+    {
+        tag[i] ^= hash[i];
+    }
+}
@@ -1,13 +1,18 @@
 #include "AudioInterface.h"
 
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+
 AudioInterface::AudioInterface()
 {
-	this->workingBufferInput = new char[this->maxSizeWorkingBufferInput];
 }
 
 AudioInterface::~AudioInterface()
 {
-	delete[] this->workingBufferInput;
+	this->stopProcessingThread();
+	this->freeWorkingBuffers();
 }
 
 auto AudioInterface::startSeqeunce() -> void
@@ -23,18 +28,21 @@ auto AudioInterface::startRecordingMode() -> void
 {
 	this->startSeqeunce();
 	this->vStartRecordingMode();
+	this->startProcessingThread(false);
 }
 
 auto AudioInterface::startPlaybackMode() -> void
 {
 	this->startSeqeunce();
 	this->vStartPlaybackMode();
+	this->startProcessingThread(true);
 }
 
 auto AudioInterface::startDuplexMode() -> void
 {
 	this->startSeqeunce();
 	this->vStartDuplexMode();
+	this->startProcessingThread(true);
 }
 
 auto AudioInterface::setConfiguration(AudioConfiguration audioConfiguration) -> void
@@ -57,6 +65,7 @@ auto AudioInterface::resume() -> void
 auto AudioInterface::stop() -> void
 {
 	this->isExecutionReady = false;
+	this->stopProcessingThread();
 	this->vStop();
 }
 
@@ -76,8 +85,13 @@ auto AudioInterface::setDefaultAudioConfig() -> void
 
 auto AudioInterface::prepareForExecution() -> bool
 {
-	this->initializeAudioProcessors();
+	if (this->initializeAudioProcessors() == false)
+		return false;
+	//the buffer-sizes depend on the configured processors
+	this->allocateWorkingBuffers(static_cast<unsigned int>(this->audioConfiguration.bufferSize));
 	this->vPrepareForExecution();
+	this->isExecutionReady = true;
+	return true;
 }
 
 auto AudioInterface::getBufferSize() -> unsigned int
@@ -90,8 +104,30 @@ auto AudioInterface::setOutputStream(std::shared_ptr<std::ostream> outputStream)
 	this->outputStream = outputStream;
 }
 
+auto AudioInterface::setPipelinedProcessing(bool enabled) -> void
+{
+	this->isPipelined = enabled;
+	//the ring-buffers are allocated with the working-buffers
+	this->isExecutionReady = false;
+}
+
+auto AudioInterface::setProcessingFrames(unsigned int frames) -> void
+{
+	this->processingFrames = frames;
+	//the working-buffers and FIFOs are allocated for the block-size
+	this->isExecutionReady = false;
+}
+
 void AudioInterface::printAudioProcessorOrder() const
 {
+	if (this->processorChain != nullptr)
+	{
+		for (const std::string& name : this->processorChain->getProcessorNames())
+		{
+			*outputStream << name << std::endl;
+		}
+		return;
+	}
     for (const auto& processor : audioProcessors)
     {
 		*outputStream << processor->getName() << std::endl;
@@ -102,6 +138,8 @@ auto AudioInterface::addProcessor(AudioProcessor *audioProcessor) -> bool
 {
     if (hasAudioProcessor(audioProcessor) == false) {
         audioProcessors.push_back(std::unique_ptr<AudioProcessor>(audioProcessor));
+        //the working-buffers need to be negotiated again
+        this->isExecutionReady = false;
         return true; 
     }
     return false;
@@ -132,6 +170,12 @@ auto AudioInterface::removeAudioProcessor(std::string nameOfAudioProcessor) -> b
     return false;
 }
 
+auto AudioInterface::setProcessorChain(ProcessorChain *processorChain) -> void
+{
+	this->processorChain.reset(processorChain);
+	this->isExecutionReady = false;
+}
+
 auto AudioInterface::clearAudioProcessors() -> void
 {
     this->audioProcessors.clear();
@@ -140,6 +184,8 @@ auto AudioInterface::clearAudioProcessors() -> void
 
 auto AudioInterface::initializeAudioProcessors() -> bool
 {
+	if (this->processorChain != nullptr)
+		return this->processorChain->configure(audioConfiguration);
     for (const auto& processor : audioProcessors)
     {
         bool result = processor->configure(audioConfiguration);
@@ -154,6 +200,8 @@ auto AudioInterface::initializeAudioProcessors() -> bool
 
 auto AudioInterface::disposeAudioProcessors() -> bool
 {
+	if (this->processorChain != nullptr)
+		return this->processorChain->cleanUp();
 	for (const auto& processor : audioProcessors)
 	{
 		bool result = processor->cleanUp();
@@ -191,23 +239,347 @@ auto AudioInterface::getAudioConfiguration()->AudioConfiguration
     return this->audioConfiguration;
 }
 
-auto AudioInterface::processAudioOutput(void *outputBuffer, unsigned int outputBufferByteSize, void *userData) -> void
+auto AudioInterface::handleAudioOutput(void *outputBuffer, unsigned int outputBufferByteSize) -> void
 {
-    unsigned int bufferSize = outputBufferByteSize;
-    for (unsigned int i = audioProcessors.size(); i > 0; i--)
-    {
-        bufferSize = audioProcessors.at(i-1)->processOutputData(outputBuffer, bufferSize, userData);
-    }
+	if (this->isPipelined == false)
+	{
+		const unsigned int frameSize = getAudioFormatSize(this->audioConfiguration.audioFormat) * this->audioConfiguration.outputDeviceChannels;
+		this->outputStreamData.nBufferFrames = frameSize != 0 ? outputBufferByteSize / frameSize : 0;
+		this->reblockAudioOutput(outputBuffer, outputBufferByteSize, &this->outputStreamData);
+		return;
+	}
+	if (this->pipelineOutput->read(outputBuffer, outputBufferByteSize) == false)
+	{
+		//the processing-thread did not keep up, play silence
+		memset(outputBuffer, 0, outputBufferByteSize);
+		this->pipelineUnderruns++;
+	}
+	this->notifyProcessingThread();
+}
+
+auto AudioInterface::handleAudioInput(void *inputBuffer, unsigned int inputBufferByteSize) -> void
+{
+	if (this->isPipelined == false)
+	{
+		const unsigned int frameSize = getAudioFormatSize(this->audioConfiguration.audioFormat) * this->audioConfiguration.inputDeviceChannels;
+		this->inputStreamData.nBufferFrames = frameSize != 0 ? inputBufferByteSize / frameSize : 0;
+		this->reblockAudioInput(inputBuffer, inputBufferByteSize, &this->inputStreamData);
+		return;
+	}
+	if (this->pipelineInput->write(inputBuffer, inputBufferByteSize) == false)
+	{
+		//the processing-thread lags too far behind, drop the buffer
+		this->pipelineOverruns++;
+	}
+	this->notifyProcessingThread();
+}
+
+auto AudioInterface::startProcessingThread(bool processOutput) -> void
+{
+	if (this->isPipelined == false || this->processingThreadRunning)
+		return;
+	this->pipelineOverruns = 0;
+	this->pipelineUnderruns = 0;
+	this->processingThreadRunning = true;
+	this->processingRequested = false;
+	this->processingThread = std::thread(&AudioInterface::runProcessingThread, this, processOutput);
+}
+
+auto AudioInterface::stopProcessingThread() -> void
+{
+	if (this->processingThreadRunning == false)
+		return;
+	this->processingThreadRunning = false;
+	this->notifyProcessingThread();
+	this->processingThread.join();
+	if (this->pipelineOverruns > 0 || this->pipelineUnderruns > 0)
+	{
+		*outputStream << "Pipelined processing dropped " << this->pipelineOverruns << " input-buffers and missed "
+			<< this->pipelineUnderruns << " output-buffers" << std::endl;
+	}
+}
+
+auto AudioInterface::notifyProcessingThread() -> void
+{
+	//the mutex is not locked, so the real-time thread never blocks on the processing-thread.
+	//A notification sent while the processing-thread is about to wait is only caught by its timeout
+	this->processingRequested = true;
+	this->processingSignal.notify_one();
+}
+
+auto AudioInterface::runProcessingThread(bool processOutput) -> void
+{
+	//the processors are always called with blocks of the same size, but may change the values while processing
+	StreamData inputData { this->blockFrames, 0, false };
+	StreamData outputData { this->blockFrames, 0, false };
+	//wait at most the duration of one block for a notification, so a missed one only delays the processing
+	const unsigned long long blockDuration = this->audioConfiguration.sampleRate == 0 ? 0 :
+		(1000000ULL * this->blockFrames) / this->audioConfiguration.sampleRate;
+	const std::chrono::microseconds maximumWait(blockDuration == 0 ? 1000 : blockDuration);
+	std::unique_lock<std::mutex> lock(this->processingMutex);
+	while (this->processingThreadRunning)
+	{
+		bool processed = false;
+		//the input is read directly into the working-buffer, so it is not copied again.
+		//The pipeline-buffers also reblock the data, since they are read and written in blocks of processingFrames
+		if (this->pipelineInput->read(this->workingBufferInput, this->processingBufferSizeInput))
+		{
+			inputData.nBufferFrames = this->blockFrames;
+			this->processAudioInput(this->workingBufferInput, this->processingBufferSizeInput, &inputData);
+			processed = true;
+		}
+		//stay one buffer ahead of the audio-device
+		if (processOutput && this->pipelineOutput->getReadableSize() < this->deviceBufferSizeOutput)
+		{
+			outputData.nBufferFrames = this->blockFrames;
+			this->processAudioOutput(this->pipelineBufferOutput.get(), this->processingBufferSizeOutput, &outputData);
+			this->pipelineOutput->write(this->pipelineBufferOutput.get(), this->processingBufferSizeOutput);
+			processed = true;
+		}
+		if (processed == false)
+		{
+			//sleep until the audio-callback accessed the pipeline again
+			this->processingSignal.wait_for(lock, maximumWait, [this]()
+			{
+				return this->processingRequested.load() || !this->processingThreadRunning;
+			});
+			this->processingRequested = false;
+		}
+	}
+}
+
+auto AudioInterface::reblockAudioOutput(void *outputBuffer, unsigned int outputBufferByteSize, StreamData *userData) -> void
+{
+	if (this->reblockingOutput == nullptr)
+	{
+		this->processAudioOutput(outputBuffer, outputBufferByteSize, userData);
+		return;
+	}
+	while (this->reblockingOutput->getReadableSize() < outputBufferByteSize)
+	{
+		if (userData != nullptr)
+			userData->nBufferFrames = this->processingFrames;
+		this->processAudioOutput(this->reblockingBufferOutput.get(), this->processingBufferSizeOutput, userData);
+		this->reblockingOutput->write(this->reblockingBufferOutput.get(), this->processingBufferSizeOutput);
+	}
+	this->reblockingOutput->read(outputBuffer, outputBufferByteSize);
+}
+
+auto AudioInterface::reblockAudioInput(void *inputBuffer, unsigned int inputBufferByteSize, StreamData *userData) -> void
+{
+	if (this->reblockingInput == nullptr)
+	{
+		this->processAudioInput(inputBuffer, inputBufferByteSize, userData);
+		return;
+	}
+	if (this->reblockingInput->write(inputBuffer, inputBufferByteSize) == false)
+	{
+		//the FIFO is emptied on every call, so this only happens if the device changed the buffer-size
+		std::cerr << "Input-buffer is larger than the negotiated size, discarding" << std::endl;
+		return;
+	}
+	//the blocks are read directly into the working-buffer, so they are not copied again
+	while (this->reblockingInput->read(this->workingBufferInput, this->processingBufferSizeInput))
+	{
+		if (userData != nullptr)
+			userData->nBufferFrames = this->processingFrames;
+		this->processAudioInput(this->workingBufferInput, this->processingBufferSizeInput, userData);
+	}
+}
+
+auto AudioInterface::processAudioOutput(void *outputBuffer, unsigned int outputBufferByteSize, StreamData *userData) -> void
+{
+	//if all processors fit into the buffer of the device, it is processed directly without copying
+	void* buffer = this->workingBufferOutput != nullptr ? this->workingBufferOutput : outputBuffer;
+	if (userData != nullptr)
+	{
+		userData->maxBufferSize = this->workingBufferOutput != nullptr ? this->maxSizeWorkingBufferOutput : outputBufferByteSize;
+		//a processor may have marked the previous buffer as silent
+		userData->isSilentPackage = false;
+	}
+	unsigned int bufferSize = outputBufferByteSize;
+	if (this->processorChain != nullptr)
+	{
+		bufferSize = this->processorChain->processOutputData(buffer, bufferSize, userData);
+	}
+	else if (this->isOutputChainInPlace)
+	{
+		for (std::size_t i = audioProcessors.size(); i > 0; i--)
+		{
+			bufferSize = audioProcessors[i-1]->processOutputData(buffer, bufferSize, userData);
+		}
+	}
+	else
+	{
+		void* alternateBuffer = this->alternateBufferOutput;
+		for (std::size_t i = audioProcessors.size(); i > 0; i--)
+		{
+			AudioProcessor* processor = audioProcessors[i-1].get();
+			if (processor->isProcessingInPlace())
+			{
+				bufferSize = processor->processOutputData(buffer, bufferSize, userData);
+			}
+			else
+			{
+				bufferSize = processor->processOutputDataOutOfPlace(buffer, bufferSize, alternateBuffer, userData);
+				std::swap(buffer, alternateBuffer);
+			}
+		}
+	}
+	if (buffer != outputBuffer)
+		memcpy(outputBuffer, buffer, bufferSize < outputBufferByteSize ? bufferSize : outputBufferByteSize);
 }
  
-auto AudioInterface::processAudioInput(void *inputBuffer, unsigned int inputBufferByteSize, void *userData) -> void
+auto AudioInterface::processAudioInput(void *inputBuffer, unsigned int inputBufferByteSize, StreamData *userData) -> void
 {
-	memcpy(this->workingBufferInput, inputBuffer, inputBufferByteSize);
-    unsigned int bufferSize = inputBufferByteSize;
-    for (unsigned int i = 0; i < audioProcessors.size(); i++)
-    {
-        bufferSize = audioProcessors.at(i)->processInputData(this->workingBufferInput, bufferSize, userData);
-    }
+	if (inputBufferByteSize > this->processingBufferSizeInput)
+	{
+		//the working-buffers are not large enough, the device must not change the buffer-size after preparing the execution
+		std::cerr << "Input-buffer is larger than the negotiated size, discarding" << std::endl;
+		return;
+	}
+	if (userData != nullptr)
+	{
+		userData->maxBufferSize = this->maxSizeWorkingBufferInput;
+		userData->isSilentPackage = false;
+	}
+	if (inputBuffer != this->workingBufferInput)
+		memcpy(this->workingBufferInput, inputBuffer, inputBufferByteSize);
+	void* buffer = this->workingBufferInput;
+	unsigned int bufferSize = inputBufferByteSize;
+	if (this->processorChain != nullptr)
+	{
+		this->processorChain->processInputData(buffer, bufferSize, userData);
+	}
+	else if (this->isInputChainInPlace)
+	{
+		for (std::size_t i = 0; i < audioProcessors.size(); i++)
+		{
+			bufferSize = audioProcessors[i]->processInputData(buffer, bufferSize, userData);
+		}
+	}
+	else
+	{
+		void* alternateBuffer = this->alternateBufferInput;
+		for (std::size_t i = 0; i < audioProcessors.size(); i++)
+		{
+			AudioProcessor* processor = audioProcessors[i].get();
+			if (processor->isProcessingInPlace())
+			{
+				bufferSize = processor->processInputData(buffer, bufferSize, userData);
+			}
+			else
+			{
+				bufferSize = processor->processInputDataOutOfPlace(buffer, bufferSize, alternateBuffer, userData);
+				std::swap(buffer, alternateBuffer);
+			}
+		}
+	}
+}
+
+auto AudioInterface::allocateWorkingBuffers(unsigned int bufferFrames) -> void
+{
+	this->freeWorkingBuffers();
+	const unsigned int frameSize = getAudioFormatSize(this->audioConfiguration.audioFormat);
+	this->deviceBufferSizeInput = bufferFrames * frameSize * this->audioConfiguration.inputDeviceChannels;
+	this->deviceBufferSizeOutput = bufferFrames * frameSize * this->audioConfiguration.outputDeviceChannels;
+	//the processors are negotiated for the blocks they are called with
+	this->blockFrames = this->processingFrames != 0 ? this->processingFrames : bufferFrames;
+	this->processingBufferSizeInput = this->blockFrames * frameSize * this->audioConfiguration.inputDeviceChannels;
+	this->processingBufferSizeOutput = this->blockFrames * frameSize * this->audioConfiguration.outputDeviceChannels;
+
+	//the input is processed in the order of the processors, the output in reverse order
+	bool inputInPlace = true;
+	bool outputInPlace = true;
+	if (this->processorChain != nullptr)
+	{
+		//the processors of a fixed chain always work in-place
+		this->maxSizeWorkingBufferInput = this->processorChain->getMaximumInputSize(this->audioConfiguration, this->processingBufferSizeInput);
+		this->maxSizeWorkingBufferOutput = this->processorChain->getMaximumOutputSize(this->audioConfiguration, this->processingBufferSizeOutput);
+	}
+	else
+	{
+		unsigned int bufferSize = this->processingBufferSizeInput;
+		this->maxSizeWorkingBufferInput = bufferSize;
+		for (const auto& processor : audioProcessors)
+		{
+			bufferSize = processor->getMaximumInputSize(this->audioConfiguration, bufferSize);
+			this->maxSizeWorkingBufferInput = std::max(this->maxSizeWorkingBufferInput, bufferSize);
+			inputInPlace = inputInPlace && processor->isProcessingInPlace();
+		}
+		bufferSize = this->processingBufferSizeOutput;
+		this->maxSizeWorkingBufferOutput = bufferSize;
+		for (std::size_t i = audioProcessors.size(); i > 0; i--)
+		{
+			bufferSize = audioProcessors[i-1]->getMaximumOutputSize(this->audioConfiguration, bufferSize);
+			this->maxSizeWorkingBufferOutput = std::max(this->maxSizeWorkingBufferOutput, bufferSize);
+			outputInPlace = outputInPlace && audioProcessors[i-1]->isProcessingInPlace();
+		}
+	}
+	this->isInputChainInPlace = inputInPlace;
+	this->isOutputChainInPlace = outputInPlace;
+	//the output can be processed directly in the buffer of the device (or the reblocking-buffer), if it is large enough
+	const bool outputInDeviceBuffer = outputInPlace && this->maxSizeWorkingBufferOutput <= this->processingBufferSizeOutput;
+
+	//round every buffer up to the alignment, so they don't share cache-lines
+	const unsigned int alignedSizeInput = (this->maxSizeWorkingBufferInput + WORKING_BUFFER_ALIGNMENT - 1) / WORKING_BUFFER_ALIGNMENT * WORKING_BUFFER_ALIGNMENT;
+	const unsigned int alignedSizeOutput = (this->maxSizeWorkingBufferOutput + WORKING_BUFFER_ALIGNMENT - 1) / WORKING_BUFFER_ALIGNMENT * WORKING_BUFFER_ALIGNMENT;
+	const unsigned int totalSize = alignedSizeInput * (inputInPlace ? 1 : 2) + (outputInDeviceBuffer ? 0 : alignedSizeOutput * (outputInPlace ? 1 : 2));
+
+	//all buffers are allocated in a single block
+	this->workingBufferMemory = new char[totalSize + WORKING_BUFFER_ALIGNMENT];
+	char* alignedMemory = this->workingBufferMemory + (WORKING_BUFFER_ALIGNMENT - reinterpret_cast<uintptr_t>(this->workingBufferMemory) % WORKING_BUFFER_ALIGNMENT);
+	this->workingBufferInput = alignedMemory;
+	alignedMemory += alignedSizeInput;
+	if (!inputInPlace)
+	{
+		this->alternateBufferInput = alignedMemory;
+		alignedMemory += alignedSizeInput;
+	}
+	if (!outputInDeviceBuffer)
+	{
+		this->workingBufferOutput = alignedMemory;
+		alignedMemory += alignedSizeOutput;
+		if (!outputInPlace)
+			this->alternateBufferOutput = alignedMemory;
+	}
+
+	if (this->isPipelined)
+	{
+		this->pipelineInput.reset(new AudioRingBuffer(PIPELINE_INPUT_BUFFERS * std::max(this->deviceBufferSizeInput, this->processingBufferSizeInput)));
+		//one buffer is played by the device, while the next one is processed
+		this->pipelineOutput.reset(new AudioRingBuffer(this->deviceBufferSizeOutput + std::max(this->deviceBufferSizeOutput, this->processingBufferSizeOutput)));
+		this->pipelineBufferOutput.reset(new char[std::max(std::max(this->maxSizeWorkingBufferOutput, this->deviceBufferSizeOutput), 1u)]);
+		//start with one buffer of silence, so the processing-thread is one buffer ahead
+		memset(this->pipelineBufferOutput.get(), 0, this->deviceBufferSizeOutput);
+		this->pipelineOutput->write(this->pipelineBufferOutput.get(), this->deviceBufferSizeOutput);
+	}
+	else if (this->blockFrames != bufferFrames)
+	{
+		//the FIFOs hold the remainder of the last call plus one buffer of the device or one block
+		this->reblockingInput.reset(new AudioRingBuffer(this->deviceBufferSizeInput + this->processingBufferSizeInput));
+		this->reblockingOutput.reset(new AudioRingBuffer(this->deviceBufferSizeOutput + this->processingBufferSizeOutput));
+		this->reblockingBufferOutput.reset(new char[std::max(std::max(this->maxSizeWorkingBufferOutput, this->processingBufferSizeOutput), 1u)]);
+	}
+}
+
+auto AudioInterface::freeWorkingBuffers() -> void
+{
+	delete[] this->workingBufferMemory;
+	this->workingBufferMemory = nullptr;
+	this->workingBufferInput = nullptr;
+	this->alternateBufferInput = nullptr;
+	this->workingBufferOutput = nullptr;
+	this->alternateBufferOutput = nullptr;
+	this->maxSizeWorkingBufferInput = 0;
+	this->maxSizeWorkingBufferOutput = 0;
+	this->deviceBufferSizeInput = 0;
+	this->processingBufferSizeInput = 0;
+	this->processingBufferSizeOutput = 0;
+	this->blockFrames = 0;
+	this->reblockingInput.reset();
+	this->reblockingOutput.reset();
+	this->reblockingBufferOutput.reset();
 }
 
 auto AudioInterface::getIsAudioConfigSet() const -> bool
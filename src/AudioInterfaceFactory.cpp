@@ -1,16 +1,80 @@
 #include "AudioInterfaceFactory.h"
 
+#include <stdexcept>
 
+#include "FileAudioWrapper.h"
 
-auto AudioInterfaceFactory::getAudioHandler(AudioProcessorNames processorName) -> std::unique_ptr<AudioInterface>
+const std::string AudioInterfaceFactory::RTAUDIO_WRAPPER = "RtAudio";
+const std::string AudioInterfaceFactory::FILE_AUDIO = "File-Audio";
+
+const Parameter* AudioInterfaceFactory::PROCESSING_FRAMES = Parameters::registerParameter(Parameter(ParameterCategory::AUDIO, 'P', "processing-frames", "The number of audio-frames passed to the processors per call, e.g. the frame-size of a codec. 0 to use the buffer-size", "0"));
+const Parameter* AudioInterfaceFactory::PIPELINED_PROCESSING = Parameters::registerParameter(Parameter(ParameterCategory::AUDIO, 'Y', "pipelined-processing", "Runs the processors in a separate thread one buffer ahead of the audio-device, adding one buffer of latency", ""));
+
+const Parameter* AudioInterfaceFactory::FILE_AUDIO_INPUT = Parameters::registerParameter(Parameter(ParameterCategory::AUDIO, 'G', "file-audio-input", "File-Audio. The WAV-file to read the audio-input from, silence is recorded without a file", ""));
+const Parameter* AudioInterfaceFactory::FILE_AUDIO_OUTPUT = Parameters::registerParameter(Parameter(ParameterCategory::AUDIO, 'H', "file-audio-output", "File-Audio. The WAV-file to write the audio-output into, the output is discarded without a file", ""));
+const Parameter* AudioInterfaceFactory::FILE_AUDIO_UNPACED = Parameters::registerParameter(Parameter(ParameterCategory::AUDIO, 'S', "file-audio-unpaced", "File-Audio. Processes the buffers as fast as possible instead of in real-time", ""));
+const Parameter* AudioInterfaceFactory::FILE_AUDIO_LOOP = Parameters::registerParameter(Parameter(ParameterCategory::AUDIO, 'U', "file-audio-loop", "File-Audio. Restarts the input-file at its end instead of stopping", ""));
+
+const std::vector<std::string> AudioInterfaceFactory::allAudioHandlerNames = {RTAUDIO_WRAPPER, FILE_AUDIO};
+
+auto AudioInterfaceFactory::getAudioHandler(const std::string name, const AudioConfiguration& audioConfig) -> std::unique_ptr<AudioInterface>
+{
+	std::unique_ptr<AudioInterface> handler = getAudioHandler(name);
+	handler->setConfiguration(audioConfig);
+	return handler;
+}
+
+auto AudioInterfaceFactory::getAudioHandler(const std::string name, const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode) -> std::unique_ptr<AudioInterface>
+{
+	std::unique_ptr<AudioInterface> handler;
+	if (name == FILE_AUDIO)
+	{
+		std::string inputFileName;
+		std::string outputFileName;
+		if (configMode->isCustomConfigurationSet(FILE_AUDIO_INPUT->longName, "Read audio-input from a file?"))
+		{
+			inputFileName = configMode->getCustomConfiguration(FILE_AUDIO_INPUT->longName, "Type audio-input file-name", "");
+		}
+		if (configMode->isCustomConfigurationSet(FILE_AUDIO_OUTPUT->longName, "Write audio-output into a file?"))
+		{
+			outputFileName = configMode->getCustomConfiguration(FILE_AUDIO_OUTPUT->longName, "Type audio-output file-name", "");
+		}
+		const FileAudioWrapper::Pacing pacing = configMode->isCustomConfigurationSet(FILE_AUDIO_UNPACED->longName, "Process audio as fast as possible?") ?
+			FileAudioWrapper::Pacing::AS_FAST_AS_POSSIBLE : FileAudioWrapper::Pacing::REAL_TIME;
+		const bool loopInput = configMode->isCustomConfigurationSet(FILE_AUDIO_LOOP->longName, "Loop the audio-input file?");
+		handler.reset(new FileAudioWrapper(inputFileName, outputFileName, pacing, loopInput));
+	}
+	else
+	{
+		handler = getAudioHandler(name);
+	}
+	if (configMode->isCustomConfigurationSet(PROCESSING_FRAMES->longName, "Set number of frames per processing-block?"))
+	{
+		const int frames = configMode->getCustomConfiguration(PROCESSING_FRAMES->longName, "Type number of frames (0 for the buffer-size)", 0);
+		if (frames < 0)
+		{
+			std::cerr << "[AudioInterfaceFactory-Error]Invalid number of processing-frames, using the buffer-size!" << std::endl;
+		}
+		else
+		{
+			handler->setProcessingFrames(static_cast<unsigned int>(frames));
+		}
+	}
+	handler->setPipelinedProcessing(configMode->isCustomConfigurationSet(PIPELINED_PROCESSING->longName, "Enable pipelined processing?"));
+	handler->setConfiguration(audioConfig);
+	return handler;
+}
+
+auto AudioInterfaceFactory::getAudioHandler(const std::string name) -> std::unique_ptr<AudioInterface>
 {
-	switch (processorName)
+	if (name == RTAUDIO_WRAPPER)
+	{
+		return std::unique_ptr<AudioInterface>(new RtAudioWrapper());
+	}
+	if (name == FILE_AUDIO)
 	{
-		case AudioProcessorNames::RTAUDIOWRAPPER:
-			std::unique_ptr<RtAudioWrapper> rtaudiowrapper(new RtAudioWrapper());
-			return std::move(rtaudiowrapper);
-		default:
-			break;
+		//without file-names, silence is recorded and the output is discarded
+		return std::unique_ptr<AudioInterface>(new FileAudioWrapper());
 	}
-	return nullptr;
+	throw std::invalid_argument("No AudioInterface for the given name");
 }
@@ -1,5 +1,7 @@
 #include "AudioProcessor.h"
 
+#include <cstring>
+
 AudioProcessor::AudioProcessor(const std::string name) : name(name) {}
 
 const std::string AudioProcessor::getName() const
@@ -18,3 +20,31 @@ bool AudioProcessor::cleanUp()
 	//dummy implementation, does nothing
 	return true;
 }
+
+unsigned int AudioProcessor::getMaximumInputSize(const AudioConfiguration& audioConfig, const unsigned int inputBufferByteSize) const
+{
+    //by default, the data is not enlarged
+    return inputBufferByteSize;
+}
+
+unsigned int AudioProcessor::getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const
+{
+    return outputBufferByteSize;
+}
+
+bool AudioProcessor::isProcessingInPlace() const
+{
+    return true;
+}
+
+unsigned int AudioProcessor::processInputDataOutOfPlace(const void *sourceBuffer, const unsigned int inputBufferByteSize, void *targetBuffer, StreamData *userData)
+{
+    memcpy(targetBuffer, sourceBuffer, inputBufferByteSize);
+    return processInputData(targetBuffer, inputBufferByteSize, userData);
+}
+
+unsigned int AudioProcessor::processOutputDataOutOfPlace(const void *sourceBuffer, const unsigned int outputBufferByteSize, void *targetBuffer, StreamData *userData)
+{
+    memcpy(targetBuffer, sourceBuffer, outputBufferByteSize);
+    return processOutputData(targetBuffer, outputBufferByteSize, userData);
+}
@@ -9,10 +9,29 @@
 
 #include "ProcessorOpus.h"
 #include "ProcessorWAV.h"
+#include "ProcessorComfortNoise.h"
+#include "ProcessorFormatConversion.h"
+#include "ProcessorResampler.h"
+#include "ProcessorVoiceActivityDetection.h"
+#include "ProcessorG711.h"
+#include "ProcessorG722.h"
+#include "ProcessorL16.h"
+#include "ProcessorLossless.h"
+#include "ProcessorOggOpus.h"
 #include "ProfilingAudioProcessor.h"
 
 const std::string AudioProcessorFactory::OPUS_CODEC = "Opus-Codec";
 const std::string AudioProcessorFactory::WAV_WRITER = "wav-Writer";
+const std::string AudioProcessorFactory::COMFORT_NOISE = "Comfort-Noise";
+const std::string AudioProcessorFactory::FORMAT_CONVERSION = "Format-Conversion";
+const std::string AudioProcessorFactory::RESAMPLER = "Resampler";
+const std::string AudioProcessorFactory::VOICE_ACTIVITY_DETECTION = "Voice-Activity-Detection";
+const std::string AudioProcessorFactory::G711_MU_LAW = "G.711-mu-Law";
+const std::string AudioProcessorFactory::G711_A_LAW = "G.711-A-Law";
+const std::string AudioProcessorFactory::G722_CODEC = "G.722-Codec";
+const std::string AudioProcessorFactory::L16_PCM = "L16-PCM";
+const std::string AudioProcessorFactory::LOSSLESS_CODEC = "Lossless-Codec";
+const std::string AudioProcessorFactory::OGG_OPUS_RECORDER = "Ogg-Opus-Recorder";
 
 AudioProcessor* AudioProcessorFactory::getAudioProcessor(const std::string name, bool createProfiler)
 {
@@ -29,6 +48,64 @@ AudioProcessor* AudioProcessorFactory::getAudioProcessor(const std::string name,
         processor = new ProcessorWAV(WAV_WRITER);
     }
     #endif
+    #ifdef PROCESSORCOMFORTNOISE_H
+    if(name == COMFORT_NOISE)
+    {
+        processor = new ProcessorComfortNoise(COMFORT_NOISE);
+    }
+    #endif
+    #ifdef PROCESSORFORMATCONVERSION_H
+    if(name == FORMAT_CONVERSION)
+    {
+        processor = new ProcessorFormatConversion(FORMAT_CONVERSION);
+    }
+    #endif
+    #ifdef PROCESSORRESAMPLER_H
+    if(name == RESAMPLER)
+    {
+        processor = new ProcessorResampler(RESAMPLER);
+    }
+    #endif
+    #ifdef PROCESSORVOICEACTIVITYDETECTION_H
+    if(name == VOICE_ACTIVITY_DETECTION)
+    {
+        processor = new ProcessorVoiceActivityDetection(VOICE_ACTIVITY_DETECTION);
+    }
+    #endif
+    #ifdef PROCESSORG711_H
+    if(name == G711_MU_LAW)
+    {
+        processor = new ProcessorG711(G711_MU_LAW, G711::Law::MU_LAW);
+    }
+    if(name == G711_A_LAW)
+    {
+        processor = new ProcessorG711(G711_A_LAW, G711::Law::A_LAW);
+    }
+    #endif
+    #ifdef PROCESSORG722_H
+    if(name == G722_CODEC)
+    {
+        processor = new ProcessorG722(G722_CODEC);
+    }
+    #endif
+    #ifdef PROCESSORL16_H
+    if(name == L16_PCM)
+    {
+        processor = new ProcessorL16(L16_PCM);
+    }
+    #endif
+    #ifdef PROCESSORLOSSLESS_H
+    if(name == LOSSLESS_CODEC)
+    {
+        processor = new ProcessorLossless(LOSSLESS_CODEC);
+    }
+    #endif
+    #ifdef PROCESSOROGGOPUS_H
+    if(name == OGG_OPUS_RECORDER)
+    {
+        processor = new ProcessorOggOpus(OGG_OPUS_RECORDER);
+    }
+    #endif
     if(processor != nullptr)
     {
         if(createProfiler)
@@ -49,6 +126,34 @@ const std::vector<std::string> AudioProcessorFactory::getAudioProcessorNames()
     #ifdef PROCESSORWAV_H
     processorNames.push_back(WAV_WRITER);
     #endif
+    #ifdef PROCESSORCOMFORTNOISE_H
+    processorNames.push_back(COMFORT_NOISE);
+    #endif
+    #ifdef PROCESSORFORMATCONVERSION_H
+    processorNames.push_back(FORMAT_CONVERSION);
+    #endif
+    #ifdef PROCESSORRESAMPLER_H
+    processorNames.push_back(RESAMPLER);
+    #endif
+    #ifdef PROCESSORVOICEACTIVITYDETECTION_H
+    processorNames.push_back(VOICE_ACTIVITY_DETECTION);
+    #endif
+    #ifdef PROCESSORG711_H
+    processorNames.push_back(G711_MU_LAW);
+    processorNames.push_back(G711_A_LAW);
+    #endif
+    #ifdef PROCESSORG722_H
+    processorNames.push_back(G722_CODEC);
+    #endif
+    #ifdef PROCESSORL16_H
+    processorNames.push_back(L16_PCM);
+    #endif
+    #ifdef PROCESSORLOSSLESS_H
+    processorNames.push_back(LOSSLESS_CODEC);
+    #endif
+    #ifdef PROCESSOROGGOPUS_H
+    processorNames.push_back(OGG_OPUS_RECORDER);
+    #endif
     return processorNames;
 }
 
@@ -0,0 +1,81 @@
+#include "AudioRingBuffer.h"
+
+#include <cstring>
+
+AudioRingBuffer::AudioRingBuffer(unsigned int capacity) : capacity(roundUpToPowerOfTwo(capacity)), buffer(new char[this->capacity]),
+    readIndex(0), writeIndex(0)
+{
+}
+
+AudioRingBuffer::~AudioRingBuffer()
+{
+    delete[] buffer;
+}
+
+bool AudioRingBuffer::write(const void* data, const unsigned int size)
+{
+    //only the writing thread modifies the write-index
+    const unsigned int currentWriteIndex = writeIndex.load(std::memory_order_relaxed);
+    //acquire, so the reader has finished reading the data we overwrite
+    const unsigned int currentReadIndex = readIndex.load(std::memory_order_acquire);
+    if(capacity - (currentWriteIndex - currentReadIndex) < size)
+    {
+        return false;
+    }
+    const unsigned int position = currentWriteIndex & (capacity - 1);
+    const unsigned int firstPart = size < capacity - position ? size : capacity - position;
+    memcpy(buffer + position, data, firstPart);
+    memcpy(buffer, (const char*)data + firstPart, size - firstPart);
+    //release, so the reader sees the written data
+    writeIndex.store(currentWriteIndex + size, std::memory_order_release);
+    return true;
+}
+
+bool AudioRingBuffer::read(void* data, const unsigned int size)
+{
+    const unsigned int currentReadIndex = readIndex.load(std::memory_order_relaxed);
+    const unsigned int currentWriteIndex = writeIndex.load(std::memory_order_acquire);
+    if(currentWriteIndex - currentReadIndex < size)
+    {
+        return false;
+    }
+    const unsigned int position = currentReadIndex & (capacity - 1);
+    const unsigned int firstPart = size < capacity - position ? size : capacity - position;
+    memcpy(data, buffer + position, firstPart);
+    memcpy((char*)data + firstPart, buffer, size - firstPart);
+    readIndex.store(currentReadIndex + size, std::memory_order_release);
+    return true;
+}
+
+unsigned int AudioRingBuffer::getReadableSize() const
+{
+    //load the read-index first, so it never overtakes the loaded write-index
+    const unsigned int currentReadIndex = readIndex.load(std::memory_order_acquire);
+    return writeIndex.load(std::memory_order_acquire) - currentReadIndex;
+}
+
+unsigned int AudioRingBuffer::getWritableSize() const
+{
+    return capacity - getReadableSize();
+}
+
+unsigned int AudioRingBuffer::getCapacity() const
+{
+    return capacity;
+}
+
+void AudioRingBuffer::clear()
+{
+    readIndex.store(0);
+    writeIndex.store(0);
+}
+
+unsigned int AudioRingBuffer::roundUpToPowerOfTwo(unsigned int value)
+{
+    unsigned int result = 1;
+    while(result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
@@ -0,0 +1,93 @@
+#include "ComfortNoise.h"
+
+#include <cmath>
+
+//the lowest level which can be transmitted
+static const uint8_t MAXIMUM_NOISE_LEVEL = 127;
+
+ComfortNoise::ComfortNoise() : randomState(0x2545F491), currentAmplitude(0)
+{
+}
+
+uint8_t ComfortNoise::calculateNoiseLevel(const int16_t* samples, const unsigned int numberOfSamples)
+{
+    if(numberOfSamples == 0)
+    {
+        return MAXIMUM_NOISE_LEVEL;
+    }
+    double sum = 0;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        sum += (double)samples[i] * samples[i];
+    }
+    //normalize to a full-scale square-wave
+    return toNoiseLevel(sum / (numberOfSamples * 32767.0 * 32767.0));
+}
+
+uint8_t ComfortNoise::calculateNoiseLevel(const float* samples, const unsigned int numberOfSamples)
+{
+    if(numberOfSamples == 0)
+    {
+        return MAXIMUM_NOISE_LEVEL;
+    }
+    double sum = 0;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        sum += (double)samples[i] * samples[i];
+    }
+    return toNoiseLevel(sum / numberOfSamples);
+}
+
+void ComfortNoise::generate(int16_t* samples, const unsigned int numberOfSamples, const uint8_t noiseLevel)
+{
+    const float targetAmplitude = toAmplitude(noiseLevel);
+    const float step = numberOfSamples > 0 ? (targetAmplitude - currentAmplitude) / numberOfSamples : 0;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        currentAmplitude += step;
+        const float sample = nextRandom() * currentAmplitude * 32767.0f;
+        samples[i] = (int16_t)(sample > 32767.0f ? 32767.0f : (sample < -32768.0f ? -32768.0f : sample));
+    }
+    currentAmplitude = targetAmplitude;
+}
+
+void ComfortNoise::generate(float* samples, const unsigned int numberOfSamples, const uint8_t noiseLevel)
+{
+    const float targetAmplitude = toAmplitude(noiseLevel);
+    const float step = numberOfSamples > 0 ? (targetAmplitude - currentAmplitude) / numberOfSamples : 0;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        currentAmplitude += step;
+        samples[i] = nextRandom() * currentAmplitude;
+    }
+    currentAmplitude = targetAmplitude;
+}
+
+float ComfortNoise::toAmplitude(const uint8_t noiseLevel)
+{
+    return powf(10.0f, -(noiseLevel & MAXIMUM_NOISE_LEVEL) / 20.0f);
+}
+
+uint8_t ComfortNoise::toNoiseLevel(const double meanPower)
+{
+    if(meanPower <= 0)
+    {
+        return MAXIMUM_NOISE_LEVEL;
+    }
+    const double level = -10.0 * log10(meanPower);
+    if(level <= 0)
+    {
+        return 0;
+    }
+    return level >= MAXIMUM_NOISE_LEVEL ? MAXIMUM_NOISE_LEVEL : (uint8_t)(level + 0.5);
+}
+
+float ComfortNoise::nextRandom()
+{
+    //xorshift32, see "Xorshift RNGs" (Marsaglia)
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    //uniform distribution in [-sqrt(3), sqrt(3)) has a RMS of 1
+    return ((int32_t)randomState / 2147483648.0f) * 1.7320508f;
+}
@@ -0,0 +1,219 @@
+#include "FileAudioWrapper.h"
+
+#include <cstring>
+#include <chrono>
+
+FileAudioWrapper::FileAudioWrapper(const std::string& inputFileName, const std::string& outputFileName, const Pacing pacing, const bool loopInput) :
+	outputFileName(outputFileName), pacing(pacing), loopInput(loopInput)
+{
+	if (!inputFileName.empty())
+		this->inputFile.reset(new WAVReader(inputFileName));
+}
+
+FileAudioWrapper::~FileAudioWrapper()
+{
+	this->stopAudioThread();
+}
+
+auto FileAudioWrapper::waitForEnd() -> void
+{
+	std::unique_lock<std::mutex> lock(this->endMutex);
+	this->endCondition.wait(lock, [this]() { return this->threadRunning == false; });
+}
+
+auto FileAudioWrapper::getProcessedFrames() const -> uint64_t
+{
+	return this->processedFrames;
+}
+
+auto FileAudioWrapper::vStartRecordingMode() -> void
+{
+	this->startAudioThread(true, false);
+}
+
+auto FileAudioWrapper::vStartPlaybackMode() -> void
+{
+	this->startAudioThread(false, true);
+}
+
+auto FileAudioWrapper::vStartDuplexMode() -> void
+{
+	this->startAudioThread(true, true);
+}
+
+auto FileAudioWrapper::vSetConfiguration(AudioConfiguration audioConfig) -> void
+{
+	this->audioConfiguration = audioConfig;
+	this->isAudioConfigSet = true;
+}
+
+auto FileAudioWrapper::vSuspend() -> void
+{
+	this->isSuspended = true;
+}
+
+auto FileAudioWrapper::vResume() -> void
+{
+	this->isSuspended = false;
+}
+
+auto FileAudioWrapper::vStop() -> void
+{
+	this->stopAudioThread();
+	//writes the remaining output and closes the file
+	this->outputFile.reset();
+	this->disposeAudioProcessors();
+}
+
+auto FileAudioWrapper::vReset() -> void
+{
+	this->stopAudioThread();
+	this->isExecutionReady = false;
+}
+
+auto FileAudioWrapper::vSetDefaultAudioConfig() -> void
+{
+	AudioConfiguration audioConfig = { 0 };
+	//the input-file determines the format, the output is written in the same format
+	const bool hasInput = this->inputFile != nullptr && this->inputFile->isOpen();
+	audioConfig.inputDeviceChannels = hasInput ? this->inputFile->getChannels() : 2;
+	audioConfig.outputDeviceChannels = audioConfig.inputDeviceChannels;
+	audioConfig.audioFormat = hasInput ? this->inputFile->getAudioFormat() : AudioFormat::SIGNED_INT_16;
+	audioConfig.sampleRate = hasInput ? this->inputFile->getSampleRate() : 48000;
+	audioConfig.bufferSize = BufferSizes::BUFFER_256;
+
+	this->setConfiguration(audioConfig);
+}
+
+auto FileAudioWrapper::vPrepareForExecution() -> bool
+{
+	return true;
+}
+
+auto FileAudioWrapper::vGetBufferSize() -> unsigned int
+{
+	return static_cast<unsigned int>(this->audioConfiguration.bufferSize);
+}
+
+auto FileAudioWrapper::startAudioThread(bool processInput, bool processOutput) -> void
+{
+	if (this->threadRunning)
+		return;
+	if (processInput && this->inputFile != nullptr)
+	{
+		//the samples are passed to the processors as they are, so the file must match the configuration
+		if (this->inputFile->isOpen() == false || this->inputFile->getAudioFormat() != this->audioConfiguration.audioFormat
+			|| this->inputFile->getSampleRate() != this->audioConfiguration.sampleRate
+			|| this->inputFile->getChannels() != this->audioConfiguration.inputDeviceChannels)
+		{
+			std::cerr << "[File-Audio-Error]The input-file does not match the audio-configuration!" << std::endl;
+			return;
+		}
+	}
+	if (processOutput && !this->outputFileName.empty())
+	{
+		this->outputFile.reset(new WAVWriter(this->outputFileName, this->audioConfiguration.audioFormat, this->audioConfiguration.sampleRate,
+			this->audioConfiguration.outputDeviceChannels));
+		if (this->outputFile->isOpen() == false)
+		{
+			this->outputFile.reset();
+			return;
+		}
+	}
+	this->processedFrames = 0;
+	this->isSuspended = false;
+	this->threadRunning = true;
+	this->audioThread = std::thread(&FileAudioWrapper::runAudioThread, this, processInput, processOutput);
+}
+
+auto FileAudioWrapper::stopAudioThread() -> void
+{
+	{
+		std::lock_guard<std::mutex> lock(this->endMutex);
+		this->threadRunning = false;
+	}
+	this->endCondition.notify_all();
+	if (this->audioThread.joinable())
+		this->audioThread.join();
+}
+
+auto FileAudioWrapper::runAudioThread(bool processInput, bool processOutput) -> void
+{
+	const unsigned int bufferFrames = static_cast<unsigned int>(this->audioConfiguration.bufferSize);
+	const unsigned int sampleSize = getAudioFormatSize(this->audioConfiguration.audioFormat);
+	const unsigned int inputBufferByteSize = bufferFrames * sampleSize * this->audioConfiguration.inputDeviceChannels;
+	const unsigned int outputBufferByteSize = bufferFrames * sampleSize * this->audioConfiguration.outputDeviceChannels;
+	std::unique_ptr<char[]> inputBuffer(new char[std::max(inputBufferByteSize, 1u)]);
+	std::unique_ptr<char[]> outputBuffer(new char[std::max(outputBufferByteSize, 1u)]);
+	memset(inputBuffer.get(), 0, inputBufferByteSize);
+	const auto bufferDuration = std::chrono::nanoseconds(1000000000ull * bufferFrames / this->audioConfiguration.sampleRate);
+	auto nextBufferTime = std::chrono::steady_clock::now();
+	uint64_t inputPosition = 0;
+	bool isEndOfInput = false;
+
+	while (this->threadRunning && !isEndOfInput)
+	{
+		if (this->isSuspended)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			nextBufferTime = std::chrono::steady_clock::now();
+			continue;
+		}
+		if (processInput)
+		{
+			isEndOfInput = this->readInput(inputBuffer.get(), inputBufferByteSize, inputPosition);
+			this->handleAudioInput(inputBuffer.get(), inputBufferByteSize);
+		}
+		if (processOutput)
+		{
+			this->handleAudioOutput(outputBuffer.get(), outputBufferByteSize);
+			if (this->outputFile != nullptr)
+			{
+				//a sound-device would not wait for the output either, but when running as fast as possible,
+				//the writer would fall behind and lose audio
+				while (!this->outputFile->write(outputBuffer.get(), outputBufferByteSize) && this->pacing == Pacing::AS_FAST_AS_POSSIBLE
+					&& this->threadRunning)
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			}
+		}
+		this->processedFrames += bufferFrames;
+		if (this->pacing == Pacing::REAL_TIME)
+		{
+			nextBufferTime += bufferDuration;
+			std::this_thread::sleep_until(nextBufferTime);
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(this->endMutex);
+		this->threadRunning = false;
+	}
+	this->endCondition.notify_all();
+}
+
+auto FileAudioWrapper::readInput(char* inputBuffer, unsigned int inputBufferByteSize, uint64_t& position) -> bool
+{
+	if (this->inputFile == nullptr)
+		return false;
+	const uint64_t dataSize = this->inputFile->getDataSize();
+	unsigned int bufferPosition = 0;
+	while (bufferPosition < inputBufferByteSize && position < dataSize)
+	{
+		const unsigned int size = static_cast<unsigned int>(std::min<uint64_t>(inputBufferByteSize - bufferPosition, dataSize - position));
+		memcpy(inputBuffer + bufferPosition, this->inputFile->getData() + position, size);
+		bufferPosition += size;
+		position += size;
+		if (position == dataSize && this->loopInput)
+			position = 0;
+	}
+	if (this->audioConfiguration.audioFormat == AudioFormat::SIGNED_INT_8)
+	{
+		//8 bit WAV-samples are unsigned
+		for (unsigned int i = 0; i < bufferPosition; i++)
+			inputBuffer[i] ^= (char)0x80;
+	}
+	//the last buffer is filled up with silence
+	memset(inputBuffer + bufferPosition, 0, inputBufferByteSize - bufferPosition);
+	return position >= dataSize;
+}
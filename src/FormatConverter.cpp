@@ -0,0 +1,643 @@
+#include "FormatConverter.h"
+
+#include <string.h> //memmove
+#include <cmath>
+
+#include "SIMD.h"
+
+//scale-factors between integer and float samples
+static const float SCALE_INT16 = 32768.0f;
+static const float SCALE_INT24 = 8388608.0f;
+static const float SCALE_INT32 = 2147483648.0f;
+//the largest float not exceeding the range of 32 bit integers
+static const float MAX_INT32_FLOAT = 2147483520.0f;
+//TPDF dither of +-1 LSB of 24 bit audio: the difference of two 16 bit random values scaled by 2^-23 / 2^16
+static const double DITHER_SCALE = 1.0 / 549755813888.0;
+
+static inline uint32_t nextRandom(uint32_t& state)
+{
+    //xorshift32, see "Xorshift RNGs" (Marsaglia)
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static inline int32_t clampAndRound(const float value, const float minimum, const float maximum)
+{
+    return (int32_t)lrintf(value < minimum ? minimum : (value > maximum ? maximum : value));
+}
+
+////
+// Scalar implementations, also used for the remaining samples of the vectorized implementations
+////
+
+static void copySamples(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* /* randomState */)
+{
+    //numberOfSamples is already the size in bytes, see FormatConverter#convert()
+    if(source != target)
+    {
+        memmove(target, source, numberOfSamples);
+    }
+}
+
+static void int16ToFloat(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* /* randomState */)
+{
+    const int16_t* in = (const int16_t*)source;
+    float* out = (float*)target;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        out[i] = in[i] * (1.0f / SCALE_INT16);
+    }
+}
+
+static void floatToInt16(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* /* randomState */)
+{
+    const float* in = (const float*)source;
+    int16_t* out = (int16_t*)target;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        out[i] = (int16_t)clampAndRound(in[i] * SCALE_INT16, -32768.0f, 32767.0f);
+    }
+}
+
+static void int32ToFloat(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* /* randomState */)
+{
+    const int32_t* in = (const int32_t*)source;
+    float* out = (float*)target;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        out[i] = (float)in[i] * (1.0f / SCALE_INT32);
+    }
+}
+
+static void floatToInt32(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* /* randomState */)
+{
+    const float* in = (const float*)source;
+    int32_t* out = (int32_t*)target;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        out[i] = clampAndRound(in[i] * SCALE_INT32, -SCALE_INT32, MAX_INT32_FLOAT);
+    }
+}
+
+static inline int32_t readInt24(const uint8_t* in)
+{
+    //shift into the upper 24 bits, which keeps the sign
+    return (int32_t)(((uint32_t)in[0] << 8) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 24));
+}
+
+static inline void writeInt24(uint8_t* out, const int32_t value)
+{
+    //value holds the sample in the lower 24 bits
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+}
+
+static void int24ToInt32(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* /* randomState */)
+{
+    const uint8_t* in = (const uint8_t*)source;
+    int32_t* out = (int32_t*)target;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        out[i] = readInt24(in + 3 * i);
+    }
+}
+
+static void int32ToInt24(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* /* randomState */)
+{
+    const int32_t* in = (const int32_t*)source;
+    uint8_t* out = (uint8_t*)target;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        writeInt24(out + 3 * i, in[i] >> 8);
+    }
+}
+
+static void int24ToFloat(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* /* randomState */)
+{
+    const uint8_t* in = (const uint8_t*)source;
+    float* out = (float*)target;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        out[i] = (float)readInt24(in + 3 * i) * (1.0f / SCALE_INT32);
+    }
+}
+
+static void floatToInt24(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* /* randomState */)
+{
+    const float* in = (const float*)source;
+    uint8_t* out = (uint8_t*)target;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        writeInt24(out + 3 * i, clampAndRound(in[i] * SCALE_INT24, -SCALE_INT24, SCALE_INT24 - 1.0f));
+    }
+}
+
+static void doubleToFloat(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const double* in = (const double*)source;
+    float* out = (float*)target;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        const uint32_t random = nextRandom(randomState[0]);
+        const int32_t dither = (int32_t)(random >> 16) - (int32_t)(random & 0xFFFF);
+        out[i] = (float)(in[i] + dither * DITHER_SCALE);
+    }
+}
+
+static void floatToDouble(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* /* randomState */)
+{
+    const float* in = (const float*)source;
+    double* out = (double*)target;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        out[i] = in[i];
+    }
+}
+
+#ifdef SIMD_X86
+////
+// SSE2 implementations, 4 samples per step
+////
+
+SIMD_TARGET_SSE2 static inline __m128i nextRandomSSE2(__m128i& state)
+{
+    state = _mm_xor_si128(state, _mm_slli_epi32(state, 13));
+    state = _mm_xor_si128(state, _mm_srli_epi32(state, 17));
+    state = _mm_xor_si128(state, _mm_slli_epi32(state, 5));
+    return state;
+}
+
+SIMD_TARGET_SSE2 static void int16ToFloatSSE2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const int16_t* in = (const int16_t*)source;
+    float* out = (float*)target;
+    const __m128 scale = _mm_set1_ps(1.0f / SCALE_INT16);
+    unsigned int i = 0;
+    for(; i + 8 <= numberOfSamples; i += 8)
+    {
+        const __m128i samples = _mm_loadu_si128((const __m128i*)(in + i));
+        //sign-extend by moving the 16 bits into the upper half and shifting back arithmetically
+        const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+        const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+    }
+    int16ToFloat(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+SIMD_TARGET_SSE2 static void floatToInt16SSE2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const float* in = (const float*)source;
+    int16_t* out = (int16_t*)target;
+    const __m128 scale = _mm_set1_ps(SCALE_INT16);
+    unsigned int i = 0;
+    for(; i + 8 <= numberOfSamples; i += 8)
+    {
+        //rounds to nearest, the saturating pack clamps to 16 bit
+        const __m128i low = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i), scale));
+        const __m128i high = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i + 4), scale));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(low, high));
+    }
+    floatToInt16(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+SIMD_TARGET_SSE2 static void int32ToFloatSSE2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const int32_t* in = (const int32_t*)source;
+    float* out = (float*)target;
+    const __m128 scale = _mm_set1_ps(1.0f / SCALE_INT32);
+    unsigned int i = 0;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(in + i))), scale));
+    }
+    int32ToFloat(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+SIMD_TARGET_SSE2 static void floatToInt32SSE2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const float* in = (const float*)source;
+    int32_t* out = (int32_t*)target;
+    const __m128 scale = _mm_set1_ps(SCALE_INT32);
+    const __m128 minimum = _mm_set1_ps(-SCALE_INT32);
+    const __m128 maximum = _mm_set1_ps(MAX_INT32_FLOAT);
+    unsigned int i = 0;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        const __m128 samples = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(in + i), scale), minimum), maximum);
+        _mm_storeu_si128((__m128i*)(out + i), _mm_cvtps_epi32(samples));
+    }
+    floatToInt32(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+SIMD_TARGET_SSE2 static void doubleToFloatSSE2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const double* in = (const double*)source;
+    float* out = (float*)target;
+    const __m128d scale = _mm_set1_pd(DITHER_SCALE);
+    const __m128i mask = _mm_set1_epi32(0xFFFF);
+    __m128i state = _mm_loadu_si128((const __m128i*)randomState);
+    unsigned int i = 0;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        const __m128i random = nextRandomSSE2(state);
+        const __m128i dither = _mm_sub_epi32(_mm_srli_epi32(random, 16), _mm_and_si128(random, mask));
+        const __m128d low = _mm_add_pd(_mm_loadu_pd(in + i), _mm_mul_pd(_mm_cvtepi32_pd(dither), scale));
+        const __m128d high = _mm_add_pd(_mm_loadu_pd(in + i + 2), _mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(dither, 0xEE)), scale));
+        _mm_storeu_ps(out + i, _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high)));
+    }
+    _mm_storeu_si128((__m128i*)randomState, state);
+    doubleToFloat(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+SIMD_TARGET_SSE2 static void floatToDoubleSSE2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const float* in = (const float*)source;
+    double* out = (double*)target;
+    unsigned int i = 0;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        const __m128 samples = _mm_loadu_ps(in + i);
+        _mm_storeu_pd(out + i, _mm_cvtps_pd(samples));
+        _mm_storeu_pd(out + i + 2, _mm_cvtps_pd(_mm_movehl_ps(samples, samples)));
+    }
+    floatToDouble(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+////
+// AVX2 implementations, 8 samples per step
+////
+
+SIMD_TARGET_AVX2 static void int16ToFloatAVX2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const int16_t* in = (const int16_t*)source;
+    float* out = (float*)target;
+    const __m256 scale = _mm256_set1_ps(1.0f / SCALE_INT16);
+    unsigned int i = 0;
+    for(; i + 8 <= numberOfSamples; i += 8)
+    {
+        const __m256i samples = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(in + i)));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+    }
+    int16ToFloat(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+SIMD_TARGET_AVX2 static void floatToInt16AVX2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const float* in = (const float*)source;
+    int16_t* out = (int16_t*)target;
+    const __m256 scale = _mm256_set1_ps(SCALE_INT16);
+    unsigned int i = 0;
+    for(; i + 8 <= numberOfSamples; i += 8)
+    {
+        const __m256i samples = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(in + i), scale));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(_mm256_castsi256_si128(samples), _mm256_extracti128_si256(samples, 1)));
+    }
+    floatToInt16(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+SIMD_TARGET_AVX2 static void int32ToFloatAVX2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const int32_t* in = (const int32_t*)source;
+    float* out = (float*)target;
+    const __m256 scale = _mm256_set1_ps(1.0f / SCALE_INT32);
+    unsigned int i = 0;
+    for(; i + 8 <= numberOfSamples; i += 8)
+    {
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*)(in + i))), scale));
+    }
+    int32ToFloat(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+SIMD_TARGET_AVX2 static void floatToInt32AVX2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const float* in = (const float*)source;
+    int32_t* out = (int32_t*)target;
+    const __m256 scale = _mm256_set1_ps(SCALE_INT32);
+    const __m256 minimum = _mm256_set1_ps(-SCALE_INT32);
+    const __m256 maximum = _mm256_set1_ps(MAX_INT32_FLOAT);
+    unsigned int i = 0;
+    for(; i + 8 <= numberOfSamples; i += 8)
+    {
+        const __m256 samples = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i), scale), minimum), maximum);
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_cvtps_epi32(samples));
+    }
+    floatToInt32(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+//moves 4 packed 24 bit samples into the upper 24 bits of 4 32 bit integers
+SIMD_TARGET_AVX2 static inline __m128i unpackInt24(const uint8_t* in)
+{
+    const __m128i shuffle = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)in), shuffle);
+}
+
+//packs the lower 24 bits of 4 32 bit integers into 12 bytes, the last 4 bytes of the result are zero
+SIMD_TARGET_AVX2 static inline __m128i packInt24(const __m128i samples)
+{
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    return _mm_shuffle_epi8(samples, shuffle);
+}
+
+//the 24 bit implementations load and store 16 bytes for 12 bytes of samples, so they stop 2 samples before the end
+SIMD_TARGET_AVX2 static void int24ToInt32AVX2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const uint8_t* in = (const uint8_t*)source;
+    int32_t* out = (int32_t*)target;
+    unsigned int i = 0;
+    for(; i + 10 <= numberOfSamples; i += 8)
+    {
+        _mm_storeu_si128((__m128i*)(out + i), unpackInt24(in + 3 * i));
+        _mm_storeu_si128((__m128i*)(out + i + 4), unpackInt24(in + 3 * i + 12));
+    }
+    int24ToInt32(in + 3 * i, out + i, numberOfSamples - i, randomState);
+}
+
+SIMD_TARGET_AVX2 static void int32ToInt24AVX2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const int32_t* in = (const int32_t*)source;
+    uint8_t* out = (uint8_t*)target;
+    unsigned int i = 0;
+    for(; i + 10 <= numberOfSamples; i += 8)
+    {
+        //the upper 3 bytes of every sample are kept
+        _mm_storeu_si128((__m128i*)(out + 3 * i), packInt24(_mm_srai_epi32(_mm_loadu_si128((const __m128i*)(in + i)), 8)));
+        _mm_storeu_si128((__m128i*)(out + 3 * i + 12), packInt24(_mm_srai_epi32(_mm_loadu_si128((const __m128i*)(in + i + 4)), 8)));
+    }
+    int32ToInt24(in + i, out + 3 * i, numberOfSamples - i, randomState);
+}
+
+SIMD_TARGET_AVX2 static void int24ToFloatAVX2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const uint8_t* in = (const uint8_t*)source;
+    float* out = (float*)target;
+    const __m256 scale = _mm256_set1_ps(1.0f / SCALE_INT32);
+    unsigned int i = 0;
+    for(; i + 10 <= numberOfSamples; i += 8)
+    {
+        const __m256i samples = _mm256_inserti128_si256(_mm256_castsi128_si256(unpackInt24(in + 3 * i)), unpackInt24(in + 3 * i + 12), 1);
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+    }
+    int24ToFloat(in + 3 * i, out + i, numberOfSamples - i, randomState);
+}
+
+SIMD_TARGET_AVX2 static void floatToInt24AVX2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const float* in = (const float*)source;
+    uint8_t* out = (uint8_t*)target;
+    const __m256 scale = _mm256_set1_ps(SCALE_INT24);
+    const __m256 minimum = _mm256_set1_ps(-SCALE_INT24);
+    const __m256 maximum = _mm256_set1_ps(SCALE_INT24 - 1.0f);
+    unsigned int i = 0;
+    for(; i + 10 <= numberOfSamples; i += 8)
+    {
+        const __m256 samples = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i), scale), minimum), maximum);
+        const __m256i integers = _mm256_cvtps_epi32(samples);
+        _mm_storeu_si128((__m128i*)(out + 3 * i), packInt24(_mm256_castsi256_si128(integers)));
+        _mm_storeu_si128((__m128i*)(out + 3 * i + 12), packInt24(_mm256_extracti128_si256(integers, 1)));
+    }
+    floatToInt24(in + i, out + 3 * i, numberOfSamples - i, randomState);
+}
+
+SIMD_TARGET_AVX2 static void doubleToFloatAVX2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const double* in = (const double*)source;
+    float* out = (float*)target;
+    const __m256d scale = _mm256_set1_pd(DITHER_SCALE);
+    const __m256i mask = _mm256_set1_epi32(0xFFFF);
+    __m256i state = _mm256_loadu_si256((const __m256i*)randomState);
+    unsigned int i = 0;
+    for(; i + 8 <= numberOfSamples; i += 8)
+    {
+        state = _mm256_xor_si256(state, _mm256_slli_epi32(state, 13));
+        state = _mm256_xor_si256(state, _mm256_srli_epi32(state, 17));
+        state = _mm256_xor_si256(state, _mm256_slli_epi32(state, 5));
+        const __m256i dither = _mm256_sub_epi32(_mm256_srli_epi32(state, 16), _mm256_and_si256(state, mask));
+        const __m256d low = _mm256_add_pd(_mm256_loadu_pd(in + i), _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(dither)), scale));
+        const __m256d high = _mm256_add_pd(_mm256_loadu_pd(in + i + 4), _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(dither, 1)), scale));
+        _mm_storeu_ps(out + i, _mm256_cvtpd_ps(low));
+        _mm_storeu_ps(out + i + 4, _mm256_cvtpd_ps(high));
+    }
+    _mm256_storeu_si256((__m256i*)randomState, state);
+    doubleToFloat(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+SIMD_TARGET_AVX2 static void floatToDoubleAVX2(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const float* in = (const float*)source;
+    double* out = (double*)target;
+    unsigned int i = 0;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        _mm256_storeu_pd(out + i, _mm256_cvtps_pd(_mm_loadu_ps(in + i)));
+    }
+    floatToDouble(in + i, out + i, numberOfSamples - i, randomState);
+}
+#endif
+
+#ifdef SIMD_NEON
+////
+// NEON implementations, 4 samples per step
+////
+
+static void int16ToFloatNEON(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const int16_t* in = (const int16_t*)source;
+    float* out = (float*)target;
+    unsigned int i = 0;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        const int32x4_t samples = vmovl_s16(vld1_s16(in + i));
+        vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(samples), 1.0f / SCALE_INT16));
+    }
+    int16ToFloat(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+static void floatToInt16NEON(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const float* in = (const float*)source;
+    int16_t* out = (int16_t*)target;
+    unsigned int i = 0;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        //rounds to nearest, the saturating narrow clamps to 16 bit
+        const int32x4_t samples = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(in + i), SCALE_INT16));
+        vst1_s16(out + i, vqmovn_s32(samples));
+    }
+    floatToInt16(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+static void int32ToFloatNEON(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const int32_t* in = (const int32_t*)source;
+    float* out = (float*)target;
+    unsigned int i = 0;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(in + i)), 1.0f / SCALE_INT32));
+    }
+    int32ToFloat(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+static void floatToInt32NEON(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const float* in = (const float*)source;
+    int32_t* out = (int32_t*)target;
+    unsigned int i = 0;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        //the conversion saturates
+        vst1q_s32(out + i, vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(in + i), SCALE_INT32)));
+    }
+    floatToInt32(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+static void doubleToFloatNEON(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const double* in = (const double*)source;
+    float* out = (float*)target;
+    const float64x2_t scale = vdupq_n_f64(DITHER_SCALE);
+    const uint32x4_t mask = vdupq_n_u32(0xFFFF);
+    uint32x4_t state = vld1q_u32(randomState);
+    unsigned int i = 0;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        state = veorq_u32(state, vshlq_n_u32(state, 13));
+        state = veorq_u32(state, vshrq_n_u32(state, 17));
+        state = veorq_u32(state, vshlq_n_u32(state, 5));
+        const int32x4_t dither = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(state, 16)), vreinterpretq_s32_u32(vandq_u32(state, mask)));
+        const float64x2_t low = vfmaq_f64(vld1q_f64(in + i), vcvtq_f64_s64(vmovl_s32(vget_low_s32(dither))), scale);
+        const float64x2_t high = vfmaq_f64(vld1q_f64(in + i + 2), vcvtq_f64_s64(vmovl_s32(vget_high_s32(dither))), scale);
+        vst1q_f32(out + i, vcombine_f32(vcvt_f32_f64(low), vcvt_f32_f64(high)));
+    }
+    vst1q_u32(randomState, state);
+    doubleToFloat(in + i, out + i, numberOfSamples - i, randomState);
+}
+
+static void floatToDoubleNEON(const void* source, void* target, const unsigned int numberOfSamples, uint32_t* randomState)
+{
+    const float* in = (const float*)source;
+    double* out = (double*)target;
+    unsigned int i = 0;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        const float32x4_t samples = vld1q_f32(in + i);
+        vst1q_f64(out + i, vcvt_f64_f32(vget_low_f32(samples)));
+        vst1q_f64(out + i + 2, vcvt_high_f64_f32(samples));
+    }
+    floatToDouble(in + i, out + i, numberOfSamples - i, randomState);
+}
+#endif
+
+FormatConverter::FormatConverter(const AudioFormat sourceFormat, const AudioFormat targetFormat, const InstructionSet instructionSet)
+{
+    const InstructionSet supportedSet = getSupportedInstructionSet();
+    //the instruction-sets of different architectures can't be mixed
+    if(instructionSet == InstructionSet::SCALAR || (instructionSet == InstructionSet::NEON) != (supportedSet == InstructionSet::NEON))
+    {
+        this->instructionSet = InstructionSet::SCALAR;
+    }
+    else
+    {
+        this->instructionSet = instructionSet < supportedSet ? instructionSet : supportedSet;
+    }
+    kernel = selectKernel(sourceFormat, targetFormat, this->instructionSet);
+    if(sourceFormat == targetFormat)
+    {
+        //the kernel copies bytes instead of samples
+        kernel = nullptr;
+    }
+    for(unsigned int i = 0; i < DITHER_LANES; i++)
+    {
+        //every lane needs a different, non-zero seed
+        randomState[i] = 0x9E3779B9u * (i + 1);
+    }
+    this->sourceFormat = sourceFormat;
+    this->targetFormat = targetFormat;
+}
+
+bool FormatConverter::isValid() const
+{
+    return kernel != nullptr || sourceFormat == targetFormat;
+}
+
+void FormatConverter::convert(const void* source, void* target, const unsigned int numberOfSamples)
+{
+    if(kernel != nullptr)
+    {
+        kernel(source, target, numberOfSamples, randomState);
+    }
+    else if(sourceFormat == targetFormat)
+    {
+        copySamples(source, target, numberOfSamples * getAudioFormatSize(sourceFormat), randomState);
+    }
+}
+
+FormatConverter::InstructionSet FormatConverter::getInstructionSet() const
+{
+    return instructionSet;
+}
+
+FormatConverter::InstructionSet FormatConverter::getSupportedInstructionSet()
+{
+#if defined(SIMD_X86)
+    if(cpuSupportsAVX2())
+    {
+        return InstructionSet::AVX2;
+    }
+    return cpuSupportsSSE2() ? InstructionSet::SSE2 : InstructionSet::SCALAR;
+#elif defined(SIMD_NEON)
+    return InstructionSet::NEON;
+#else
+    return InstructionSet::SCALAR;
+#endif
+}
+
+FormatConverter::Kernel FormatConverter::selectKernel(const AudioFormat sourceFormat, const AudioFormat targetFormat, const InstructionSet instructionSet)
+{
+    //scalar, SSE2, AVX2 and NEON implementations, nullptr if there is no vectorized implementation
+    struct Conversion
+    {
+        AudioFormat source;
+        AudioFormat target;
+        Kernel kernels[4];
+    };
+#if defined(SIMD_X86)
+#define FORMATCONVERTER_KERNELS(scalar, sse2, avx2, neon) {scalar, sse2, avx2, nullptr}
+#elif defined(SIMD_NEON)
+#define FORMATCONVERTER_KERNELS(scalar, sse2, avx2, neon) {scalar, nullptr, nullptr, neon}
+#else
+#define FORMATCONVERTER_KERNELS(scalar, sse2, avx2, neon) {scalar, nullptr, nullptr, nullptr}
+#endif
+    static const Conversion conversions[] = {
+        {AudioFormat::SIGNED_INT_16, AudioFormat::FLOAT_32, FORMATCONVERTER_KERNELS(int16ToFloat, int16ToFloatSSE2, int16ToFloatAVX2, int16ToFloatNEON)},
+        {AudioFormat::FLOAT_32, AudioFormat::SIGNED_INT_16, FORMATCONVERTER_KERNELS(floatToInt16, floatToInt16SSE2, floatToInt16AVX2, floatToInt16NEON)},
+        {AudioFormat::SIGNED_INT_32, AudioFormat::FLOAT_32, FORMATCONVERTER_KERNELS(int32ToFloat, int32ToFloatSSE2, int32ToFloatAVX2, int32ToFloatNEON)},
+        {AudioFormat::FLOAT_32, AudioFormat::SIGNED_INT_32, FORMATCONVERTER_KERNELS(floatToInt32, floatToInt32SSE2, floatToInt32AVX2, floatToInt32NEON)},
+        {AudioFormat::SIGNED_INT_24, AudioFormat::SIGNED_INT_32, FORMATCONVERTER_KERNELS(int24ToInt32, nullptr, int24ToInt32AVX2, nullptr)},
+        {AudioFormat::SIGNED_INT_32, AudioFormat::SIGNED_INT_24, FORMATCONVERTER_KERNELS(int32ToInt24, nullptr, int32ToInt24AVX2, nullptr)},
+        {AudioFormat::SIGNED_INT_24, AudioFormat::FLOAT_32, FORMATCONVERTER_KERNELS(int24ToFloat, nullptr, int24ToFloatAVX2, nullptr)},
+        {AudioFormat::FLOAT_32, AudioFormat::SIGNED_INT_24, FORMATCONVERTER_KERNELS(floatToInt24, nullptr, floatToInt24AVX2, nullptr)},
+        {AudioFormat::FLOAT_64, AudioFormat::FLOAT_32, FORMATCONVERTER_KERNELS(doubleToFloat, doubleToFloatSSE2, doubleToFloatAVX2, doubleToFloatNEON)},
+        {AudioFormat::FLOAT_32, AudioFormat::FLOAT_64, FORMATCONVERTER_KERNELS(floatToDouble, floatToDoubleSSE2, floatToDoubleAVX2, floatToDoubleNEON)}
+    };
+#undef FORMATCONVERTER_KERNELS
+    for(const Conversion& conversion : conversions)
+    {
+        if(conversion.source == sourceFormat && conversion.target == targetFormat)
+        {
+            //fall back to the next smaller instruction-set without an implementation
+            for(int set = (int)instructionSet; set >= 0; set--)
+            {
+                if(conversion.kernels[set] != nullptr)
+                {
+                    return conversion.kernels[set];
+                }
+            }
+        }
+    }
+    return nullptr;
+}
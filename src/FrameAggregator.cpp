@@ -0,0 +1,98 @@
+#include "FrameAggregator.h"
+
+#include <string.h> //memcpy
+
+FrameAggregator::FrameAggregator(const uint8_t framesPerPackage, const unsigned int maximumFrameSize) :
+    framesPerPackage(framesPerPackage), maximumFrameSize(maximumFrameSize), numberOfFrames(0), payloadSize(0)
+{
+    payloadBuffer = new uint8_t[getMaximumPayloadSize(framesPerPackage, maximumFrameSize)];
+}
+
+FrameAggregator::~FrameAggregator()
+{
+    delete[] payloadBuffer;
+}
+
+bool FrameAggregator::addFrame(const void* frame, const unsigned int frameSize)
+{
+    if(numberOfFrames == framesPerPackage)
+    {
+        //start new package
+        numberOfFrames = 0;
+    }
+    if(numberOfFrames == 0)
+    {
+        //the frame-lengths are stored in front of the frames
+        payloadSize = 1 + framesPerPackage * sizeof(uint16_t);
+    }
+    const unsigned int size = frameSize > maximumFrameSize ? maximumFrameSize : frameSize;
+    payloadBuffer[1 + numberOfFrames * sizeof(uint16_t)] = (uint8_t)(size >> 8);
+    payloadBuffer[1 + numberOfFrames * sizeof(uint16_t) + 1] = (uint8_t)(size & 0xFF);
+    memcpy(payloadBuffer + payloadSize, frame, size);
+    payloadSize += size;
+    numberOfFrames++;
+    payloadBuffer[0] = numberOfFrames;
+    return numberOfFrames == framesPerPackage;
+}
+
+void FrameAggregator::reset()
+{
+    numberOfFrames = 0;
+    payloadSize = 0;
+}
+
+const void* FrameAggregator::getPayload() const
+{
+    return payloadBuffer;
+}
+
+unsigned int FrameAggregator::getPayloadSize() const
+{
+    return payloadSize;
+}
+
+uint8_t FrameAggregator::getFramesPerPackage() const
+{
+    return framesPerPackage;
+}
+
+unsigned int FrameAggregator::getMaximumPayloadSize(const uint8_t framesPerPackage, const unsigned int maximumFrameSize)
+{
+    return 1 + framesPerPackage * (sizeof(uint16_t) + maximumFrameSize);
+}
+
+uint8_t FrameAggregator::getNumberOfFrames(const void* payload, const unsigned int payloadSize)
+{
+    if(payloadSize < 1)
+    {
+        return 0;
+    }
+    const uint8_t numberOfFrames = ((const uint8_t*)payload)[0];
+    if(payloadSize < 1 + numberOfFrames * sizeof(uint16_t))
+    {
+        return 0;
+    }
+    return numberOfFrames;
+}
+
+const void* FrameAggregator::getFrame(const void* payload, const unsigned int payloadSize, const uint8_t index, unsigned int& frameSize)
+{
+    const uint8_t* buffer = (const uint8_t*)payload;
+    const uint8_t numberOfFrames = getNumberOfFrames(payload, payloadSize);
+    if(index >= numberOfFrames)
+    {
+        return nullptr;
+    }
+    unsigned int offset = 1 + numberOfFrames * sizeof(uint16_t);
+    for(uint8_t i = 0; i < index; i++)
+    {
+        offset += (buffer[1 + i * sizeof(uint16_t)] << 8) | buffer[1 + i * sizeof(uint16_t) + 1];
+    }
+    frameSize = (buffer[1 + index * sizeof(uint16_t)] << 8) | buffer[1 + index * sizeof(uint16_t) + 1];
+    if(offset + frameSize > payloadSize)
+    {
+        //malformed payload
+        return nullptr;
+    }
+    return buffer + offset;
+}
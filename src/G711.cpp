@@ -0,0 +1,354 @@
+#include "G711.h"
+
+#include "SIMD.h"
+
+//the bias added to the 14 bit μ-law magnitude before the segment is determined and the maximum biased magnitude
+static const int MU_LAW_BIAS = 33;
+static const int MU_LAW_CLIP = 0x1FFF;
+//the codes are transmitted with inverted bits (μ-law) or with every even bit inverted (A-law)
+static const uint8_t MU_LAW_MASK = 0xFF;
+static const uint8_t A_LAW_MASK = 0xD5;
+//a biased magnitude with its leading bit at position n + 5 (μ-law) or n + 4 (A-law) belongs to segment n.
+//Converted to float, the exponent and the 4 most significant bits of the mantissa are (segment << 4 | mantissa)
+//plus these offsets (the biased exponent of the first segment, shifted to the position of the segment)
+static const int MU_LAW_FLOAT_OFFSET = (127 + 5) << 4;
+static const int A_LAW_FLOAT_OFFSET = (127 + 4) << 4;
+//the lowest A-law magnitude, whose segment is determined by its leading bit
+static const int A_LAW_LINEAR_LIMIT = 32;
+
+////
+// Scalar implementation, after the reference implementation (g711.c) of ITU-T G.191
+////
+
+uint8_t G711::encodeMuLaw(const int16_t sample)
+{
+    //14 bit magnitude, the negative values are one's complement
+    const uint8_t mask = sample < 0 ? 0x7F : MU_LAW_MASK;
+    int magnitude = ((sample < 0 ? ~sample : sample) >> 2) + MU_LAW_BIAS;
+    if(magnitude > MU_LAW_CLIP)
+    {
+        magnitude = MU_LAW_CLIP;
+    }
+    unsigned int segment = 0;
+    while(magnitude >= (0x40 << segment))
+    {
+        segment++;
+    }
+    return (uint8_t)(((segment << 4) | ((magnitude >> (segment + 1)) & 0x0F)) ^ mask);
+}
+
+uint8_t G711::encodeALaw(const int16_t sample)
+{
+    //13 bit magnitude, the negative values are one's complement
+    const uint8_t mask = sample < 0 ? 0x55 : A_LAW_MASK;
+    const int magnitude = (sample < 0 ? ~sample : sample) >> 3;
+    unsigned int segment = 0;
+    while(magnitude >= (0x20 << segment))
+    {
+        segment++;
+    }
+    const unsigned int mantissa = segment < 2 ? (magnitude >> 1) & 0x0F : (magnitude >> segment) & 0x0F;
+    return (uint8_t)(((segment << 4) | mantissa) ^ mask);
+}
+
+static int16_t decodeMuLaw(const uint8_t code)
+{
+    const uint8_t value = ~code;
+    const int magnitude = ((((value & 0x0F) << 3) + 0x84) << ((value & 0x70) >> 4)) - 0x84;
+    return (int16_t)((value & 0x80) ? -magnitude : magnitude);
+}
+
+static int16_t decodeALaw(const uint8_t code)
+{
+    const uint8_t value = code ^ 0x55;
+    int magnitude = (value & 0x0F) << 4;
+    const unsigned int segment = (value & 0x70) >> 4;
+    if(segment == 0)
+    {
+        magnitude += 8;
+    }
+    else
+    {
+        magnitude = (magnitude + 0x108) << (segment - 1);
+    }
+    return (int16_t)((value & 0x80) ? magnitude : -magnitude);
+}
+
+/*!
+ * The decoding-tables for both laws, created on first use
+ */
+struct DecodingTables
+{
+    int16_t muLaw[256];
+    int16_t aLaw[256];
+
+    DecodingTables()
+    {
+        for(unsigned int code = 0; code < 256; code++)
+        {
+            muLaw[code] = decodeMuLaw((uint8_t)code);
+            aLaw[code] = decodeALaw((uint8_t)code);
+        }
+    }
+
+    static const DecodingTables& getInstance()
+    {
+        //thread-safe initialization since C++11
+        static const DecodingTables tables;
+        return tables;
+    }
+};
+
+static void encodeMuLawScalar(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples)
+{
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        encoded[i] = G711::encodeMuLaw(samples[i]);
+    }
+}
+
+static void encodeALawScalar(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples)
+{
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        encoded[i] = G711::encodeALaw(samples[i]);
+    }
+}
+
+////
+// Vectorized implementations
+//
+// All samples are loaded before the codes are stored, so the encoding also works in-place
+////
+
+#if defined(SIMD_X86)
+
+/*!
+ * \return the segment and mantissa of the 8 biased magnitudes (both halves as 32 bit integers), minus the offset
+ */
+SIMD_TARGET_SSE2 static inline __m128i toSegmentsSSE2(const __m128i magnitudes, const int offset)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low = _mm_castps_si128(_mm_cvtepi32_ps(_mm_unpacklo_epi16(magnitudes, zero)));
+    const __m128i high = _mm_castps_si128(_mm_cvtepi32_ps(_mm_unpackhi_epi16(magnitudes, zero)));
+    const __m128i offsets = _mm_set1_epi32(offset);
+    return _mm_packs_epi32(_mm_sub_epi32(_mm_srli_epi32(low, 19), offsets), _mm_sub_epi32(_mm_srli_epi32(high, 19), offsets));
+}
+
+SIMD_TARGET_SSE2 static inline __m128i encodeMuLawSSE2(const __m128i samples)
+{
+    const __m128i negative = _mm_cmplt_epi16(samples, _mm_setzero_si128());
+    //one's complement
+    __m128i magnitudes = _mm_srai_epi16(_mm_xor_si128(samples, negative), 2);
+    magnitudes = _mm_min_epi16(_mm_add_epi16(magnitudes, _mm_set1_epi16(MU_LAW_BIAS)), _mm_set1_epi16(MU_LAW_CLIP));
+    const __m128i codes = toSegmentsSSE2(magnitudes, MU_LAW_FLOAT_OFFSET);
+    const __m128i masks = _mm_xor_si128(_mm_set1_epi16(MU_LAW_MASK), _mm_and_si128(negative, _mm_set1_epi16(0x80)));
+    return _mm_xor_si128(codes, masks);
+}
+
+SIMD_TARGET_SSE2 static inline __m128i encodeALawSSE2(const __m128i samples)
+{
+    const __m128i negative = _mm_cmplt_epi16(samples, _mm_setzero_si128());
+    //one's complement
+    const __m128i magnitudes = _mm_srai_epi16(_mm_xor_si128(samples, negative), 3);
+    //the magnitudes of the first two segments are linear
+    const __m128i isLinear = _mm_cmplt_epi16(magnitudes, _mm_set1_epi16(A_LAW_LINEAR_LIMIT));
+    const __m128i linear = _mm_srli_epi16(magnitudes, 1);
+    const __m128i logarithmic = toSegmentsSSE2(magnitudes, A_LAW_FLOAT_OFFSET);
+    const __m128i codes = _mm_or_si128(_mm_and_si128(isLinear, linear), _mm_andnot_si128(isLinear, logarithmic));
+    const __m128i masks = _mm_xor_si128(_mm_set1_epi16(A_LAW_MASK), _mm_and_si128(negative, _mm_set1_epi16(0x80)));
+    return _mm_xor_si128(codes, masks);
+}
+
+template<__m128i (*encodeVector)(const __m128i)>
+SIMD_TARGET_SSE2 static void encodeSSE2(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples,
+                                        uint8_t (*encodeSample)(const int16_t))
+{
+    unsigned int i = 0;
+    for(; i + 16 <= numberOfSamples; i += 16)
+    {
+        const __m128i first = _mm_loadu_si128((const __m128i*)(samples + i));
+        const __m128i second = _mm_loadu_si128((const __m128i*)(samples + i + 8));
+        _mm_storeu_si128((__m128i*)(encoded + i), _mm_packus_epi16(encodeVector(first), encodeVector(second)));
+    }
+    for(; i < numberOfSamples; i++)
+    {
+        encoded[i] = encodeSample(samples[i]);
+    }
+}
+
+SIMD_TARGET_SSE2 static void encodeMuLawKernelSSE2(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples)
+{
+    encodeSSE2<encodeMuLawSSE2>(samples, encoded, numberOfSamples, G711::encodeMuLaw);
+}
+
+SIMD_TARGET_SSE2 static void encodeALawKernelSSE2(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples)
+{
+    encodeSSE2<encodeALawSSE2>(samples, encoded, numberOfSamples, G711::encodeALaw);
+}
+
+/*!
+ * \return the codes of the 8 samples as 32 bit integers, calculated like the SSE2 version
+ */
+SIMD_TARGET_AVX2 static inline __m256i encodeMuLawAVX2(const __m256i samples)
+{
+    const __m256i negative = _mm256_cmpgt_epi32(_mm256_setzero_si256(), samples);
+    __m256i magnitudes = _mm256_srai_epi32(_mm256_xor_si256(samples, negative), 2);
+    magnitudes = _mm256_min_epi32(_mm256_add_epi32(magnitudes, _mm256_set1_epi32(MU_LAW_BIAS)), _mm256_set1_epi32(MU_LAW_CLIP));
+    const __m256i codes = _mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(magnitudes)), 19), _mm256_set1_epi32(MU_LAW_FLOAT_OFFSET));
+    const __m256i masks = _mm256_xor_si256(_mm256_set1_epi32(MU_LAW_MASK), _mm256_and_si256(negative, _mm256_set1_epi32(0x80)));
+    return _mm256_xor_si256(codes, masks);
+}
+
+SIMD_TARGET_AVX2 static inline __m256i encodeALawAVX2(const __m256i samples)
+{
+    const __m256i negative = _mm256_cmpgt_epi32(_mm256_setzero_si256(), samples);
+    const __m256i magnitudes = _mm256_srai_epi32(_mm256_xor_si256(samples, negative), 3);
+    const __m256i isLinear = _mm256_cmpgt_epi32(_mm256_set1_epi32(A_LAW_LINEAR_LIMIT), magnitudes);
+    const __m256i linear = _mm256_srli_epi32(magnitudes, 1);
+    const __m256i logarithmic = _mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(magnitudes)), 19), _mm256_set1_epi32(A_LAW_FLOAT_OFFSET));
+    const __m256i codes = _mm256_blendv_epi8(logarithmic, linear, isLinear);
+    const __m256i masks = _mm256_xor_si256(_mm256_set1_epi32(A_LAW_MASK), _mm256_and_si256(negative, _mm256_set1_epi32(0x80)));
+    return _mm256_xor_si256(codes, masks);
+}
+
+template<__m256i (*encodeVector)(const __m256i)>
+SIMD_TARGET_AVX2 static void encodeAVX2(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples,
+                                        uint8_t (*encodeSample)(const int16_t))
+{
+    unsigned int i = 0;
+    for(; i + 16 <= numberOfSamples; i += 16)
+    {
+        const __m256i first = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(samples + i)));
+        const __m256i second = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(samples + i + 8)));
+        const __m256i firstCodes = encodeVector(first);
+        const __m256i secondCodes = encodeVector(second);
+        //the packing instructions work per 128 bit lane, so the lanes are packed explicitly to keep the order
+        const __m128i firstWords = _mm_packs_epi32(_mm256_castsi256_si128(firstCodes), _mm256_extracti128_si256(firstCodes, 1));
+        const __m128i secondWords = _mm_packs_epi32(_mm256_castsi256_si128(secondCodes), _mm256_extracti128_si256(secondCodes, 1));
+        _mm_storeu_si128((__m128i*)(encoded + i), _mm_packus_epi16(firstWords, secondWords));
+    }
+    for(; i < numberOfSamples; i++)
+    {
+        encoded[i] = encodeSample(samples[i]);
+    }
+}
+
+SIMD_TARGET_AVX2 static void encodeMuLawKernelAVX2(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples)
+{
+    encodeAVX2<encodeMuLawAVX2>(samples, encoded, numberOfSamples, G711::encodeMuLaw);
+}
+
+SIMD_TARGET_AVX2 static void encodeALawKernelAVX2(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples)
+{
+    encodeAVX2<encodeALawAVX2>(samples, encoded, numberOfSamples, G711::encodeALaw);
+}
+
+#elif defined(SIMD_NEON)
+
+/*!
+ * \return the segment and mantissa of the 8 biased magnitudes, minus the offset
+ */
+static inline int16x8_t toSegmentsNEON(const int16x8_t magnitudes, const int offset)
+{
+    const int32x4_t offsets = vdupq_n_s32(offset);
+    const int32x4_t low = vreinterpretq_s32_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(magnitudes))));
+    const int32x4_t high = vreinterpretq_s32_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(magnitudes))));
+    return vcombine_s16(vmovn_s32(vsubq_s32(vshrq_n_s32(low, 19), offsets)), vmovn_s32(vsubq_s32(vshrq_n_s32(high, 19), offsets)));
+}
+
+static inline uint8x8_t encodeMuLawNEON(const int16x8_t samples)
+{
+    const int16x8_t negative = vreinterpretq_s16_u16(vcltq_s16(samples, vdupq_n_s16(0)));
+    int16x8_t magnitudes = vshrq_n_s16(veorq_s16(samples, negative), 2);
+    magnitudes = vminq_s16(vaddq_s16(magnitudes, vdupq_n_s16(MU_LAW_BIAS)), vdupq_n_s16(MU_LAW_CLIP));
+    const int16x8_t codes = toSegmentsNEON(magnitudes, MU_LAW_FLOAT_OFFSET);
+    const int16x8_t masks = veorq_s16(vdupq_n_s16(MU_LAW_MASK), vandq_s16(negative, vdupq_n_s16(0x80)));
+    return vmovn_u16(vreinterpretq_u16_s16(veorq_s16(codes, masks)));
+}
+
+static inline uint8x8_t encodeALawNEON(const int16x8_t samples)
+{
+    const int16x8_t negative = vreinterpretq_s16_u16(vcltq_s16(samples, vdupq_n_s16(0)));
+    const int16x8_t magnitudes = vshrq_n_s16(veorq_s16(samples, negative), 3);
+    const uint16x8_t isLinear = vcltq_s16(magnitudes, vdupq_n_s16(A_LAW_LINEAR_LIMIT));
+    const int16x8_t codes = vbslq_s16(isLinear, vshrq_n_s16(magnitudes, 1), toSegmentsNEON(magnitudes, A_LAW_FLOAT_OFFSET));
+    const int16x8_t masks = veorq_s16(vdupq_n_s16(A_LAW_MASK), vandq_s16(negative, vdupq_n_s16(0x80)));
+    return vmovn_u16(vreinterpretq_u16_s16(veorq_s16(codes, masks)));
+}
+
+template<uint8x8_t (*encodeVector)(const int16x8_t)>
+static void encodeNEON(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples, uint8_t (*encodeSample)(const int16_t))
+{
+    unsigned int i = 0;
+    for(; i + 16 <= numberOfSamples; i += 16)
+    {
+        const int16x8_t first = vld1q_s16(samples + i);
+        const int16x8_t second = vld1q_s16(samples + i + 8);
+        vst1q_u8(encoded + i, vcombine_u8(encodeVector(first), encodeVector(second)));
+    }
+    for(; i < numberOfSamples; i++)
+    {
+        encoded[i] = encodeSample(samples[i]);
+    }
+}
+
+static void encodeMuLawKernelNEON(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples)
+{
+    encodeNEON<encodeMuLawNEON>(samples, encoded, numberOfSamples, G711::encodeMuLaw);
+}
+
+static void encodeALawKernelNEON(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples)
+{
+    encodeNEON<encodeALawNEON>(samples, encoded, numberOfSamples, G711::encodeALaw);
+}
+
+#endif
+
+G711::G711(const Law law, const FormatConverter::InstructionSet instructionSet) :
+    law(law), instructionSet(FormatConverter::InstructionSet::SCALAR), encodeKernel(law == Law::MU_LAW ? encodeMuLawScalar : encodeALawScalar),
+    decodingTable(law == Law::MU_LAW ? DecodingTables::getInstance().muLaw : DecodingTables::getInstance().aLaw)
+{
+#if defined(SIMD_X86)
+    if(instructionSet == FormatConverter::InstructionSet::AVX2 && cpuSupportsAVX2())
+    {
+        this->instructionSet = FormatConverter::InstructionSet::AVX2;
+        encodeKernel = law == Law::MU_LAW ? encodeMuLawKernelAVX2 : encodeALawKernelAVX2;
+    }
+    else if(instructionSet == FormatConverter::InstructionSet::SSE2 || instructionSet == FormatConverter::InstructionSet::AVX2)
+    {
+        this->instructionSet = FormatConverter::InstructionSet::SSE2;
+        encodeKernel = law == Law::MU_LAW ? encodeMuLawKernelSSE2 : encodeALawKernelSSE2;
+    }
+#elif defined(SIMD_NEON)
+    if(instructionSet == FormatConverter::InstructionSet::NEON)
+    {
+        this->instructionSet = FormatConverter::InstructionSet::NEON;
+        encodeKernel = law == Law::MU_LAW ? encodeMuLawKernelNEON : encodeALawKernelNEON;
+    }
+#endif
+}
+
+void G711::encode(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples) const
+{
+    encodeKernel(samples, encoded, numberOfSamples);
+}
+
+void G711::decode(const uint8_t* encoded, int16_t* samples, const unsigned int numberOfSamples) const
+{
+    //backwards, so the expansion also works in-place
+    for(unsigned int i = numberOfSamples; i > 0; i--)
+    {
+        samples[i - 1] = decodingTable[encoded[i - 1]];
+    }
+}
+
+G711::Law G711::getLaw() const
+{
+    return law;
+}
+
+FormatConverter::InstructionSet G711::getInstructionSet() const
+{
+    return instructionSet;
+}
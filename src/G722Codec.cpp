@@ -0,0 +1,373 @@
+#include "G722Codec.h"
+
+#include <string.h> //memcpy, memmove
+
+#include "SIMD.h"
+
+//the number of samples of the previous calls required by the QMF
+static const unsigned int HISTORY = 22;
+
+//The QMF coefficients (G.722, table 11) arranged for the 24 samples ending with the current pair of samples.
+//The transmit-QMF calculates the low band from the sum and the high band from the difference of the even and odd polyphase-filters
+alignas(16) static const int16_t TRANSMIT_LOW[24] = {
+    3, -11, -11, 53, 12, -156, 32, 362, -210, -805, 951, 3876, 3876, 951, -805, -210, 362, 32, -156, 12, 53, -11, -11, 3
+};
+alignas(16) static const int16_t TRANSMIT_HIGH[24] = {
+    -3, -11, 11, 53, -12, -156, -32, 362, 210, -805, -951, 3876, -3876, 951, 805, -210, -362, 32, 156, 12, -53, -11, 11, 3
+};
+//the receive-QMF calculates the first output-sample from the odd and the second from the even polyphase-filter
+alignas(16) static const int16_t RECEIVE_FIRST[24] = {
+    0, -11, 0, 53, 0, -156, 0, 362, 0, -805, 0, 3876, 0, 951, 0, -210, 0, 32, 0, 12, 0, -11, 0, 3
+};
+alignas(16) static const int16_t RECEIVE_SECOND[24] = {
+    3, 0, -11, 0, 12, 0, 32, 0, -210, 0, 951, 0, 3876, 0, -805, 0, 362, 0, -156, 0, 53, 0, -11, 0
+};
+
+//the decision levels of the 6 bit low band quantizer
+static const int Q6[32] = {
+    0, 35, 72, 110, 150, 190, 233, 276, 323, 370, 422, 473, 530, 587, 650, 714,
+    786, 858, 940, 1023, 1121, 1219, 1339, 1458, 1612, 1765, 1980, 2195, 2557, 2919, 0, 0
+};
+//the 6 bit codes of the quantizer intervals for negative and positive differences
+static const int ILN[32] = {
+    0, 63, 62, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 0
+};
+static const int ILP[32] = {
+    0, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 0
+};
+//the output-levels of the 6 bit and the 4 bit (used for the prediction) inverse low band quantizer
+static const int QM6[64] = {
+    -136, -136, -136, -136, -24808, -21904, -19008, -16704, -14984, -13512, -12280, -11192, -10232, -9360, -8576, -7856,
+    -7192, -6576, -6000, -5456, -4944, -4464, -4008, -3576, -3168, -2776, -2400, -2032, -1688, -1360, -1040, -728,
+    24808, 21904, 19008, 16704, 14984, 13512, 12280, 11192, 10232, 9360, 8576, 7856, 7192, 6576, 6000, 5456,
+    4944, 4464, 4008, 3576, 3168, 2776, 2400, 2032, 1688, 1360, 1040, 728, 432, 136, -432, -136
+};
+static const int QM4[16] = {
+    0, -20456, -12896, -8968, -6288, -4240, -2584, -1200, 20456, 12896, 8968, 6288, 4240, 2584, 1200, 0
+};
+//the low band scale-factor multipliers and the mapping of the 4 bit codes to them
+static const int WL[8] = {-60, -30, 58, 172, 334, 538, 1198, 3042};
+static const int RL42[16] = {0, 7, 6, 5, 4, 3, 2, 1, 7, 6, 5, 4, 3, 2, 1, 0};
+//the inverse logarithmic scale-factors
+static const int ILB[32] = {
+    2048, 2093, 2139, 2186, 2233, 2282, 2332, 2383, 2435, 2489, 2543, 2599, 2656, 2714, 2774, 2834,
+    2896, 2960, 3025, 3091, 3158, 3228, 3298, 3371, 3444, 3520, 3597, 3676, 3756, 3838, 3922, 4008
+};
+//the 2 bit high band codes, output-levels and scale-factor multipliers
+static const int IHN[3] = {0, 1, 0};
+static const int IHP[3] = {0, 3, 2};
+static const int QM2[4] = {-7408, -1616, 7408, 1616};
+static const int WH[3] = {0, -214, 798};
+static const int RH2[4] = {2, 1, 2, 1};
+
+//the limits of the logarithmic scale-factors of the low and the high band
+static const int MAXIMUM_NB_LOW = 18432;
+static const int MAXIMUM_NB_HIGH = 22528;
+
+static inline int saturate(const int value)
+{
+    return value > 32767 ? 32767 : (value < -32768 ? -32768 : value);
+}
+
+/*!
+ * Adapts the logarithmic scale-factor (LOGSCL/LOGSCH) and calculates the linear scale-factor (SCALEL/SCALEH)
+ *
+ * \param shift The shift of the scale-factor, 8 for the low band and 10 for the high band
+ */
+static inline void adaptScaleFactor(int& nb, int& det, const int multiplier, const int maximum, const int shift)
+{
+    nb = ((nb * 127) >> 7) + multiplier;
+    nb = nb < 0 ? 0 : (nb > maximum ? maximum : nb);
+    const int exponent = shift - (nb >> 11);
+    const int scale = ILB[(nb >> 6) & 31];
+    det = (exponent < 0 ? scale << -exponent : scale >> exponent) << 2;
+}
+
+////
+// QMF filter-kernels
+////
+
+static void filterScalar(const int16_t* signal, const unsigned int numberOfPairs, const int16_t* firstCoefficients,
+                         const int16_t* secondCoefficients, int32_t* first, int32_t* second)
+{
+    for(unsigned int j = 0; j < numberOfPairs; j++)
+    {
+        const int16_t* window = signal + 2 * j;
+        int32_t firstSum = 0;
+        int32_t secondSum = 0;
+        for(unsigned int k = 0; k < 24; k++)
+        {
+            firstSum += window[k] * firstCoefficients[k];
+            secondSum += window[k] * secondCoefficients[k];
+        }
+        first[j] = firstSum;
+        second[j] = secondSum;
+    }
+}
+
+#if defined(SIMD_X86)
+
+SIMD_TARGET_SSE2 static void filterSSE2(const int16_t* signal, const unsigned int numberOfPairs, const int16_t* firstCoefficients,
+                                        const int16_t* secondCoefficients, int32_t* first, int32_t* second)
+{
+    const __m128i first0 = _mm_load_si128((const __m128i*)firstCoefficients);
+    const __m128i first1 = _mm_load_si128((const __m128i*)(firstCoefficients + 8));
+    const __m128i first2 = _mm_load_si128((const __m128i*)(firstCoefficients + 16));
+    const __m128i second0 = _mm_load_si128((const __m128i*)secondCoefficients);
+    const __m128i second1 = _mm_load_si128((const __m128i*)(secondCoefficients + 8));
+    const __m128i second2 = _mm_load_si128((const __m128i*)(secondCoefficients + 16));
+    for(unsigned int j = 0; j < numberOfPairs; j++)
+    {
+        const int16_t* window = signal + 2 * j;
+        const __m128i x0 = _mm_loadu_si128((const __m128i*)window);
+        const __m128i x1 = _mm_loadu_si128((const __m128i*)(window + 8));
+        const __m128i x2 = _mm_loadu_si128((const __m128i*)(window + 16));
+        //the products of the 16 bit samples and coefficients are exact in 32 bit
+        const __m128i firstSums = _mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(x0, first0), _mm_madd_epi16(x1, first1)), _mm_madd_epi16(x2, first2));
+        const __m128i secondSums = _mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(x0, second0), _mm_madd_epi16(x1, second1)), _mm_madd_epi16(x2, second2));
+        //horizontal sums of both filters: (f0 + f2, s0 + s2, f1 + f3, s1 + s3)
+        __m128i sums = _mm_add_epi32(_mm_unpacklo_epi32(firstSums, secondSums), _mm_unpackhi_epi32(firstSums, secondSums));
+        sums = _mm_add_epi32(sums, _mm_srli_si128(sums, 8));
+        first[j] = _mm_cvtsi128_si32(sums);
+        second[j] = _mm_cvtsi128_si32(_mm_srli_si128(sums, 4));
+    }
+}
+
+#elif defined(SIMD_NEON)
+
+static inline int32_t dotProductNEON(const int16x8_t x0, const int16x8_t x1, const int16x8_t x2, const int16_t* coefficients)
+{
+    int32x4_t sums = vmull_s16(vget_low_s16(x0), vld1_s16(coefficients));
+    sums = vmlal_s16(sums, vget_high_s16(x0), vld1_s16(coefficients + 4));
+    sums = vmlal_s16(sums, vget_low_s16(x1), vld1_s16(coefficients + 8));
+    sums = vmlal_s16(sums, vget_high_s16(x1), vld1_s16(coefficients + 12));
+    sums = vmlal_s16(sums, vget_low_s16(x2), vld1_s16(coefficients + 16));
+    sums = vmlal_s16(sums, vget_high_s16(x2), vld1_s16(coefficients + 20));
+    return vaddvq_s32(sums);
+}
+
+static void filterNEON(const int16_t* signal, const unsigned int numberOfPairs, const int16_t* firstCoefficients,
+                       const int16_t* secondCoefficients, int32_t* first, int32_t* second)
+{
+    for(unsigned int j = 0; j < numberOfPairs; j++)
+    {
+        const int16_t* window = signal + 2 * j;
+        const int16x8_t x0 = vld1q_s16(window);
+        const int16x8_t x1 = vld1q_s16(window + 8);
+        const int16x8_t x2 = vld1q_s16(window + 16);
+        first[j] = dotProductNEON(x0, x1, x2, firstCoefficients);
+        second[j] = dotProductNEON(x0, x1, x2, secondCoefficients);
+    }
+}
+
+#endif
+
+G722Codec::G722Codec(const FormatConverter::InstructionSet instructionSet) :
+    instructionSet(FormatConverter::InstructionSet::SCALAR), filterKernel(filterScalar), encoderSignal(HISTORY, 0), decoderSignal(HISTORY, 0),
+    firstOutputs(), secondOutputs()
+{
+#if defined(SIMD_X86)
+    if(instructionSet == FormatConverter::InstructionSet::SSE2 || instructionSet == FormatConverter::InstructionSet::AVX2)
+    {
+        this->instructionSet = FormatConverter::InstructionSet::SSE2;
+        filterKernel = filterSSE2;
+    }
+#elif defined(SIMD_NEON)
+    if(instructionSet == FormatConverter::InstructionSet::NEON)
+    {
+        this->instructionSet = FormatConverter::InstructionSet::NEON;
+        filterKernel = filterNEON;
+    }
+#endif
+    reset();
+}
+
+unsigned int G722Codec::encode(const int16_t* samples, uint8_t* encoded, const unsigned int numberOfSamples)
+{
+    const unsigned int numberOfPairs = numberOfSamples / 2;
+    //the samples are copied before any byte is written, so the encoding works in-place
+    encoderSignal.resize(HISTORY + 2 * numberOfPairs);
+    memcpy(encoderSignal.data() + HISTORY, samples, 2 * numberOfPairs * sizeof(int16_t));
+    firstOutputs.resize(numberOfPairs);
+    secondOutputs.resize(numberOfPairs);
+    filterKernel(encoderSignal.data(), numberOfPairs, TRANSMIT_LOW, TRANSMIT_HIGH, firstOutputs.data(), secondOutputs.data());
+    memmove(encoderSignal.data(), encoderSignal.data() + 2 * numberOfPairs, HISTORY * sizeof(int16_t));
+
+    Band& low = encoderBands[0];
+    Band& high = encoderBands[1];
+    for(unsigned int j = 0; j < numberOfPairs; j++)
+    {
+        const int xlow = firstOutputs[j] >> 14;
+        const int xhigh = secondOutputs[j] >> 14;
+
+        //low band: SUBTRA, QUANTL
+        const int el = saturate(xlow - low.s);
+        int magnitude = el >= 0 ? el : -(el + 1);
+        unsigned int interval = 1;
+        while(interval < 30 && magnitude >= ((Q6[interval] * low.det) >> 12))
+        {
+            interval++;
+        }
+        const int ilow = el < 0 ? ILN[interval] : ILP[interval];
+        //INVQAL, LOGSCL, SCALEL
+        const int ril = ilow >> 2;
+        const int dlow = (low.det * QM4[ril]) >> 15;
+        adaptScaleFactor(low.nb, low.det, WL[RL42[ril]], MAXIMUM_NB_LOW, 8);
+        updatePredictor(low, dlow);
+
+        //high band: SUBTRA, QUANTH
+        const int eh = saturate(xhigh - high.s);
+        magnitude = eh >= 0 ? eh : -(eh + 1);
+        const int mih = magnitude >= ((564 * high.det) >> 12) ? 2 : 1;
+        const int ihigh = eh < 0 ? IHN[mih] : IHP[mih];
+        //INVQAH, LOGSCH, SCALEH
+        const int dhigh = (high.det * QM2[ihigh]) >> 15;
+        adaptScaleFactor(high.nb, high.det, WH[RH2[ihigh]], MAXIMUM_NB_HIGH, 10);
+        updatePredictor(high, dhigh);
+
+        encoded[j] = (uint8_t)((ihigh << 6) | ilow);
+    }
+    return numberOfPairs;
+}
+
+unsigned int G722Codec::decode(const uint8_t* encoded, int16_t* samples, const unsigned int numberOfBytes)
+{
+    //all bytes are decoded into the QMF-signal before any sample is written, so the decoding works in-place
+    decoderSignal.resize(HISTORY + 2 * numberOfBytes);
+    Band& low = decoderBands[0];
+    Band& high = decoderBands[1];
+    for(unsigned int j = 0; j < numberOfBytes; j++)
+    {
+        const int ilow = encoded[j] & 0x3F;
+        const int ihigh = (encoded[j] >> 6) & 0x03;
+
+        //low band: INVQBL, RECONS, LIMIT
+        int rlow = low.s + ((low.det * QM6[ilow]) >> 15);
+        rlow = rlow > 16383 ? 16383 : (rlow < -16384 ? -16384 : rlow);
+        //INVQAL, LOGSCL, SCALEL
+        const int ril = ilow >> 2;
+        const int dlow = (low.det * QM4[ril]) >> 15;
+        adaptScaleFactor(low.nb, low.det, WL[RL42[ril]], MAXIMUM_NB_LOW, 8);
+        updatePredictor(low, dlow);
+
+        //high band: INVQAH, RECONS, LIMIT
+        const int dhigh = (high.det * QM2[ihigh]) >> 15;
+        int rhigh = high.s + dhigh;
+        rhigh = rhigh > 16383 ? 16383 : (rhigh < -16384 ? -16384 : rhigh);
+        //LOGSCH, SCALEH
+        adaptScaleFactor(high.nb, high.det, WH[RH2[ihigh]], MAXIMUM_NB_HIGH, 10);
+        updatePredictor(high, dhigh);
+
+        decoderSignal[HISTORY + 2 * j] = (int16_t)(rlow + rhigh);
+        decoderSignal[HISTORY + 2 * j + 1] = (int16_t)(rlow - rhigh);
+    }
+
+    firstOutputs.resize(numberOfBytes);
+    secondOutputs.resize(numberOfBytes);
+    filterKernel(decoderSignal.data(), numberOfBytes, RECEIVE_FIRST, RECEIVE_SECOND, firstOutputs.data(), secondOutputs.data());
+    memmove(decoderSignal.data(), decoderSignal.data() + 2 * numberOfBytes, HISTORY * sizeof(int16_t));
+    for(unsigned int j = 0; j < numberOfBytes; j++)
+    {
+        samples[2 * j] = (int16_t)saturate(firstOutputs[j] >> 11);
+        samples[2 * j + 1] = (int16_t)saturate(secondOutputs[j] >> 11);
+    }
+    return 2 * numberOfBytes;
+}
+
+void G722Codec::reset()
+{
+    resetBand(encoderBands[0], 32);
+    resetBand(encoderBands[1], 8);
+    resetBand(decoderBands[0], 32);
+    resetBand(decoderBands[1], 8);
+    encoderSignal.assign(HISTORY, 0);
+    decoderSignal.assign(HISTORY, 0);
+}
+
+FormatConverter::InstructionSet G722Codec::getInstructionSet() const
+{
+    return instructionSet;
+}
+
+void G722Codec::resetBand(Band& band, const int det)
+{
+    memset(&band, 0, sizeof(Band));
+    band.det = det;
+}
+
+void G722Codec::updatePredictor(Band& band, const int d)
+{
+    //RECONS, PARREC
+    band.d[0] = d;
+    band.r[0] = saturate(band.s + d);
+    band.p[0] = saturate(band.sz + d);
+
+    //UPPOL2
+    for(unsigned int i = 0; i < 3; i++)
+    {
+        band.sg[i] = band.p[i] >> 15;
+    }
+    int wd1 = saturate(band.a[1] * 4);
+    int wd2 = band.sg[0] == band.sg[1] ? -wd1 : wd1;
+    if(wd2 > 32767)
+    {
+        wd2 = 32767;
+    }
+    int wd3 = (wd2 >> 7) + (band.sg[0] == band.sg[2] ? 128 : -128);
+    wd3 += (band.a[2] * 32512) >> 15;
+    band.ap[2] = wd3 > 12288 ? 12288 : (wd3 < -12288 ? -12288 : wd3);
+
+    //UPPOL1
+    wd1 = band.sg[0] == band.sg[1] ? 192 : -192;
+    wd2 = (band.a[1] * 32640) >> 15;
+    band.ap[1] = saturate(wd1 + wd2);
+    wd3 = saturate(15360 - band.ap[2]);
+    if(band.ap[1] > wd3)
+    {
+        band.ap[1] = wd3;
+    }
+    else if(band.ap[1] < -wd3)
+    {
+        band.ap[1] = -wd3;
+    }
+
+    //UPZERO
+    wd1 = d == 0 ? 0 : 128;
+    band.sg[0] = d >> 15;
+    for(unsigned int i = 1; i < 7; i++)
+    {
+        band.sg[i] = band.d[i] >> 15;
+        wd2 = band.sg[i] == band.sg[0] ? wd1 : -wd1;
+        wd3 = (band.b[i] * 32640) >> 15;
+        band.bp[i] = saturate(wd2 + wd3);
+    }
+
+    //DELAYA
+    for(unsigned int i = 6; i > 0; i--)
+    {
+        band.d[i] = band.d[i - 1];
+        band.b[i] = band.bp[i];
+    }
+    for(unsigned int i = 2; i > 0; i--)
+    {
+        band.r[i] = band.r[i - 1];
+        band.p[i] = band.p[i - 1];
+        band.a[i] = band.ap[i];
+    }
+
+    //FILTEP
+    wd1 = (band.a[1] * saturate(band.r[1] + band.r[1])) >> 15;
+    wd2 = (band.a[2] * saturate(band.r[2] + band.r[2])) >> 15;
+    band.sp = saturate(wd1 + wd2);
+
+    //FILTEZ
+    band.sz = 0;
+    for(unsigned int i = 6; i > 0; i--)
+    {
+        band.sz += (band.b[i] * saturate(band.d[i] + band.d[i])) >> 15;
+    }
+    band.sz = saturate(band.sz);
+
+    //PREDIC
+    band.s = saturate(band.sp + band.sz);
+}
@@ -0,0 +1,121 @@
+#include "LatencyHistogram.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*!
+ * \return the index of the highest bit set, the value must not be zero
+ */
+static inline unsigned int getHighestBit(const uint64_t value)
+{
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return index;
+#else
+    unsigned int index = 0;
+    while(value >> (index + 1))
+    {
+        index++;
+    }
+    return index;
+#endif
+}
+
+LatencyHistogram::LatencyHistogram() : buckets(NUMBER_OF_BUCKETS), count(0), total(0), maximum(0)
+{
+    reset();
+}
+
+void LatencyHistogram::record(const uint64_t nanoseconds)
+{
+    std::atomic<uint64_t>& bucket = buckets[getBucketIndex(nanoseconds)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    total.store(total.load(std::memory_order_relaxed) + nanoseconds, std::memory_order_relaxed);
+    if(nanoseconds > maximum.load(std::memory_order_relaxed))
+    {
+        maximum.store(nanoseconds, std::memory_order_relaxed);
+    }
+    //the count is written last, so a reader never sees more values counted than in the buckets
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+uint64_t LatencyHistogram::getCount() const
+{
+    return count.load(std::memory_order_acquire);
+}
+
+uint64_t LatencyHistogram::getTotal() const
+{
+    return total.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMaximum() const
+{
+    return maximum.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getPercentile(const double percentile) const
+{
+    const uint64_t numberOfValues = getCount();
+    if(numberOfValues == 0)
+    {
+        return 0;
+    }
+    //the rank of the value of the percentile, at least the first value
+    uint64_t rank = (uint64_t)(percentile / 100.0 * numberOfValues + 0.5);
+    rank = rank == 0 ? 1 : (rank > numberOfValues ? numberOfValues : rank);
+    uint64_t countedValues = 0;
+    for(unsigned int i = 0; i < NUMBER_OF_BUCKETS; i++)
+    {
+        countedValues += buckets[i].load(std::memory_order_relaxed);
+        if(countedValues >= rank)
+        {
+            //the last bucket also counts all larger values
+            const uint64_t limit = i + 1 < NUMBER_OF_BUCKETS ? getBucketLimit(i) : getMaximum();
+            return limit < getMaximum() ? limit : getMaximum();
+        }
+    }
+    return getMaximum();
+}
+
+void LatencyHistogram::reset()
+{
+    for(std::atomic<uint64_t>& bucket : buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    maximum.store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_release);
+}
+
+unsigned int LatencyHistogram::getBucketIndex(const uint64_t value)
+{
+    if(value < 2 * SUB_BUCKET_COUNT)
+    {
+        return (unsigned int)value;
+    }
+    const unsigned int highestBit = getHighestBit(value);
+    if(highestBit >= MAXIMUM_EXPONENT)
+    {
+        return NUMBER_OF_BUCKETS - 1;
+    }
+    //the value is split into the power of two and the next SUB_BUCKET_BITS bits below the highest bit
+    const unsigned int shift = highestBit - SUB_BUCKET_BITS;
+    return 2 * SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_COUNT + (unsigned int)((value >> shift) - SUB_BUCKET_COUNT);
+}
+
+uint64_t LatencyHistogram::getBucketLimit(const unsigned int index)
+{
+    if(index < 2 * SUB_BUCKET_COUNT)
+    {
+        return index;
+    }
+    const unsigned int shift = (index - 2 * SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT + 1;
+    const uint64_t subBucket = (index - 2 * SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+    return ((subBucket + 1) << shift) - 1;
+}
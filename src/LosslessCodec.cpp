@@ -0,0 +1,731 @@
+#include "LosslessCodec.h"
+
+#include <cmath>
+#include <utility>
+
+#include "SIMD.h"
+
+//the types of an encoded channel
+static const unsigned int TYPE_VERBATIM = 0;
+static const unsigned int TYPE_CONSTANT = 1;
+static const unsigned int TYPE_PREDICTED = 2;
+//the number of bits of the frame- and channel-headers and the predictor fields
+static const unsigned int FRAME_HEADER_BITS = 16;
+static const unsigned int CHANNEL_HEADER_BITS = 8;
+static const unsigned int SHIFT_BITS = 4;
+static const unsigned int PRECISION_BITS = 4;
+static const unsigned int RICE_PARAMETER_BITS = 5;
+static const unsigned int MAXIMUM_SHIFT = (1 << SHIFT_BITS) - 1;
+static const unsigned int MAXIMUM_RICE_PARAMETER = (1 << RICE_PARAMETER_BITS) - 1;
+static const unsigned int MAXIMUM_FRAMES = 0xFFFF;
+//the number of fixed polynomial predictors (of order 0 to 4), their coefficients and the precision required to store them
+static const unsigned int NUM_FIXED_PREDICTORS = 5;
+static const int32_t FIXED_COEFFICIENTS[NUM_FIXED_PREDICTORS][4] = {{0, 0, 0, 0}, {1, 0, 0, 0}, {2, -1, 0, 0}, {3, -3, 1, 0}, {4, -6, 4, -1}};
+static const unsigned int FIXED_PRECISION = 4;
+//the predicted value is clamped to this range, so the residual always fits into 32 bits
+static const int64_t PREDICTION_LIMIT = int64_t(1) << 30;
+
+////
+// Bit-stream
+////
+
+class BitWriter
+{
+public:
+    BitWriter(uint8_t* data, const unsigned int capacity) : data(data), capacity(capacity), position(0), accumulator(0), pendingBits(0), overflow(false)
+    {
+    }
+
+    void write(const uint32_t value, const unsigned int count)
+    {
+        accumulator = (accumulator << count) | (value & ((uint64_t(1) << count) - 1));
+        pendingBits += count;
+        while(pendingBits >= 8)
+        {
+            pendingBits -= 8;
+            put((uint8_t)(accumulator >> pendingBits));
+        }
+    }
+
+    void writeSigned(const int32_t value, const unsigned int count)
+    {
+        write((uint32_t)value, count);
+    }
+
+    //writes the value as zeroes followed by a one
+    void writeUnary(uint64_t value)
+    {
+        while(value >= 32)
+        {
+            write(0, 32);
+            value -= 32;
+        }
+        write(1, (unsigned int)value + 1);
+    }
+
+    void flush()
+    {
+        if(pendingBits > 0)
+        {
+            put((uint8_t)(accumulator << (8 - pendingBits)));
+            pendingBits = 0;
+        }
+    }
+
+    unsigned int getSize() const
+    {
+        return position;
+    }
+
+    bool hasOverflown() const
+    {
+        return overflow;
+    }
+
+private:
+    uint8_t* data;
+    const unsigned int capacity;
+    unsigned int position;
+    uint64_t accumulator;
+    unsigned int pendingBits;
+    bool overflow;
+
+    void put(const uint8_t byte)
+    {
+        if(position < capacity)
+        {
+            data[position++] = byte;
+        }
+        else
+        {
+            overflow = true;
+        }
+    }
+};
+
+class BitReader
+{
+public:
+    BitReader(const uint8_t* data, const unsigned int size) : data(data), size(size), position(0), accumulator(0), availableBits(0), overflow(false)
+    {
+    }
+
+    uint32_t read(const unsigned int count)
+    {
+        while(availableBits < count)
+        {
+            refill();
+        }
+        availableBits -= count;
+        return (uint32_t)((accumulator >> availableBits) & ((uint64_t(1) << count) - 1));
+    }
+
+    int32_t readSigned(const unsigned int count)
+    {
+        //sign-extend the value
+        const uint32_t value = read(count);
+        const uint32_t signBit = uint32_t(1) << (count - 1);
+        return (int32_t)((value ^ signBit) - signBit);
+    }
+
+    uint64_t readUnary()
+    {
+        uint64_t value = 0;
+        while(!overflow)
+        {
+            if(availableBits == 0)
+            {
+                refill();
+                continue;
+            }
+            if((accumulator & ((uint64_t(1) << availableBits) - 1)) == 0)
+            {
+                //all remaining bits are zeroes
+                value += availableBits;
+                availableBits = 0;
+                continue;
+            }
+            while(((accumulator >> (availableBits - 1)) & 1) == 0)
+            {
+                value++;
+                availableBits--;
+            }
+            availableBits--;
+            return value;
+        }
+        return 0;
+    }
+
+    bool hasOverflown() const
+    {
+        return overflow;
+    }
+
+private:
+    const uint8_t* data;
+    const unsigned int size;
+    unsigned int position;
+    uint64_t accumulator;
+    unsigned int availableBits;
+    bool overflow;
+
+    void refill()
+    {
+        //reading past the end yields zeroes and marks the stream as invalid
+        accumulator = (accumulator << 8) | (position < size ? data[position] : 0);
+        overflow |= position >= size;
+        position++;
+        availableBits += 8;
+    }
+};
+
+////
+// Residual calculation
+////
+
+static inline int64_t clampPrediction(const int64_t prediction)
+{
+    return prediction > PREDICTION_LIMIT ? PREDICTION_LIMIT : (prediction < -PREDICTION_LIMIT ? -PREDICTION_LIMIT : prediction);
+}
+
+static inline int32_t calculateResidualScalar(const double* signal, const unsigned int index, const double* coefficients, const unsigned int order,
+                                              const unsigned int shift)
+{
+    int64_t sum = 0;
+    for(unsigned int j = 0; j < order; j++)
+    {
+        sum += (int64_t)coefficients[j] * (int64_t)signal[index - 1 - j];
+    }
+    //the arithmetic shift rounds towards negative infinity, as the decoder does
+    return (int32_t)((int64_t)signal[index] - clampPrediction(sum >> shift));
+}
+
+static unsigned int getShift(const double scale)
+{
+    int exponent;
+    std::frexp(scale, &exponent);
+    return (unsigned int)(1 - exponent);
+}
+
+static void calculateResidualKernelScalar(const double* signal, const unsigned int numberOfSamples, const double* coefficients, const unsigned int order,
+                                          const double scale, int32_t* residual)
+{
+    const unsigned int shift = getShift(scale);
+    for(unsigned int i = order; i < numberOfSamples; i++)
+    {
+        residual[i - order] = calculateResidualScalar(signal, i, coefficients, order, shift);
+    }
+}
+
+#if defined(SIMD_X86)
+SIMD_TARGET_SSE2 static void calculateResidualKernelSSE2(const double* signal, const unsigned int numberOfSamples, const double* coefficients,
+                                                             const unsigned int order, const double scale, int32_t* residual)
+{
+    __m128d broadcastCoefficients[LosslessCodec::MAXIMUM_ORDER];
+    for(unsigned int j = 0; j < order; j++)
+    {
+        broadcastCoefficients[j] = _mm_set1_pd(coefficients[j]);
+    }
+    const __m128d factor = _mm_set1_pd(scale);
+    const __m128d upperLimit = _mm_set1_pd((double)PREDICTION_LIMIT);
+    const __m128d lowerLimit = _mm_set1_pd((double)-PREDICTION_LIMIT);
+    const __m128d one = _mm_set1_pd(1.0);
+    unsigned int i = order;
+    for(; i + 2 <= numberOfSamples; i += 2)
+    {
+        //the products and sums of up to 24 bit samples and 15 bit coefficients are exact in double-precision
+        __m128d sum = _mm_setzero_pd();
+        for(unsigned int j = 0; j < order; j++)
+        {
+            sum = _mm_add_pd(sum, _mm_mul_pd(broadcastCoefficients[j], _mm_loadu_pd(signal + i - 1 - j)));
+        }
+        __m128d prediction = _mm_min_pd(_mm_max_pd(_mm_mul_pd(sum, factor), lowerLimit), upperLimit);
+        //SSE2 has no floor, so truncate and correct the negative fractions
+        const __m128d truncated = _mm_cvtepi32_pd(_mm_cvttpd_epi32(prediction));
+        prediction = _mm_sub_pd(truncated, _mm_and_pd(_mm_cmpgt_pd(truncated, prediction), one));
+        const __m128i difference = _mm_cvtpd_epi32(_mm_sub_pd(_mm_loadu_pd(signal + i), prediction));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(residual + i - order), difference);
+    }
+    const unsigned int shift = getShift(scale);
+    for(; i < numberOfSamples; i++)
+    {
+        residual[i - order] = calculateResidualScalar(signal, i, coefficients, order, shift);
+    }
+}
+
+SIMD_TARGET_AVX2 static void calculateResidualKernelAVX2(const double* signal, const unsigned int numberOfSamples, const double* coefficients,
+                                                             const unsigned int order, const double scale, int32_t* residual)
+{
+    __m256d broadcastCoefficients[LosslessCodec::MAXIMUM_ORDER];
+    for(unsigned int j = 0; j < order; j++)
+    {
+        broadcastCoefficients[j] = _mm256_set1_pd(coefficients[j]);
+    }
+    const __m256d factor = _mm256_set1_pd(scale);
+    const __m256d upperLimit = _mm256_set1_pd((double)PREDICTION_LIMIT);
+    const __m256d lowerLimit = _mm256_set1_pd((double)-PREDICTION_LIMIT);
+    unsigned int i = order;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        __m256d sum = _mm256_setzero_pd();
+        for(unsigned int j = 0; j < order; j++)
+        {
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(broadcastCoefficients[j], _mm256_loadu_pd(signal + i - 1 - j)));
+        }
+        const __m256d prediction = _mm256_floor_pd(_mm256_min_pd(_mm256_max_pd(_mm256_mul_pd(sum, factor), lowerLimit), upperLimit));
+        const __m128i difference = _mm256_cvtpd_epi32(_mm256_sub_pd(_mm256_loadu_pd(signal + i), prediction));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(residual + i - order), difference);
+    }
+    const unsigned int shift = getShift(scale);
+    for(; i < numberOfSamples; i++)
+    {
+        residual[i - order] = calculateResidualScalar(signal, i, coefficients, order, shift);
+    }
+}
+#elif defined(SIMD_NEON)
+static void calculateResidualKernelNEON(const double* signal, const unsigned int numberOfSamples, const double* coefficients, const unsigned int order,
+                                        const double scale, int32_t* residual)
+{
+    float64x2_t broadcastCoefficients[LosslessCodec::MAXIMUM_ORDER];
+    for(unsigned int j = 0; j < order; j++)
+    {
+        broadcastCoefficients[j] = vdupq_n_f64(coefficients[j]);
+    }
+    const float64x2_t factor = vdupq_n_f64(scale);
+    const float64x2_t upperLimit = vdupq_n_f64((double)PREDICTION_LIMIT);
+    const float64x2_t lowerLimit = vdupq_n_f64((double)-PREDICTION_LIMIT);
+    unsigned int i = order;
+    for(; i + 2 <= numberOfSamples; i += 2)
+    {
+        float64x2_t sum = vdupq_n_f64(0.0);
+        for(unsigned int j = 0; j < order; j++)
+        {
+            sum = vaddq_f64(sum, vmulq_f64(broadcastCoefficients[j], vld1q_f64(signal + i - 1 - j)));
+        }
+        const float64x2_t prediction = vrndmq_f64(vminq_f64(vmaxq_f64(vmulq_f64(sum, factor), lowerLimit), upperLimit));
+        vst1_s32(residual + i - order, vmovn_s64(vcvtq_s64_f64(vsubq_f64(vld1q_f64(signal + i), prediction))));
+    }
+    const unsigned int shift = getShift(scale);
+    for(; i < numberOfSamples; i++)
+    {
+        residual[i - order] = calculateResidualScalar(signal, i, coefficients, order, shift);
+    }
+}
+#endif
+
+static inline uint32_t toUnsigned(const int32_t residual)
+{
+    //zig-zag encoding: 0, -1, 1, -2, 2, ... => 0, 1, 2, 3, 4, ...
+    return ((uint32_t)residual << 1) ^ (uint32_t)(residual >> 31);
+}
+
+static inline int32_t toSigned(const uint32_t value)
+{
+    return (int32_t)((value >> 1) ^ (~(value & 1) + 1));
+}
+
+/*!
+ * Determines the Rice parameter with the fewest bits for the residual
+ *
+ * \return the number of bits of the Rice coded residual
+ */
+static uint64_t selectRiceParameter(const int32_t* residual, const unsigned int numberOfSamples, unsigned int& riceParameter)
+{
+    uint64_t sum = 0;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        sum += toUnsigned(residual[i]);
+    }
+    //the optimal parameter is close to the logarithm of the mean value, so only its neighbours are calculated exactly
+    unsigned int estimate = 0;
+    while(estimate < MAXIMUM_RICE_PARAMETER && ((uint64_t)numberOfSamples << (estimate + 1)) <= sum)
+    {
+        estimate++;
+    }
+    const unsigned int lowest = estimate > 0 ? estimate - 1 : 0;
+    uint64_t quotients[3] = {0, 0, 0};
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        const uint32_t value = toUnsigned(residual[i]);
+        quotients[0] += value >> lowest;
+        quotients[1] += value >> (lowest + 1);
+        quotients[2] += value >> (lowest + 2);
+    }
+    uint64_t bestBits = UINT64_MAX;
+    for(unsigned int k = lowest; k <= lowest + 2 && k <= MAXIMUM_RICE_PARAMETER; k++)
+    {
+        const uint64_t bits = quotients[k - lowest] + (uint64_t)numberOfSamples * (k + 1);
+        if(bits < bestBits)
+        {
+            bestBits = bits;
+            riceParameter = k;
+        }
+    }
+    return bestBits;
+}
+
+////
+// Codec
+////
+
+LosslessCodec::LosslessCodec(const unsigned int channels, const unsigned int bitsPerSample, const FormatConverter::InstructionSet instructionSet) :
+    channels(channels), bitsPerSample(bitsPerSample), instructionSet(FormatConverter::InstructionSet::SCALAR), residualKernel(calculateResidualKernelScalar)
+{
+#if defined(SIMD_X86)
+    if(instructionSet == FormatConverter::InstructionSet::AVX2 && cpuSupportsAVX2())
+    {
+        this->instructionSet = FormatConverter::InstructionSet::AVX2;
+        residualKernel = calculateResidualKernelAVX2;
+    }
+    else if(instructionSet == FormatConverter::InstructionSet::SSE2 || instructionSet == FormatConverter::InstructionSet::AVX2)
+    {
+        this->instructionSet = FormatConverter::InstructionSet::SSE2;
+        residualKernel = calculateResidualKernelSSE2;
+    }
+#elif defined(SIMD_NEON)
+    if(instructionSet == FormatConverter::InstructionSet::NEON)
+    {
+        this->instructionSet = FormatConverter::InstructionSet::NEON;
+        residualKernel = calculateResidualKernelNEON;
+    }
+#endif
+}
+
+unsigned int LosslessCodec::encode(const int32_t* samples, const unsigned int numberOfFrames, uint8_t* encoded, const unsigned int maximumSize)
+{
+    if(numberOfFrames > MAXIMUM_FRAMES)
+    {
+        return 0;
+    }
+    channelSamples.resize(numberOfFrames);
+    signal.resize(numberOfFrames);
+    residual.resize(numberOfFrames);
+    bestResidual.resize(numberOfFrames);
+    updateWindow(numberOfFrames);
+
+    BitWriter writer(encoded, maximumSize);
+    writer.write(numberOfFrames, FRAME_HEADER_BITS);
+    for(unsigned int channel = 0; channel < channels; channel++)
+    {
+        bool isConstant = true;
+        for(unsigned int i = 0; i < numberOfFrames; i++)
+        {
+            channelSamples[i] = samples[i * channels + channel];
+            signal[i] = channelSamples[i];
+            isConstant &= channelSamples[i] == channelSamples[0];
+        }
+        if(isConstant && numberOfFrames > 0)
+        {
+            writer.write(TYPE_CONSTANT << 6, CHANNEL_HEADER_BITS);
+            writer.writeSigned(channelSamples[0], bitsPerSample);
+            continue;
+        }
+
+        //the verbatim samples are the fallback for signals, which can't be predicted (e.g. white noise)
+        uint64_t bestBits = CHANNEL_HEADER_BITS + (uint64_t)numberOfFrames * bitsPerSample;
+        Predictor bestPredictor;
+        bestPredictor.order = 0;
+        unsigned int bestRiceParameter = 0;
+        bool isPredicted = false;
+
+        Predictor predictor;
+        unsigned int riceParameter = 0;
+        for(unsigned int order = 0; order < NUM_FIXED_PREDICTORS && order < numberOfFrames; order++)
+        {
+            predictor.order = order;
+            predictor.shift = 0;
+            predictor.precision = FIXED_PRECISION;
+            for(unsigned int j = 0; j < order; j++)
+            {
+                predictor.coefficients[j] = FIXED_COEFFICIENTS[order][j];
+            }
+            const uint64_t bits = evaluatePredictor(predictor, numberOfFrames, riceParameter);
+            if(bits < bestBits)
+            {
+                bestBits = bits;
+                bestPredictor = predictor;
+                bestRiceParameter = riceParameter;
+                isPredicted = true;
+                std::swap(residual, bestResidual);
+            }
+        }
+        double lpc[MAXIMUM_ORDER][MAXIMUM_ORDER];
+        const unsigned int maximumOrder = calculateLPC(numberOfFrames, lpc);
+        for(unsigned int order = 1; order <= maximumOrder; order++)
+        {
+            predictor.order = order;
+            //the coarse coefficients reduce the overhead of short blocks, the precise coefficients the residual of long blocks
+            for(const unsigned int precision : {getCoefficientPrecision(numberOfFrames), MAXIMUM_PRECISION})
+            {
+                if(!quantizeCoefficients(lpc[order - 1], order, precision, predictor))
+                {
+                    continue;
+                }
+                const uint64_t bits = evaluatePredictor(predictor, numberOfFrames, riceParameter);
+                if(bits < bestBits)
+                {
+                    bestBits = bits;
+                    bestPredictor = predictor;
+                    bestRiceParameter = riceParameter;
+                    isPredicted = true;
+                    std::swap(residual, bestResidual);
+                }
+            }
+        }
+
+        if(!isPredicted)
+        {
+            writer.write(TYPE_VERBATIM << 6, CHANNEL_HEADER_BITS);
+            for(unsigned int i = 0; i < numberOfFrames; i++)
+            {
+                writer.writeSigned(channelSamples[i], bitsPerSample);
+            }
+            continue;
+        }
+        writer.write((TYPE_PREDICTED << 6) | bestPredictor.order, CHANNEL_HEADER_BITS);
+        writer.write(bestPredictor.shift, SHIFT_BITS);
+        writer.write(bestPredictor.precision - 1, PRECISION_BITS);
+        for(unsigned int j = 0; j < bestPredictor.order; j++)
+        {
+            writer.writeSigned(bestPredictor.coefficients[j], bestPredictor.precision);
+        }
+        for(unsigned int i = 0; i < bestPredictor.order; i++)
+        {
+            writer.writeSigned(channelSamples[i], bitsPerSample);
+        }
+        writer.write(bestRiceParameter, RICE_PARAMETER_BITS);
+        const uint32_t remainderMask = (uint32_t)((uint64_t(1) << bestRiceParameter) - 1);
+        for(unsigned int i = 0; i < numberOfFrames - bestPredictor.order; i++)
+        {
+            const uint32_t value = toUnsigned(bestResidual[i]);
+            writer.writeUnary(value >> bestRiceParameter);
+            writer.write(value & remainderMask, bestRiceParameter);
+        }
+        if(writer.hasOverflown())
+        {
+            return 0;
+        }
+    }
+    writer.flush();
+    return writer.hasOverflown() ? 0 : writer.getSize();
+}
+
+unsigned int LosslessCodec::decode(const uint8_t* encoded, const unsigned int encodedSize, int32_t* samples, const unsigned int maximumFrames)
+{
+    BitReader reader(encoded, encodedSize);
+    const unsigned int numberOfFrames = reader.read(FRAME_HEADER_BITS);
+    if(numberOfFrames > maximumFrames)
+    {
+        return 0;
+    }
+    channelSamples.resize(numberOfFrames);
+    for(unsigned int channel = 0; channel < channels && !reader.hasOverflown(); channel++)
+    {
+        const unsigned int header = reader.read(CHANNEL_HEADER_BITS);
+        const unsigned int type = header >> 6;
+        const unsigned int order = header & 0x0F;
+        if(type == TYPE_VERBATIM)
+        {
+            for(unsigned int i = 0; i < numberOfFrames; i++)
+            {
+                channelSamples[i] = reader.readSigned(bitsPerSample);
+            }
+        }
+        else if(type == TYPE_CONSTANT)
+        {
+            const int32_t value = reader.readSigned(bitsPerSample);
+            for(unsigned int i = 0; i < numberOfFrames; i++)
+            {
+                channelSamples[i] = value;
+            }
+        }
+        else if(type == TYPE_PREDICTED && order <= MAXIMUM_ORDER && order <= numberOfFrames)
+        {
+            const unsigned int shift = reader.read(SHIFT_BITS);
+            const unsigned int precision = reader.read(PRECISION_BITS) + 1;
+            int64_t coefficients[MAXIMUM_ORDER];
+            for(unsigned int j = 0; j < order; j++)
+            {
+                coefficients[j] = reader.readSigned(precision);
+            }
+            for(unsigned int i = 0; i < order; i++)
+            {
+                channelSamples[i] = reader.readSigned(bitsPerSample);
+            }
+            const unsigned int riceParameter = reader.read(RICE_PARAMETER_BITS);
+            for(unsigned int i = order; i < numberOfFrames; i++)
+            {
+                const uint64_t quotient = reader.readUnary();
+                if((quotient >> (32 - riceParameter)) != 0 || reader.hasOverflown())
+                {
+                    return 0;
+                }
+                const uint32_t value = (uint32_t)(quotient << riceParameter) | reader.read(riceParameter);
+                int64_t sum = 0;
+                for(unsigned int j = 0; j < order; j++)
+                {
+                    sum += coefficients[j] * channelSamples[i - 1 - j];
+                }
+                channelSamples[i] = (int32_t)(toSigned(value) + clampPrediction(sum >> shift));
+            }
+        }
+        else
+        {
+            return 0;
+        }
+        for(unsigned int i = 0; i < numberOfFrames; i++)
+        {
+            samples[i * channels + channel] = channelSamples[i];
+        }
+    }
+    return reader.hasOverflown() ? 0 : numberOfFrames;
+}
+
+unsigned int LosslessCodec::getMaximumEncodedSize(const unsigned int numberOfFrames) const
+{
+    //the verbatim samples are the largest encoding of a channel
+    return (FRAME_HEADER_BITS + channels * (CHANNEL_HEADER_BITS + numberOfFrames * bitsPerSample) + 7) / 8;
+}
+
+FormatConverter::InstructionSet LosslessCodec::getInstructionSet() const
+{
+    return instructionSet;
+}
+
+void LosslessCodec::updateWindow(const unsigned int numberOfFrames)
+{
+    if(window.size() == numberOfFrames)
+    {
+        return;
+    }
+    //Tukey-window with 50% taper, the window used by FLAC
+    static const double PI = 3.14159265358979323846;
+    window.assign(numberOfFrames, 1.0);
+    windowedSignal.resize(numberOfFrames);
+    const unsigned int taperSize = numberOfFrames / 4;
+    for(unsigned int i = 0; i < taperSize; i++)
+    {
+        const double value = 0.5 - 0.5 * std::cos(PI * i / taperSize);
+        window[i] = value;
+        window[numberOfFrames - 1 - i] = value;
+    }
+}
+
+unsigned int LosslessCodec::calculateLPC(const unsigned int numberOfFrames, double lpc[MAXIMUM_ORDER][MAXIMUM_ORDER])
+{
+    const unsigned int maximumOrder = numberOfFrames > MAXIMUM_ORDER ? MAXIMUM_ORDER : (numberOfFrames > 0 ? numberOfFrames - 1 : 0);
+    double* windowed = windowedSignal.data();
+    for(unsigned int i = 0; i < numberOfFrames; i++)
+    {
+        windowed[i] = signal[i] * window[i];
+    }
+    double autocorrelation[MAXIMUM_ORDER + 1];
+    for(unsigned int lag = 0; lag <= maximumOrder; lag++)
+    {
+        double sum = 0.0;
+        for(unsigned int i = lag; i < numberOfFrames; i++)
+        {
+            sum += windowed[i] * windowed[i - lag];
+        }
+        autocorrelation[lag] = sum;
+    }
+    if(maximumOrder == 0 || autocorrelation[0] == 0.0)
+    {
+        return 0;
+    }
+
+    //Levinson-Durbin recursion
+    double reflection[MAXIMUM_ORDER];
+    double error = autocorrelation[0];
+    for(unsigned int i = 0; i < maximumOrder; i++)
+    {
+        double r = -autocorrelation[i + 1];
+        for(unsigned int j = 0; j < i; j++)
+        {
+            r -= reflection[j] * autocorrelation[i - j];
+        }
+        r /= error;
+        reflection[i] = r;
+        unsigned int j = 0;
+        for(; j < i / 2; j++)
+        {
+            const double previous = reflection[j];
+            reflection[j] += r * reflection[i - 1 - j];
+            reflection[i - 1 - j] += r * previous;
+        }
+        if(i & 1)
+        {
+            reflection[j] += reflection[j] * r;
+        }
+        error *= 1.0 - r * r;
+        for(j = 0; j <= i; j++)
+        {
+            lpc[i][j] = -reflection[j];
+        }
+        if(error <= 0.0)
+        {
+            //the signal is predicted perfectly, higher orders won't improve the prediction
+            return i + 1;
+        }
+    }
+    return maximumOrder;
+}
+
+uint64_t LosslessCodec::evaluatePredictor(const Predictor& predictor, const unsigned int numberOfFrames, unsigned int& riceParameter)
+{
+    double coefficients[MAXIMUM_ORDER];
+    for(unsigned int j = 0; j < predictor.order; j++)
+    {
+        coefficients[j] = predictor.coefficients[j];
+    }
+    residualKernel(signal.data(), numberOfFrames, coefficients, predictor.order, std::ldexp(1.0, -(int)predictor.shift), residual.data());
+    const uint64_t residualBits = selectRiceParameter(residual.data(), numberOfFrames - predictor.order, riceParameter);
+    return CHANNEL_HEADER_BITS + SHIFT_BITS + PRECISION_BITS + predictor.order * (predictor.precision + bitsPerSample) + RICE_PARAMETER_BITS + residualBits;
+}
+
+bool LosslessCodec::quantizeCoefficients(const double* lpc, const unsigned int order, const unsigned int precision, Predictor& predictor)
+{
+    double maximum = 0.0;
+    for(unsigned int j = 0; j < order; j++)
+    {
+        maximum = std::fabs(lpc[j]) > maximum ? std::fabs(lpc[j]) : maximum;
+    }
+    if(maximum <= 0.0 || !std::isfinite(maximum))
+    {
+        return false;
+    }
+    //the largest shift, for which the largest coefficient still fits into the precision
+    int exponent;
+    std::frexp(maximum, &exponent);
+    const int shift = (int)precision - 1 - exponent;
+    if(shift < 0)
+    {
+        return false;
+    }
+    predictor.shift = shift > (int)MAXIMUM_SHIFT ? MAXIMUM_SHIFT : (unsigned int)shift;
+    predictor.precision = precision;
+    const int32_t maximumCoefficient = (1 << (precision - 1)) - 1;
+    const int32_t minimumCoefficient = -(1 << (precision - 1));
+    //the rounding error is carried over to the next coefficient
+    double error = 0.0;
+    for(unsigned int j = 0; j < order; j++)
+    {
+        error += std::ldexp(lpc[j], (int)predictor.shift);
+        long quantized = std::lround(error);
+        quantized = quantized > maximumCoefficient ? maximumCoefficient : (quantized < minimumCoefficient ? minimumCoefficient : quantized);
+        predictor.coefficients[j] = (int32_t)quantized;
+        error -= quantized;
+    }
+    return true;
+}
+
+unsigned int LosslessCodec::getCoefficientPrecision(const unsigned int numberOfFrames)
+{
+    //the precisions chosen by FLAC for the block-sizes
+    unsigned int precision = 7;
+    for(unsigned int limit = 192; limit < numberOfFrames && precision < MAXIMUM_PRECISION; limit *= 2)
+    {
+        precision++;
+    }
+    return precision;
+}
@@ -0,0 +1,336 @@
+#include "OggOpusWriter.h"
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstring>
+
+#include "opus.h"
+#include "OpusMultistreamEncoder.h"
+
+//the flags of the header-type of an Ogg-page
+static const uint8_t PAGE_BEGIN_OF_STREAM = 0x02;
+static const uint8_t PAGE_END_OF_STREAM = 0x04;
+//the size of the fixed part of the header of an Ogg-page
+static const unsigned int PAGE_HEADER_SIZE = 27;
+//the size of the prefix storing the size of a queued packet
+static const unsigned int PACKET_PREFIX_SIZE = 2;
+//the vendor-string written into the OpusTags-header
+static const char* VENDOR = "OHMComm";
+
+static void putLittleEndian(std::vector<uint8_t>& buffer, const uint64_t value, const unsigned int numberOfBytes)
+{
+    for(unsigned int i = 0; i < numberOfBytes; i++)
+    {
+        buffer.push_back((uint8_t)(value >> (8 * i)));
+    }
+}
+
+static void putTag(std::vector<uint8_t>& buffer, const char* tag)
+{
+    buffer.insert(buffer.end(), tag, tag + strlen(tag));
+}
+
+/*!
+ * The CRC-32 of Ogg (polynomial 0x04C11DB7, not reflected, no initial or final XOR)
+ */
+static uint32_t calculateCRC(const std::vector<uint8_t>& data)
+{
+    static const std::vector<uint32_t> table = []()
+    {
+        std::vector<uint32_t> entries(256);
+        for(uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t r = i << 24;
+            for(unsigned int bit = 0; bit < 8; bit++)
+            {
+                r = (r & 0x80000000u) ? (r << 1) ^ 0x04C11DB7u : r << 1;
+            }
+            entries[i] = r;
+        }
+        return entries;
+    }();
+    uint32_t crc = 0;
+    for(const uint8_t byte : data)
+    {
+        crc = (crc << 8) ^ table[((crc >> 24) ^ byte) & 0xFF];
+    }
+    return crc;
+}
+
+OggOpusWriter::OggOpusWriter(const std::string& fileName, const unsigned int channels, const unsigned int sampleRate, const unsigned int preSkip,
+                             const unsigned int bufferDuration) :
+    file(nullptr), streams(1), serialNumber(std::random_device()()), pageSequenceNumber(0),
+    ringBuffer(std::max(MAXIMUM_BYTES_PER_SECOND * channels / 1000 * bufferDuration, PACKET_PREFIX_SIZE + MAXIMUM_PACKET_SIZE)),
+    queueBuffer(PACKET_PREFIX_SIZE + MAXIMUM_PACKET_SIZE), packetBuffer(MAXIMUM_PACKET_SIZE), pageSegments(), pageBody(), pageStartPosition(0),
+    granulePosition(0), previousTOC(0), previousDuration(0), writtenPackets(0), droppedPackets(0), threadRunning(false), writeThread()
+{
+    file = fopen(fileName.c_str(), "wb");
+    if(file == nullptr)
+    {
+        std::cerr << "[Ogg-Opus-Writer-Error]Failed to open file: " << fileName << std::endl;
+        return;
+    }
+    if(!writeHeaders(channels, sampleRate, preSkip))
+    {
+        std::cerr << "[Ogg-Opus-Writer-Error]Failed to write header: " << fileName << std::endl;
+        fclose(file);
+        file = nullptr;
+        return;
+    }
+    threadRunning = true;
+    writeThread = std::thread(&OggOpusWriter::runThread, this);
+}
+
+OggOpusWriter::~OggOpusWriter()
+{
+    close();
+}
+
+bool OggOpusWriter::isOpen() const
+{
+    return file != nullptr;
+}
+
+bool OggOpusWriter::write(const void* packet, const unsigned int size)
+{
+    if(!threadRunning.load(std::memory_order_relaxed) || size == 0 || size > MAXIMUM_PACKET_SIZE)
+    {
+        return false;
+    }
+    //the size and the packet are queued with a single write, so the writing thread never sees a partial packet
+    queueBuffer[0] = (uint8_t)size;
+    queueBuffer[1] = (uint8_t)(size >> 8);
+    memcpy(queueBuffer.data() + PACKET_PREFIX_SIZE, packet, size);
+    if(!ringBuffer.write(queueBuffer.data(), PACKET_PREFIX_SIZE + size))
+    {
+        //the writing thread can't keep up with the audio, drop the packet instead of blocking the audio-thread
+        droppedPackets.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool OggOpusWriter::writeSilence()
+{
+    if(!threadRunning.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+    //a packet of size zero marks the silence
+    const uint8_t prefix[PACKET_PREFIX_SIZE] = {0, 0};
+    if(!ringBuffer.write(prefix, PACKET_PREFIX_SIZE))
+    {
+        droppedPackets.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void OggOpusWriter::close()
+{
+    if(writeThread.joinable())
+    {
+        threadRunning = false;
+        writeThread.join();
+    }
+    if(file != nullptr)
+    {
+        flushPage(PAGE_END_OF_STREAM);
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+uint64_t OggOpusWriter::getWrittenPackets() const
+{
+    return writtenPackets.load();
+}
+
+uint64_t OggOpusWriter::getDroppedPackets() const
+{
+    return droppedPackets.load();
+}
+
+uint64_t OggOpusWriter::getGranulePosition() const
+{
+    return granulePosition.load();
+}
+
+unsigned int OggOpusWriter::getPreSkip(const unsigned int sampleRate, const unsigned int channels, const int application)
+{
+    int error;
+    OpusEncoder* encoder = opus_encoder_create(sampleRate, channels > 2 ? 2 : channels, application, &error);
+    if(error != OPUS_OK)
+    {
+        return 0;
+    }
+    opus_int32 lookahead = 0;
+    opus_encoder_ctl(encoder, OPUS_GET_LOOKAHEAD(&lookahead));
+    opus_encoder_destroy(encoder);
+    //the look-ahead is given in samples of the encoder's sample-rate, the pre-skip always in 48 kHz samples
+    return (unsigned int)lookahead * (48000 / sampleRate);
+}
+
+bool OggOpusWriter::writeHeaders(const unsigned int channels, const unsigned int sampleRate, const unsigned int preSkip)
+{
+    unsigned int coupledStreams = channels == 2 ? 1 : 0;
+    std::vector<unsigned char> mapping;
+    if(channels > 2)
+    {
+        OpusMultistreamEncoder::getChannelMapping(channels, streams, coupledStreams, mapping);
+    }
+
+    std::vector<uint8_t> head;
+    putTag(head, "OpusHead");
+    //the version, the number of channels and the pre-skip
+    putLittleEndian(head, 1, 1);
+    putLittleEndian(head, channels, 1);
+    putLittleEndian(head, preSkip, 2);
+    putLittleEndian(head, sampleRate, 4);
+    //the output-gain
+    putLittleEndian(head, 0, 2);
+    if(channels > 2)
+    {
+        //mapping-family 1 for the Vorbis channel-orders, 255 for one mono stream per channel
+        putLittleEndian(head, channels <= 8 ? 1 : 255, 1);
+        putLittleEndian(head, streams, 1);
+        putLittleEndian(head, coupledStreams, 1);
+        head.insert(head.end(), mapping.begin(), mapping.end());
+    }
+    else
+    {
+        putLittleEndian(head, 0, 1);
+    }
+
+    std::vector<uint8_t> tags;
+    putTag(tags, "OpusTags");
+    putLittleEndian(tags, strlen(VENDOR), 4);
+    putTag(tags, VENDOR);
+    //no user-comments
+    putLittleEndian(tags, 0, 4);
+
+    //each header-packet is the only packet on its page
+    const std::vector<uint8_t> headSegments(1, (uint8_t)head.size());
+    std::vector<uint8_t> tagsSegments(tags.size() / 255, 255);
+    tagsSegments.push_back((uint8_t)(tags.size() % 255));
+    return writePage(PAGE_BEGIN_OF_STREAM, 0, headSegments, head) && writePage(0, 0, tagsSegments, tags);
+}
+
+bool OggOpusWriter::writePage(const uint8_t headerType, const uint64_t position, const std::vector<uint8_t>& segments, const std::vector<uint8_t>& body)
+{
+    std::vector<uint8_t> page;
+    page.reserve(PAGE_HEADER_SIZE + segments.size() + body.size());
+    putTag(page, "OggS");
+    putLittleEndian(page, 0, 1);
+    putLittleEndian(page, headerType, 1);
+    putLittleEndian(page, position, 8);
+    putLittleEndian(page, serialNumber, 4);
+    putLittleEndian(page, pageSequenceNumber++, 4);
+    //the checksum is calculated over the whole page with the checksum-field set to zero
+    putLittleEndian(page, 0, 4);
+    putLittleEndian(page, segments.size(), 1);
+    page.insert(page.end(), segments.begin(), segments.end());
+    page.insert(page.end(), body.begin(), body.end());
+    const uint32_t crc = calculateCRC(page);
+    for(unsigned int i = 0; i < 4; i++)
+    {
+        page[22 + i] = (uint8_t)(crc >> (8 * i));
+    }
+    return fwrite(page.data(), 1, page.size(), file) == page.size() && fflush(file) == 0;
+}
+
+void OggOpusWriter::flushPage(const uint8_t headerType)
+{
+    //the last page is written even without packets, to mark the end of the stream
+    if(pageSegments.empty() && headerType != PAGE_END_OF_STREAM)
+    {
+        return;
+    }
+    if(!writePage(headerType, granulePosition.load(), pageSegments, pageBody))
+    {
+        std::cerr << "[Ogg-Opus-Writer-Error]Failed to write page!" << std::endl;
+    }
+    pageSegments.clear();
+    pageBody.clear();
+    pageStartPosition = granulePosition.load();
+}
+
+void OggOpusWriter::addPacket(const uint8_t* packet, const unsigned int size, const unsigned int duration)
+{
+    const unsigned int numberOfSegments = size / 255 + 1;
+    //a page is only completed when the next packet arrives, so the last page always contains a packet
+    if(pageSegments.size() + numberOfSegments > MAXIMUM_SEGMENTS || granulePosition.load() - pageStartPosition >= PAGE_DURATION)
+    {
+        flushPage(0);
+    }
+    pageSegments.insert(pageSegments.end(), numberOfSegments - 1, 255);
+    pageSegments.push_back((uint8_t)(size % 255));
+    pageBody.insert(pageBody.end(), packet, packet + size);
+    granulePosition.fetch_add(duration);
+    writtenPackets.fetch_add(1);
+}
+
+unsigned int OggOpusWriter::createSilencePacket()
+{
+    if(previousDuration == 0)
+    {
+        return 0;
+    }
+    //code 3 (arbitrary number of frames) with constant frame-sizes of zero bytes
+    const uint8_t toc = (previousTOC & 0xFC) | 0x03;
+    const unsigned int numberOfFrames = previousDuration / opus_packet_get_samples_per_frame(&previousTOC, 48000);
+    unsigned int size = 0;
+    for(unsigned int stream = 0; stream < streams; stream++)
+    {
+        packetBuffer[size++] = toc;
+        packetBuffer[size++] = (uint8_t)numberOfFrames;
+        if(stream + 1 < streams)
+        {
+            //all but the last stream of a multistream-packet use the self-delimiting framing, which adds the frame-size
+            packetBuffer[size++] = 0;
+        }
+    }
+    return size;
+}
+
+void OggOpusWriter::writeBufferedPackets()
+{
+    uint8_t prefix[PACKET_PREFIX_SIZE];
+    while(ringBuffer.read(prefix, PACKET_PREFIX_SIZE))
+    {
+        unsigned int size = prefix[0] | (prefix[1] << 8);
+        if(size == 0)
+        {
+            size = createSilencePacket();
+            if(size > 0)
+            {
+                addPacket(packetBuffer.data(), size, previousDuration);
+            }
+            continue;
+        }
+        ringBuffer.read(packetBuffer.data(), size);
+        const int duration = opus_packet_get_nb_samples(packetBuffer.data(), size, 48000);
+        //packets of more than 120 ms are invalid
+        if(duration <= 0 || duration > 5760)
+        {
+            droppedPackets.fetch_add(1);
+            continue;
+        }
+        previousTOC = packetBuffer[0];
+        previousDuration = duration;
+        addPacket(packetBuffer.data(), size, duration);
+    }
+}
+
+void OggOpusWriter::runThread()
+{
+    while(threadRunning)
+    {
+        writeBufferedPackets();
+        std::this_thread::sleep_for(std::chrono::milliseconds((long)WRITE_INTERVAL));
+    }
+    //write the packets queued before the writer was closed
+    writeBufferedPackets();
+}
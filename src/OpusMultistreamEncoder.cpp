@@ -0,0 +1,344 @@
+#include "OpusMultistreamEncoder.h"
+#include "ProcessorOpus.h"
+
+#include <string.h> //memcpy
+
+//the number of streams, coupled streams and the mapping of the Vorbis channel-order for 1 to 8 channels (RFC 7845, section 5.1.1.2)
+static const unsigned char VORBIS_MAPPINGS[8][10] = {
+    {1, 0, 0},
+    {1, 1, 0, 1},
+    {2, 1, 0, 2, 1},
+    {2, 2, 0, 1, 2, 3},
+    {3, 2, 0, 4, 1, 2, 3},
+    {4, 2, 0, 4, 1, 2, 3, 5},
+    {4, 3, 0, 4, 1, 2, 3, 5, 6},
+    {5, 3, 0, 6, 1, 2, 3, 4, 5, 7}
+};
+
+OpusMultistreamEncoder::OpusMultistreamEncoder(const unsigned int sampleRate, const unsigned int channels, const int application, const unsigned int numberOfThreads) :
+    sampleRate(sampleRate), channels(channels), streams(), coupledStreams(0), mapping(), errorCode(OPUS_OK), intInput(nullptr), floatInput(nullptr), frameSize(0),
+    workers(), jobMutex(), jobStarted(), jobFinished(), jobNumber(0), pendingWorkers(0), running(true)
+{
+    if(channels == 0 || channels > 255)
+    {
+        errorCode = OPUS_BAD_ARG;
+        return;
+    }
+    unsigned int numberOfStreams = 0;
+    getChannelMapping(channels, numberOfStreams, coupledStreams, mapping);
+    streams.resize(numberOfStreams);
+    for(unsigned int s = 0; s < numberOfStreams; s++)
+    {
+        Stream& stream = streams[s];
+        stream.numberOfChannels = s < coupledStreams ? 2 : 1;
+        //the decoder assigns the channels 2s and 2s+1 to the coupled stream s, followed by one channel per mono stream
+        const unsigned int firstDecodedChannel = s < coupledStreams ? 2 * s : s + coupledStreams;
+        stream.firstChannel = stream.secondChannel = 0;
+        for(unsigned int c = 0; c < channels; c++)
+        {
+            if(mapping[c] == firstDecodedChannel)
+            {
+                stream.firstChannel = c;
+            }
+            else if(stream.numberOfChannels == 2 && mapping[c] == firstDecodedChannel + 1)
+            {
+                stream.secondChannel = c;
+            }
+        }
+        stream.intSamples.resize(MAXIMUM_FRAME_SIZE * stream.numberOfChannels);
+        stream.floatSamples.resize(MAXIMUM_FRAME_SIZE * stream.numberOfChannels);
+        stream.packet.resize(MAXIMUM_STREAM_PACKET_SIZE);
+        stream.packetSize = 0;
+        int error = OPUS_OK;
+        stream.encoder = opus_encoder_create(sampleRate, stream.numberOfChannels, application, &error);
+        if(error != OPUS_OK)
+        {
+            errorCode = error;
+        }
+    }
+    if(errorCode != OPUS_OK)
+    {
+        return;
+    }
+
+    unsigned int threads = numberOfThreads;
+    if(threads == 0)
+    {
+        //the real-time thread calling the encoder should not block on the workers for only a few streams
+        threads = numberOfStreams < PARALLEL_STREAMS_THRESHOLD ? 1 : std::thread::hardware_concurrency();
+    }
+    if(threads > numberOfStreams)
+    {
+        threads = numberOfStreams;
+    }
+    //the calling thread encodes the streams of the first thread
+    for(unsigned int t = 1; t < threads; t++)
+    {
+        workers.push_back(std::thread(&OpusMultistreamEncoder::runWorker, this, t));
+    }
+}
+
+OpusMultistreamEncoder::~OpusMultistreamEncoder()
+{
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        running = false;
+    }
+    jobStarted.notify_all();
+    for(std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    for(Stream& stream : streams)
+    {
+        if(stream.encoder != nullptr)
+        {
+            opus_encoder_destroy(stream.encoder);
+        }
+    }
+}
+
+int OpusMultistreamEncoder::getErrorCode() const
+{
+    return errorCode;
+}
+
+unsigned int OpusMultistreamEncoder::getNumberOfStreams() const
+{
+    return streams.size();
+}
+
+unsigned int OpusMultistreamEncoder::getNumberOfCoupledStreams() const
+{
+    return coupledStreams;
+}
+
+const unsigned char* OpusMultistreamEncoder::getMapping() const
+{
+    return mapping.data();
+}
+
+unsigned int OpusMultistreamEncoder::getNumberOfThreads() const
+{
+    return workers.size() + 1;
+}
+
+bool OpusMultistreamEncoder::applySettings(const OpusEncoderSettings& settings, const unsigned int frameSize)
+{
+    for(Stream& stream : streams)
+    {
+        OpusEncoderSettings streamSettings = settings;
+        if(settings.bitrate > 0)
+        {
+            streamSettings.bitrate = settings.bitrate * stream.numberOfChannels / channels;
+        }
+        if(!ProcessorOpus::applyEncoderSettings(stream.encoder, streamSettings, frameSize, sampleRate))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int OpusMultistreamEncoder::encode(const opus_int16* pcm, const unsigned int frameSize, unsigned char* data, const unsigned int maximumSize)
+{
+    intInput = pcm;
+    floatInput = nullptr;
+    this->frameSize = frameSize;
+    return encodeAll(data, maximumSize);
+}
+
+int OpusMultistreamEncoder::encode(const float* pcm, const unsigned int frameSize, unsigned char* data, const unsigned int maximumSize)
+{
+    intInput = nullptr;
+    floatInput = pcm;
+    this->frameSize = frameSize;
+    return encodeAll(data, maximumSize);
+}
+
+void OpusMultistreamEncoder::getChannelMapping(const unsigned int channels, unsigned int& streams, unsigned int& coupledStreams, std::vector<unsigned char>& mapping)
+{
+    mapping.resize(channels);
+    if(channels >= 1 && channels <= 8)
+    {
+        const unsigned char* vorbisMapping = VORBIS_MAPPINGS[channels - 1];
+        streams = vorbisMapping[0];
+        coupledStreams = vorbisMapping[1];
+        memcpy(mapping.data(), vorbisMapping + 2, channels);
+        return;
+    }
+    //mapping family 255: a mono stream per channel
+    streams = channels;
+    coupledStreams = 0;
+    for(unsigned int c = 0; c < channels; c++)
+    {
+        mapping[c] = (unsigned char)c;
+    }
+}
+
+int OpusMultistreamEncoder::toSelfDelimited(const unsigned char* packet, const int packetSize, unsigned char* target, const unsigned int maximumSize)
+{
+    unsigned char toc;
+    const unsigned char* frames[48];
+    opus_int16 sizes[48];
+    int payloadOffset;
+    const int numberOfFrames = opus_packet_parse(packet, packetSize, &toc, frames, sizes, &payloadOffset);
+    if(numberOfFrames < 0)
+    {
+        return numberOfFrames;
+    }
+    //the TOC-byte, the frame-count byte and two bytes per frame-size at most
+    unsigned int requiredSize = 2 + 2 * numberOfFrames;
+    for(int i = 0; i < numberOfFrames; i++)
+    {
+        requiredSize += sizes[i];
+    }
+    if(requiredSize > maximumSize)
+    {
+        return OPUS_BUFFER_TOO_SMALL;
+    }
+    unsigned int position = 0;
+    if(numberOfFrames == 1)
+    {
+        //code 0: a single frame
+        target[position++] = toc & 0xFC;
+    }
+    else
+    {
+        //code 3 with VBR-flag and without padding, the self-delimiting variant stores the sizes of all frames
+        target[position++] = (toc & 0xFC) | 0x03;
+        target[position++] = 0x80 | numberOfFrames;
+    }
+    for(int i = 0; i < numberOfFrames; i++)
+    {
+        if(sizes[i] < 252)
+        {
+            target[position++] = (unsigned char)sizes[i];
+        }
+        else
+        {
+            target[position] = (unsigned char)(252 + (sizes[i] & 0x03));
+            target[position + 1] = (unsigned char)((sizes[i] - target[position]) >> 2);
+            position += 2;
+        }
+    }
+    for(int i = 0; i < numberOfFrames; i++)
+    {
+        memcpy(target + position, frames[i], sizes[i]);
+        position += sizes[i];
+    }
+    return position;
+}
+
+void OpusMultistreamEncoder::runWorker(const unsigned int threadIndex)
+{
+    std::unique_lock<std::mutex> lock(jobMutex);
+    //the workers are started before the first job, but the first job may be posted before a worker runs
+    unsigned long lastJob = 0;
+    while(true)
+    {
+        jobStarted.wait(lock, [this, lastJob]() { return !running || jobNumber != lastJob; });
+        if(!running)
+        {
+            return;
+        }
+        lastJob = jobNumber;
+        lock.unlock();
+        encodeStreams(threadIndex);
+        lock.lock();
+        if(--pendingWorkers == 0)
+        {
+            jobFinished.notify_one();
+        }
+    }
+}
+
+void OpusMultistreamEncoder::encodeStreams(const unsigned int threadIndex)
+{
+    const unsigned int numberOfThreads = workers.size() + 1;
+    for(unsigned int s = threadIndex; s < streams.size(); s += numberOfThreads)
+    {
+        Stream& stream = streams[s];
+        if(intInput != nullptr)
+        {
+            for(unsigned int i = 0; i < frameSize; i++)
+            {
+                stream.intSamples[i * stream.numberOfChannels] = intInput[i * channels + stream.firstChannel];
+                if(stream.numberOfChannels == 2)
+                {
+                    stream.intSamples[i * 2 + 1] = intInput[i * channels + stream.secondChannel];
+                }
+            }
+            stream.packetSize = opus_encode(stream.encoder, stream.intSamples.data(), frameSize, stream.packet.data(), stream.packet.size());
+        }
+        else
+        {
+            for(unsigned int i = 0; i < frameSize; i++)
+            {
+                stream.floatSamples[i * stream.numberOfChannels] = floatInput[i * channels + stream.firstChannel];
+                if(stream.numberOfChannels == 2)
+                {
+                    stream.floatSamples[i * 2 + 1] = floatInput[i * channels + stream.secondChannel];
+                }
+            }
+            stream.packetSize = opus_encode_float(stream.encoder, stream.floatSamples.data(), frameSize, stream.packet.data(), stream.packet.size());
+        }
+    }
+}
+
+int OpusMultistreamEncoder::encodeAll(unsigned char* data, const unsigned int maximumSize)
+{
+    if(errorCode != OPUS_OK)
+    {
+        return errorCode;
+    }
+    if(frameSize > MAXIMUM_FRAME_SIZE)
+    {
+        return OPUS_BAD_ARG;
+    }
+    if(!workers.empty())
+    {
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            ++jobNumber;
+            pendingWorkers = workers.size();
+        }
+        jobStarted.notify_all();
+    }
+    encodeStreams(0);
+    if(!workers.empty())
+    {
+        std::unique_lock<std::mutex> lock(jobMutex);
+        jobFinished.wait(lock, [this]() { return pendingWorkers == 0; });
+    }
+
+    //all streams but the last use the self-delimiting framing
+    unsigned int position = 0;
+    for(unsigned int s = 0; s < streams.size(); s++)
+    {
+        const Stream& stream = streams[s];
+        if(stream.packetSize < 0)
+        {
+            return stream.packetSize;
+        }
+        if(s + 1 < streams.size())
+        {
+            const int size = toSelfDelimited(stream.packet.data(), stream.packetSize, data + position, maximumSize - position);
+            if(size < 0)
+            {
+                return size;
+            }
+            position += size;
+        }
+        else
+        {
+            if(position + stream.packetSize > maximumSize)
+            {
+                return OPUS_BUFFER_TOO_SMALL;
+            }
+            memcpy(data + position, stream.packet.data(), stream.packetSize);
+            position += stream.packetSize;
+        }
+    }
+    return position;
+}
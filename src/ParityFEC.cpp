@@ -0,0 +1,210 @@
+#include "rtp/ParityFEC.h"
+
+#include <algorithm> //std::min
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FEC_XOR_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FEC_XOR_NEON 1
+#endif
+
+ParityFEC::ParityFEC(const uint8_t groupSize, const unsigned int maximumPayloadSize) :
+    groupSize(groupSize), maximumPayloadSize(maximumPayloadSize), parityDataSize(0), numberOfPackages(0)
+{
+    fecBuffer = new char[FEC_HEADER_SIZE + maximumPayloadSize];
+}
+
+ParityFEC::~ParityFEC()
+{
+    delete[] fecBuffer;
+}
+
+bool ParityFEC::addPackage(const RTPHeader* header, const void* payload, const unsigned int payloadSize)
+{
+    FECHeader* fecHeader = (FECHeader*)fecBuffer;
+    if(numberOfPackages == 0 || numberOfPackages == groupSize)
+    {
+        //start new group
+        *fecHeader = FECHeader();
+        fecHeader->setBaseSequenceNumber(header->getSequenceNumber());
+        fecHeader->setGroupSize(groupSize);
+        memset(fecBuffer + FEC_HEADER_SIZE, 0, maximumPayloadSize);
+        parityDataSize = 0;
+        numberOfPackages = 0;
+    }
+    const unsigned int size = payloadSize > maximumPayloadSize ? maximumPayloadSize : payloadSize;
+    fecHeader->setPayloadTypeRecovery(fecHeader->getPayloadTypeRecovery() ^ ((header->isMarked() << 7) | header->getPayloadType()));
+    fecHeader->setLengthRecovery(fecHeader->getLengthRecovery() ^ (uint16_t)size);
+    fecHeader->setTimestampRecovery(fecHeader->getTimestampRecovery() ^ header->getTimestamp());
+    //the parity-buffer is zeroed out, so shorter payloads are implicitly padded
+    xorBuffers(fecBuffer + FEC_HEADER_SIZE, payload, size);
+    if(size > parityDataSize)
+    {
+        parityDataSize = size;
+    }
+    numberOfPackages++;
+    return numberOfPackages == groupSize;
+}
+
+const void* ParityFEC::getFECPayload() const
+{
+    return fecBuffer;
+}
+
+unsigned int ParityFEC::getFECPayloadSize() const
+{
+    return FEC_HEADER_SIZE + parityDataSize;
+}
+
+uint8_t ParityFEC::getGroupSize() const
+{
+    return groupSize;
+}
+
+void ParityFEC::xorBuffers(void* destination, const void* source, const unsigned int size)
+{
+    unsigned char* dest = (unsigned char*)destination;
+    const unsigned char* src = (const unsigned char*)source;
+    unsigned int i = 0;
+#if defined(FEC_XOR_SSE2)
+    for(; i + 16 <= size; i += 16)
+    {
+        __m128i d = _mm_loadu_si128((const __m128i*)(dest + i));
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dest + i), _mm_xor_si128(d, s));
+    }
+#elif defined(FEC_XOR_NEON)
+    for(; i + 16 <= size; i += 16)
+    {
+        vst1q_u8(dest + i, veorq_u8(vld1q_u8(dest + i), vld1q_u8(src + i)));
+    }
+#else
+    for(; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t d, s;
+        memcpy(&d, dest + i, sizeof(uint64_t));
+        memcpy(&s, src + i, sizeof(uint64_t));
+        d ^= s;
+        memcpy(dest + i, &d, sizeof(uint64_t));
+    }
+#endif
+    for(; i < size; i++)
+    {
+        dest[i] ^= src[i];
+    }
+}
+
+ParityFECRecovery::ParityFECRecovery(const unsigned int maximumPayloadSize) :
+    maximumPayloadSize(maximumPayloadSize), history(HISTORY_SIZE), recoveredIndex(0)
+{
+    for(StoredPackage& package : history)
+    {
+        package.isValid = false;
+    }
+}
+
+bool ParityFECRecovery::addPackage(const RTPHeader* header, const void* payload, const unsigned int payloadSize)
+{
+    if(isStored(header->getSequenceNumber()))
+    {
+        return false;
+    }
+    StoredPackage& package = history[header->getSequenceNumber() % HISTORY_SIZE];
+    const unsigned int size = payloadSize > maximumPayloadSize ? maximumPayloadSize : payloadSize;
+    package.isValid = true;
+    package.header = *header;
+    package.payload.assign((const char*)payload, (const char*)payload + size);
+    return true;
+}
+
+bool ParityFECRecovery::recoverPackage(const void* fecPayload, const unsigned int fecPayloadSize)
+{
+    if(fecPayloadSize < FEC_HEADER_SIZE || fecPayloadSize - FEC_HEADER_SIZE > maximumPayloadSize)
+    {
+        //discard invalid FEC-package
+        return false;
+    }
+    const FECHeader* fecHeader = (const FECHeader*)fecPayload;
+    //we can recover at most one package per group
+    int lostSequenceNumber = -1;
+    for(uint8_t i = 0; i < fecHeader->getGroupSize(); i++)
+    {
+        const uint16_t sequenceNumber = fecHeader->getBaseSequenceNumber() + i;
+        if(!isStored(sequenceNumber))
+        {
+            if(lostSequenceNumber >= 0)
+            {
+                return false;
+            }
+            lostSequenceNumber = sequenceNumber;
+        }
+    }
+    if(lostSequenceNumber < 0)
+    {
+        //nothing to recover
+        return false;
+    }
+    //XOR the FEC-package with all other packages of the group
+    const unsigned int parityDataSize = fecPayloadSize - FEC_HEADER_SIZE;
+    std::vector<char> payload((const char*)fecPayload + FEC_HEADER_SIZE, (const char*)fecPayload + fecPayloadSize);
+    uint8_t payloadTypeRecovery = fecHeader->getPayloadTypeRecovery();
+    uint16_t lengthRecovery = fecHeader->getLengthRecovery();
+    uint32_t timestampRecovery = fecHeader->getTimestampRecovery();
+    uint32_t ssrc = 0;
+    for(uint8_t i = 0; i < fecHeader->getGroupSize(); i++)
+    {
+        const uint16_t sequenceNumber = fecHeader->getBaseSequenceNumber() + i;
+        if(sequenceNumber == lostSequenceNumber)
+        {
+            continue;
+        }
+        const StoredPackage& groupPackage = history[sequenceNumber % HISTORY_SIZE];
+        const unsigned int groupPayloadSize = groupPackage.payload.size();
+        ParityFEC::xorBuffers(payload.data(), groupPackage.payload.data(), std::min(groupPayloadSize, parityDataSize));
+        payloadTypeRecovery ^= (groupPackage.header.isMarked() << 7) | groupPackage.header.getPayloadType();
+        lengthRecovery ^= (uint16_t)groupPayloadSize;
+        timestampRecovery ^= groupPackage.header.getTimestamp();
+        ssrc = groupPackage.header.getSSRC();
+    }
+    if(lengthRecovery > parityDataSize)
+    {
+        //corrupted FEC-package
+        return false;
+    }
+    payload.resize(lengthRecovery);
+    recoveredIndex = lostSequenceNumber % HISTORY_SIZE;
+    StoredPackage& lostPackage = history[recoveredIndex];
+    lostPackage.header = RTPHeader();
+    lostPackage.header.setMarker(payloadTypeRecovery >> 7);
+    lostPackage.header.setPayloadType((PayloadType)(payloadTypeRecovery & 0x7F));
+    lostPackage.header.setSequenceNumber(lostSequenceNumber);
+    lostPackage.header.setTimestamp(timestampRecovery);
+    lostPackage.header.setSSRC(ssrc);
+    lostPackage.payload.swap(payload);
+    //a late arrival of the lost package is now detected as duplicate
+    lostPackage.isValid = true;
+    return true;
+}
+
+const RTPHeader& ParityFECRecovery::getRecoveredHeader() const
+{
+    return history[recoveredIndex].header;
+}
+
+const void* ParityFECRecovery::getRecoveredPayload() const
+{
+    return history[recoveredIndex].payload.data();
+}
+
+unsigned int ParityFECRecovery::getRecoveredPayloadSize() const
+{
+    return history[recoveredIndex].payload.size();
+}
+
+bool ParityFECRecovery::isStored(const uint16_t sequenceNumber) const
+{
+    const StoredPackage& package = history[sequenceNumber % HISTORY_SIZE];
+    return package.isValid && package.header.getSequenceNumber() == sequenceNumber;
+}
@@ -0,0 +1,100 @@
+#include "ProcessorComfortNoise.h"
+
+const Parameter* ProcessorComfortNoise::SILENCE_THRESHOLD = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'N', "silence-threshold", "Comfort-Noise. The noise-level in -dBov (0 - 127) at or below which audio is not sent", "50"));
+
+ProcessorComfortNoise::ProcessorComfortNoise(const std::string name) : AudioProcessor(name),
+    isFloatFormat(false), inputChannels(0), outputChannels(0), silenceThreshold(DEFAULT_SILENCE_THRESHOLD), hangoverFrames(0), silentFrames(0)
+{
+}
+
+bool ProcessorComfortNoise::configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)
+{
+    if(audioConfig.audioFormat != AudioFormat::SIGNED_INT_16 && audioConfig.audioFormat != AudioFormat::FLOAT_32)
+    {
+        std::cerr << "Unsupported audio-format!" << std::endl;
+        return false;
+    }
+    isFloatFormat = audioConfig.audioFormat == AudioFormat::FLOAT_32;
+    inputChannels = audioConfig.inputDeviceChannels;
+    outputChannels = audioConfig.outputDeviceChannels;
+    hangoverFrames = (audioConfig.sampleRate * HANGOVER_MILLISECONDS) / 1000;
+    silentFrames = 0;
+    if(configMode->isCustomConfigurationSet(SILENCE_THRESHOLD->longName, "Set custom silence-threshold?"))
+    {
+        const int threshold = configMode->getCustomConfiguration(SILENCE_THRESHOLD->longName, "Type silence-threshold in -dBov", (int)DEFAULT_SILENCE_THRESHOLD);
+        if(threshold < 0 || threshold > (int)MAXIMUM_SILENCE_THRESHOLD)
+        {
+            std::cerr << "[ComfortNoise-configure-Error]Invalid silence-threshold: " << threshold << std::endl;
+            return false;
+        }
+        silenceThreshold = (unsigned int)threshold;
+    }
+    return true;
+}
+
+unsigned int ProcessorComfortNoise::getSupportedAudioFormats() const
+{
+    return AudioConfiguration::AUDIO_FORMAT_SINT16 | AudioConfiguration::AUDIO_FORMAT_FLOAT32;
+}
+
+unsigned int ProcessorComfortNoise::getSupportedSampleRates() const
+{
+    return AudioConfiguration::SAMPLE_RATE_ALL;
+}
+
+const std::vector<int> ProcessorComfortNoise::getSupportedBufferSizes(unsigned int sampleRate) const
+{
+    return std::vector<int>{BUFFER_SIZE_ANY};
+}
+
+unsigned int ProcessorComfortNoise::processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData)
+{
+    if(userData->isSilentPackage)
+    {
+        //already replaced by a previous processor, e.g. ProcessorVoiceActivityDetection
+        silentFrames = hangoverFrames + 1;
+        return inputBufferByteSize;
+    }
+    const unsigned int numberOfSamples = userData->nBufferFrames * inputChannels;
+    const uint8_t noiseLevel = isFloatFormat ? ComfortNoise::calculateNoiseLevel((const float*)inputBuffer, numberOfSamples) :
+        ComfortNoise::calculateNoiseLevel((const int16_t*)inputBuffer, numberOfSamples);
+    if(noiseLevel >= silenceThreshold)
+    {
+        //prevent overflow on long silences
+        if(silentFrames <= hangoverFrames)
+        {
+            silentFrames += userData->nBufferFrames;
+        }
+    }
+    else
+    {
+        silentFrames = 0;
+    }
+    userData->isSilentPackage = silentFrames > hangoverFrames;
+    if(!userData->isSilentPackage)
+    {
+        return inputBufferByteSize;
+    }
+    //replace the audio-data with the comfort-noise payload
+    ((uint8_t*)inputBuffer)[0] = noiseLevel;
+    return COMFORT_NOISE_PAYLOAD_SIZE;
+}
+
+unsigned int ProcessorComfortNoise::processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData)
+{
+    if(!userData->isSilentPackage)
+    {
+        return outputBufferByteSize;
+    }
+    const uint8_t noiseLevel = ((const uint8_t*)outputBuffer)[0];
+    const unsigned int numberOfSamples = userData->nBufferFrames * outputChannels;
+    //the buffer contains audio-data again for the following processors
+    userData->isSilentPackage = false;
+    if(isFloatFormat)
+    {
+        comfortNoise.generate((float*)outputBuffer, numberOfSamples, noiseLevel);
+        return numberOfSamples * sizeof(float);
+    }
+    comfortNoise.generate((int16_t*)outputBuffer, numberOfSamples, noiseLevel);
+    return numberOfSamples * sizeof(int16_t);
+}
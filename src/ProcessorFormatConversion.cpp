@@ -0,0 +1,113 @@
+#include "ProcessorFormatConversion.h"
+
+#include <iostream>
+#include <string.h> //memcpy
+
+//the largest sample-format, FLOAT_64
+static const unsigned int MAXIMUM_SAMPLE_SIZE = 8;
+
+ProcessorFormatConversion::ProcessorFormatConversion(const std::string name, const AudioFormat processingFormat) : AudioProcessor(name),
+    processingFormat(processingFormat), deviceFormat(processingFormat), inputConverter(processingFormat, processingFormat),
+    outputConverter(processingFormat, processingFormat), conversionBuffer()
+{
+}
+
+bool ProcessorFormatConversion::configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)
+{
+    deviceFormat = audioConfig.audioFormat;
+    inputConverter = FormatConverter(deviceFormat, processingFormat);
+    outputConverter = FormatConverter(processingFormat, deviceFormat);
+    if(!inputConverter.isValid() || !outputConverter.isValid())
+    {
+        std::cerr << "Unsupported audio-format for the format-conversion!" << std::endl;
+        return false;
+    }
+    const unsigned int maxChannels = audioConfig.inputDeviceChannels > audioConfig.outputDeviceChannels ?
+        audioConfig.inputDeviceChannels : audioConfig.outputDeviceChannels;
+    conversionBuffer.resize(static_cast<unsigned int>(audioConfig.bufferSize) * maxChannels * MAXIMUM_SAMPLE_SIZE);
+    return true;
+}
+
+bool ProcessorFormatConversion::cleanUp()
+{
+    std::vector<char>().swap(conversionBuffer);
+    return true;
+}
+
+unsigned int ProcessorFormatConversion::getSupportedAudioFormats() const
+{
+    return AudioConfiguration::AUDIO_FORMAT_ALL;
+}
+
+unsigned int ProcessorFormatConversion::getSupportedSampleRates() const
+{
+    return AudioConfiguration::SAMPLE_RATE_ALL;
+}
+
+const std::vector<int> ProcessorFormatConversion::getSupportedBufferSizes(unsigned int sampleRate) const
+{
+    return std::vector<int>{BUFFER_SIZE_ANY};
+}
+
+unsigned int ProcessorFormatConversion::getMaximumInputSize(const AudioConfiguration& audioConfig, const unsigned int inputBufferByteSize) const
+{
+    return getConvertedSize(inputBufferByteSize, audioConfig.audioFormat, processingFormat);
+}
+
+unsigned int ProcessorFormatConversion::getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const
+{
+    return getConvertedSize(outputBufferByteSize, processingFormat, audioConfig.audioFormat);
+}
+
+bool ProcessorFormatConversion::isProcessingInPlace() const
+{
+    return false;
+}
+
+unsigned int ProcessorFormatConversion::processInputDataOutOfPlace(const void* sourceBuffer, const unsigned int inputBufferByteSize, void* targetBuffer, StreamData* userData)
+{
+    const unsigned int numberOfSamples = inputBufferByteSize / getAudioFormatSize(deviceFormat);
+    inputConverter.convert(sourceBuffer, targetBuffer, numberOfSamples);
+    return numberOfSamples * getAudioFormatSize(processingFormat);
+}
+
+unsigned int ProcessorFormatConversion::processOutputDataOutOfPlace(const void* sourceBuffer, const unsigned int outputBufferByteSize, void* targetBuffer, StreamData* userData)
+{
+    if(userData != nullptr && userData->isSilentPackage)
+    {
+        //the buffer holds no audio-data, see ProcessorComfortNoise
+        memcpy(targetBuffer, sourceBuffer, outputBufferByteSize);
+        return outputBufferByteSize;
+    }
+    const unsigned int numberOfSamples = outputBufferByteSize / getAudioFormatSize(processingFormat);
+    outputConverter.convert(sourceBuffer, targetBuffer, numberOfSamples);
+    return numberOfSamples * getAudioFormatSize(deviceFormat);
+}
+
+unsigned int ProcessorFormatConversion::processInputData(void* inputBuffer, const unsigned int inputBufferByteSize, StreamData* userData)
+{
+    if(inputBufferByteSize > conversionBuffer.size())
+    {
+        std::cerr << "Input-buffer exceeds the configured buffer-size!" << std::endl;
+        return 0;
+    }
+    memcpy(conversionBuffer.data(), inputBuffer, inputBufferByteSize);
+    return processInputDataOutOfPlace(conversionBuffer.data(), inputBufferByteSize, inputBuffer, userData);
+}
+
+unsigned int ProcessorFormatConversion::processOutputData(void* outputBuffer, const unsigned int outputBufferByteSize, StreamData* userData)
+{
+    if(outputBufferByteSize > conversionBuffer.size())
+    {
+        std::cerr << "Output-buffer exceeds the configured buffer-size!" << std::endl;
+        return 0;
+    }
+    memcpy(conversionBuffer.data(), outputBuffer, outputBufferByteSize);
+    return processOutputDataOutOfPlace(conversionBuffer.data(), outputBufferByteSize, outputBuffer, userData);
+}
+
+unsigned int ProcessorFormatConversion::getConvertedSize(const unsigned int byteSize, const AudioFormat sourceFormat, const AudioFormat targetFormat)
+{
+    const unsigned int sourceSize = getAudioFormatSize(sourceFormat);
+    return ((byteSize + sourceSize - 1) / sourceSize) * getAudioFormatSize(targetFormat);
+}
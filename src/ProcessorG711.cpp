@@ -0,0 +1,76 @@
+#include "ProcessorG711.h"
+
+ProcessorG711::ProcessorG711(const std::string name, const G711::Law law) : AudioProcessor(name), codec(law), outputChannels(0)
+{
+}
+
+bool ProcessorG711::configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)
+{
+    if(audioConfig.audioFormat != AudioFormat::SIGNED_INT_16)
+    {
+        std::cerr << "[G.711-configure-Error]Unsupported audio-format, G.711 requires 16 bit samples!" << std::endl;
+        return false;
+    }
+    if(audioConfig.sampleRate != SAMPLE_RATE)
+    {
+        std::cerr << "[G.711-configure-Error]G.711 requires a sample-rate of 8 kHz, add a resampler before the codec!" << std::endl;
+        return false;
+    }
+    outputChannels = audioConfig.outputDeviceChannels;
+    return true;
+}
+
+unsigned int ProcessorG711::getSupportedAudioFormats() const
+{
+    return AudioConfiguration::AUDIO_FORMAT_SINT16;
+}
+
+unsigned int ProcessorG711::getSupportedSampleRates() const
+{
+    return AudioConfiguration::SAMPLE_RATE_8000;
+}
+
+const std::vector<int> ProcessorG711::getSupportedBufferSizes(unsigned int sampleRate) const
+{
+    return std::vector<int>{BUFFER_SIZE_ANY};
+}
+
+PayloadType ProcessorG711::getSupportedPlayloadType() const
+{
+    return codec.getLaw() == G711::Law::MU_LAW ? PayloadType::PCMU : PayloadType::PCMA;
+}
+
+unsigned int ProcessorG711::getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const
+{
+    return outputBufferByteSize * sizeof(int16_t);
+}
+
+unsigned int ProcessorG711::processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData)
+{
+    if(userData->isSilentPackage)
+    {
+        //the comfort-noise payload is not encoded
+        return inputBufferByteSize;
+    }
+    const unsigned int numberOfSamples = inputBufferByteSize / sizeof(int16_t);
+    codec.encode((const int16_t*)inputBuffer, (uint8_t*)inputBuffer, numberOfSamples);
+    return numberOfSamples;
+}
+
+unsigned int ProcessorG711::processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData)
+{
+    if(userData->isSilentPackage)
+    {
+        //the comfort-noise payload is not decoded
+        return outputBufferByteSize;
+    }
+    unsigned int numberOfSamples = outputBufferByteSize;
+    if(numberOfSamples * sizeof(int16_t) > userData->maxBufferSize)
+    {
+        std::cerr << "[G.711-processOutputData-Error]Buffer too small for the decoded samples!" << std::endl;
+        numberOfSamples = userData->maxBufferSize / sizeof(int16_t);
+    }
+    codec.decode((const uint8_t*)outputBuffer, (int16_t*)outputBuffer, numberOfSamples);
+    userData->nBufferFrames = numberOfSamples / outputChannels;
+    return numberOfSamples * sizeof(int16_t);
+}
@@ -0,0 +1,139 @@
+#include "ProcessorG722.h"
+
+#include <algorithm>
+
+ProcessorG722::ProcessorG722(const std::string name) : AudioProcessor(name), codecs(), inputChannels(0), outputChannels(0),
+    channelSamples(), channelBytes()
+{
+}
+
+bool ProcessorG722::configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)
+{
+    if(audioConfig.audioFormat != AudioFormat::SIGNED_INT_16)
+    {
+        std::cerr << "[G.722-configure-Error]Unsupported audio-format, G.722 requires 16 bit samples!" << std::endl;
+        return false;
+    }
+    if(audioConfig.sampleRate != G722Codec::SAMPLE_RATE)
+    {
+        std::cerr << "[G.722-configure-Error]G.722 requires a sample-rate of 16 kHz, add a resampler before the codec!" << std::endl;
+        return false;
+    }
+    inputChannels = audioConfig.inputDeviceChannels;
+    outputChannels = audioConfig.outputDeviceChannels;
+    codecs.clear();
+    codecs.resize(std::max(inputChannels, outputChannels));
+    return true;
+}
+
+unsigned int ProcessorG722::getSupportedAudioFormats() const
+{
+    return AudioConfiguration::AUDIO_FORMAT_SINT16;
+}
+
+unsigned int ProcessorG722::getSupportedSampleRates() const
+{
+    return AudioConfiguration::SAMPLE_RATE_16000;
+}
+
+const std::vector<int> ProcessorG722::getSupportedBufferSizes(unsigned int sampleRate) const
+{
+    return std::vector<int>{BUFFER_SIZE_ANY};
+}
+
+PayloadType ProcessorG722::getSupportedPlayloadType() const
+{
+    return PayloadType::G722;
+}
+
+unsigned int ProcessorG722::getRTPClockRate() const
+{
+    return G722Codec::RTP_CLOCK_RATE;
+}
+
+unsigned int ProcessorG722::getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const
+{
+    return outputBufferByteSize * 2 * sizeof(int16_t);
+}
+
+unsigned int ProcessorG722::processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData)
+{
+    if(userData->isSilentPackage)
+    {
+        //the comfort-noise payload is not encoded
+        return inputBufferByteSize;
+    }
+    unsigned int numberOfFrames = inputBufferByteSize / (sizeof(int16_t) * inputChannels);
+    if(numberOfFrames % 2 != 0)
+    {
+        std::cerr << "[G.722-processInputData-Error]Odd number of frames, the last frame is dropped!" << std::endl;
+        numberOfFrames--;
+    }
+    const unsigned int bytesPerChannel = numberOfFrames / 2;
+    if(inputChannels == 1)
+    {
+        return codecs[0].encode((const int16_t*)inputBuffer, (uint8_t*)inputBuffer, numberOfFrames);
+    }
+    //all channels are deinterleaved first, since the interleaved bytes overwrite the samples of the other channels
+    const int16_t* samples = (const int16_t*)inputBuffer;
+    channelSamples.resize(numberOfFrames * inputChannels);
+    channelBytes.resize(bytesPerChannel * inputChannels);
+    for(unsigned int c = 0; c < inputChannels; c++)
+    {
+        for(unsigned int i = 0; i < numberOfFrames; i++)
+        {
+            channelSamples[c * numberOfFrames + i] = samples[i * inputChannels + c];
+        }
+        codecs[c].encode(channelSamples.data() + c * numberOfFrames, channelBytes.data() + c * bytesPerChannel, numberOfFrames);
+    }
+    uint8_t* encoded = (uint8_t*)inputBuffer;
+    for(unsigned int c = 0; c < inputChannels; c++)
+    {
+        for(unsigned int i = 0; i < bytesPerChannel; i++)
+        {
+            encoded[i * inputChannels + c] = channelBytes[c * bytesPerChannel + i];
+        }
+    }
+    return bytesPerChannel * inputChannels;
+}
+
+unsigned int ProcessorG722::processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData)
+{
+    if(userData->isSilentPackage)
+    {
+        //the comfort-noise payload is not decoded
+        return outputBufferByteSize;
+    }
+    unsigned int bytesPerChannel = outputBufferByteSize / outputChannels;
+    if(bytesPerChannel * outputChannels * 2 * sizeof(int16_t) > userData->maxBufferSize)
+    {
+        std::cerr << "[G.722-processOutputData-Error]Buffer too small for the decoded samples!" << std::endl;
+        bytesPerChannel = userData->maxBufferSize / (outputChannels * 2 * sizeof(int16_t));
+    }
+    const unsigned int numberOfFrames = bytesPerChannel * 2;
+    userData->nBufferFrames = numberOfFrames;
+    if(outputChannels == 1)
+    {
+        return codecs[0].decode((const uint8_t*)outputBuffer, (int16_t*)outputBuffer, bytesPerChannel) * sizeof(int16_t);
+    }
+    const uint8_t* encoded = (const uint8_t*)outputBuffer;
+    channelBytes.resize(bytesPerChannel * outputChannels);
+    channelSamples.resize(numberOfFrames * outputChannels);
+    for(unsigned int c = 0; c < outputChannels; c++)
+    {
+        for(unsigned int i = 0; i < bytesPerChannel; i++)
+        {
+            channelBytes[c * bytesPerChannel + i] = encoded[i * outputChannels + c];
+        }
+    }
+    int16_t* samples = (int16_t*)outputBuffer;
+    for(unsigned int c = 0; c < outputChannels; c++)
+    {
+        codecs[c].decode(channelBytes.data() + c * bytesPerChannel, channelSamples.data() + c * numberOfFrames, bytesPerChannel);
+        for(unsigned int i = 0; i < numberOfFrames; i++)
+        {
+            samples[i * outputChannels + c] = channelSamples[c * numberOfFrames + i];
+        }
+    }
+    return numberOfFrames * outputChannels * sizeof(int16_t);
+}
@@ -0,0 +1,163 @@
+#include "ProcessorL16.h"
+
+#include "SIMD.h"
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+//the host byte-order is already the network byte-order
+#define L16_BIG_ENDIAN 1
+#endif
+
+static void swapScalar(uint16_t* samples, const unsigned int numberOfSamples)
+{
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        samples[i] = (uint16_t)((samples[i] << 8) | (samples[i] >> 8));
+    }
+}
+
+#if defined(SIMD_X86)
+
+SIMD_TARGET_SSE2 static void swapSSE2(uint16_t* samples, const unsigned int numberOfSamples)
+{
+    unsigned int i = 0;
+    //two vectors per iteration to keep enough loads in flight to saturate the memory-bandwidth
+    for(; i + 16 <= numberOfSamples; i += 16)
+    {
+        const __m128i first = _mm_loadu_si128((const __m128i*)(samples + i));
+        const __m128i second = _mm_loadu_si128((const __m128i*)(samples + i + 8));
+        _mm_storeu_si128((__m128i*)(samples + i), _mm_or_si128(_mm_slli_epi16(first, 8), _mm_srli_epi16(first, 8)));
+        _mm_storeu_si128((__m128i*)(samples + i + 8), _mm_or_si128(_mm_slli_epi16(second, 8), _mm_srli_epi16(second, 8)));
+    }
+    swapScalar(samples + i, numberOfSamples - i);
+}
+
+SIMD_TARGET_AVX2 static void swapAVX2(uint16_t* samples, const unsigned int numberOfSamples)
+{
+    //a byte-shuffle within every 16 bit lane
+    const __m256i mask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    unsigned int i = 0;
+    for(; i + 32 <= numberOfSamples; i += 32)
+    {
+        const __m256i first = _mm256_loadu_si256((const __m256i*)(samples + i));
+        const __m256i second = _mm256_loadu_si256((const __m256i*)(samples + i + 16));
+        _mm256_storeu_si256((__m256i*)(samples + i), _mm256_shuffle_epi8(first, mask));
+        _mm256_storeu_si256((__m256i*)(samples + i + 16), _mm256_shuffle_epi8(second, mask));
+    }
+    swapScalar(samples + i, numberOfSamples - i);
+}
+
+#elif defined(SIMD_NEON)
+
+static void swapNEON(uint16_t* samples, const unsigned int numberOfSamples)
+{
+    unsigned int i = 0;
+    for(; i + 16 <= numberOfSamples; i += 16)
+    {
+        const uint8x16_t first = vld1q_u8((const uint8_t*)(samples + i));
+        const uint8x16_t second = vld1q_u8((const uint8_t*)(samples + i + 8));
+        vst1q_u8((uint8_t*)(samples + i), vrev16q_u8(first));
+        vst1q_u8((uint8_t*)(samples + i + 8), vrev16q_u8(second));
+    }
+    swapScalar(samples + i, numberOfSamples - i);
+}
+
+#endif
+
+ProcessorL16::ProcessorL16(const std::string name, const FormatConverter::InstructionSet instructionSet) : AudioProcessor(name),
+    kernel(selectKernel(instructionSet)), inputChannels(0), outputChannels(0)
+{
+}
+
+bool ProcessorL16::configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)
+{
+    if(audioConfig.audioFormat != AudioFormat::SIGNED_INT_16)
+    {
+        std::cerr << "[L16-configure-Error]Unsupported audio-format, L16 requires 16 bit samples!" << std::endl;
+        return false;
+    }
+    if(audioConfig.sampleRate != SAMPLE_RATE)
+    {
+        std::cerr << "[L16-configure-Error]The L16 payload-types require a sample-rate of 44.1 kHz!" << std::endl;
+        return false;
+    }
+    if(audioConfig.inputDeviceChannels < 1 || audioConfig.inputDeviceChannels > 2 || audioConfig.outputDeviceChannels < 1 || audioConfig.outputDeviceChannels > 2)
+    {
+        std::cerr << "[L16-configure-Error]The L16 payload-types are only defined for mono and stereo audio!" << std::endl;
+        return false;
+    }
+    inputChannels = audioConfig.inputDeviceChannels;
+    outputChannels = audioConfig.outputDeviceChannels;
+    return true;
+}
+
+unsigned int ProcessorL16::getSupportedAudioFormats() const
+{
+    return AudioConfiguration::AUDIO_FORMAT_SINT16;
+}
+
+unsigned int ProcessorL16::getSupportedSampleRates() const
+{
+    return AudioConfiguration::SAMPLE_RATE_44100;
+}
+
+const std::vector<int> ProcessorL16::getSupportedBufferSizes(unsigned int sampleRate) const
+{
+    return std::vector<int>{BUFFER_SIZE_ANY};
+}
+
+PayloadType ProcessorL16::getSupportedPlayloadType() const
+{
+    return inputChannels == 1 ? PayloadType::L16_1 : PayloadType::L16_2;
+}
+
+unsigned int ProcessorL16::processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData)
+{
+    if(userData->isSilentPackage)
+    {
+        //the comfort-noise payload is not audio
+        return inputBufferByteSize;
+    }
+#ifndef L16_BIG_ENDIAN
+    kernel((uint16_t*)inputBuffer, inputBufferByteSize / sizeof(uint16_t));
+#endif
+    return inputBufferByteSize;
+}
+
+unsigned int ProcessorL16::processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData)
+{
+    if(userData->isSilentPackage)
+    {
+        return outputBufferByteSize;
+    }
+#ifndef L16_BIG_ENDIAN
+    kernel((uint16_t*)outputBuffer, outputBufferByteSize / sizeof(uint16_t));
+#endif
+    userData->nBufferFrames = outputBufferByteSize / (sizeof(uint16_t) * outputChannels);
+    return outputBufferByteSize;
+}
+
+void ProcessorL16::swapByteOrder(uint16_t* samples, const unsigned int numberOfSamples, const FormatConverter::InstructionSet instructionSet)
+{
+    selectKernel(instructionSet)(samples, numberOfSamples);
+}
+
+ProcessorL16::Kernel ProcessorL16::selectKernel(const FormatConverter::InstructionSet instructionSet)
+{
+#if defined(SIMD_X86)
+    //#swapByteOrder() selects the kernel on every call, but the CPU is only queried once
+    if(instructionSet == FormatConverter::InstructionSet::AVX2 && cpuSupportsAVX2())
+    {
+        return swapAVX2;
+    }
+    if(instructionSet == FormatConverter::InstructionSet::SSE2 || instructionSet == FormatConverter::InstructionSet::AVX2)
+    {
+        return swapSSE2;
+    }
+#elif defined(SIMD_NEON)
+    if(instructionSet == FormatConverter::InstructionSet::NEON)
+    {
+        return swapNEON;
+    }
+#endif
+    return swapScalar;
+}
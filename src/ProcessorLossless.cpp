@@ -0,0 +1,120 @@
+#include "ProcessorLossless.h"
+
+#include <algorithm>
+
+ProcessorLossless::ProcessorLossless(const std::string name) : AudioProcessor(name), encoder(), decoder(), inputChannels(0), outputChannels(0),
+    sampleSize(0), samples()
+{
+}
+
+bool ProcessorLossless::configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)
+{
+    if(audioConfig.audioFormat != AudioFormat::SIGNED_INT_16 && audioConfig.audioFormat != AudioFormat::SIGNED_INT_24)
+    {
+        std::cerr << "[Lossless-configure-Error]Unsupported audio-format, only 16 bit and 24 bit integer samples are supported!" << std::endl;
+        return false;
+    }
+    sampleSize = getAudioFormatSize(audioConfig.audioFormat);
+    inputChannels = audioConfig.inputDeviceChannels;
+    outputChannels = audioConfig.outputDeviceChannels;
+    encoder.reset(new LosslessCodec(inputChannels, sampleSize * 8));
+    decoder.reset(new LosslessCodec(outputChannels, sampleSize * 8));
+    return true;
+}
+
+unsigned int ProcessorLossless::getSupportedAudioFormats() const
+{
+    return AudioConfiguration::AUDIO_FORMAT_ALL;
+}
+
+unsigned int ProcessorLossless::getSupportedSampleRates() const
+{
+    return AudioConfiguration::SAMPLE_RATE_ALL;
+}
+
+const std::vector<int> ProcessorLossless::getSupportedBufferSizes(unsigned int sampleRate) const
+{
+    return std::vector<int>{BUFFER_SIZE_ANY};
+}
+
+PayloadType ProcessorLossless::getSupportedPlayloadType() const
+{
+    return PayloadType::LOSSLESS;
+}
+
+unsigned int ProcessorLossless::getMaximumInputSize(const AudioConfiguration& audioConfig, const unsigned int inputBufferByteSize) const
+{
+    //the verbatim samples plus the frame-header, a header per channel and the padding, see LosslessCodec::getMaximumEncodedSize()
+    return inputBufferByteSize + 3 + audioConfig.inputDeviceChannels;
+}
+
+unsigned int ProcessorLossless::getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const
+{
+    const unsigned int bufferByteSize = (unsigned int)audioConfig.bufferSize * audioConfig.outputDeviceChannels * getAudioFormatSize(audioConfig.audioFormat);
+    return std::max(outputBufferByteSize, bufferByteSize);
+}
+
+unsigned int ProcessorLossless::processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData)
+{
+    if(userData->isSilentPackage)
+    {
+        //the comfort-noise payload is not encoded
+        return inputBufferByteSize;
+    }
+    const unsigned int numberOfFrames = inputBufferByteSize / (sampleSize * inputChannels);
+    const unsigned int numberOfSamples = numberOfFrames * inputChannels;
+    samples.resize(numberOfSamples);
+    const uint8_t* bytes = (const uint8_t*)inputBuffer;
+    if(sampleSize == 2)
+    {
+        std::copy((const int16_t*)inputBuffer, (const int16_t*)inputBuffer + numberOfSamples, samples.begin());
+    }
+    else
+    {
+        for(unsigned int i = 0; i < numberOfSamples; i++)
+        {
+            //packed little-endian 24 bit samples, sign-extended by the arithmetic shift
+            samples[i] = (int32_t)((uint32_t)bytes[3 * i] << 8 | (uint32_t)bytes[3 * i + 1] << 16 | (uint32_t)bytes[3 * i + 2] << 24) >> 8;
+        }
+    }
+    const unsigned int encodedSize = encoder->encode(samples.data(), numberOfFrames, (uint8_t*)inputBuffer, userData->maxBufferSize);
+    if(encodedSize == 0)
+    {
+        std::cerr << "[Lossless-processInputData-Error]Buffer too small for the encoded frame!" << std::endl;
+    }
+    return encodedSize;
+}
+
+unsigned int ProcessorLossless::processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData)
+{
+    if(userData->isSilentPackage)
+    {
+        //the comfort-noise payload is not decoded
+        return outputBufferByteSize;
+    }
+    const unsigned int maximumFrames = userData->maxBufferSize / (sampleSize * outputChannels);
+    samples.resize(maximumFrames * outputChannels);
+    const unsigned int numberOfFrames = decoder->decode((const uint8_t*)outputBuffer, outputBufferByteSize, samples.data(), maximumFrames);
+    if(numberOfFrames == 0)
+    {
+        std::cerr << "[Lossless-processOutputData-Error]Invalid or too large frame received!" << std::endl;
+        return 0;
+    }
+    userData->nBufferFrames = numberOfFrames;
+    const unsigned int numberOfSamples = numberOfFrames * outputChannels;
+    if(sampleSize == 2)
+    {
+        std::copy(samples.begin(), samples.begin() + numberOfSamples, (int16_t*)outputBuffer);
+    }
+    else
+    {
+        uint8_t* bytes = (uint8_t*)outputBuffer;
+        for(unsigned int i = 0; i < numberOfSamples; i++)
+        {
+            bytes[3 * i] = (uint8_t)samples[i];
+            bytes[3 * i + 1] = (uint8_t)(samples[i] >> 8);
+            bytes[3 * i + 2] = (uint8_t)(samples[i] >> 16);
+        }
+    }
+    return numberOfSamples * sampleSize;
+}
@@ -0,0 +1,82 @@
+#include "ProcessorOggOpus.h"
+
+const Parameter* ProcessorOggOpus::INPUT_FILE_NAME = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'J', "input-ogg-file", "Ogg-Opus-Recorder. The name of the Ogg-file to record the encoded audio-input", ""));
+const Parameter* ProcessorOggOpus::OUTPUT_FILE_NAME = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'K', "output-ogg-file", "Ogg-Opus-Recorder. The name of the Ogg-file to record the encoded audio-output", ""));
+
+ProcessorOggOpus::ProcessorOggOpus(const std::string name, const int opusApplication) :
+    AudioProcessor(name), opusApplication(opusApplication), inputWriter(), outputWriter()
+{
+}
+
+bool ProcessorOggOpus::configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)
+{
+    if(configMode->isCustomConfigurationSet(INPUT_FILE_NAME->longName, "Record encoded audio-input?"))
+    {
+        std::string fileName = configMode->getCustomConfiguration(INPUT_FILE_NAME->longName, "Type audio-input file-name", "");
+        const unsigned int preSkip = OggOpusWriter::getPreSkip(audioConfig.sampleRate, audioConfig.inputDeviceChannels, opusApplication);
+        inputWriter.reset(new OggOpusWriter(fileName, audioConfig.inputDeviceChannels, audioConfig.sampleRate, preSkip));
+        if(!inputWriter->isOpen())
+        {
+            return false;
+        }
+    }
+    if(configMode->isCustomConfigurationSet(OUTPUT_FILE_NAME->longName, "Record encoded audio-output?"))
+    {
+        std::string fileName = configMode->getCustomConfiguration(OUTPUT_FILE_NAME->longName, "Type audio-output file-name", "");
+        outputWriter.reset(new OggOpusWriter(fileName, audioConfig.outputDeviceChannels, audioConfig.sampleRate));
+        if(!outputWriter->isOpen())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+unsigned int ProcessorOggOpus::getSupportedAudioFormats() const
+{
+    return AudioConfiguration::AUDIO_FORMAT_ALL;
+}
+
+const std::vector<int> ProcessorOggOpus::getSupportedBufferSizes(unsigned int sampleRate) const
+{
+    return std::vector<int>{BUFFER_SIZE_ANY};
+}
+
+unsigned int ProcessorOggOpus::getSupportedSampleRates() const
+{
+    return AudioConfiguration::SAMPLE_RATE_ALL;
+}
+
+PayloadType ProcessorOggOpus::getSupportedPlayloadType() const
+{
+    return PayloadType::OPUS;
+}
+
+unsigned int ProcessorOggOpus::processInputData(void* inputBuffer, const unsigned int inputBufferByteSize, StreamData* userData)
+{
+    if(inputWriter)
+    {
+        record(*inputWriter, inputBuffer, inputBufferByteSize, userData);
+    }
+    return inputBufferByteSize;
+}
+
+unsigned int ProcessorOggOpus::processOutputData(void* outputBuffer, const unsigned int outputBufferByteSize, StreamData* userData)
+{
+    if(outputWriter)
+    {
+        record(*outputWriter, outputBuffer, outputBufferByteSize, userData);
+    }
+    return outputBufferByteSize;
+}
+
+void ProcessorOggOpus::record(OggOpusWriter& writer, const void* packet, const unsigned int size, const StreamData* userData)
+{
+    //the comfort-noise payload is no Opus-packet and an empty buffer is a lost packet, the decoder conceals both
+    if(userData->isSilentPackage || size == 0)
+    {
+        writer.writeSilence();
+        return;
+    }
+    writer.write(packet, size);
+}
@@ -1,7 +1,23 @@
 #include "ProcessorOpus.h"
 
+const Parameter* ProcessorOpus::BITRATE = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'B', "opus-bitrate", "Opus-Codec. The target bitrate in bits per second (6000 - 510000), 0 to choose it automatically", "0"));
+const Parameter* ProcessorOpus::COMPLEXITY = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'C', "opus-complexity", "Opus-Codec. The complexity of the encoder from 0 (lowest CPU-usage) to 10 (best quality)", "10"));
+const Parameter* ProcessorOpus::BITRATE_MODE = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'M', "opus-bitrate-mode", "Opus-Codec. 0 for constant, 1 for variable, 2 for constrained variable bitrate", "1"));
+const Parameter* ProcessorOpus::BANDWIDTH = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'W', "opus-bandwidth", "Opus-Codec. The maximum audio bandwidth in kHz (4, 6, 8, 12 or 20)", "20"));
+const Parameter* ProcessorOpus::FRAME_DURATION = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'D', "opus-frame-duration", "Opus-Codec. The duration of an encoded frame in ms (5, 10, 20, 40 or 60), must match the processing block-size. 0 to use the block-size", "0"));
+const Parameter* ProcessorOpus::INBAND_FEC = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'F', "opus-fec", "Opus-Codec. Enables the in-band forward error-correction", ""));
+const Parameter* ProcessorOpus::DTX = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'X', "opus-dtx", "Opus-Codec. Enables the discontinuous transmission, silence is encoded with very small packets", ""));
+const Parameter* ProcessorOpus::PACKET_LOSS = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'L', "opus-packet-loss", "Opus-Codec. The expected packet-loss in percent (0 - 100)", "0"));
+const Parameter* ProcessorOpus::ENCODER_THREADS = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'T', "opus-threads", "Opus-Codec. The number of threads to encode more than two channels with, 0 to choose automatically. More than one thread should only be used with pipelined processing", "0"));
+
+OpusEncoderSettings::OpusEncoderSettings() : bitrate(OPUS_AUTO), complexity(10), bitrateMode(OpusBitrateMode::VBR),
+    maximumBandwidth(OPUS_BANDWIDTH_FULLBAND), frameDuration(OPUS_FRAMESIZE_ARG), inbandFEC(false), dtx(false), expectedPacketLoss(0)
+{
+}
+
 ProcessorOpus::ProcessorOpus(const std::string name, OpusCodingModes opusApplication) :
-    AudioProcessor(name), OpusEncoderObject(nullptr), OpusDecoderObject(nullptr)
+    AudioProcessor(name), OpusEncoderObject(nullptr), OpusDecoderObject(nullptr), multistreamEncoder(nullptr), multistreamDecoder(nullptr),
+    encoderSettings(), frameDurationFrames(0), errorCode(OPUS_OK)
 {
     this->OpusApplication = opusApplication;
 }
@@ -12,55 +28,113 @@ ProcessorOpus::~ProcessorOpus()
         opus_encoder_destroy(OpusEncoderObject);
     if(OpusDecoderObject != nullptr)
         opus_decoder_destroy(OpusDecoderObject);
+    if(multistreamDecoder != nullptr)
+        opus_multistream_decoder_destroy(multistreamDecoder);
+}
+
+unsigned int ProcessorOpus::getSupportedAudioFormats() const
+{
+    return AudioConfiguration::AUDIO_FORMAT_SINT16 | AudioConfiguration::AUDIO_FORMAT_FLOAT32;
+}
+
+unsigned int ProcessorOpus::getSupportedSampleRates() const
+{
+    //Opus also supports 12 and 24 kHz, which have no flags
+    return AudioConfiguration::SAMPLE_RATE_8000 | AudioConfiguration::SAMPLE_RATE_16000 | AudioConfiguration::SAMPLE_RATE_48000;
 }
 
 
 bool ProcessorOpus::configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)
 {
-	SpeexResamplerState
-    outputDeviceChannels = audioConfig.outputDeviceChannels;
+    if(audioConfig.audioFormat != AudioFormat::SIGNED_INT_16 && audioConfig.audioFormat != AudioFormat::FLOAT_32)
+    {
+        std::cerr << "[Opus-configure-Error]Unsupported audio-format, only 16 bit integer and 32 bit float are supported." << std::endl;
+        return false;
+    }
+    //the audio-format and number of channels are read from the stored configuration while processing
     this->audioConfig = audioConfig;
-	
-    OpusEncoderObject = opus_encoder_create(audioConfig.sampleRate, audioConfig.inputDeviceChannels, OpusApplication, &ErrorCode);
-    OpusDecoderObject = opus_decoder_create(audioConfig.sampleRate, audioConfig.outputDeviceChannels, &ErrorCode);
 
-    if (ErrorCode == OPUS_OK)
+    if(!readEncoderSettings(configMode, encoderSettings))
     {
-        return true;
+        return false;
+    }
+
+    unsigned int encoderThreads = 0;
+    if(configMode->isCustomConfigurationSet(ENCODER_THREADS->longName, "Set number of Opus-encoder threads?"))
+    {
+        encoderThreads = configMode->getCustomConfiguration(ENCODER_THREADS->longName, "Type number of threads (0 for automatic)", 0);
+    }
+
+    //Opus-encoders and -decoders support at most two channels, more channels are split into multiple streams
+    if(audioConfig.inputDeviceChannels > 2)
+    {
+        multistreamEncoder.reset(new OpusMultistreamEncoder(audioConfig.sampleRate, audioConfig.inputDeviceChannels, static_cast<int>(OpusApplication), encoderThreads));
+        errorCode = multistreamEncoder->getErrorCode();
     }
     else
     {
-        if (ErrorCode == OPUS_ALLOC_FAIL)
+        OpusEncoderObject = opus_encoder_create(audioConfig.sampleRate, audioConfig.inputDeviceChannels, static_cast<int>(OpusApplication), &errorCode);
+    }
+    if(errorCode == OPUS_OK)
+    {
+        if(audioConfig.outputDeviceChannels > 2)
+        {
+            //the decoder must use the same channel-mapping as the multistream-encoder of the remote side
+            unsigned int streams = 0;
+            unsigned int coupledStreams = 0;
+            std::vector<unsigned char> mapping;
+            OpusMultistreamEncoder::getChannelMapping(audioConfig.outputDeviceChannels, streams, coupledStreams, mapping);
+            multistreamDecoder = opus_multistream_decoder_create(audioConfig.sampleRate, audioConfig.outputDeviceChannels, streams, coupledStreams, mapping.data(), &errorCode);
+        }
+        else
+        {
+            OpusDecoderObject = opus_decoder_create(audioConfig.sampleRate, audioConfig.outputDeviceChannels, &errorCode);
+        }
+    }
+
+    if (errorCode == OPUS_OK)
+    {
+        //the size of the processing-blocks may differ from the buffer-size, so the frame-duration is checked while encoding
+        frameDurationFrames = getFrameDurationFrames(encoderSettings.frameDuration, audioConfig.sampleRate);
+        if(multistreamEncoder)
+        {
+            return multistreamEncoder->applySettings(encoderSettings, 0);
+        }
+        return applyEncoderSettings(OpusEncoderObject, encoderSettings, 0, audioConfig.sampleRate);
+    }
+    else
+    {
+        if (errorCode == OPUS_ALLOC_FAIL)
         {
             std::cerr << "[Opus-configure-Error]Memory allocation has failed." << std::endl;
             return false;
         }
-        else if (ErrorCode == OPUS_BAD_ARG)
+        else if (errorCode == OPUS_BAD_ARG)
         {
             std::cerr << "[Opus-configure-Error]One or more invalid/out of range arguments." << std::endl;
             return false;
         }
-        else if (ErrorCode == OPUS_BUFFER_TOO_SMALL)
+        else if (errorCode == OPUS_BUFFER_TOO_SMALL)
         {
             std::cerr << "[Opus-configure-Error]The mode struct passed is invalid." << std::endl;
             return false;
         }
-        else if (ErrorCode == OPUS_INTERNAL_ERROR)
+        else if (errorCode == OPUS_INTERNAL_ERROR)
         {
             std::cerr << "[Opus-configure-Error]An internal error was detected." << std::endl;
             return false;
         }
-        else if (ErrorCode == OPUS_INVALID_PACKET)
+        else if (errorCode == OPUS_INVALID_PACKET)
         {
             std::cerr << "[Opus-configure-Error]The compressed data passed is corrupted." << std::endl;
             return false;
         }
-        else if (ErrorCode == OPUS_INVALID_STATE)
+        else if (errorCode == OPUS_INVALID_STATE)
         {
             std::cerr << "[Opus-configure-Error]An encoder or decoder structure is invalid or already freed." << std::endl;
             return false;
         }
-        else if (ErrorCode == OPUS_UNIMPLEMENTED)
+        else if (errorCode == OPUS_UNIMPLEMENTED)
         {
             std::cerr << "[Opus-configure-Error]Invalid/unsupported request number. " << std::endl;
             return false;
@@ -75,15 +149,31 @@ bool ProcessorOpus::configure(const AudioConfiguration& audioConfig, const std::
 
 unsigned int ProcessorOpus::processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData)
 {
-	
+    if(userData->isSilentPackage)
+    {
+        //the comfort-noise payload is not encoded
+        return inputBufferByteSize;
+    }
+    if(frameDurationFrames != 0 && !checkFrameDuration(userData->nBufferFrames))
+    {
+        return 0;
+    }
     unsigned int lengthEncodedPacketInBytes = 0;
-    if (rtaudioFormat == AudioConfiguration::AUDIO_FORMAT_SINT16)
+    if (audioConfig.audioFormat == AudioFormat::SIGNED_INT_16)
     {
+        if(multistreamEncoder)
+        {
+            return multistreamEncoder->encode((const opus_int16 *)inputBuffer, userData->nBufferFrames, (unsigned char *)inputBuffer, userData->maxBufferSize);
+        }
         lengthEncodedPacketInBytes = opus_encode(OpusEncoderObject, (opus_int16 *)inputBuffer, userData->nBufferFrames, (unsigned char *)inputBuffer, userData->maxBufferSize);
         return lengthEncodedPacketInBytes;
     }
-    else if (rtaudioFormat == AudioConfiguration::AUDIO_FORMAT_FLOAT32)
+    else if (audioConfig.audioFormat == AudioFormat::FLOAT_32)
     {
+        if(multistreamEncoder)
+        {
+            return multistreamEncoder->encode((const float *)inputBuffer, userData->nBufferFrames, (unsigned char *)inputBuffer, userData->maxBufferSize);
+        }
         lengthEncodedPacketInBytes = opus_encode_float(OpusEncoderObject, (const float *)inputBuffer, userData->nBufferFrames, (unsigned char *)inputBuffer, userData->maxBufferSize);
         return lengthEncodedPacketInBytes;
     }
@@ -96,19 +186,32 @@ unsigned int ProcessorOpus::processInputData(void *inputBuffer, const unsigned i
 
 unsigned int ProcessorOpus::processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData)
 {
+    if(userData->isSilentPackage)
+    {
+        //the comfort-noise payload is not decoded
+        return outputBufferByteSize;
+    }
     unsigned int numberOfDecodedSamples = 0;
-    if (rtaudioFormat == AudioConfiguration::AUDIO_FORMAT_SINT16)
+    //the decoders expect the capacity of the buffer in frames per channel
+    const unsigned int maximumFrames = userData->maxBufferSize / (audioConfig.outputDeviceChannels * getAudioFormatSize(audioConfig.audioFormat));
+    if (audioConfig.audioFormat == AudioFormat::SIGNED_INT_16)
     {
-        numberOfDecodedSamples = opus_decode(OpusDecoderObject, (unsigned char *)outputBuffer, outputBufferByteSize, (opus_int16 *)outputBuffer, userData->maxBufferSize, 0);
+        if(multistreamDecoder != nullptr)
+            numberOfDecodedSamples = opus_multistream_decode(multistreamDecoder, (unsigned char *)outputBuffer, outputBufferByteSize, (opus_int16 *)outputBuffer, maximumFrames, 0);
+        else
+            numberOfDecodedSamples = opus_decode(OpusDecoderObject, (unsigned char *)outputBuffer, outputBufferByteSize, (opus_int16 *)outputBuffer, maximumFrames, 0);
         userData->nBufferFrames = numberOfDecodedSamples;
-        const unsigned int outputBufferInBytes = (numberOfDecodedSamples * sizeof(opus_int16) * outputDeviceChannels);
+        const unsigned int outputBufferInBytes = (numberOfDecodedSamples * sizeof(opus_int16) * audioConfig.outputDeviceChannels);
         return outputBufferInBytes;
     }
-    else if (rtaudioFormat == AudioConfiguration::AUDIO_FORMAT_FLOAT32)
+    else if (audioConfig.audioFormat == AudioFormat::FLOAT_32)
     {
-        numberOfDecodedSamples = opus_decode_float(OpusDecoderObject, (const unsigned char *)outputBuffer, outputBufferByteSize, (float *)outputBuffer, userData->maxBufferSize, 0);
+        if(multistreamDecoder != nullptr)
+            numberOfDecodedSamples = opus_multistream_decode_float(multistreamDecoder, (const unsigned char *)outputBuffer, outputBufferByteSize, (float *)outputBuffer, maximumFrames, 0);
+        else
+            numberOfDecodedSamples = opus_decode_float(OpusDecoderObject, (const unsigned char *)outputBuffer, outputBufferByteSize, (float *)outputBuffer, maximumFrames, 0);
         userData->nBufferFrames = numberOfDecodedSamples;
-        const unsigned int outputBufferInBytes = (numberOfDecodedSamples * sizeof(float) * outputDeviceChannels);
+        const unsigned int outputBufferInBytes = (numberOfDecodedSamples * sizeof(float) * audioConfig.outputDeviceChannels);
         return outputBufferInBytes;
     }
     else
@@ -118,3 +221,137 @@ unsigned int ProcessorOpus::processOutputData(void *outputBuffer, const unsigned
     }
 }
 
+bool ProcessorOpus::applyEncoderSettings(OpusEncoder* encoder, const OpusEncoderSettings& settings, const unsigned int frameSize, const unsigned int sampleRate)
+{
+    const unsigned int durationFrames = getFrameDurationFrames(settings.frameDuration, sampleRate);
+    if(durationFrames != 0 && frameSize != 0 && durationFrames != frameSize)
+    {
+        //the encoder would only encode the first frames of every buffer
+        std::cerr << "[Opus-configure-Error]The frame-duration does not match the buffer-size of " << frameSize << " frames." << std::endl;
+        return false;
+    }
+    const int results[] = {
+        opus_encoder_ctl(encoder, OPUS_SET_BITRATE(settings.bitrate)),
+        opus_encoder_ctl(encoder, OPUS_SET_COMPLEXITY(settings.complexity)),
+        opus_encoder_ctl(encoder, OPUS_SET_VBR(settings.bitrateMode == OpusBitrateMode::CBR ? 0 : 1)),
+        opus_encoder_ctl(encoder, OPUS_SET_VBR_CONSTRAINT(settings.bitrateMode == OpusBitrateMode::CONSTRAINED_VBR ? 1 : 0)),
+        opus_encoder_ctl(encoder, OPUS_SET_MAX_BANDWIDTH(settings.maximumBandwidth)),
+        opus_encoder_ctl(encoder, OPUS_SET_EXPERT_FRAME_DURATION(settings.frameDuration)),
+        opus_encoder_ctl(encoder, OPUS_SET_INBAND_FEC(settings.inbandFEC ? 1 : 0)),
+        opus_encoder_ctl(encoder, OPUS_SET_DTX(settings.dtx ? 1 : 0)),
+        opus_encoder_ctl(encoder, OPUS_SET_PACKET_LOSS_PERC(settings.expectedPacketLoss))
+    };
+    for(const int result : results)
+    {
+        if(result != OPUS_OK)
+        {
+            std::cerr << "[Opus-configure-Error]Invalid encoder-setting: " << opus_strerror(result) << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+unsigned int ProcessorOpus::getFrameDurationFrames(const int frameDuration, const unsigned int sampleRate)
+{
+    if(frameDuration == OPUS_FRAMESIZE_ARG)
+    {
+        return 0;
+    }
+    //OPUS_FRAMESIZE_2_5_MS is 2.5 ms, every following value doubles the duration, up to 40 ms. 60 ms is the exception
+    return frameDuration == OPUS_FRAMESIZE_60_MS ? sampleRate * 60 / 1000 : (sampleRate / 400) << (frameDuration - OPUS_FRAMESIZE_2_5_MS);
+}
+
+bool ProcessorOpus::checkFrameDuration(const unsigned int numberOfFrames)
+{
+    if(numberOfFrames == frameDurationFrames)
+    {
+        return true;
+    }
+    //the encoder would only encode the first frames of every block
+    std::cerr << "[Opus-processInputData-Error]The frame-duration does not match the processing-block of " << numberOfFrames
+        << " frames, encoding the whole block instead." << std::endl;
+    encoderSettings.frameDuration = OPUS_FRAMESIZE_ARG;
+    frameDurationFrames = 0;
+    if(multistreamEncoder)
+    {
+        return multistreamEncoder->applySettings(encoderSettings, 0);
+    }
+    return applyEncoderSettings(OpusEncoderObject, encoderSettings, 0, audioConfig.sampleRate);
+}
+
+bool ProcessorOpus::readEncoderSettings(const std::shared_ptr<ConfigurationMode> configMode, OpusEncoderSettings& settings)
+{
+    if(configMode->isCustomConfigurationSet(BITRATE->longName, "Set custom Opus-bitrate?"))
+    {
+        const int bitrate = configMode->getCustomConfiguration(BITRATE->longName, "Type bitrate in bits per second (0 for automatic)", 0);
+        if(bitrate != 0 && (bitrate < 6000 || bitrate > 510000))
+        {
+            std::cerr << "[Opus-configure-Error]Invalid bitrate: " << bitrate << std::endl;
+            return false;
+        }
+        settings.bitrate = bitrate == 0 ? OPUS_AUTO : bitrate;
+    }
+    if(configMode->isCustomConfigurationSet(COMPLEXITY->longName, "Set custom Opus-complexity?"))
+    {
+        settings.complexity = configMode->getCustomConfiguration(COMPLEXITY->longName, "Type complexity (0 - 10)", settings.complexity);
+        if(settings.complexity < 0 || settings.complexity > 10)
+        {
+            std::cerr << "[Opus-configure-Error]Invalid complexity: " << settings.complexity << std::endl;
+            return false;
+        }
+    }
+    if(configMode->isCustomConfigurationSet(BITRATE_MODE->longName, "Set custom Opus-bitrate-mode?"))
+    {
+        const int mode = configMode->getCustomConfiguration(BITRATE_MODE->longName, "Type bitrate-mode (0 = CBR, 1 = VBR, 2 = constrained VBR)", static_cast<int>(settings.bitrateMode));
+        if(mode < static_cast<int>(OpusBitrateMode::CBR) || mode > static_cast<int>(OpusBitrateMode::CONSTRAINED_VBR))
+        {
+            std::cerr << "[Opus-configure-Error]Invalid bitrate-mode: " << mode << std::endl;
+            return false;
+        }
+        settings.bitrateMode = static_cast<OpusBitrateMode>(mode);
+    }
+    if(configMode->isCustomConfigurationSet(BANDWIDTH->longName, "Set custom Opus-bandwidth?"))
+    {
+        const int bandwidth = configMode->getCustomConfiguration(BANDWIDTH->longName, "Type maximum bandwidth in kHz (4, 6, 8, 12 or 20)", 20);
+        switch(bandwidth)
+        {
+            case 4: settings.maximumBandwidth = OPUS_BANDWIDTH_NARROWBAND; break;
+            case 6: settings.maximumBandwidth = OPUS_BANDWIDTH_MEDIUMBAND; break;
+            case 8: settings.maximumBandwidth = OPUS_BANDWIDTH_WIDEBAND; break;
+            case 12: settings.maximumBandwidth = OPUS_BANDWIDTH_SUPERWIDEBAND; break;
+            case 20: settings.maximumBandwidth = OPUS_BANDWIDTH_FULLBAND; break;
+            default:
+                std::cerr << "[Opus-configure-Error]Invalid bandwidth: " << bandwidth << std::endl;
+                return false;
+        }
+    }
+    if(configMode->isCustomConfigurationSet(FRAME_DURATION->longName, "Set custom Opus-frame-duration?"))
+    {
+        const int duration = configMode->getCustomConfiguration(FRAME_DURATION->longName, "Type frame-duration in ms (5, 10, 20, 40 or 60, 0 for the buffer-size)", 0);
+        switch(duration)
+        {
+            case 0: settings.frameDuration = OPUS_FRAMESIZE_ARG; break;
+            case 5: settings.frameDuration = OPUS_FRAMESIZE_5_MS; break;
+            case 10: settings.frameDuration = OPUS_FRAMESIZE_10_MS; break;
+            case 20: settings.frameDuration = OPUS_FRAMESIZE_20_MS; break;
+            case 40: settings.frameDuration = OPUS_FRAMESIZE_40_MS; break;
+            case 60: settings.frameDuration = OPUS_FRAMESIZE_60_MS; break;
+            default:
+                std::cerr << "[Opus-configure-Error]Invalid frame-duration: " << duration << std::endl;
+                return false;
+        }
+    }
+    settings.inbandFEC = configMode->isCustomConfigurationSet(INBAND_FEC->longName, "Enable Opus in-band FEC?");
+    settings.dtx = configMode->isCustomConfigurationSet(DTX->longName, "Enable Opus DTX?");
+    if(configMode->isCustomConfigurationSet(PACKET_LOSS->longName, "Set expected packet-loss?"))
+    {
+        settings.expectedPacketLoss = configMode->getCustomConfiguration(PACKET_LOSS->longName, "Type expected packet-loss in percent", 0);
+        if(settings.expectedPacketLoss < 0 || settings.expectedPacketLoss > 100)
+        {
+            std::cerr << "[Opus-configure-Error]Invalid packet-loss: " << settings.expectedPacketLoss << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
@@ -3,13 +3,46 @@
 
 Participant participantDatabase[2] = {0};
 
+const Parameter* ProcessorRTP::FEC_GROUP_SIZE = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'E', "fec-group-size", "RTP. Sends a parity FEC-package for every group of this many RTP-packages (1 - 255), 0 disables FEC", "0"));
+
 ProcessorRTP::ProcessorRTP(const std::string name, std::shared_ptr<NetworkWrapper> networkwrapper, 
-                           std::shared_ptr<RTPBufferHandler> buffer, const PayloadType payloadType) : AudioProcessor(name), payloadType(payloadType)
+                           std::shared_ptr<RTPBufferHandler> buffer, const PayloadType payloadType, const uint8_t fecGroupSize,
+                           const unsigned short maxPackageDuration, std::shared_ptr<SRTPContext> srtpContext, const bool sendCaptureTime,
+                           std::shared_ptr<SRTPContext> fecSRTPContext) :
+    AudioProcessor(name), payloadType(payloadType), fecGroupSize(fecGroupSize), maxPackageDuration(maxPackageDuration), srtpContext(srtpContext),
+    fecSRTPContext(fecSRTPContext), sendCaptureTime(sendCaptureTime)
 {
     this->networkObject = networkwrapper;
     this->rtpBuffer = buffer;
 }
 
+bool ProcessorRTP::configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)
+{
+    //required to determine the number of frames per package
+    sampleRate = audioConfig.sampleRate;
+    if(configMode->isCustomConfigurationSet(FEC_GROUP_SIZE->longName, "Enable forward error-correction?"))
+    {
+        const int groupSize = configMode->getCustomConfiguration(FEC_GROUP_SIZE->longName, "Type number of RTP-packages per FEC-package (0 to disable)", static_cast<int>(fecGroupSize));
+        if(groupSize < 0 || groupSize > UINT8_MAX)
+        {
+            std::cerr << "[RTP-configure-Error]Invalid FEC group-size: " << groupSize << std::endl;
+            return false;
+        }
+        fecGroupSize = static_cast<uint8_t>(groupSize);
+    }
+    if(maxPackageDuration > 0 && !checkPackageDuration(audioConfig))
+    {
+        return false;
+    }
+    if(fecGroupSize > 0 && srtpContext != nullptr && (fecSRTPContext == nullptr || fecSRTPContext == srtpContext))
+    {
+        //the FEC-packages would be sent unencrypted or reuse the IVs of the media-packages
+        std::cerr << "[RTP-configure-Error]FEC with SRTP requires a separate SRTP-context for the FEC-packages!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
 unsigned int ProcessorRTP::getSupportedAudioFormats() const
 {
     return AudioConfiguration::AUDIO_FORMAT_ALL;
@@ -30,17 +63,35 @@ unsigned int ProcessorRTP::processInputData(void *inputBuffer, const unsigned in
     // pack data into a rtp-package
     if (rtpPackage == nullptr)
     {
-        initPackageHandler(userData->maxBufferSize);
+        initPackageHandler(userData);
+    }
+    if(userData->isSilentPackage)
+    {
+        //comfort-noise is not played back, so its latency is not measured
+        packageCaptureTime = 0;
+    }
+    else if(sendCaptureTime && packageCaptureTime == 0 && sampleRate > 0)
+    {
+        //the processors are run, when the buffer is full, so the first frame was captured one buffer-duration earlier
+        packageCaptureTime = RTPPackageHandler::getWallClockTime() - (1000000000ull * userData->nBufferFrames) / sampleRate;
+    }
+    if(userData->isSilentPackage)
+    {
+        sendComfortNoise(((const uint8_t*)inputBuffer)[0], userData->nBufferFrames);
+    }
+    else if(frameAggregator != nullptr)
+    {
+        //only send a package, if enough frames are combined
+        if(frameAggregator->addFrame(inputBuffer, inputBufferByteSize))
+        {
+            sendPackage(frameAggregator->getPayload(), frameAggregator->getPayloadSize(), payloadType);
+        }
+    }
+    else
+    {
+        sendPackage(inputBuffer, inputBufferByteSize, payloadType);
     }
-    const void* newRTPPackage = rtpPackage->createNewRTPPackage(inputBuffer, inputBufferByteSize);
-    //only send the number of bytes really required: header + actual payload-size
-    this->networkObject->sendData(newRTPPackage, rtpPackage->getRTPHeaderSize() + inputBufferByteSize);
-
-    participantDatabase[PARTICIPANT_SELF].extendedHighestSequenceNumber += 1;
     Statistics::incrementCounter(Statistics::COUNTER_FRAMES_SENT, userData->nBufferFrames);
-    Statistics::incrementCounter(Statistics::COUNTER_PACKAGES_SENT, 1);
-    Statistics::incrementCounter(Statistics::COUNTER_HEADER_BYTES_SENT, RTP_HEADER_MIN_SIZE);
-    Statistics::incrementCounter(Statistics::COUNTER_PAYLOAD_BYTES_SENT, inputBufferByteSize);
 
     //no changes in buffer-size
     return inputBufferByteSize;
@@ -51,10 +102,26 @@ unsigned int ProcessorRTP::processOutputData(void *outputBuffer, const unsigned
     // unpack data from a rtp-package
     if (rtpPackage == nullptr)
     {
-        initPackageHandler(userData->maxBufferSize);
+        initPackageHandler(userData);
     }
     //read package from buffer
     auto result = rtpBuffer->readPackage(*rtpPackage);
+    if(result == RTPBufferStatus::RTP_BUFFER_ALL_OKAY)
+    {
+        isReceivingSilence = rtpPackage->getRTPPackageHeader()->getPayloadType() == PayloadType::CN;
+        if(isReceivingSilence && rtpPackage->getActualPayloadSize() >= COMFORT_NOISE_PAYLOAD_SIZE)
+        {
+            receivedNoiseLevel = ((const uint8_t*)rtpPackage->getRTPPackageData())[0];
+        }
+    }
+    userData->isSilentPackage = isReceivingSilence && (result == RTPBufferStatus::RTP_BUFFER_ALL_OKAY || result == RTPBufferStatus::RTP_BUFFER_OUTPUT_UNDERFLOW);
+    if(userData->isSilentPackage)
+    {
+        //during silence, the sender only sends comfort-noise packages occasionally, so an underflow is expected
+        memset(outputBuffer, 0, outputBufferByteSize);
+        ((uint8_t*)outputBuffer)[0] = receivedNoiseLevel;
+        return COMFORT_NOISE_PAYLOAD_SIZE;
+    }
 
     if (result == RTPBufferStatus::RTP_BUFFER_IS_PUFFERING)
     {
@@ -65,6 +132,11 @@ unsigned int ProcessorRTP::processOutputData(void *outputBuffer, const unsigned
         std::cerr << "Output Buffer underflow" << std::endl;
     }
 
+    if(result == RTPBufferStatus::RTP_BUFFER_ALL_OKAY)
+    {
+        recordLatency(userData->nBufferFrames);
+    }
+
     const void* recvAudioData = rtpPackage->getRTPPackageData();
     unsigned int receivedPayloadSize = rtpPackage->getActualPayloadSize();
     memcpy(outputBuffer, recvAudioData, outputBufferByteSize);
@@ -84,11 +156,51 @@ bool ProcessorRTP::cleanUp()
     //clean up send-buffer
     delete rtpPackage;
     rtpPackage = nullptr;
+    delete fecPackage;
+    fecPackage = nullptr;
+    delete parityFEC;
+    parityFEC = nullptr;
+    //frames of an incomplete aggregated package are not sent anymore,
+    //this drops less than the maximum package duration of audio at the end of the communication
+    delete frameAggregator;
+    frameAggregator = nullptr;
+    return true;
+}
+
+bool ProcessorRTP::checkPackageDuration(const AudioConfiguration& audioConfig) const
+{
+    const unsigned int bufferFrames = static_cast<unsigned int>(audioConfig.bufferSize);
+    if(bufferFrames == 0)
+    {
+        //the number of frames per package is determined from the first buffer
+        return true;
+    }
+    //the size of the uncompressed audio-frames is the upper bound for the encoded frames
+    const unsigned int frameSize = bufferFrames * audioConfig.inputDeviceChannels * getAudioFormatSize(audioConfig.audioFormat);
+    const unsigned int framesPerPackage = (maxPackageDuration * audioConfig.sampleRate) / (1000 * bufferFrames);
+    if(framesPerPackage > UINT8_MAX || FrameAggregator::getMaximumPayloadSize(framesPerPackage, frameSize) > FrameAggregator::MAXIMUM_PAYLOAD_SIZE)
+    {
+        std::cerr << "[RTP-configure-Error]The maximum package-duration of " << maxPackageDuration
+            << " ms exceeds the maximum size of an aggregated package!" << std::endl;
+        return false;
+    }
     return true;
 }
 
-void ProcessorRTP::initPackageHandler(unsigned int maxBufferSize)
+void ProcessorRTP::initPackageHandler(const StreamData *userData)
 {
+    unsigned int maxBufferSize = userData->maxBufferSize;
+    if(maxPackageDuration > 0 && sampleRate > 0 && frameAggregator == nullptr)
+    {
+        //combine as many frames as fit into the maximum package duration
+        unsigned int framesPerPackage = (maxPackageDuration * sampleRate) / (1000 * userData->nBufferFrames);
+        //the actual buffer-size may exceed the estimation of #checkPackageDuration()
+        const unsigned int maximumFrames = (FrameAggregator::MAXIMUM_PAYLOAD_SIZE - 1) / (sizeof(uint16_t) + maxBufferSize);
+        framesPerPackage = framesPerPackage > maximumFrames ? maximumFrames : framesPerPackage;
+        framesPerPackage = framesPerPackage < 1 ? 1 : (framesPerPackage > UINT8_MAX ? UINT8_MAX : framesPerPackage);
+        frameAggregator = new FrameAggregator(framesPerPackage, maxBufferSize);
+        maxBufferSize = FrameAggregator::getMaximumPayloadSize(framesPerPackage, maxBufferSize);
+    }
     if(rtpPackage == nullptr)
     {
         rtpPackage = new RTPPackageHandler(maxBufferSize, payloadType);
@@ -96,4 +208,108 @@ void ProcessorRTP::initPackageHandler(unsigned int maxBufferSize)
     participantDatabase[PARTICIPANT_SELF].ssrc = rtpPackage->ssrc;
     participantDatabase[PARTICIPANT_SELF].initialRTPTimestamp = rtpPackage->timestamp;
     participantDatabase[PARTICIPANT_SELF].extendedHighestSequenceNumber = rtpPackage->sequenceNr;
+    //the SRTP rollover-counter starts with zero
+    mediaPackageIndex = rtpPackage->sequenceNr & 0xFFFF;
+    if(fecGroupSize > 0 && parityFEC == nullptr)
+    {
+        parityFEC = new ParityFEC(fecGroupSize, maxBufferSize);
+        fecPackage = new RTPPackageHandler(FEC_HEADER_SIZE + maxBufferSize, PayloadType::FEC);
+        //FEC-packages belong to the same source, but use their own sequence numbers.
+        //With SRTP, they are encrypted with their own context, since the IV is derived from SSRC and sequence number
+        fecPackage->ssrc = rtpPackage->ssrc;
+        fecPackageIndex = fecPackage->sequenceNr & 0xFFFF;
+    }
+}
+
+void ProcessorRTP::sendComfortNoise(const uint8_t noiseLevel, const unsigned int numberOfFrames)
+{
+    const int levelChange = (int)noiseLevel - (int)sentNoiseLevel;
+    framesSinceComfortNoise += numberOfFrames;
+    if(!isSendingSilence || framesSinceComfortNoise >= (COMFORT_NOISE_INTERVAL * sampleRate) / 1000
+       || (unsigned int)abs(levelChange) >= COMFORT_NOISE_LEVEL_CHANGE)
+    {
+        if(!isSendingSilence && frameAggregator != nullptr)
+        {
+            //the frames before the silence are not sent to not delay the comfort-noise
+            frameAggregator->reset();
+        }
+        isSendingSilence = true;
+        sentNoiseLevel = noiseLevel;
+        framesSinceComfortNoise = 0;
+        sendPackage(&noiseLevel, COMFORT_NOISE_PAYLOAD_SIZE, PayloadType::CN);
+    }
+    else
+    {
+        Statistics::incrementCounter(Statistics::COUNTER_BUFFERS_SUPPRESSED, 1);
+    }
+}
+
+void ProcessorRTP::sendPackage(const void *payload, unsigned int payloadSize, const PayloadType payloadType)
+{
+    rtpPackage->createNewRTPPackage(payload, payloadSize, payloadType, packageCaptureTime);
+    packageCaptureTime = 0;
+    if(isSendingSilence && payloadType != PayloadType::CN)
+    {
+        //the marker-bit marks the first package after a silence (RFC 3551 section 4.1)
+        ((RTPHeader*)rtpPackage->getWorkBuffer())->setMarker(true);
+        isSendingSilence = false;
+    }
+    //only send the number of bytes really required: header + header-extension + actual payload-size
+    const unsigned int packageSize = rtpPackage->getRTPHeaderSize() + rtpPackage->getRTPHeaderExtensionSize() + payloadSize;
+    const unsigned int sentSize = sendRTPPackage(*rtpPackage, packageSize, srtpContext.get(), mediaPackageIndex);
+    if(sentSize == 0)
+    {
+        return;
+    }
+    if(parityFEC != nullptr)
+    {
+        sendFECPackage(payload, payloadSize);
+    }
+
+    participantDatabase[PARTICIPANT_SELF].extendedHighestSequenceNumber += 1;
+    Statistics::incrementCounter(Statistics::COUNTER_PACKAGES_SENT, 1);
+    //the SRTP authentication-tag is counted as header
+    Statistics::incrementCounter(Statistics::COUNTER_HEADER_BYTES_SENT, sentSize - payloadSize);
+    Statistics::incrementCounter(Statistics::COUNTER_PAYLOAD_BYTES_SENT, payloadSize);
+}
+
+void ProcessorRTP::sendFECPackage(const void *payload, unsigned int payloadSize)
+{
+    if(parityFEC->addPackage(rtpPackage->getRTPPackageHeader(), payload, payloadSize))
+    {
+        fecPackage->createNewRTPPackage(parityFEC->getFECPayload(), parityFEC->getFECPayloadSize());
+        const unsigned int sentSize = sendRTPPackage(*fecPackage, fecPackage->getRTPHeaderSize() + parityFEC->getFECPayloadSize(), fecSRTPContext.get(), fecPackageIndex);
+        Statistics::incrementCounter(Statistics::COUNTER_HEADER_BYTES_SENT, sentSize);
+    }
+}
+
+unsigned int ProcessorRTP::sendRTPPackage(RTPPackageHandler& package, unsigned int packageSize, const SRTPContext* context, uint32_t& packageIndex)
+{
+    if(context != nullptr)
+    {
+        packageIndex = SRTPContext::estimatePackageIndex(packageIndex, package.getRTPPackageHeader()->getSequenceNumber());
+        if(!context->protect(package, packageSize, packageIndex >> 16))
+        {
+            //never send the package unencrypted
+            std::cerr << "Failed to encrypt SRTP-package" << std::endl;
+            return 0;
+        }
+    }
+    this->networkObject->sendData(package.getWorkBuffer(), packageSize);
+    return packageSize;
+}
+
+void ProcessorRTP::recordLatency(const unsigned int numberOfFrames)
+{
+    //the buffer is played back after the buffer currently played by the sound-device,
+    //the latency of the sound-device itself is unknown
+    const uint64_t outputDelay = sampleRate > 0 ? (1000000000ull * numberOfFrames) / sampleRate : 0;
+    Statistics::recordLatency(Statistics::LATENCY_OUTPUT, outputDelay);
+    const PackageTiming timing = rtpPackage->getPackageTiming();
+    const uint64_t playbackTime = RTPPackageHandler::getWallClockTime() + outputDelay;
+    //if the clocks are not synchronized, the package may seem to be played back before it was captured
+    if(timing.captureTime != 0 && playbackTime > timing.captureTime)
+    {
+        Statistics::recordLatency(Statistics::LATENCY_MOUTH_TO_EAR, playbackTime - timing.captureTime);
+    }
 }
@@ -0,0 +1,169 @@
+#include "ProcessorResampler.h"
+
+#include <iostream>
+#include <string.h> //memcpy
+
+const Parameter* ProcessorResampler::PROCESSING_RATE = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'R', "resample-rate", "Resampler. The sample-rate in Hz to resample the audio of the device to", "48000"));
+const Parameter* ProcessorResampler::QUALITY = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'Q', "resample-quality", "Resampler. The quality of the resampling from 0 (lowest CPU-usage) to 3 (best quality)", "2"));
+
+ProcessorResampler::ProcessorResampler(const std::string name) : AudioProcessor(name),
+    inputChannels(0), outputChannels(0), inputResampler(nullptr), outputResampler(nullptr), resamplingBuffer()
+{
+}
+
+bool ProcessorResampler::configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)
+{
+    if(audioConfig.audioFormat != AudioFormat::FLOAT_32)
+    {
+        std::cerr << "Unsupported audio-format!" << std::endl;
+        return false;
+    }
+    unsigned int processingRate = DEFAULT_PROCESSING_RATE;
+    if(configMode->isCustomConfigurationSet(PROCESSING_RATE->longName, "Set custom resampling-rate?"))
+    {
+        processingRate = configMode->getCustomConfiguration(PROCESSING_RATE->longName, "Type sample-rate in Hz", (int)DEFAULT_PROCESSING_RATE);
+    }
+    int quality = static_cast<int>(Resampler::Quality::HIGH);
+    if(configMode->isCustomConfigurationSet(QUALITY->longName, "Set custom resampling-quality?"))
+    {
+        quality = configMode->getCustomConfiguration(QUALITY->longName, "Type quality (0 - 3)", quality);
+    }
+    if(quality < static_cast<int>(Resampler::Quality::LOW) || quality > static_cast<int>(Resampler::Quality::BEST))
+    {
+        std::cerr << "Invalid resampling-quality!" << std::endl;
+        return false;
+    }
+    inputChannels = audioConfig.inputDeviceChannels;
+    outputChannels = audioConfig.outputDeviceChannels;
+    inputResampler.reset();
+    outputResampler.reset();
+    if(processingRate == audioConfig.sampleRate)
+    {
+        return true;
+    }
+
+    const unsigned int bufferFrames = static_cast<unsigned int>(audioConfig.bufferSize);
+    inputResampler.reset(new Resampler(audioConfig.sampleRate, processingRate, inputChannels, static_cast<Resampler::Quality>(quality), bufferFrames));
+    //the output-buffers hold the frames of one device-buffer at the processing-rate
+    const unsigned int outputBufferFrames = inputResampler->getMaximumOutputFrames(bufferFrames);
+    outputResampler.reset(new Resampler(processingRate, audioConfig.sampleRate, outputChannels, static_cast<Resampler::Quality>(quality), outputBufferFrames));
+    if(!inputResampler->isValid() || !outputResampler->isValid())
+    {
+        std::cerr << "Unsupported ratio of sample-rates: " << audioConfig.sampleRate << " to " << processingRate << std::endl;
+        inputResampler.reset();
+        outputResampler.reset();
+        return false;
+    }
+    const unsigned int maxChannels = inputChannels > outputChannels ? inputChannels : outputChannels;
+    resamplingBuffer.resize((outputBufferFrames > bufferFrames ? outputBufferFrames : bufferFrames) * maxChannels);
+    return true;
+}
+
+bool ProcessorResampler::cleanUp()
+{
+    inputResampler.reset();
+    outputResampler.reset();
+    std::vector<float>().swap(resamplingBuffer);
+    return true;
+}
+
+unsigned int ProcessorResampler::getSupportedAudioFormats() const
+{
+    return AudioConfiguration::AUDIO_FORMAT_FLOAT32;
+}
+
+unsigned int ProcessorResampler::getSupportedSampleRates() const
+{
+    return AudioConfiguration::SAMPLE_RATE_ALL;
+}
+
+const std::vector<int> ProcessorResampler::getSupportedBufferSizes(unsigned int sampleRate) const
+{
+    return std::vector<int>{BUFFER_SIZE_ANY};
+}
+
+unsigned int ProcessorResampler::getMaximumInputSize(const AudioConfiguration& audioConfig, const unsigned int inputBufferByteSize) const
+{
+    if(inputResampler == nullptr)
+    {
+        return inputBufferByteSize;
+    }
+    const unsigned int frameSize = sizeof(float) * inputChannels;
+    return inputResampler->getMaximumOutputFrames((inputBufferByteSize + frameSize - 1) / frameSize) * frameSize;
+}
+
+unsigned int ProcessorResampler::getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const
+{
+    if(outputResampler == nullptr)
+    {
+        return outputBufferByteSize;
+    }
+    const unsigned int frameSize = sizeof(float) * outputChannels;
+    return outputResampler->getMaximumOutputFrames((outputBufferByteSize + frameSize - 1) / frameSize) * frameSize;
+}
+
+bool ProcessorResampler::isProcessingInPlace() const
+{
+    return inputResampler == nullptr;
+}
+
+unsigned int ProcessorResampler::processInputDataOutOfPlace(const void* sourceBuffer, const unsigned int inputBufferByteSize, void* targetBuffer, StreamData* userData)
+{
+    if(inputResampler == nullptr)
+    {
+        memcpy(targetBuffer, sourceBuffer, inputBufferByteSize);
+        return inputBufferByteSize;
+    }
+    const unsigned int frames = inputResampler->process((const float*)sourceBuffer, inputBufferByteSize / (sizeof(float) * inputChannels), (float*)targetBuffer);
+    if(userData != nullptr)
+    {
+        userData->nBufferFrames = frames;
+    }
+    return frames * sizeof(float) * inputChannels;
+}
+
+unsigned int ProcessorResampler::processOutputDataOutOfPlace(const void* sourceBuffer, const unsigned int outputBufferByteSize, void* targetBuffer, StreamData* userData)
+{
+    if(outputResampler == nullptr || (userData != nullptr && userData->isSilentPackage))
+    {
+        //the comfort-noise payload is passed unchanged, see ProcessorComfortNoise
+        memcpy(targetBuffer, sourceBuffer, outputBufferByteSize);
+        return outputBufferByteSize;
+    }
+    const unsigned int frames = outputResampler->process((const float*)sourceBuffer, outputBufferByteSize / (sizeof(float) * outputChannels), (float*)targetBuffer);
+    if(userData != nullptr)
+    {
+        userData->nBufferFrames = frames;
+    }
+    return frames * sizeof(float) * outputChannels;
+}
+
+unsigned int ProcessorResampler::processInputData(void* inputBuffer, const unsigned int inputBufferByteSize, StreamData* userData)
+{
+    if(inputResampler == nullptr)
+    {
+        return inputBufferByteSize;
+    }
+    if(inputBufferByteSize > resamplingBuffer.size() * sizeof(float))
+    {
+        std::cerr << "Input-buffer exceeds the configured buffer-size!" << std::endl;
+        return 0;
+    }
+    memcpy(resamplingBuffer.data(), inputBuffer, inputBufferByteSize);
+    return processInputDataOutOfPlace(resamplingBuffer.data(), inputBufferByteSize, inputBuffer, userData);
+}
+
+unsigned int ProcessorResampler::processOutputData(void* outputBuffer, const unsigned int outputBufferByteSize, StreamData* userData)
+{
+    if(outputResampler == nullptr)
+    {
+        return outputBufferByteSize;
+    }
+    if(outputBufferByteSize > resamplingBuffer.size() * sizeof(float))
+    {
+        std::cerr << "Output-buffer exceeds the configured buffer-size!" << std::endl;
+        return 0;
+    }
+    memcpy(resamplingBuffer.data(), outputBuffer, outputBufferByteSize);
+    return processOutputDataOutOfPlace(resamplingBuffer.data(), outputBufferByteSize, outputBuffer, userData);
+}
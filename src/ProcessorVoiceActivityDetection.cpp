@@ -0,0 +1,79 @@
+#include "ProcessorVoiceActivityDetection.h"
+
+#include <string.h> //memset
+
+#include "ComfortNoise.h"
+
+const Parameter* ProcessorVoiceActivityDetection::THRESHOLD = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'V', "vad-threshold", "Voice-Activity-Detection. The level in dB above the background noise at which audio is considered speech", "9"));
+
+ProcessorVoiceActivityDetection::ProcessorVoiceActivityDetection(const std::string name) : AudioProcessor(name),
+    detector(nullptr), isFloatFormat(false), inputChannels(0), outputChannels(0)
+{
+}
+
+bool ProcessorVoiceActivityDetection::configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)
+{
+    if(audioConfig.audioFormat != AudioFormat::SIGNED_INT_16 && audioConfig.audioFormat != AudioFormat::FLOAT_32)
+    {
+        std::cerr << "Unsupported audio-format!" << std::endl;
+        return false;
+    }
+    isFloatFormat = audioConfig.audioFormat == AudioFormat::FLOAT_32;
+    inputChannels = audioConfig.inputDeviceChannels;
+    outputChannels = audioConfig.outputDeviceChannels;
+    unsigned int threshold = DEFAULT_THRESHOLD;
+    if(configMode->isCustomConfigurationSet(THRESHOLD->longName, "Set custom voice-activity threshold?"))
+    {
+        threshold = configMode->getCustomConfiguration(THRESHOLD->longName, "Type threshold in dB", (int)DEFAULT_THRESHOLD);
+    }
+    detector.reset(new VoiceActivityDetector(audioConfig.sampleRate, inputChannels, (float)threshold));
+    return true;
+}
+
+unsigned int ProcessorVoiceActivityDetection::getSupportedAudioFormats() const
+{
+    return AudioConfiguration::AUDIO_FORMAT_SINT16 | AudioConfiguration::AUDIO_FORMAT_FLOAT32;
+}
+
+unsigned int ProcessorVoiceActivityDetection::getSupportedSampleRates() const
+{
+    return AudioConfiguration::SAMPLE_RATE_ALL;
+}
+
+const std::vector<int> ProcessorVoiceActivityDetection::getSupportedBufferSizes(unsigned int sampleRate) const
+{
+    return std::vector<int>{BUFFER_SIZE_ANY};
+}
+
+unsigned int ProcessorVoiceActivityDetection::processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData)
+{
+    if(userData->isSilentPackage)
+    {
+        return inputBufferByteSize;
+    }
+    const unsigned int numberOfSamples = userData->nBufferFrames * inputChannels;
+    const bool isSpeech = isFloatFormat ? detector->isSpeech((const float*)inputBuffer, userData->nBufferFrames) :
+        detector->isSpeech((const int16_t*)inputBuffer, userData->nBufferFrames);
+    if(isSpeech)
+    {
+        return inputBufferByteSize;
+    }
+    userData->isSilentPackage = true;
+    //replace the audio-data with the comfort-noise payload
+    ((uint8_t*)inputBuffer)[0] = isFloatFormat ? ComfortNoise::calculateNoiseLevel((const float*)inputBuffer, numberOfSamples) :
+        ComfortNoise::calculateNoiseLevel((const int16_t*)inputBuffer, numberOfSamples);
+    return COMFORT_NOISE_PAYLOAD_SIZE;
+}
+
+unsigned int ProcessorVoiceActivityDetection::processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData)
+{
+    if(!userData->isSilentPackage)
+    {
+        return outputBufferByteSize;
+    }
+    //no comfort-noise was synthesized, so play silence instead of the payload
+    const unsigned int size = userData->nBufferFrames * outputChannels * (isFloatFormat ? sizeof(float) : sizeof(int16_t));
+    memset(outputBuffer, 0, size);
+    userData->isSilentPackage = false;
+    return size;
+}
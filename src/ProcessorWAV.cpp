@@ -7,57 +7,44 @@
 
 #include "ProcessorWAV.h"
 
-using namespace wav;
-
 const Parameter* ProcessorWAV::INPUT_FILE_NAME = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'I', "input-wav-file", "wav-Writer. The name of the wav-file to log the audio-input", ""));
 const Parameter* ProcessorWAV::OUTPUT_FILE_NAME = Parameters::registerParameter(Parameter(ParameterCategory::PROCESSORS, 'O', "output-wav-file", "wav-Writer. The name of the wav-file to log the audio-output", ""));
 
-ProcessorWAV::ProcessorWAV(const std::string name) : AudioProcessor(name)
+ProcessorWAV::ProcessorWAV(const std::string name) : AudioProcessor(name), inputWriter(), outputWriter()
 {
-    writeInputFile = nullptr;
-    writeOutputFile = nullptr;
 }
 
 ProcessorWAV::~ProcessorWAV()
 {
-    if(writeInputFile != nullptr)
-    {
-        wavfile_close(writeInputFile);
-    }
-    if(writeOutputFile != nullptr)
-    {
-        wavfile_close(writeOutputFile);
-    }
+    //the writers write the remaining samples and close the files
 }
 
 bool ProcessorWAV::configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)
 {
-    if(audioConfig.audioFormatFlag != AudioConfiguration::AUDIO_FORMAT_SINT16)
-    {
-        std::cerr << "Unsupported audio-format!" << std::endl;
-        return false;
-    }
-    if(audioConfig.sampleRate != 44100)
-    {
-        std::cerr << "Unsupported sample-rate!" << std::endl;
-        return false;
-    }
     if(configMode->isCustomConfigurationSet(INPUT_FILE_NAME->longName, "Log audio-input?"))
     {
         std::string fileName = configMode->getCustomConfiguration(INPUT_FILE_NAME->longName, "Type audio-input file-name", "");
-        writeInputFile = wavfile_open(fileName.c_str());
+        inputWriter.reset(new WAVWriter(fileName, audioConfig.audioFormat, audioConfig.sampleRate, audioConfig.inputDeviceChannels));
+        if(!inputWriter->isOpen())
+        {
+            return false;
+        }
     }
     if(configMode->isCustomConfigurationSet(OUTPUT_FILE_NAME->longName, "Log audio-output?"))
     {
         std::string fileName = configMode->getCustomConfiguration(OUTPUT_FILE_NAME->longName, "Type audio-output file-name", "");
-        writeOutputFile = wavfile_open(fileName.c_str());
+        outputWriter.reset(new WAVWriter(fileName, audioConfig.audioFormat, audioConfig.sampleRate, audioConfig.outputDeviceChannels));
+        if(!outputWriter->isOpen())
+        {
+            return false;
+        }
     }
     return true;
 }
 
 unsigned int ProcessorWAV::getSupportedAudioFormats() const
 {
-    return AudioConfiguration::AUDIO_FORMAT_SINT16;
+    return AudioConfiguration::AUDIO_FORMAT_ALL;
 }
 
 const std::vector<int> ProcessorWAV::getSupportedBufferSizes(unsigned int sampleRate) const
@@ -67,7 +54,7 @@ const std::vector<int> ProcessorWAV::getSupportedBufferSizes(unsigned int sample
 
 unsigned int ProcessorWAV::getSupportedSampleRates() const
 {
-    return AudioConfiguration::SAMPLE_RATE_44100;
+    return AudioConfiguration::SAMPLE_RATE_ALL;
 }
 
 PayloadType ProcessorWAV::getSupportedPlayloadType() const
@@ -77,19 +64,34 @@ PayloadType ProcessorWAV::getSupportedPlayloadType() const
 
 unsigned int ProcessorWAV::processInputData(void* inputBuffer, const unsigned int inputBufferByteSize, StreamData* userData)
 {
-    if(writeInputFile != nullptr)
+    if(inputWriter)
     {
-        wavfile_write(writeInputFile, (short*)inputBuffer, userData->nBufferFrames*2);
+        if(userData->isSilentPackage)
+        {
+            //the buffer holds no audio-data, log the duration of the package as silence
+            inputWriter->writeSilence(userData->nBufferFrames);
+        }
+        else
+        {
+            inputWriter->write(inputBuffer, inputBufferByteSize);
+        }
     }
     return inputBufferByteSize;
-
 }
 
 unsigned int ProcessorWAV::processOutputData(void* outputBuffer, const unsigned int outputBufferByteSize, StreamData* userData)
 {
-    if(writeOutputFile != nullptr)
+    if(outputWriter)
     {
-        wavfile_write(writeOutputFile, (short*)outputBuffer, userData->nBufferFrames*2);
+        if(userData->isSilentPackage)
+        {
+            //the buffer holds no audio-data, log the duration of the package as silence
+            outputWriter->writeSilence(userData->nBufferFrames);
+        }
+        else
+        {
+            outputWriter->write(outputBuffer, outputBufferByteSize);
+        }
     }
     return outputBufferByteSize;
 }
@@ -1,7 +1,7 @@
 #include "ProfilingAudioProcessor.h"
 
 ProfilingAudioProcessor::ProfilingAudioProcessor(AudioProcessor* profiledProcessor) : AudioProcessor(profiledProcessor->getName()),
-    profiledProcessor(profiledProcessor), outputProcessingTime(0), inputProcessingTime(0), count(0)
+    profiledProcessor(profiledProcessor), inputHistogram(), outputHistogram()
 {
 }
 
@@ -10,38 +10,35 @@ ProfilingAudioProcessor::~ProfilingAudioProcessor()
     delete(profiledProcessor);
 }
 
-void ProfilingAudioProcessor::addTimeInputProcessing(long ms)
+uint64_t ProfilingAudioProcessor::getElapsedNanoseconds(const std::chrono::steady_clock::time_point start)
 {
-	count++;
-	inputProcessingTime += ms;
-};
-
-void ProfilingAudioProcessor::addTimeOutputProcessing(long ms)
-{
-	count++;
-	outputProcessingTime += ms;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
 }
 
 unsigned long ProfilingAudioProcessor::getTotalInputTime() const
 {
-    return inputProcessingTime;
+    return inputHistogram.getTotal() / 1000;
 }
 
 unsigned long ProfilingAudioProcessor::getTotalOutputTime() const
 {
-    return outputProcessingTime;
+    return outputHistogram.getTotal() / 1000;
+}
+
+const LatencyHistogram& ProfilingAudioProcessor::getInputHistogram() const
+{
+    return inputHistogram;
 }
 
-unsigned long ProfilingAudioProcessor::getTotalCount() const
+const LatencyHistogram& ProfilingAudioProcessor::getOutputHistogram() const
 {
-    return count;
+    return outputHistogram;
 }
 
 void ProfilingAudioProcessor::reset()
 {
-	outputProcessingTime = 0;
-	inputProcessingTime = 0;
-	count = 0;
+    inputHistogram.reset();
+    outputHistogram.reset();
 }
 
 bool ProfilingAudioProcessor::configure(const AudioConfiguration& audioConfig, const std::shared_ptr<ConfigurationMode> configMode)
@@ -64,22 +61,49 @@ unsigned int ProfilingAudioProcessor::getSupportedSampleRates() const
     return profiledProcessor->getSupportedSampleRates();
 }
 
+unsigned int ProfilingAudioProcessor::getMaximumInputSize(const AudioConfiguration& audioConfig, const unsigned int inputBufferByteSize) const
+{
+    return profiledProcessor->getMaximumInputSize(audioConfig, inputBufferByteSize);
+}
+
+unsigned int ProfilingAudioProcessor::getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const
+{
+    return profiledProcessor->getMaximumOutputSize(audioConfig, outputBufferByteSize);
+}
+
+bool ProfilingAudioProcessor::isProcessingInPlace() const
+{
+    return profiledProcessor->isProcessingInPlace();
+}
+
 unsigned int ProfilingAudioProcessor::processInputData(void* inputBuffer, const unsigned int inputBufferByteSize, StreamData* userData)
 {
-    auto start = std::chrono::high_resolution_clock::now();
+    const auto start = std::chrono::steady_clock::now();
     int retVal = profiledProcessor->processInputData(inputBuffer, inputBufferByteSize, userData);
-    auto end = std::chrono::high_resolution_clock::now();
-    long duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-    addTimeInputProcessing(duration);
+    inputHistogram.record(getElapsedNanoseconds(start));
     return retVal;
 }
 
 unsigned int ProfilingAudioProcessor::processOutputData(void* outputBuffer, const unsigned int outputBufferByteSize, StreamData* userData)
 {
-    auto start = std::chrono::high_resolution_clock::now();
+    const auto start = std::chrono::steady_clock::now();
     int retVal = profiledProcessor->processOutputData(outputBuffer, outputBufferByteSize, userData);
-    auto end = std::chrono::high_resolution_clock::now();
-    long duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-    addTimeOutputProcessing(duration);
+    outputHistogram.record(getElapsedNanoseconds(start));
+    return retVal;
+}
+
+unsigned int ProfilingAudioProcessor::processInputDataOutOfPlace(const void* sourceBuffer, const unsigned int inputBufferByteSize, void* targetBuffer, StreamData* userData)
+{
+    const auto start = std::chrono::steady_clock::now();
+    int retVal = profiledProcessor->processInputDataOutOfPlace(sourceBuffer, inputBufferByteSize, targetBuffer, userData);
+    inputHistogram.record(getElapsedNanoseconds(start));
+    return retVal;
+}
+
+unsigned int ProfilingAudioProcessor::processOutputDataOutOfPlace(const void* sourceBuffer, const unsigned int outputBufferByteSize, void* targetBuffer, StreamData* userData)
+{
+    const auto start = std::chrono::steady_clock::now();
+    int retVal = profiledProcessor->processOutputDataOutOfPlace(sourceBuffer, outputBufferByteSize, targetBuffer, userData);
+    outputHistogram.record(getElapsedNanoseconds(start));
     return retVal;
 }
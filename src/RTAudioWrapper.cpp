@@ -25,10 +25,10 @@ auto RtAudioWrapper::callback(void *outputBuffer, void *inputBuffer, unsigned in
 	}
    
     if (inputBuffer != nullptr)
-        this->processAudioInput(inputBuffer, this->inputBufferSizeInBytes, nullptr);
+        this->handleAudioInput(inputBuffer, this->inputBufferSizeInBytes);
 
     if (outputBuffer != nullptr)
-        this->processAudioOutput(outputBuffer, this->outputBufferSizeInBytes, nullptr);
+        this->handleAudioOutput(outputBuffer, this->outputBufferSizeInBytes);
 
     return 0;
 }
@@ -64,9 +64,14 @@ auto getRtAudioFormat(const AudioConfiguration &audioConfig) -> RtAudioFormat
 
 auto RtAudioWrapper::setActualBufferSizes() -> void
 {
-	int sizeAudioFormat = static_cast<int>(this->audioConfiguration.audioFormat);
+	int sizeAudioFormat = getAudioFormatSize(this->audioConfiguration.audioFormat);
 	this->outputBufferSizeInBytes = this->bufferSizeInNumberOfSamples * sizeAudioFormat * this->audioConfiguration.outputDeviceChannels;
 	this->inputBufferSizeInBytes = this->bufferSizeInNumberOfSamples * sizeAudioFormat * this->audioConfiguration.inputDeviceChannels;
+	if (this->bufferSizeInNumberOfSamples != static_cast<unsigned int>(this->audioConfiguration.bufferSize))
+	{
+		//RtAudio may choose another buffer-size than requested
+		this->allocateWorkingBuffers(this->bufferSizeInNumberOfSamples);
+	}
 }
 
 auto RtAudioWrapper::vStartRecordingMode() -> void
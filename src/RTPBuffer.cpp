@@ -8,6 +8,8 @@
 
 #include "rtp/RTPBuffer.h"
 
+#include <algorithm> //std::min
+
 
 RTPBuffer::RTPBuffer(uint16_t maxCapacity, uint16_t maxDelay, uint16_t minBufferPackages) : capacity(maxCapacity), maxDelay(maxDelay), minBufferPackages(minBufferPackages)
 {
@@ -15,6 +17,7 @@ RTPBuffer::RTPBuffer(uint16_t maxCapacity, uint16_t maxDelay, uint16_t minBuffer
     ringBuffer = new RTPBufferPackage[maxCapacity];
     size = 0;
     minSequenceNumber = 0;
+    nextFECWriteIndex = 0;
     #ifdef _WIN32
     bufferMutex = CreateMutex(nullptr, false, L"BufferMutex");
     #endif
@@ -61,22 +64,10 @@ RTPBufferStatus RTPBuffer::addPackage(const RTPPackageHandler &package, unsigned
     //write package-data into buffer
     ringBuffer[newWriteIndex].isValid = true;
     ringBuffer[newWriteIndex].header = *receivedHeader;
-    if(ringBuffer[newWriteIndex].packageContent == nullptr)
-    {
-        //allocate new buffer with the current content-size
-        ringBuffer[newWriteIndex].bufferSize = contentSize;
-        ringBuffer[newWriteIndex].packageContent = malloc(contentSize);
-    }
-    else if(ringBuffer[newWriteIndex].bufferSize < contentSize)
-    {
-        //reallocate buffer, because the content would not fit
-        ringBuffer[newWriteIndex].bufferSize = contentSize;
-        ringBuffer[newWriteIndex].packageContent = realloc(ringBuffer[newWriteIndex].packageContent, contentSize);
-    }
     //save timestamp of reception
     ringBuffer[newWriteIndex].receptionTimestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
-    ringBuffer[newWriteIndex].contentSize = contentSize;
-    memcpy(ringBuffer[newWriteIndex].packageContent, package.getRTPPackageData(), contentSize);
+    ringBuffer[newWriteIndex].timing = package.getPackageTiming();
+    copyPackageContent(ringBuffer[newWriteIndex], package.getRTPPackageData(), contentSize);
     //update size
     size++;
     Statistics::maxCounter(Statistics::RTP_BUFFER_MAXIMUM_USAGE, size);
@@ -96,6 +87,11 @@ RTPBufferStatus RTPBuffer::readPackage(RTPPackageHandler &package)
         unlockMutex();
         return RTPBufferStatus::RTP_BUFFER_OUTPUT_UNDERFLOW;
     }
+    if(ringBuffer[nextReadIndex].isValid == false)
+    {
+        //the next package is missing, try to recover it before skipping it
+        recoverPackage(minSequenceNumber);
+    }
     //need to search for oldest valid package, newer than minSequenceNumber and newer than currentTimestamp - maxDelay
     uint16_t index = nextReadIndex;
     unsigned long currentTimestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
@@ -126,10 +122,13 @@ RTPBufferStatus RTPBuffer::readPackage(RTPPackageHandler &package)
         return RTPBufferStatus::RTP_BUFFER_OUTPUT_UNDERFLOW;
     }
 
-    char *packageBuffer = (char *)package.getWorkBuffer();
-    memcpy(packageBuffer, &(bufferPack->header), sizeof(bufferPack->header));
-    memcpy(packageBuffer + sizeof(bufferPack->header), bufferPack->packageContent, bufferPack->contentSize);
+    //the header-extension is restored, so the reader can determine the end-to-end latency
+    void *payloadBuffer = package.writeRTPPackageHeader(bufferPack->header, bufferPack->timing);
+    memcpy(payloadBuffer, bufferPack->packageContent, bufferPack->contentSize);
     package.setActualPayloadSize(bufferPack->contentSize);
+    //the reception-timestamps have a resolution of milliseconds and are truncated to 32 bits
+    const unsigned int bufferedMilliseconds = (unsigned int)currentTimestamp - bufferPack->receptionTimestamp;
+    Statistics::recordLatency(Statistics::LATENCY_JITTER_BUFFER, bufferedMilliseconds * 1000000ull);
 
     //Invalidate buffer-entry
     bufferPack->isValid = false;
@@ -144,11 +143,157 @@ RTPBufferStatus RTPBuffer::readPackage(RTPPackageHandler &package)
     return RTPBufferStatus::RTP_BUFFER_ALL_OKAY;
 }
 
+RTPBufferStatus RTPBuffer::addFECPackage(const RTPPackageHandler &package, unsigned int contentSize)
+{
+    if(contentSize < FEC_HEADER_SIZE)
+    {
+        //discard invalid FEC-package
+        return RTPBufferStatus::RTP_BUFFER_ALL_OKAY;
+    }
+    lockMutex();
+    RTPBufferPackage &fecPackage = fecBuffer[nextFECWriteIndex];
+    fecPackage.isValid = true;
+    fecPackage.header = *package.getRTPPackageHeader();
+    fecPackage.receptionTimestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    copyPackageContent(fecPackage, package.getRTPPackageData(), contentSize);
+    nextFECWriteIndex = (nextFECWriteIndex + 1) % FEC_BUFFER_CAPACITY;
+
+    if(size > 0)
+    {
+        //the FEC-package is sent after the last package of its group, so we can already recover a lost package,
+        //if all other packages of the group were received
+        const FECHeader *fecHeader = (const FECHeader*)fecPackage.packageContent;
+        for(uint8_t i = 0; i < fecHeader->getGroupSize(); i++)
+        {
+            const uint16_t sequenceNumber = fecHeader->getBaseSequenceNumber() + i;
+            const int index = getPackageIndex(sequenceNumber);
+            //only packages not yet played back need to be recovered
+            if(index >= 0 && ringBuffer[index].isValid == false && (uint16_t)(sequenceNumber - minSequenceNumber) < capacity)
+            {
+                //we can recover at most one package per group
+                recoverPackage(sequenceNumber);
+                break;
+            }
+        }
+    }
+    unlockMutex();
+    return RTPBufferStatus::RTP_BUFFER_ALL_OKAY;
+}
+
 unsigned int RTPBuffer::getSize() const
 {
     return size;
 }
 
+void RTPBuffer::copyPackageContent(RTPBufferPackage &bufferPackage, const void *content, unsigned int contentSize)
+{
+    if(bufferPackage.packageContent == nullptr)
+    {
+        //allocate new buffer with the current content-size
+        bufferPackage.bufferSize = contentSize;
+        bufferPackage.packageContent = malloc(contentSize);
+    }
+    else if(bufferPackage.bufferSize < contentSize)
+    {
+        //reallocate buffer, because the content would not fit
+        bufferPackage.bufferSize = contentSize;
+        bufferPackage.packageContent = realloc(bufferPackage.packageContent, contentSize);
+    }
+    bufferPackage.contentSize = contentSize;
+    memcpy(bufferPackage.packageContent, content, contentSize);
+}
+
+bool RTPBuffer::recoverPackage(uint16_t sequenceNumber)
+{
+    const int lostIndex = getPackageIndex(sequenceNumber);
+    if(lostIndex < 0 || ringBuffer[lostIndex].isValid == true || size == capacity)
+    {
+        return false;
+    }
+    for(uint8_t f = 0; f < FEC_BUFFER_CAPACITY; f++)
+    {
+        const RTPBufferPackage &fecPackage = fecBuffer[f];
+        if(fecPackage.isValid == false || !((const FECHeader*)fecPackage.packageContent)->isProtected(sequenceNumber))
+        {
+            continue;
+        }
+        const FECHeader *fecHeader = (const FECHeader*)fecPackage.packageContent;
+        //all other packages of the group must still be stored (played back packages keep their content until overwritten)
+        bool groupComplete = true;
+        for(uint8_t i = 0; i < fecHeader->getGroupSize(); i++)
+        {
+            const uint16_t groupSequenceNumber = fecHeader->getBaseSequenceNumber() + i;
+            if(groupSequenceNumber == sequenceNumber)
+            {
+                continue;
+            }
+            const int index = getPackageIndex(groupSequenceNumber);
+            if(index < 0 || ringBuffer[index].packageContent == nullptr || ringBuffer[index].header.getSequenceNumber() != groupSequenceNumber)
+            {
+                groupComplete = false;
+                break;
+            }
+        }
+        if(!groupComplete)
+        {
+            continue;
+        }
+        //XOR the FEC-package with all other packages of the group
+        const unsigned int parityDataSize = fecPackage.contentSize - FEC_HEADER_SIZE;
+        RTPBufferPackage &lostPackage = ringBuffer[lostIndex];
+        copyPackageContent(lostPackage, (const char*)fecPackage.packageContent + FEC_HEADER_SIZE, parityDataSize);
+        uint8_t payloadTypeRecovery = fecHeader->getPayloadTypeRecovery();
+        uint16_t lengthRecovery = fecHeader->getLengthRecovery();
+        uint32_t timestampRecovery = fecHeader->getTimestampRecovery();
+        uint32_t ssrc = 0;
+        for(uint8_t i = 0; i < fecHeader->getGroupSize(); i++)
+        {
+            const uint16_t groupSequenceNumber = fecHeader->getBaseSequenceNumber() + i;
+            if(groupSequenceNumber == sequenceNumber)
+            {
+                continue;
+            }
+            const RTPBufferPackage &groupPackage = ringBuffer[getPackageIndex(groupSequenceNumber)];
+            ParityFEC::xorBuffers(lostPackage.packageContent, groupPackage.packageContent, std::min(groupPackage.contentSize, parityDataSize));
+            payloadTypeRecovery ^= (groupPackage.header.isMarked() << 7) | groupPackage.header.getPayloadType();
+            lengthRecovery ^= (uint16_t)groupPackage.contentSize;
+            timestampRecovery ^= groupPackage.header.getTimestamp();
+            ssrc = groupPackage.header.getSSRC();
+        }
+        if(lengthRecovery > parityDataSize)
+        {
+            //corrupted FEC-package
+            continue;
+        }
+        RTPHeader recoveredHeader;
+        recoveredHeader.setMarker(payloadTypeRecovery >> 7);
+        recoveredHeader.setPayloadType((PayloadType)(payloadTypeRecovery & 0x7F));
+        recoveredHeader.setSequenceNumber(sequenceNumber);
+        recoveredHeader.setTimestamp(timestampRecovery);
+        recoveredHeader.setSSRC(ssrc);
+        lostPackage.header = recoveredHeader;
+        //the timing of the lost package is unknown
+        lostPackage.timing = PackageTiming();
+        lostPackage.contentSize = lengthRecovery;
+        lostPackage.receptionTimestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        lostPackage.isValid = true;
+        size++;
+        Statistics::incrementCounter(Statistics::COUNTER_PACKAGES_RECOVERED, 1);
+        return true;
+    }
+    return false;
+}
+
+int RTPBuffer::getPackageIndex(uint16_t sequenceNumber) const
+{
+    const int16_t offset = (int16_t)(sequenceNumber - minSequenceNumber);
+    if(offset >= capacity || offset <= -capacity)
+    {
+        return -1;
+    }
+    return (nextReadIndex + capacity + offset) % capacity;
+}
+
 uint16_t RTPBuffer::calculateIndex(uint16_t index, uint16_t offset)
 {
     return (index + offset) % capacity;
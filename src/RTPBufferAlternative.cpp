@@ -127,6 +127,8 @@ void RTPBufferAlternative::copySilencePackageIntoPackage(RTPPackageHandler &pack
 
 	// Copy data from buffer into package
 	memcpy((char*)packageBuffer, currentHeaderData, rtpHeaderSize);
+	// The header-extension is not buffered
+	((RTPHeader*)packageBuffer)->setExtension(false);
 	memset((char*)packageBuffer + rtpHeaderSize, 0, payloadSize);
 }
 
@@ -151,6 +153,8 @@ bool RTPBufferAlternative::copyNextPackageIntoPackage(RTPPackageHandler &package
 	int rtpHeaderSize = package.getRTPHeaderSize();
 	int payloadSize = package.getMaximumPayloadSize();
 	memcpy((char*)packageBuffer, currentHeaderData, rtpHeaderSize);
+	// The header-extension is not buffered
+	((RTPHeader*)packageBuffer)->setExtension(false);
 	memcpy((char*)packageBuffer + rtpHeaderSize, currentDataInBuffer, payloadSize);
 
 	// set last read sequence number
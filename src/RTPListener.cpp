@@ -8,14 +8,18 @@
 #include "rtp/RTPListener.h"
 #include "Statistics.h"
 
-RTPListener::RTPListener(std::shared_ptr<NetworkWrapper> wrapper, std::shared_ptr<RTPBufferHandler> buffer, unsigned int receiveBufferSize, std::function<void()> stopCallback) :
-    stopCallback(stopCallback), rtpHandler(receiveBufferSize), lastDelay(0)
+RTPListener::RTPListener(std::shared_ptr<NetworkWrapper> wrapper, std::shared_ptr<RTPBufferHandler> buffer, unsigned int receiveBufferSize, std::function<void()> stopCallback,
+                         const bool aggregatedFrames, std::shared_ptr<SRTPContext> srtpContext, std::shared_ptr<SRTPContext> fecSRTPContext) :
+    stopCallback(stopCallback), rtpHandler(receiveBufferSize), frameHandler(receiveBufferSize), aggregatedFrames(aggregatedFrames),
+    fecRecovery(receiveBufferSize), srtpContext(srtpContext), fecSRTPContext(fecSRTPContext), lastDelay(0)
 {
     this->wrapper = wrapper;
     this->buffer = buffer;
 }
 
-RTPListener::RTPListener(const RTPListener& orig) : rtpHandler(orig.rtpHandler), lastDelay(orig.lastDelay)
+RTPListener::RTPListener(const RTPListener& orig) : rtpHandler(orig.rtpHandler), frameHandler(orig.frameHandler),
+    aggregatedFrames(orig.aggregatedFrames), fecRecovery(orig.fecRecovery), srtpContext(orig.srtpContext), fecSRTPContext(orig.fecSRTPContext),
+    lastDelay(orig.lastDelay)
 {
     this->wrapper = orig.wrapper;
     this->buffer = orig.buffer;
@@ -50,10 +54,25 @@ void RTPListener::runThread()
         {
             //just continue to next loop iteration, checking if thread should continue running
         }
+        else if(threadRunning && srtpContext != nullptr && !unprotectPackage(receivedSize))
+        {
+            std::cerr << "SRTP-package could not be authenticated, discarding" << std::endl;
+        }
+        else if(threadRunning && RTPPackageHandler::isRTPPackage(rtpHandler.getWorkBuffer(), (unsigned int)receivedSize)
+                && rtpHandler.getRTPPackageHeader()->getPayloadType() == PayloadType::FEC)
+        {
+            //FEC-packages are not played back, they only serve to recover lost packages.
+            //The FEC-header and -payload start after the CSRCs and header-extension
+            addFECPackage(receivedSize - (rtpHandler.getRTPHeaderSize() + rtpHandler.getRTPHeaderExtensionSize()));
+            Statistics::incrementCounter(Statistics::COUNTER_HEADER_BYTES_RECEIVED, receivedSize);
+        }
         else if(threadRunning && RTPPackageHandler::isRTPPackage(rtpHandler.getWorkBuffer(), (unsigned int)receivedSize))
         {
+            const uint64_t receptionTime = RTPPackageHandler::getWallClockTime();
+            //the header-extension is counted as header
+            const unsigned int headerSize = rtpHandler.getRTPHeaderSize() + rtpHandler.getRTPHeaderExtensionSize();
             //2. write package to buffer
-            auto result = buffer->addPackage(rtpHandler, receivedSize - RTP_HEADER_MIN_SIZE);
+            auto result = addToBuffer(receivedSize - headerSize);
             if (result == RTPBufferStatus::RTP_BUFFER_INPUT_OVERFLOW)
             {
                 //TODO some handling or simply discard?
@@ -78,9 +97,10 @@ void RTPListener::runThread()
                 }
                 calculateInterarrivalJitter(rtpHandler.getRTPPackageHeader()->getTimestamp(), rtpHandler.getCurrentRTPTimestamp());
                 participantDatabase[PARTICIPANT_REMOTE].ssrc = rtpHandler.getRTPPackageHeader()->getSSRC();
+                recordLatency(receptionTime);
                 Statistics::incrementCounter(Statistics::COUNTER_PACKAGES_RECEIVED, 1);
-                Statistics::incrementCounter(Statistics::COUNTER_HEADER_BYTES_RECEIVED, RTP_HEADER_MIN_SIZE);
-                Statistics::incrementCounter(Statistics::COUNTER_PAYLOAD_BYTES_RECEIVED, receivedSize - RTP_HEADER_MIN_SIZE);
+                Statistics::incrementCounter(Statistics::COUNTER_HEADER_BYTES_RECEIVED, headerSize);
+                Statistics::incrementCounter(Statistics::COUNTER_PAYLOAD_BYTES_RECEIVED, receivedSize - headerSize);
             }
         }
     }
@@ -103,6 +123,23 @@ float RTPListener::calculateInterarrivalJitter(uint32_t sentTimestamp, uint32_t
     return lastJitter;
 }
 
+void RTPListener::recordLatency(const uint64_t receptionTime) const
+{
+    const PackageTiming timing = rtpHandler.getPackageTiming();
+    if(timing.captureTime == 0)
+    {
+        //the sender does not measure the latency
+        return;
+    }
+    const uint64_t sendTime = timing.captureTime + timing.sendDelay * 1000ull;
+    Statistics::recordLatency(Statistics::LATENCY_SENDING, timing.sendDelay * 1000ull);
+    //if the clocks are not synchronized, the package may seem to be received before it was sent
+    if(receptionTime >= sendTime)
+    {
+        Statistics::recordLatency(Statistics::LATENCY_NETWORK, receptionTime - sendTime);
+    }
+}
+
 void RTPListener::shutdown()
 {
     // notify the thread to stop
@@ -111,30 +148,111 @@ void RTPListener::shutdown()
 
 uint32_t RTPListener::calculateExtendedHighestSequenceNumber(const uint16_t receivedSequenceNumber) const
 {
-    //See https://tools.ietf.org/html/rfc3711#section-3.3.1
-    const uint32_t previousValue = participantDatabase[PARTICIPANT_REMOTE].extendedHighestSequenceNumber;
-    //rollover-count is the higher 16 bits
-    const uint32_t rollOverCount = previousValue >> 16;
-    //determine possible values for the next extended highest sequence number
-    const uint32_t possibleValues[3] = {
-        //package is older than current EHSeqNr
-        ((rollOverCount - 1) << 16) + receivedSequenceNumber,
-        //package is in same roll-over than current EHSeqNr
-        (rollOverCount << 16) + receivedSequenceNumber,
-        //roll-over between current EHSeqNr and new package
-        ((rollOverCount + 1) << 16) + receivedSequenceNumber
-    };
-    //determine closest of the possible values
-    //skip ROC-1 unless we actually have a roll over
-    uint8_t index = previousValue < UINT16_MAX ? 1 : 0;
-    for(uint8_t i = 1; i < 3; i++)
+    //the extended highest sequence number is the same as the SRTP package-index
+    return SRTPContext::estimatePackageIndex(participantDatabase[PARTICIPANT_REMOTE].extendedHighestSequenceNumber, receivedSequenceNumber);
+}
+
+bool RTPListener::unprotectPackage(int& receivedSize)
+{
+    if(!RTPPackageHandler::isRTPPackage(rtpHandler.getWorkBuffer(), (unsigned int)receivedSize))
+    {
+        return false;
+    }
+    //FEC-packages are a separate stream with their own sequence numbers and SRTP-context
+    const bool isFECPackage = rtpHandler.getRTPPackageHeader()->getPayloadType() == PayloadType::FEC;
+    const SRTPContext* context = isFECPackage ? fecSRTPContext.get() : srtpContext.get();
+    if(context == nullptr)
+    {
+        return false;
+    }
+    uint32_t& highestIndex = isFECPackage ? fecPackageIndex : mediaPackageIndex;
+    const uint32_t packageIndex = SRTPContext::estimatePackageIndex(highestIndex, rtpHandler.getRTPPackageHeader()->getSequenceNumber());
+    unsigned int packageSize = (unsigned int)receivedSize;
+    if(!context->unprotect(rtpHandler, packageSize, packageIndex >> 16))
     {
-        uint32_t diffPrev = abs(possibleValues[index] - previousValue);
-        uint32_t diffNew = abs(possibleValues[i] - previousValue);
-        if(diffNew < diffPrev)
+        return false;
+    }
+    //only authenticated packages may advance the rollover-counter
+    if(packageIndex > highestIndex)
+    {
+        highestIndex = packageIndex;
+    }
+    receivedSize = (int)packageSize;
+    return true;
+}
+
+RTPBufferStatus RTPListener::addToBuffer(const unsigned int payloadSize)
+{
+    if(!aggregatedFrames)
+    {
+        return buffer->addPackage(rtpHandler, payloadSize);
+    }
+    if(!fecRecovery.addPackage(rtpHandler.getRTPPackageHeader(), rtpHandler.getRTPPackageData(), payloadSize))
+    {
+        //the package was already recovered from a FEC-package
+        return RTPBufferStatus::RTP_BUFFER_ALL_OKAY;
+    }
+    return addFramesToBuffer(*rtpHandler.getRTPPackageHeader(), rtpHandler.getRTPPackageData(), payloadSize, rtpHandler.getPackageTiming());
+}
+
+RTPBufferStatus RTPListener::addFramesToBuffer(const RTPHeader& header, const void* payload, const unsigned int payloadSize, const PackageTiming& timing)
+{
+    //comfort-noise packages are not aggregated, but replace a whole package of frames
+    const bool isComfortNoise = header.getPayloadType() == PayloadType::CN;
+    const uint8_t numberOfFrames = isComfortNoise ? lastFramesPerPackage : FrameAggregator::getNumberOfFrames(payload, payloadSize);
+    const uint8_t previousFramesPerPackage = lastFramesPerPackage;
+    if(!isComfortNoise && numberOfFrames > 0)
+    {
+        lastFramesPerPackage = numberOfFrames;
+    }
+    const uint32_t extendedSequenceNumber = firstPackage ? header.getSequenceNumber() : calculateExtendedHighestSequenceNumber(header.getSequenceNumber());
+    if(!hasFrameNumberBase)
+    {
+        hasFrameNumberBase = true;
+        nextPackageSequenceNumber = extendedSequenceNumber;
+    }
+    //the number of the first frame of this package, the 16 bit arithmetic wraps around like the sequence numbers in the RTPBuffer
+    const int32_t packageOffset = (int32_t)(extendedSequenceNumber - nextPackageSequenceNumber);
+    const uint16_t frameNumberBase = (uint16_t)(nextFrameNumber + packageOffset * previousFramesPerPackage);
+    if(packageOffset >= 0)
+    {
+        nextPackageSequenceNumber = extendedSequenceNumber + 1;
+        nextFrameNumber = (uint16_t)(frameNumberBase + numberOfFrames);
+    }
+    RTPBufferStatus result = RTPBufferStatus::RTP_BUFFER_ALL_OKAY;
+    for(uint8_t i = 0; i < numberOfFrames; i++)
+    {
+        unsigned int frameSize = payloadSize;
+        const void* frame = isComfortNoise ? payload : FrameAggregator::getFrame(payload, payloadSize, i, frameSize);
+        if(frame == nullptr)
+        {
+            break;
+        }
+        //copy the header and the timing of the aggregated package and assign the sequence number of the frame,
+        //all frames are assigned the capture-time of the first frame of the package
+        RTPHeader frameHeader = header;
+        frameHeader.setSequenceNumber((uint16_t)(frameNumberBase + i));
+        memcpy(frameHandler.writeRTPPackageHeader(frameHeader, timing), frame, frameSize);
+        RTPBufferStatus frameResult = buffer->addPackage(frameHandler, frameSize);
+        if(frameResult != RTPBufferStatus::RTP_BUFFER_ALL_OKAY)
         {
-            index = i;
+            result = frameResult;
         }
     }
-    return possibleValues[index];
+    return result;
+}
+
+void RTPListener::addFECPackage(const unsigned int contentSize)
+{
+    if(!aggregatedFrames)
+    {
+        buffer->addFECPackage(rtpHandler, contentSize);
+        return;
+    }
+    if(fecRecovery.recoverPackage(rtpHandler.getRTPPackageData(), contentSize))
+    {
+        //the timing of the lost package is unknown
+        addFramesToBuffer(fecRecovery.getRecoveredHeader(), fecRecovery.getRecoveredPayload(), fecRecovery.getRecoveredPayloadSize(), PackageTiming());
+        Statistics::incrementCounter(Statistics::COUNTER_PACKAGES_RECOVERED, 1);
+    }
 }
@@ -7,6 +7,60 @@
 
 #include "rtp/RTPPackageHandler.h"
 
+#include <algorithm>
+
+//the seconds between the NTP-epoch (1900) and the UNIX-epoch (1970)
+static const uint64_t NTP_UNIX_OFFSET = 2208988800ull;
+static const uint64_t NANOSECONDS_PER_SECOND = 1000000000ull;
+
+/*!
+ * Converts the wall-clock time in nanoseconds into the 64 bit NTP-format (32 bit seconds since 1900 and 32 bit fraction)
+ */
+static uint64_t toNTPTime(const uint64_t nanoseconds)
+{
+    const uint64_t seconds = nanoseconds / NANOSECONDS_PER_SECOND + NTP_UNIX_OFFSET;
+    const uint64_t fraction = ((nanoseconds % NANOSECONDS_PER_SECOND) << 32) / NANOSECONDS_PER_SECOND;
+    return (seconds << 32) | fraction;
+}
+
+static uint64_t fromNTPTime(const uint64_t ntpTime)
+{
+    if((ntpTime >> 32) < NTP_UNIX_OFFSET)
+    {
+        return 0;
+    }
+    //the fraction is rounded, so a converted time is restored exactly
+    const uint64_t nanoseconds = ((ntpTime & 0xFFFFFFFF) * NANOSECONDS_PER_SECOND + (1ull << 31)) >> 32;
+    return ((ntpTime >> 32) - NTP_UNIX_OFFSET) * NANOSECONDS_PER_SECOND + nanoseconds;
+}
+
+static void writeBigEndian(uint8_t* buffer, const uint64_t value, const unsigned int numberOfBytes)
+{
+    for(unsigned int i = 0; i < numberOfBytes; i++)
+    {
+        buffer[i] = (uint8_t)(value >> (8 * (numberOfBytes - 1 - i)));
+    }
+}
+
+static uint64_t readBigEndian(const uint8_t* buffer, const unsigned int numberOfBytes)
+{
+    uint64_t value = 0;
+    for(unsigned int i = 0; i < numberOfBytes; i++)
+    {
+        value = (value << 8) | buffer[i];
+    }
+    return value;
+}
+
+/*!
+ * \return the size in bytes of the header-extension starting at the given position, including the profile- and length-field
+ */
+static unsigned int readExtensionSize(const void* extension)
+{
+    //the length (in 32 bit words) follows the 16 bit profile
+    return RTP_HEADER_EXTENSION_MIN_SIZE + readBigEndian((const uint8_t*)extension + 2, 2) * sizeof(uint32_t);
+}
+
 RTPPackageHandler::RTPPackageHandler(unsigned int maximumPayloadSize, PayloadType payloadType)
 {
     this->maximumPayloadSize = maximumPayloadSize;
@@ -30,6 +84,11 @@ RTPPackageHandler::~RTPPackageHandler()
 }
 
 const void* RTPPackageHandler::createNewRTPPackage(const void* audioData, unsigned int payloadSize)
+{
+    return createNewRTPPackage(audioData, payloadSize, payloadType);
+}
+
+const void* RTPPackageHandler::createNewRTPPackage(const void* audioData, unsigned int payloadSize, PayloadType payloadType, const uint64_t captureTime)
 {
     RTPHeader newRTPHeader;
 
@@ -41,14 +100,45 @@ const void* RTPPackageHandler::createNewRTPPackage(const void* audioData, unsign
     newRTPHeader.setTimestamp(getCurrentRTPTimestamp());
     newRTPHeader.setSSRC(this->ssrc);
 
+    PackageTiming timing = {captureTime, 0};
+    if(captureTime != 0)
+    {
+        //the package is sent right after it is created
+        const uint64_t now = getWallClockTime();
+        timing.sendDelay = now > captureTime ? (uint32_t)std::min<uint64_t>((now - captureTime) / 1000, UINT32_MAX) : 0;
+    }
+
     // Copy RTPHeader and Audiodata in the buffer
-    memcpy((char*)workBuffer, &newRTPHeader, RTP_HEADER_MIN_SIZE);
-    memcpy((char*)(workBuffer)+ RTP_HEADER_MIN_SIZE, audioData, payloadSize);
+    void* payload = writeRTPPackageHeader(newRTPHeader, timing);
+    memcpy(payload, audioData, payloadSize);
     actualPayloadSize = payloadSize;
 
     return workBuffer;
 }
 
+void* RTPPackageHandler::writeRTPPackageHeader(const RTPHeader& header, const PackageTiming& timing)
+{
+    memcpy(workBuffer, &header, RTP_HEADER_MIN_SIZE);
+    //the CSRC-list of a received package is not kept, the header-extension would be read behind the missing CSRCs
+    ((RTPHeader*)workBuffer)->setCSRCCount(0);
+    ((RTPHeader*)workBuffer)->setExtension(timing.captureTime != 0);
+    uint8_t* extension = (uint8_t*)workBuffer + getRTPHeaderSize();
+    if(timing.captureTime == 0)
+    {
+        return extension;
+    }
+    //the element-header (4 bit ID, 4 bit size - 1) and the element are padded to full 32 bit words
+    const unsigned int extensionLength = (1 + CAPTURE_TIME_ELEMENT_SIZE + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    writeBigEndian(extension, RTP_HEADER_EXTENSION_ONE_BYTE_PROFILE, 2);
+    writeBigEndian(extension + 2, extensionLength, 2);
+    uint8_t* element = extension + RTP_HEADER_EXTENSION_MIN_SIZE;
+    memset(element, 0, extensionLength * sizeof(uint32_t));
+    element[0] = (CAPTURE_TIME_ELEMENT_ID << 4) | (CAPTURE_TIME_ELEMENT_SIZE - 1);
+    writeBigEndian(element + 1, toNTPTime(timing.captureTime), 8);
+    writeBigEndian(element + 9, timing.sendDelay, 4);
+    return element + extensionLength * sizeof(uint32_t);
+}
+
 const void* RTPPackageHandler::getRTPPackageData() const
 {
     return (char*)(workBuffer) + getRTPHeaderSize() + getRTPHeaderExtensionSize();
@@ -59,7 +149,6 @@ const RTPHeader* RTPPackageHandler::getRTPPackageHeader() const
     return (RTPHeader*)workBuffer;
 }
 
-//TODO needs testing
 const RTPHeaderExtension RTPPackageHandler::getRTPHeaderExtension() const
 {
     if(!getRTPPackageHeader()->hasExtension())
@@ -68,13 +157,53 @@ const RTPHeaderExtension RTPPackageHandler::getRTPHeaderExtension() const
         return RTPHeaderExtension(0);
     }
     //we must copy the contents of the header-extension, because we don't have any dynamic-sized array
-    const RTPHeaderExtension* readEx = (RTPHeaderExtension*)((char*)(workBuffer) + getRTPHeaderSize());
-    RTPHeaderExtension ex(readEx->getLength());
-    ex.setProfile(readEx->getProfile());
-    memcpy(ex.getExtension(), ((char*)(workBuffer) + getRTPHeaderSize() + RTP_HEADER_EXTENSION_MIN_SIZE), readEx->getLength());
+    const uint8_t* readEx = (const uint8_t*)workBuffer + getRTPHeaderSize();
+    RTPHeaderExtension ex((readExtensionSize(readEx) - RTP_HEADER_EXTENSION_MIN_SIZE) / sizeof(uint32_t));
+    ex.setProfile(readBigEndian(readEx, 2));
+    memcpy(ex.getExtension(), readEx + RTP_HEADER_EXTENSION_MIN_SIZE, ex.getLength() * sizeof(uint32_t));
     return ex;
 }
 
+PackageTiming RTPPackageHandler::getPackageTiming() const
+{
+    PackageTiming timing = {0, 0};
+    if(!getRTPPackageHeader()->hasExtension())
+    {
+        return timing;
+    }
+    const uint8_t* extension = (const uint8_t*)workBuffer + getRTPHeaderSize();
+    if(readBigEndian(extension, 2) != RTP_HEADER_EXTENSION_ONE_BYTE_PROFILE)
+    {
+        return timing;
+    }
+    const uint8_t* element = extension + RTP_HEADER_EXTENSION_MIN_SIZE;
+    const uint8_t* end = extension + getRTPHeaderExtensionSize();
+    while(element < end)
+    {
+        if(element[0] == 0)
+        {
+            //padding between the elements
+            ++element;
+            continue;
+        }
+        const uint8_t id = element[0] >> 4;
+        const unsigned int size = (element[0] & 0x0F) + 1;
+        if(id == 15 || element + 1 + size > end)
+        {
+            //the reserved ID 15 stops the parsing (RFC 8285 section 4.2)
+            break;
+        }
+        if(id == CAPTURE_TIME_ELEMENT_ID && size >= CAPTURE_TIME_ELEMENT_SIZE)
+        {
+            timing.captureTime = fromNTPTime(readBigEndian(element + 1, 8));
+            timing.sendDelay = (uint32_t)readBigEndian(element + 9, 4);
+            break;
+        }
+        element += 1 + size;
+    }
+    return timing;
+}
+
 unsigned int RTPPackageHandler::getRandomNumber()
 {
 	return this->randomGenerator();
@@ -101,8 +230,7 @@ unsigned int RTPPackageHandler::getRTPHeaderExtensionSize() const
 {
     if(((RTPHeader*)workBuffer)->hasExtension())
     {
-        const RTPHeaderExtension* readEx = (RTPHeaderExtension*)((char*)(workBuffer) + getRTPHeaderSize());
-        return RTP_HEADER_EXTENSION_MIN_SIZE + readEx->getLength() * sizeof(uint32_t);
+        return readExtensionSize((char*)(workBuffer) + getRTPHeaderSize());
     }
     else
     {
@@ -153,6 +281,11 @@ uint32_t RTPPackageHandler::getCurrentRTPTimestamp() const
     return timestamp + std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
+uint64_t RTPPackageHandler::getWallClockTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
 bool RTPPackageHandler::isRTPPackage(const void* packageBuffer, unsigned int packageLength)
 {
     //1. check for package size, if large enough
@@ -169,6 +302,20 @@ bool RTPPackageHandler::isRTPPackage(const void* packageBuffer, unsigned int pac
         //version is always 2 per specification
         return false;
     }
+    //4. the CSRCs and the header-extension must fit into the package
+    unsigned int headerSize = RTP_HEADER_MIN_SIZE + readHeader->getCSRCCount() * sizeof(uint32_t);
+    if(readHeader->hasExtension())
+    {
+        if(headerSize + RTP_HEADER_EXTENSION_MIN_SIZE > packageLength)
+        {
+            return false;
+        }
+        headerSize += readExtensionSize((const char*)packageBuffer + headerSize);
+    }
+    if(headerSize > packageLength)
+    {
+        return false;
+    }
     //we have no more fields to eliminate the package as RTP-package, so we accept it
     return true;
 }
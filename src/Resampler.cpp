@@ -0,0 +1,279 @@
+#include "Resampler.h"
+
+#include <string.h> //memmove
+#include <cmath>
+
+#include "SIMD.h"
+
+static const double PI = 3.14159265358979323846;
+
+//the number of taps (without lengthening for downsampling), the Kaiser-window parameter beta and the cut-off frequency
+//relative to the Nyquist-frequency for every quality-level
+static const unsigned int FILTER_LENGTHS[] = {16, 32, 64, 128};
+static const double KAISER_BETAS[] = {4.55, 6.76, 8.96, 11.16};
+static const double CUT_OFF_FREQUENCIES[] = {0.80, 0.88, 0.93, 0.96};
+
+//the filter-length is a multiple of the largest vector-size
+static const unsigned int FILTER_LENGTH_ALIGNMENT = 8;
+
+static unsigned int greatestCommonDivisor(unsigned int a, unsigned int b)
+{
+    while(b != 0)
+    {
+        const unsigned int remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+    return a;
+}
+
+//the zeroth order modified Bessel-function of the first kind
+static double besselI0(const double x)
+{
+    double sum = 1, term = 1;
+    for(unsigned int k = 1; k < 50 && term > sum * 1e-12; k++)
+    {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+static float dotProduct(const float* samples, const float* coefficients, const unsigned int length)
+{
+    float sum = 0;
+    for(unsigned int i = 0; i < length; i++)
+    {
+        sum += samples[i] * coefficients[i];
+    }
+    return sum;
+}
+
+#ifdef SIMD_X86
+SIMD_TARGET_SSE2 static float dotProductSSE2(const float* samples, const float* coefficients, const unsigned int length)
+{
+    //two accumulators to hide the latency of the additions
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+    for(unsigned int i = 0; i < length; i += 8)
+    {
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(samples + i), _mm_loadu_ps(coefficients + i)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(samples + i + 4), _mm_loadu_ps(coefficients + i + 4)));
+    }
+    sum0 = _mm_add_ps(sum0, sum1);
+    sum0 = _mm_add_ps(sum0, _mm_movehl_ps(sum0, sum0));
+    sum0 = _mm_add_ss(sum0, _mm_shuffle_ps(sum0, sum0, 1));
+    return _mm_cvtss_f32(sum0);
+}
+
+SIMD_TARGET_AVX2 static float dotProductAVX2(const float* samples, const float* coefficients, const unsigned int length)
+{
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    unsigned int i = 0;
+    for(; i + 16 <= length; i += 16)
+    {
+        sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(samples + i), _mm256_loadu_ps(coefficients + i)));
+        sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(_mm256_loadu_ps(samples + i + 8), _mm256_loadu_ps(coefficients + i + 8)));
+    }
+    if(i < length)
+    {
+        sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(samples + i), _mm256_loadu_ps(coefficients + i)));
+    }
+    sum0 = _mm256_add_ps(sum0, sum1);
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(sum0), _mm256_extractf128_ps(sum0, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+#endif
+
+#ifdef SIMD_NEON
+static float dotProductNEON(const float* samples, const float* coefficients, const unsigned int length)
+{
+    float32x4_t sum0 = vdupq_n_f32(0);
+    float32x4_t sum1 = vdupq_n_f32(0);
+    for(unsigned int i = 0; i < length; i += 8)
+    {
+        sum0 = vfmaq_f32(sum0, vld1q_f32(samples + i), vld1q_f32(coefficients + i));
+        sum1 = vfmaq_f32(sum1, vld1q_f32(samples + i + 4), vld1q_f32(coefficients + i + 4));
+    }
+    return vaddvq_f32(vaddq_f32(sum0, sum1));
+}
+#endif
+
+Resampler::Resampler(const unsigned int inputRate, const unsigned int outputRate, const unsigned int channels, const Quality quality,
+                     const unsigned int maximumInputFrames, const FormatConverter::InstructionSet instructionSet) :
+    interpolation(0), decimation(0), channels(channels), filterLength(0), maximumInputFrames(maximumInputFrames),
+    instructionSet(FormatConverter::InstructionSet::SCALAR), dotProduct(::dotProduct), coefficients(), history(), historySize(0), position(0), phase(0)
+{
+    if(inputRate == 0 || outputRate == 0 || channels == 0 || maximumInputFrames == 0)
+    {
+        return;
+    }
+    const unsigned int divisor = greatestCommonDivisor(inputRate, outputRate);
+    interpolation = outputRate / divisor;
+    decimation = inputRate / divisor;
+    if(interpolation > MAXIMUM_PHASES)
+    {
+        interpolation = 0;
+        return;
+    }
+#if defined(SIMD_X86)
+    if(instructionSet == FormatConverter::InstructionSet::AVX2 && cpuSupportsAVX2())
+    {
+        this->instructionSet = FormatConverter::InstructionSet::AVX2;
+        dotProduct = dotProductAVX2;
+    }
+    else if(instructionSet == FormatConverter::InstructionSet::SSE2 || instructionSet == FormatConverter::InstructionSet::AVX2)
+    {
+        this->instructionSet = FormatConverter::InstructionSet::SSE2;
+        dotProduct = dotProductSSE2;
+    }
+#elif defined(SIMD_NEON)
+    if(instructionSet == FormatConverter::InstructionSet::NEON)
+    {
+        this->instructionSet = FormatConverter::InstructionSet::NEON;
+        dotProduct = dotProductNEON;
+    }
+#endif
+    designFilter(quality);
+    history.resize(channels * (filterLength - 1 + maximumInputFrames));
+    reset();
+}
+
+bool Resampler::isValid() const
+{
+    return interpolation != 0;
+}
+
+unsigned int Resampler::process(const float* input, const unsigned int inputFrames, float* output)
+{
+    if(!isValid())
+    {
+        return 0;
+    }
+    const unsigned int historyCapacity = filterLength - 1 + maximumInputFrames;
+    unsigned int outputFrames = 0;
+    for(unsigned int offset = 0; offset < inputFrames; offset += maximumInputFrames)
+    {
+        const unsigned int chunkFrames = inputFrames - offset < maximumInputFrames ? inputFrames - offset : maximumInputFrames;
+        //de-interleave the input into the history of the channels
+        for(unsigned int channel = 0; channel < channels; channel++)
+        {
+            float* channelHistory = history.data() + channel * historyCapacity + historySize;
+            const float* channelInput = input + offset * channels + channel;
+            for(unsigned int i = 0; i < chunkFrames; i++)
+            {
+                channelHistory[i] = channelInput[i * channels];
+            }
+        }
+        historySize += chunkFrames;
+
+        while(position + filterLength <= historySize)
+        {
+            const float* phaseCoefficients = coefficients.data() + phase * filterLength;
+            for(unsigned int channel = 0; channel < channels; channel++)
+            {
+                output[outputFrames * channels + channel] = dotProduct(history.data() + channel * historyCapacity + position, phaseCoefficients, filterLength);
+            }
+            outputFrames++;
+            phase += decimation;
+            position += phase / interpolation;
+            phase %= interpolation;
+        }
+
+        //keep the samples required for the next output-frames
+        if(position >= historySize)
+        {
+            position -= historySize;
+            historySize = 0;
+        }
+        else
+        {
+            historySize -= position;
+            for(unsigned int channel = 0; channel < channels; channel++)
+            {
+                float* channelHistory = history.data() + channel * historyCapacity;
+                memmove(channelHistory, channelHistory + position, historySize * sizeof(float));
+            }
+            position = 0;
+        }
+    }
+    return outputFrames;
+}
+
+unsigned int Resampler::getMaximumOutputFrames(const unsigned int inputFrames) const
+{
+    if(!isValid())
+    {
+        return 0;
+    }
+    //one additional frame, since the fractional position carries over from the previous call
+    return (unsigned int)(((unsigned long long)inputFrames * interpolation + decimation - 1) / decimation) + 1;
+}
+
+unsigned int Resampler::getDelay() const
+{
+    return filterLength / 2;
+}
+
+void Resampler::reset()
+{
+    //start with a history of silence, so the first input-frame is the newest sample of the first output-frame
+    for(float& sample : history)
+    {
+        sample = 0;
+    }
+    historySize = filterLength > 0 ? filterLength - 1 : 0;
+    position = 0;
+    phase = 0;
+}
+
+unsigned int Resampler::getFilterLength() const
+{
+    return filterLength;
+}
+
+FormatConverter::InstructionSet Resampler::getInstructionSet() const
+{
+    return instructionSet;
+}
+
+void Resampler::designFilter(const Quality quality)
+{
+    const unsigned int level = static_cast<unsigned int>(quality);
+    //when downsampling, the cut-off frequency is lowered and the filter lengthened by the same factor to keep the transition band steep
+    const double bandwidth = decimation > interpolation ? (double)interpolation / decimation : 1.0;
+    const double cutOff = CUT_OFF_FREQUENCIES[level] * bandwidth;
+    const unsigned int length = (unsigned int)ceil(FILTER_LENGTHS[level] / bandwidth);
+    filterLength = ((length + FILTER_LENGTH_ALIGNMENT - 1) / FILTER_LENGTH_ALIGNMENT) * FILTER_LENGTH_ALIGNMENT;
+
+    const double halfLength = filterLength / 2.0;
+    const double center = halfLength - 1;
+    const double beta = KAISER_BETAS[level];
+    const double normalization = besselI0(beta);
+    coefficients.resize(interpolation * filterLength);
+    for(unsigned int p = 0; p < interpolation; p++)
+    {
+        float* phaseCoefficients = coefficients.data() + p * filterLength;
+        double sum = 0;
+        for(unsigned int k = 0; k < filterLength; k++)
+        {
+            //the distance in input-samples between the output-frame and the history-sample k
+            const double t = center + (double)p / interpolation - k;
+            const double x = PI * cutOff * t;
+            const double sinc = fabs(x) < 1e-12 ? 1.0 : sin(x) / x;
+            const double ratio = t / halfLength;
+            const double window = ratio * ratio < 1 ? besselI0(beta * sqrt(1 - ratio * ratio)) / normalization : 0;
+            const double coefficient = cutOff * sinc * window;
+            phaseCoefficients[k] = (float)coefficient;
+            sum += coefficient;
+        }
+        //normalize every phase to unity gain at DC
+        for(unsigned int k = 0; k < filterLength; k++)
+        {
+            phaseCoefficients[k] = (float)(phaseCoefficients[k] / sum);
+        }
+    }
+}
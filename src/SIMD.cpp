@@ -0,0 +1,88 @@
+#include "SIMD.h"
+
+#ifdef SIMD_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+//EDX of leaf 1
+static const unsigned int FEATURE_SSE2 = 1 << 26;
+//ECX of leaf 1
+static const unsigned int FEATURE_OSXSAVE = 1 << 27;
+static const unsigned int FEATURE_AVX = 1 << 28;
+//EBX of leaf 7
+static const unsigned int FEATURE_AVX2 = 1 << 5;
+//the operating system saves the SSE- and AVX-registers (XCR0 bits 1 and 2)
+static const unsigned long long XCR0_AVX_STATE = 0x6;
+
+struct CPUFeatures
+{
+    bool sse2;
+    bool avx2;
+
+    CPUFeatures() : sse2(false), avx2(false)
+    {
+        unsigned int ecx, edx, extendedFeatures;
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        ecx = (unsigned int)info[2];
+        edx = (unsigned int)info[3];
+        __cpuidex(info, 7, 0);
+        extendedFeatures = (unsigned int)info[1];
+#else
+        unsigned int eax, ebx;
+        if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        {
+            return;
+        }
+        extendedFeatures = 0;
+        if(__get_cpuid_max(0, nullptr) >= 7)
+        {
+            unsigned int ecx7, edx7;
+            __cpuid_count(7, 0, eax, extendedFeatures, ecx7, edx7);
+        }
+#endif
+        sse2 = (edx & FEATURE_SSE2) != 0;
+        if(sse2 && (ecx & FEATURE_OSXSAVE) != 0 && (ecx & FEATURE_AVX) != 0)
+        {
+#ifdef _MSC_VER
+            const unsigned long long xcr0 = _xgetbv(0);
+#else
+            unsigned int xcr0Low, xcr0High;
+            __asm__ ("xgetbv" : "=a" (xcr0Low), "=d" (xcr0High) : "c" (0));
+            const unsigned long long xcr0 = xcr0Low;
+#endif
+            avx2 = (xcr0 & XCR0_AVX_STATE) == XCR0_AVX_STATE && (extendedFeatures & FEATURE_AVX2) != 0;
+        }
+    }
+};
+
+static const CPUFeatures& getCPUFeatures()
+{
+    static const CPUFeatures features;
+    return features;
+}
+
+bool cpuSupportsSSE2()
+{
+    return getCPUFeatures().sse2;
+}
+
+bool cpuSupportsAVX2()
+{
+    return getCPUFeatures().avx2;
+}
+#else
+bool cpuSupportsSSE2()
+{
+    return false;
+}
+
+bool cpuSupportsAVX2()
+{
+    return false;
+}
+#endif
@@ -0,0 +1,162 @@
+#include "rtp/SRTPContext.h"
+
+//labels of the key-derivation, see RFC 3711 section 4.3.1
+static const uint8_t LABEL_ENCRYPTION_KEY = 0x00;
+static const uint8_t LABEL_SALT = 0x02;
+
+SRTPContext::SRTPContext(const uint8_t* masterKey, const uint8_t* masterSalt, const bool useHardwareAcceleration) :
+    cipher(deriveSessionKeys(masterKey, masterSalt, sessionKey, sessionSalt), useHardwareAcceleration)
+{
+    //the key is only required to initialize the cipher
+    memset(sessionKey, 0, sizeof(sessionKey));
+}
+
+SRTPContext::SRTPContext(const uint8_t* sessionKey, const uint8_t* sessionSalt, const bool useHardwareAcceleration, const bool) :
+    cipher(sessionKey, useHardwareAcceleration)
+{
+    memset(this->sessionKey, 0, sizeof(this->sessionKey));
+    memcpy(this->sessionSalt, sessionSalt, sizeof(this->sessionSalt));
+}
+
+SRTPContext SRTPContext::fromSessionKeys(const uint8_t* sessionKey, const uint8_t* sessionSalt, const bool useHardwareAcceleration)
+{
+    return SRTPContext(sessionKey, sessionSalt, useHardwareAcceleration, true);
+}
+
+bool SRTPContext::protect(void* package, unsigned int& packageSize, const unsigned int maximumPackageSize, const uint32_t rolloverCounter) const
+{
+    uint8_t* buffer = (uint8_t*)package;
+    const unsigned int headerSize = getHeaderSize(buffer, packageSize);
+    if(headerSize == 0 || packageSize + SRTP_AUTH_TAG_SIZE > maximumPackageSize)
+    {
+        return false;
+    }
+    uint8_t iv[AESGCM::IV_SIZE];
+    createIV(buffer, rolloverCounter, iv);
+    cipher.encrypt(iv, buffer, headerSize, buffer + headerSize, packageSize - headerSize, buffer + packageSize);
+    packageSize += SRTP_AUTH_TAG_SIZE;
+    return true;
+}
+
+bool SRTPContext::protect(RTPPackageHandler& package, unsigned int& packageSize, const uint32_t rolloverCounter) const
+{
+    return protect(package.getWorkBuffer(), packageSize, package.getMaximumPackageSize(), rolloverCounter);
+}
+
+bool SRTPContext::unprotect(void* package, unsigned int& packageSize, const uint32_t rolloverCounter) const
+{
+    uint8_t* buffer = (uint8_t*)package;
+    if(packageSize < SRTP_AUTH_TAG_SIZE)
+    {
+        return false;
+    }
+    const unsigned int headerSize = getHeaderSize(buffer, packageSize - SRTP_AUTH_TAG_SIZE);
+    if(headerSize == 0)
+    {
+        return false;
+    }
+    const unsigned int payloadSize = packageSize - SRTP_AUTH_TAG_SIZE - headerSize;
+    uint8_t iv[AESGCM::IV_SIZE];
+    createIV(buffer, rolloverCounter, iv);
+    if(!cipher.decrypt(iv, buffer, headerSize, buffer + headerSize, payloadSize, buffer + headerSize + payloadSize))
+    {
+        return false;
+    }
+    packageSize -= SRTP_AUTH_TAG_SIZE;
+    return true;
+}
+
+bool SRTPContext::unprotect(RTPPackageHandler& package, unsigned int& packageSize, const uint32_t rolloverCounter) const
+{
+    return unprotect(package.getWorkBuffer(), packageSize, rolloverCounter);
+}
+
+bool SRTPContext::isHardwareAccelerated() const
+{
+    return cipher.isHardwareAccelerated();
+}
+
+uint32_t SRTPContext::estimatePackageIndex(const uint32_t highestIndex, const uint16_t sequenceNumber)
+{
+    //See https://tools.ietf.org/html/rfc3711#section-3.3.1
+    //rollover-count is the higher 16 bits
+    const uint32_t rollOverCount = highestIndex >> 16;
+    const uint16_t highestSequenceNumber = highestIndex & 0xFFFF;
+    uint32_t estimatedRollOverCount = rollOverCount;
+    if(highestSequenceNumber < 0x8000)
+    {
+        //package is older than the current highest index and from before the roll-over
+        if(sequenceNumber > highestSequenceNumber + 0x8000 && rollOverCount > 0)
+        {
+            estimatedRollOverCount = rollOverCount - 1;
+        }
+    }
+    else if(sequenceNumber < highestSequenceNumber - 0x8000)
+    {
+        //roll-over between the current highest index and the new package
+        estimatedRollOverCount = rollOverCount + 1;
+    }
+    return (estimatedRollOverCount << 16) | sequenceNumber;
+}
+
+void SRTPContext::deriveKey(const uint8_t* masterKey, const uint8_t* masterSalt, const unsigned int masterSaltSize, const uint8_t label,
+                            uint8_t* output, const unsigned int outputSize)
+{
+    //the key-derivation uses the raw AES block-cipher in counter-mode (AES-CM) with the master-key
+    const AESGCM masterCipher(masterKey);
+    //x = (label || index DIV key_derivation_rate) XOR master_salt, where the 56 bit key-id ends at the 112th bit,
+    //followed by the 16 bit block-counter. With a key-derivation-rate of zero, the index-part is always zero.
+    //The 96 bit salt of RFC 7714 occupies the first bytes and is padded with zeroes (as libsrtp does)
+    uint8_t block[16] = {0};
+    memcpy(block, masterSalt, masterSaltSize);
+    block[7] ^= label;
+    uint8_t keyStream[16];
+    masterCipher.encryptBlock(block, keyStream);
+    memcpy(output, keyStream, outputSize);
+}
+
+const uint8_t* SRTPContext::deriveSessionKeys(const uint8_t* masterKey, const uint8_t* masterSalt, uint8_t* sessionKey, uint8_t* sessionSalt)
+{
+    deriveKey(masterKey, masterSalt, SRTP_MASTER_SALT_SIZE, LABEL_ENCRYPTION_KEY, sessionKey, AESGCM::KEY_SIZE);
+    deriveKey(masterKey, masterSalt, SRTP_MASTER_SALT_SIZE, LABEL_SALT, sessionSalt, AESGCM::IV_SIZE);
+    return sessionKey;
+}
+
+unsigned int SRTPContext::getHeaderSize(const uint8_t* package, const unsigned int packageSize)
+{
+    if(!RTPPackageHandler::isRTPPackage(package, packageSize))
+    {
+        return 0;
+    }
+    //the header is parsed directly to support all 15 CSRCs
+    unsigned int headerSize = RTP_HEADER_MIN_SIZE + (package[0] & 0x0F) * sizeof(uint32_t);
+    if(((const RTPHeader*)package)->hasExtension())
+    {
+        if(headerSize + 4 > packageSize)
+        {
+            return 0;
+        }
+        //the header-extension starts with 16 bit profile and 16 bit length (in 32 bit words)
+        const unsigned int extensionLength = (package[headerSize + 2] << 8) | package[headerSize + 3];
+        headerSize += 4 + extensionLength * sizeof(uint32_t);
+    }
+    return headerSize > packageSize ? 0 : headerSize;
+}
+
+void SRTPContext::createIV(const uint8_t* package, const uint32_t rolloverCounter, uint8_t* iv) const
+{
+    //see https://tools.ietf.org/html/rfc7714#section-8.1
+    iv[0] = 0;
+    iv[1] = 0;
+    //SSRC and sequence number are already in network byte-order
+    memcpy(iv + 2, package + 8, 4);
+    iv[6] = (uint8_t)(rolloverCounter >> 24);
+    iv[7] = (uint8_t)(rolloverCounter >> 16);
+    iv[8] = (uint8_t)(rolloverCounter >> 8);
+    iv[9] = (uint8_t)rolloverCounter;
+    memcpy(iv + 10, package + 2, 2);
+    for(unsigned int i = 0; i < AESGCM::IV_SIZE; i++)
+    {
+        iv[i] ^= sessionSalt[i];
+    }
+}
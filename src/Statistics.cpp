@@ -8,30 +8,92 @@
 #include "Statistics.h"
 #include <fstream>
 
-long Statistics::counters[] = {0};
+Statistics::CounterShard Statistics::shards[Statistics::NUMBER_OF_SHARDS];
+LatencyHistogram Statistics::latencies[Statistics::NUMBER_OF_LATENCIES];
 std::vector<ProfilingAudioProcessor*> Statistics::audioProcessorStatistics;
 
+Statistics::CounterShard& Statistics::getShard()
+{
+    static std::atomic<unsigned int> nextShard{0};
+    //the threads are assigned to the shards in the order of their first update
+    thread_local const unsigned int shardIndex = nextShard.fetch_add(1, std::memory_order_relaxed) % NUMBER_OF_SHARDS;
+    return shards[shardIndex];
+}
+
 void Statistics::incrementCounter(int counterIndex, long byValue)
 {
-    counters[counterIndex] += byValue;
+    getShard().counters[counterIndex].fetch_add(byValue, std::memory_order_relaxed);
 }
 
 void Statistics::setCounter(int counterIndex, long newValue)
 {
-    counters[counterIndex] = newValue;
+    //the value is kept in the first shard, so the sum of all shards is the new value
+    shards[0].counters[counterIndex].store(newValue, std::memory_order_relaxed);
+    for(unsigned int i = 1; i < NUMBER_OF_SHARDS; i++)
+    {
+        shards[i].counters[counterIndex].store(0, std::memory_order_relaxed);
+    }
 }
 
 void Statistics::maxCounter(int counterIndex, long newValue)
 {
-    if(newValue > counters[counterIndex])
+    //the maximum is kept in the first shard. A new maximum is rare, so usually the counter is only read
+    std::atomic<long>& counter = shards[0].counters[counterIndex];
+    long oldValue = counter.load(std::memory_order_relaxed);
+    while(newValue > oldValue && !counter.compare_exchange_weak(oldValue, newValue, std::memory_order_relaxed))
     {
-        counters[counterIndex] = newValue;
+        //oldValue was updated to the current value, retry
     }
 }
 
 long Statistics::readCounter(int counterIndex)
 {
-    return counters[counterIndex];
+    long value = 0;
+    for(const CounterShard& shard : shards)
+    {
+        value += shard.counters[counterIndex].load(std::memory_order_relaxed);
+    }
+    return value;
+}
+
+Statistics::CounterSnapshot Statistics::takeSnapshot()
+{
+    CounterSnapshot snapshot;
+    snapshot.fill(0);
+    //reads the shards one after another, so every cache-line is only fetched once
+    for(const CounterShard& shard : shards)
+    {
+        for(int i = 0; i < NUMBER_OF_COUNTERS; i++)
+        {
+            snapshot[i] += shard.counters[i].load(std::memory_order_relaxed);
+        }
+    }
+    return snapshot;
+}
+
+void Statistics::resetCounters()
+{
+    for(CounterShard& shard : shards)
+    {
+        for(std::atomic<long>& counter : shard.counters)
+        {
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
+    for(LatencyHistogram& latency : latencies)
+    {
+        latency.reset();
+    }
+}
+
+void Statistics::recordLatency(int latencyIndex, uint64_t nanoseconds)
+{
+    latencies[latencyIndex].record(nanoseconds);
+}
+
+const LatencyHistogram& Statistics::getLatency(int latencyIndex)
+{
+    return latencies[latencyIndex];
 }
 
 void Statistics::printStatistics()
@@ -117,6 +179,8 @@ void Statistics::removeAllProfilers()
 
 void Statistics::printStatistics(std::ostream& outputStream)
 {
+    //all values are printed from the same snapshot, so the derived values (e.g. the overhead) match the printed counters
+    const CounterSnapshot counters = takeSnapshot();
     double seconds = counters[TOTAL_ELAPSED_MILLISECONDS] / 1000.0;
     if(seconds == 0)
     {
@@ -143,6 +207,7 @@ void Statistics::printStatistics(std::ostream& outputStream)
     outputStream << "+++ Network statistics +++" << std::endl;
     outputStream << "Sent " << counters[COUNTER_PACKAGES_SENT] << " packages ("
             << (counters[COUNTER_PACKAGES_SENT]/seconds) << " per second)" << std::endl;
+    outputStream << "Suppressed " << counters[COUNTER_BUFFERS_SUPPRESSED] << " silent audio-buffers" << std::endl;
     outputStream << "Sent " << (counters[COUNTER_PAYLOAD_BYTES_SENT] + counters[COUNTER_HEADER_BYTES_SENT]) << " bytes ("
             << prettifyByteSize(counters[COUNTER_PAYLOAD_BYTES_SENT] + counters[COUNTER_HEADER_BYTES_SENT]) << ") in total ("
             << prettifyByteSize((counters[COUNTER_PAYLOAD_BYTES_SENT] + counters[COUNTER_HEADER_BYTES_SENT])/seconds) << "/s)"
@@ -175,6 +240,7 @@ void Statistics::printStatistics(std::ostream& outputStream)
             << "%)" << std::endl;
     outputStream << "Lost " << counters[COUNTER_PACKAGES_LOST] << " RTP-packages ("
             << (counters[COUNTER_PACKAGES_LOST]/seconds) << " packages per second)" << std::endl;
+    outputStream << "Recovered " << counters[COUNTER_PACKAGES_RECOVERED] << " lost RTP-packages via FEC" << std::endl;
     //Buffer statistics
     outputStream << std::endl;
     outputStream << "+++ Buffer statistics +++" << std::endl;
@@ -182,6 +248,17 @@ void Statistics::printStatistics(std::ostream& outputStream)
             << counters[RTP_BUFFER_LIMIT] << " packages ("
             << prettifyPercentage(counters[RTP_BUFFER_MAXIMUM_USAGE]/(double)counters[RTP_BUFFER_LIMIT]) << "%)"
             << std::endl;
+    //Latency statistics
+    if(latencies[LATENCY_MOUTH_TO_EAR].getCount() > 0 || latencies[LATENCY_JITTER_BUFFER].getCount() > 0)
+    {
+        outputStream << std::endl;
+        outputStream << "+++ Latency statistics +++" << std::endl;
+        printEndToEndLatency(outputStream, "Sending (remote)", latencies[LATENCY_SENDING]);
+        printEndToEndLatency(outputStream, "Network", latencies[LATENCY_NETWORK]);
+        printEndToEndLatency(outputStream, "Jitter-buffer", latencies[LATENCY_JITTER_BUFFER]);
+        printEndToEndLatency(outputStream, "Output-device", latencies[LATENCY_OUTPUT]);
+        printEndToEndLatency(outputStream, "Mouth-to-ear", latencies[LATENCY_MOUTH_TO_EAR]);
+    }
     //Compression statistics
     outputStream << std::endl;
     outputStream << "+++ Compression statistics +++" << std::endl;
@@ -209,12 +286,38 @@ void Statistics::printAudioProcessorStatistic(std::ostream& outputStream)
     outputStream << "+++ AudioProcessor statistics +++" << std::endl;
     for(ProfilingAudioProcessor* profiler : Statistics::audioProcessorStatistics)
     {
-        double inputAverage = profiler->getTotalInputTime() / (double)profiler->getTotalCount();
-        double outputAverage = profiler->getTotalOutputTime() / (double)profiler->getTotalCount();
         outputStream << std::endl << profiler->getName() << std::endl;
-        outputStream << "\tProcessing audio-input took " << profiler->getTotalInputTime()
-                << " microseconds in total (" << inputAverage << " microseconds per call)" << std::endl;
-        outputStream << "\tProcessing audio-output took  " << profiler->getTotalOutputTime()
-                << " microseconds in total (" << outputAverage << " microseconds per call)" << std::endl;
+        printLatencies(outputStream, "audio-input", profiler->getInputHistogram());
+        printLatencies(outputStream, "audio-output", profiler->getOutputHistogram());
+    }
+}
+
+void Statistics::printLatencies(std::ostream& outputStream, const std::string& direction, const LatencyHistogram& histogram)
+{
+    const uint64_t calls = histogram.getCount();
+    if(calls == 0)
+    {
+        outputStream << "\tProcessing " << direction << " was not called" << std::endl;
+        return;
+    }
+    //the latencies are recorded in nanoseconds and printed in microseconds
+    outputStream << "\tProcessing " << direction << " took " << (histogram.getTotal() / 1000) << " microseconds in total ("
+            << calls << " calls, " << (histogram.getTotal() / 1000.0 / calls) << " microseconds per call)" << std::endl;
+    outputStream << "\t\tp50 " << (histogram.getPercentile(50) / 1000.0) << ", p99 " << (histogram.getPercentile(99) / 1000.0)
+            << ", p99.9 " << (histogram.getPercentile(99.9) / 1000.0) << ", max " << (histogram.getMaximum() / 1000.0)
+            << " microseconds" << std::endl;
+}
+
+void Statistics::printEndToEndLatency(std::ostream& outputStream, const std::string& component, const LatencyHistogram& histogram)
+{
+    const uint64_t packages = histogram.getCount();
+    if(packages == 0)
+    {
+        outputStream << component << " latency was not measured" << std::endl;
+        return;
     }
+    //the latencies are recorded in nanoseconds and printed in milliseconds
+    outputStream << component << " latency was " << (histogram.getTotal() / 1000000.0 / packages) << " ms on average ("
+            << packages << " packages), p50 " << (histogram.getPercentile(50) / 1000000.0) << ", p99 "
+            << (histogram.getPercentile(99) / 1000000.0) << ", max " << (histogram.getMaximum() / 1000000.0) << " ms" << std::endl;
 }
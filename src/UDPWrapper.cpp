@@ -1,14 +1,22 @@
 #include "UDPWrapper.h"
 
-UDPWrapper::UDPWrapper(unsigned short portIncoming, const std::string remoteIPAddress, unsigned short portOutgoing) :
+UDPWrapper::UDPWrapper(unsigned short portIncoming, const std::string remoteIPAddress, unsigned short portOutgoing,
+                       unsigned char multicastTTL, bool multicastLoopback, const std::string multicastSourceAddress) :
     localAddress({0}), remoteAddress({0})
 {
 	initializeNetworkConfig(portIncoming, remoteIPAddress, portOutgoing);
 	initializeNetwork();
+	if(isMulticast && !initializeMulticast(multicastTTL, multicastLoopback, multicastSourceAddress))
+	{
+		//the destructor is not run for a partially constructed object
+		closeNetwork();
+		throw std::runtime_error("Failed to join the multicast group");
+	}
 }
 
 UDPWrapper::UDPWrapper(const NetworkConfiguration& networkConfig) :
-    UDPWrapper(networkConfig.localPort, networkConfig.remoteIPAddress, networkConfig.remotePort)
+    UDPWrapper(networkConfig.localPort, networkConfig.remoteIPAddress, networkConfig.remotePort,
+               networkConfig.multicastTTL, networkConfig.multicastLoopback, networkConfig.multicastSourceAddress)
 {
 }
 
@@ -54,6 +62,7 @@ void UDPWrapper::initializeNetworkConfig(unsigned short localPort, const std::st
         remoteAddress.ipv6.sin6_family = AF_INET6;
         inet_pton(AF_INET6, remoteIPAddress.c_str(), &(remoteAddress.ipv6.sin6_addr));
         remoteAddress.ipv6.sin6_port = htons(remotePort);
+        isMulticast = IN6_IS_ADDR_MULTICAST(&(remoteAddress.ipv6.sin6_addr));
     }
     else
     {
@@ -66,6 +75,8 @@ void UDPWrapper::initializeNetworkConfig(unsigned short localPort, const std::st
         remoteAddress.ipv4.sin_family = AF_INET;
         inet_pton(AF_INET, remoteIPAddress.c_str(), &(remoteAddress.ipv4.sin_addr));
         remoteAddress.ipv4.sin_port = htons(remotePort);
+        //multicast addresses are in the range 224.0.0.0 - 239.255.255.255
+        isMulticast = (ntohl(remoteAddress.ipv4.sin_addr.s_addr) & 0xF0000000) == 0xE0000000;
     }
 }
 
@@ -92,6 +103,12 @@ bool UDPWrapper::createSocket()
     {
         std::cout << "Socket created." << std::endl;
     }
+    if(isMulticast)
+    {
+        //allow several receivers of the multicast group on the same device
+        int reuseAddress = 1;
+        setsockopt(Socket, SOL_SOCKET, SO_REUSEADDR, (char*) &reuseAddress, sizeof(reuseAddress));
+    }
     
     if (bind(Socket, (sockaddr*)&(this->localAddress), addressLength) == SOCKET_ERROR)
     {
@@ -114,6 +131,89 @@ bool UDPWrapper::createSocket()
     return true;
 }
 
+bool UDPWrapper::initializeMulticast(unsigned char multicastTTL, bool multicastLoopback, const std::string multicastSourceAddress)
+{
+    //the options are of type int (DWORD on Windows) for both IPv4 and IPv6
+    int loopback = multicastLoopback ? 1 : 0;
+    int result;
+    if(isIPv6)
+    {
+        if(multicastTTL != 0)
+        {
+            int hops = multicastTTL;
+            setsockopt(Socket, IPPROTO_IPV6, IPV6_MULTICAST_HOPS, (char*) &hops, sizeof(hops));
+        }
+        setsockopt(Socket, IPPROTO_IPV6, IPV6_MULTICAST_LOOP, (char*) &loopback, sizeof(loopback));
+        if(multicastSourceAddress.empty())
+        {
+            ipv6_mreq request;
+            request.ipv6mr_multiaddr = remoteAddress.ipv6.sin6_addr;
+            //let the system choose the interface
+            request.ipv6mr_interface = 0;
+            result = setsockopt(Socket, IPPROTO_IPV6, IPV6_JOIN_GROUP, (char*) &request, sizeof(request));
+        }
+        else
+        {
+            #ifdef MCAST_JOIN_SOURCE_GROUP
+            group_source_req request;
+            memset(&request, 0, sizeof(request));
+            request.gsr_interface = 0;
+            sockaddr_in6* group = (sockaddr_in6*) &(request.gsr_group);
+            group->sin6_family = AF_INET6;
+            group->sin6_addr = remoteAddress.ipv6.sin6_addr;
+            sockaddr_in6* source = (sockaddr_in6*) &(request.gsr_source);
+            source->sin6_family = AF_INET6;
+            if(inet_pton(AF_INET6, multicastSourceAddress.c_str(), &(source->sin6_addr)) != 1)
+            {
+                std::cerr << "Invalid multicast source-address: " << multicastSourceAddress << std::endl;
+                return false;
+            }
+            result = setsockopt(Socket, IPPROTO_IPV6, MCAST_JOIN_SOURCE_GROUP, (char*) &request, sizeof(request));
+            #else
+            std::cerr << "Source-specific multicast is not supported for IPv6, receiving from all sources" << std::endl;
+            return initializeMulticast(multicastTTL, multicastLoopback, "");
+            #endif
+        }
+    }
+    else
+    {
+        if(multicastTTL != 0)
+        {
+            int ttl = multicastTTL;
+            setsockopt(Socket, IPPROTO_IP, IP_MULTICAST_TTL, (char*) &ttl, sizeof(ttl));
+        }
+        setsockopt(Socket, IPPROTO_IP, IP_MULTICAST_LOOP, (char*) &loopback, sizeof(loopback));
+        if(multicastSourceAddress.empty())
+        {
+            ip_mreq request;
+            request.imr_multiaddr = remoteAddress.ipv4.sin_addr;
+            //let the system choose the interface
+            request.imr_interface.s_addr = htonl(INADDR_ANY);
+            result = setsockopt(Socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, (char*) &request, sizeof(request));
+        }
+        else
+        {
+            ip_mreq_source request;
+            memset(&request, 0, sizeof(request));
+            request.imr_multiaddr = remoteAddress.ipv4.sin_addr;
+            if(inet_pton(AF_INET, multicastSourceAddress.c_str(), &(request.imr_sourceaddr)) != 1)
+            {
+                std::cerr << "Invalid multicast source-address: " << multicastSourceAddress << std::endl;
+                return false;
+            }
+            request.imr_interface.s_addr = htonl(INADDR_ANY);
+            result = setsockopt(Socket, IPPROTO_IP, IP_ADD_SOURCE_MEMBERSHIP, (char*) &request, sizeof(request));
+        }
+    }
+    if(result == SOCKET_ERROR)
+    {
+        std::wcerr << "Error joining the multicast group: " << getLastError() << std::endl;
+        return false;
+    }
+    std::cout << "Multicast group joined." << std::endl;
+    return true;
+}
+
 int UDPWrapper::sendData(const void *buffer, const unsigned int bufferSize)
 {
     return sendto(this->Socket, (char*)buffer, (int)bufferSize, 0, (sockaddr*)&(this->remoteAddress), getSocketAddressLength());
@@ -0,0 +1,349 @@
+#include "VoiceActivityDetector.h"
+
+#include <cmath>
+
+#include "SIMD.h"
+
+//the scale of 16 bit samples to full-scale
+static const float SCALE_INT16 = 1.0f / 32768.0f;
+//the lowest noise-floor (also the noise-floor at start) in dB relative to full-scale,
+//so the noise-floor does not need to rise from digital silence
+static const float MINIMUM_NOISE_FLOOR = -70.0f;
+//the power below which audio is never considered speech, in dB relative to full-scale
+static const float MINIMUM_SPEECH_POWER = -65.0f;
+//the rate at which the noise-floor rises, in dB per second
+static const float NOISE_FLOOR_RISE = 5.0f;
+//the weight of the current buffer, when the noise-floor falls
+static const float NOISE_FLOOR_FALL = 0.5f;
+//the minimum correlation and maximum zero-crossing rate of voiced speech
+static const float VOICED_CORRELATION = 0.7f;
+static const float VOICED_ZERO_CROSSING_RATE = 0.25f;
+static const unsigned int HANGOVER_MILLISECONDS = 200;
+
+////
+// The kernels accumulate the power from the first sample and the correlation and zero-crossings from the sample at index lag
+////
+
+template<typename Sample>
+static inline float toFloat(const Sample sample);
+
+template<>
+inline float toFloat<float>(const float sample)
+{
+    return sample;
+}
+
+template<>
+inline float toFloat<int16_t>(const int16_t sample)
+{
+    return sample * SCALE_INT16;
+}
+
+template<typename Sample, typename Sums>
+static void accumulate(const Sample* samples, const unsigned int start, const unsigned int numberOfSamples, const unsigned int lag, Sums& sums)
+{
+    for(unsigned int i = start; i < numberOfSamples; i++)
+    {
+        const float current = toFloat(samples[i]);
+        const float previous = toFloat(samples[i - lag]);
+        sums.squares += current * current;
+        sums.products += current * previous;
+        sums.zeroCrossings += std::signbit(current) != std::signbit(previous);
+    }
+}
+
+template<typename Sample, typename Sums>
+static void accumulateFirst(const Sample* samples, const unsigned int numberOfSamples, const unsigned int lag, Sums& sums)
+{
+    for(unsigned int i = 0; i < lag && i < numberOfSamples; i++)
+    {
+        const float sample = toFloat(samples[i]);
+        sums.squares += sample * sample;
+    }
+}
+
+#ifdef SIMD_X86
+//the sign-bits of the samples are the most significant bits, so the shifted difference counts the sign-changes
+#define VAD_SSE2_ACCUMULATE(current, previous) \
+    squares = _mm_add_ps(squares, _mm_mul_ps(current, current)); \
+    products = _mm_add_ps(products, _mm_mul_ps(current, previous)); \
+    crossings = _mm_add_epi32(crossings, _mm_srli_epi32(_mm_castps_si128(_mm_xor_ps(current, previous)), 31));
+
+SIMD_TARGET_SSE2 static inline float sumSSE2(const __m128 values)
+{
+    const __m128 sum = _mm_add_ps(values, _mm_movehl_ps(values, values));
+    return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+}
+
+SIMD_TARGET_SSE2 static inline unsigned int sumSSE2(const __m128i values)
+{
+    const __m128i sum = _mm_add_epi32(values, _mm_shuffle_epi32(values, 0x4E));
+    return (unsigned int)_mm_cvtsi128_si32(_mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1)));
+}
+
+template<typename Sums>
+SIMD_TARGET_SSE2 static Sums floatKernelSSE2(const float* samples, const unsigned int numberOfSamples, const unsigned int lag)
+{
+    __m128 squares = _mm_setzero_ps(), products = _mm_setzero_ps();
+    __m128i crossings = _mm_setzero_si128();
+    unsigned int i = lag;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        const __m128 current = _mm_loadu_ps(samples + i);
+        const __m128 previous = _mm_loadu_ps(samples + i - lag);
+        VAD_SSE2_ACCUMULATE(current, previous)
+    }
+    Sums sums = {sumSSE2(squares), sumSSE2(products), sumSSE2(crossings)};
+    accumulate(samples, i, numberOfSamples, lag, sums);
+    accumulateFirst(samples, numberOfSamples, lag, sums);
+    return sums;
+}
+
+SIMD_TARGET_SSE2 static inline __m128 loadInt16SSE2(const __m128i values, const bool high)
+{
+    //sign-extend by moving the 16 bits into the upper half and shifting back arithmetically
+    const __m128i extended = _mm_srai_epi32(high ? _mm_unpackhi_epi16(values, values) : _mm_unpacklo_epi16(values, values), 16);
+    return _mm_mul_ps(_mm_cvtepi32_ps(extended), _mm_set1_ps(SCALE_INT16));
+}
+
+template<typename Sums>
+SIMD_TARGET_SSE2 static Sums int16KernelSSE2(const int16_t* samples, const unsigned int numberOfSamples, const unsigned int lag)
+{
+    __m128 squares = _mm_setzero_ps(), products = _mm_setzero_ps();
+    __m128i crossings = _mm_setzero_si128();
+    unsigned int i = lag;
+    for(; i + 8 <= numberOfSamples; i += 8)
+    {
+        const __m128i currentValues = _mm_loadu_si128((const __m128i*)(samples + i));
+        const __m128i previousValues = _mm_loadu_si128((const __m128i*)(samples + i - lag));
+        const __m128 currentLow = loadInt16SSE2(currentValues, false);
+        const __m128 previousLow = loadInt16SSE2(previousValues, false);
+        VAD_SSE2_ACCUMULATE(currentLow, previousLow)
+        const __m128 currentHigh = loadInt16SSE2(currentValues, true);
+        const __m128 previousHigh = loadInt16SSE2(previousValues, true);
+        VAD_SSE2_ACCUMULATE(currentHigh, previousHigh)
+    }
+    Sums sums = {sumSSE2(squares), sumSSE2(products), sumSSE2(crossings)};
+    accumulate(samples, i, numberOfSamples, lag, sums);
+    accumulateFirst(samples, numberOfSamples, lag, sums);
+    return sums;
+}
+#undef VAD_SSE2_ACCUMULATE
+
+#define VAD_AVX2_ACCUMULATE(current, previous) \
+    squares = _mm256_add_ps(squares, _mm256_mul_ps(current, current)); \
+    products = _mm256_add_ps(products, _mm256_mul_ps(current, previous)); \
+    crossings = _mm256_add_epi32(crossings, _mm256_srli_epi32(_mm256_castps_si256(_mm256_xor_ps(current, previous)), 31));
+
+SIMD_TARGET_AVX2 static inline float sumAVX2(const __m256 values)
+{
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(values), _mm256_extractf128_ps(values, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+}
+
+SIMD_TARGET_AVX2 static inline unsigned int sumAVX2(const __m256i values)
+{
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    return (unsigned int)_mm_cvtsi128_si32(_mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1)));
+}
+
+template<typename Sums>
+SIMD_TARGET_AVX2 static Sums floatKernelAVX2(const float* samples, const unsigned int numberOfSamples, const unsigned int lag)
+{
+    __m256 squares = _mm256_setzero_ps(), products = _mm256_setzero_ps();
+    __m256i crossings = _mm256_setzero_si256();
+    unsigned int i = lag;
+    for(; i + 8 <= numberOfSamples; i += 8)
+    {
+        const __m256 current = _mm256_loadu_ps(samples + i);
+        const __m256 previous = _mm256_loadu_ps(samples + i - lag);
+        VAD_AVX2_ACCUMULATE(current, previous)
+    }
+    Sums sums = {sumAVX2(squares), sumAVX2(products), sumAVX2(crossings)};
+    accumulate(samples, i, numberOfSamples, lag, sums);
+    accumulateFirst(samples, numberOfSamples, lag, sums);
+    return sums;
+}
+
+template<typename Sums>
+SIMD_TARGET_AVX2 static Sums int16KernelAVX2(const int16_t* samples, const unsigned int numberOfSamples, const unsigned int lag)
+{
+    const __m256 scale = _mm256_set1_ps(SCALE_INT16);
+    __m256 squares = _mm256_setzero_ps(), products = _mm256_setzero_ps();
+    __m256i crossings = _mm256_setzero_si256();
+    unsigned int i = lag;
+    for(; i + 8 <= numberOfSamples; i += 8)
+    {
+        const __m256 current = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(samples + i)))), scale);
+        const __m256 previous = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(samples + i - lag)))), scale);
+        VAD_AVX2_ACCUMULATE(current, previous)
+    }
+    Sums sums = {sumAVX2(squares), sumAVX2(products), sumAVX2(crossings)};
+    accumulate(samples, i, numberOfSamples, lag, sums);
+    accumulateFirst(samples, numberOfSamples, lag, sums);
+    return sums;
+}
+#undef VAD_AVX2_ACCUMULATE
+#endif
+
+#ifdef SIMD_NEON
+#define VAD_NEON_ACCUMULATE(current, previous) \
+    squares = vfmaq_f32(squares, current, current); \
+    products = vfmaq_f32(products, current, previous); \
+    crossings = vaddq_u32(crossings, vshrq_n_u32(veorq_u32(vreinterpretq_u32_f32(current), vreinterpretq_u32_f32(previous)), 31));
+
+template<typename Sums>
+static Sums floatKernelNEON(const float* samples, const unsigned int numberOfSamples, const unsigned int lag)
+{
+    float32x4_t squares = vdupq_n_f32(0), products = vdupq_n_f32(0);
+    uint32x4_t crossings = vdupq_n_u32(0);
+    unsigned int i = lag;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        const float32x4_t current = vld1q_f32(samples + i);
+        const float32x4_t previous = vld1q_f32(samples + i - lag);
+        VAD_NEON_ACCUMULATE(current, previous)
+    }
+    Sums sums = {vaddvq_f32(squares), vaddvq_f32(products), vaddvq_u32(crossings)};
+    accumulate(samples, i, numberOfSamples, lag, sums);
+    accumulateFirst(samples, numberOfSamples, lag, sums);
+    return sums;
+}
+
+template<typename Sums>
+static Sums int16KernelNEON(const int16_t* samples, const unsigned int numberOfSamples, const unsigned int lag)
+{
+    float32x4_t squares = vdupq_n_f32(0), products = vdupq_n_f32(0);
+    uint32x4_t crossings = vdupq_n_u32(0);
+    unsigned int i = lag;
+    for(; i + 4 <= numberOfSamples; i += 4)
+    {
+        const float32x4_t current = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(samples + i))), SCALE_INT16);
+        const float32x4_t previous = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(samples + i - lag))), SCALE_INT16);
+        VAD_NEON_ACCUMULATE(current, previous)
+    }
+    Sums sums = {vaddvq_f32(squares), vaddvq_f32(products), vaddvq_u32(crossings)};
+    accumulate(samples, i, numberOfSamples, lag, sums);
+    accumulateFirst(samples, numberOfSamples, lag, sums);
+    return sums;
+}
+#undef VAD_NEON_ACCUMULATE
+#endif
+
+template<typename Sample, typename Sums>
+static Sums scalarKernel(const Sample* samples, const unsigned int numberOfSamples, const unsigned int lag)
+{
+    Sums sums = {0, 0, 0};
+    accumulate(samples, lag, numberOfSamples, lag, sums);
+    accumulateFirst(samples, numberOfSamples, lag, sums);
+    return sums;
+}
+
+VoiceActivityDetector::VoiceActivityDetector(const unsigned int sampleRate, const unsigned int channels, const float threshold,
+                                             const FormatConverter::InstructionSet instructionSet) :
+    sampleRate(sampleRate), channels(channels > 0 ? channels : 1), threshold(threshold), instructionSet(FormatConverter::InstructionSet::SCALAR),
+    int16Kernel(scalarKernel<int16_t, Sums>), floatKernel(scalarKernel<float, Sums>), noiseFloor(MINIMUM_NOISE_FLOOR),
+    hangoverFrames((sampleRate * HANGOVER_MILLISECONDS) / 1000), framesSinceSpeech(hangoverFrames + 1)
+{
+#if defined(SIMD_X86)
+    if(instructionSet == FormatConverter::InstructionSet::AVX2 && cpuSupportsAVX2())
+    {
+        this->instructionSet = FormatConverter::InstructionSet::AVX2;
+        int16Kernel = int16KernelAVX2<Sums>;
+        floatKernel = floatKernelAVX2<Sums>;
+    }
+    else if(instructionSet == FormatConverter::InstructionSet::SSE2 || instructionSet == FormatConverter::InstructionSet::AVX2)
+    {
+        this->instructionSet = FormatConverter::InstructionSet::SSE2;
+        int16Kernel = int16KernelSSE2<Sums>;
+        floatKernel = floatKernelSSE2<Sums>;
+    }
+#elif defined(SIMD_NEON)
+    if(instructionSet == FormatConverter::InstructionSet::NEON)
+    {
+        this->instructionSet = FormatConverter::InstructionSet::NEON;
+        int16Kernel = int16KernelNEON<Sums>;
+        floatKernel = floatKernelNEON<Sums>;
+    }
+#endif
+}
+
+bool VoiceActivityDetector::isSpeech(const int16_t* samples, const unsigned int numberOfFrames)
+{
+    return classify(calculateFeatures(samples, numberOfFrames), numberOfFrames);
+}
+
+bool VoiceActivityDetector::isSpeech(const float* samples, const unsigned int numberOfFrames)
+{
+    return classify(calculateFeatures(samples, numberOfFrames), numberOfFrames);
+}
+
+VoiceActivityDetector::Features VoiceActivityDetector::calculateFeatures(const int16_t* samples, const unsigned int numberOfFrames) const
+{
+    return toFeatures(int16Kernel(samples, numberOfFrames * channels, channels), numberOfFrames);
+}
+
+VoiceActivityDetector::Features VoiceActivityDetector::calculateFeatures(const float* samples, const unsigned int numberOfFrames) const
+{
+    return toFeatures(floatKernel(samples, numberOfFrames * channels, channels), numberOfFrames);
+}
+
+float VoiceActivityDetector::getNoiseFloor() const
+{
+    return noiseFloor;
+}
+
+FormatConverter::InstructionSet VoiceActivityDetector::getInstructionSet() const
+{
+    return instructionSet;
+}
+
+VoiceActivityDetector::Features VoiceActivityDetector::toFeatures(const Sums& sums, const unsigned int numberOfFrames) const
+{
+    Features features = {0, 0, 0};
+    if(numberOfFrames == 0)
+    {
+        return features;
+    }
+    features.power = sums.squares / (numberOfFrames * channels);
+    features.correlation = sums.squares > 0 ? sums.products / sums.squares : 0;
+    features.zeroCrossingRate = numberOfFrames > 1 ? (float)sums.zeroCrossings / ((numberOfFrames - 1) * channels) : 0;
+    return features;
+}
+
+bool VoiceActivityDetector::classify(const Features& features, const unsigned int numberOfFrames)
+{
+    //-150 dB for digital silence
+    const float power = 10.0f * log10f(features.power + 1e-15f);
+    bool speech = false;
+    if(power >= MINIMUM_SPEECH_POWER)
+    {
+        const bool isVoiced = features.correlation >= VOICED_CORRELATION && features.zeroCrossingRate <= VOICED_ZERO_CROSSING_RATE;
+        speech = power >= noiseFloor + threshold || (isVoiced && power >= noiseFloor + threshold / 2);
+    }
+
+    //follow the minima of the power quickly and rise slowly, so the noise-floor adapts to changes of the background noise
+    if(power < noiseFloor)
+    {
+        noiseFloor += NOISE_FLOOR_FALL * (power - noiseFloor);
+        noiseFloor = noiseFloor < MINIMUM_NOISE_FLOOR ? MINIMUM_NOISE_FLOOR : noiseFloor;
+    }
+    else
+    {
+        noiseFloor += (NOISE_FLOOR_RISE * numberOfFrames) / sampleRate;
+    }
+
+    if(speech)
+    {
+        framesSinceSpeech = 0;
+        return true;
+    }
+    //prevent overflow on long silences
+    if(framesSinceSpeech <= hangoverFrames)
+    {
+        framesSinceSpeech += numberOfFrames;
+    }
+    return framesSinceSpeech <= hangoverFrames;
+}
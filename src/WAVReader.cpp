@@ -0,0 +1,211 @@
+#include "WAVReader.h"
+
+#include <iostream>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//the format-tags of the fmt-chunk
+static const uint16_t WAVE_FORMAT_PCM = 0x0001;
+static const uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+static const uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+static uint32_t readLittleEndian(const uint8_t* data, const unsigned int numberOfBytes)
+{
+    uint32_t value = 0;
+    for(unsigned int i = 0; i < numberOfBytes; i++)
+    {
+        value |= (uint32_t)data[i] << (8 * i);
+    }
+    return value;
+}
+
+WAVReader::WAVReader(const std::string& fileName) : mapping(nullptr), mappingSize(0),
+#ifdef _WIN32
+    fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr),
+#endif
+    format(AudioFormat::SIGNED_INT_16), sampleRate(0), channels(0), data(nullptr), dataSize(0)
+{
+    if(!mapFile(fileName))
+    {
+        std::cerr << "[WAV-Reader-Error]Failed to map file: " << fileName << std::endl;
+        return;
+    }
+    if(!parseHeader())
+    {
+        std::cerr << "[WAV-Reader-Error]Invalid or unsupported WAV-file: " << fileName << std::endl;
+        unmapFile();
+    }
+}
+
+WAVReader::~WAVReader()
+{
+    unmapFile();
+}
+
+bool WAVReader::isOpen() const
+{
+    return data != nullptr;
+}
+
+AudioFormat WAVReader::getAudioFormat() const
+{
+    return format;
+}
+
+unsigned int WAVReader::getSampleRate() const
+{
+    return sampleRate;
+}
+
+unsigned int WAVReader::getChannels() const
+{
+    return channels;
+}
+
+const uint8_t* WAVReader::getData() const
+{
+    return data;
+}
+
+uint64_t WAVReader::getDataSize() const
+{
+    return dataSize;
+}
+
+uint64_t WAVReader::getNumberOfFrames() const
+{
+    return channels == 0 ? 0 : dataSize / (getAudioFormatSize(format) * channels);
+}
+
+bool WAVReader::mapFile(const std::string& fileName)
+{
+#ifdef _WIN32
+    fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    LARGE_INTEGER fileSize;
+    if(fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        return false;
+    }
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mappingHandle == nullptr)
+    {
+        return false;
+    }
+    mapping = (const uint8_t*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    mappingSize = fileSize.QuadPart;
+    return mapping != nullptr;
+#else
+    const int file = open(fileName.c_str(), O_RDONLY);
+    if(file < 0)
+    {
+        return false;
+    }
+    struct stat fileStatus;
+    if(fstat(file, &fileStatus) != 0 || fileStatus.st_size == 0)
+    {
+        ::close(file);
+        return false;
+    }
+    void* address = mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    //the mapping stays valid after the file is closed
+    ::close(file);
+    if(address == MAP_FAILED)
+    {
+        return false;
+    }
+    //the samples are read from the start to the end
+    madvise(address, fileStatus.st_size, MADV_SEQUENTIAL);
+    mapping = (const uint8_t*)address;
+    mappingSize = fileStatus.st_size;
+    return true;
+#endif
+}
+
+void WAVReader::unmapFile()
+{
+#ifdef _WIN32
+    if(mapping != nullptr)
+    {
+        UnmapViewOfFile(mapping);
+    }
+    if(mappingHandle != nullptr)
+    {
+        CloseHandle(mappingHandle);
+    }
+    if(fileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(fileHandle);
+    }
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if(mapping != nullptr)
+    {
+        munmap((void*)mapping, mappingSize);
+    }
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+    data = nullptr;
+    dataSize = 0;
+}
+
+bool WAVReader::parseHeader()
+{
+    if(mappingSize < 12 || memcmp(mapping, "RIFF", 4) != 0 || memcmp(mapping + 8, "WAVE", 4) != 0)
+    {
+        return false;
+    }
+    bool hasFormat = false;
+    uint64_t position = 12;
+    while(position + 8 <= mappingSize)
+    {
+        const uint8_t* chunk = mapping + position;
+        const uint64_t chunkSize = readLittleEndian(chunk + 4, 4);
+        if(memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16 && position + 8 + chunkSize <= mappingSize)
+        {
+            uint16_t formatTag = readLittleEndian(chunk + 8, 2);
+            channels = readLittleEndian(chunk + 10, 2);
+            sampleRate = readLittleEndian(chunk + 12, 4);
+            const unsigned int bitsPerSample = readLittleEndian(chunk + 22, 2);
+            if(formatTag == WAVE_FORMAT_EXTENSIBLE && chunkSize >= 40)
+            {
+                //the first two bytes of the sub-format GUID are the actual format-tag
+                formatTag = readLittleEndian(chunk + 32, 2);
+            }
+            if(formatTag == WAVE_FORMAT_PCM && bitsPerSample >= 8 && bitsPerSample <= 32 && bitsPerSample % 8 == 0)
+            {
+                format = (AudioFormat)((int)AudioFormat::SIGNED_INT_8 + (int)(bitsPerSample / 8) - 1);
+            }
+            else if(formatTag == WAVE_FORMAT_IEEE_FLOAT && (bitsPerSample == 32 || bitsPerSample == 64))
+            {
+                format = bitsPerSample == 32 ? AudioFormat::FLOAT_32 : AudioFormat::FLOAT_64;
+            }
+            else
+            {
+                return false;
+            }
+            hasFormat = channels > 0 && sampleRate > 0;
+        }
+        else if(memcmp(chunk, "data", 4) == 0 && hasFormat)
+        {
+            //a file written by a crashed application may be shorter than the header states
+            const uint64_t availableSize = mappingSize - position - 8;
+            const unsigned int frameSize = getAudioFormatSize(format) * channels;
+            data = chunk + 8;
+            dataSize = (chunkSize < availableSize ? chunkSize : availableSize) / frameSize * frameSize;
+            return true;
+        }
+        //chunks are aligned to two bytes
+        position += 8 + chunkSize + (chunkSize & 1);
+    }
+    return false;
+}
@@ -0,0 +1,242 @@
+#include "WAVWriter.h"
+
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#endif
+
+//the format-tags of the fmt-chunk
+static const uint16_t WAVE_FORMAT_PCM = 0x0001;
+static const uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+static const uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+//the size of the RIFF-chunk header (tag and size), which is not included in the RIFF-size
+static const unsigned int RIFF_HEADER_SIZE = 8;
+//the minimum capacity of the ring-buffer in bytes
+static const unsigned int MINIMUM_BUFFER_SIZE = 64 * 1024;
+//the size of the block of zeroes silence is written from
+static const unsigned int SILENCE_BLOCK_SIZE = 4096;
+//the maximum size of a RIFF-file
+static const uint64_t MAXIMUM_FILE_SIZE = 0xFFFFFFFFull;
+
+static void putLittleEndian(std::vector<uint8_t>& header, const uint32_t value, const unsigned int numberOfBytes)
+{
+    for(unsigned int i = 0; i < numberOfBytes; i++)
+    {
+        header.push_back((uint8_t)(value >> (8 * i)));
+    }
+}
+
+static void putTag(std::vector<uint8_t>& header, const char* tag)
+{
+    header.insert(header.end(), tag, tag + 4);
+}
+
+WAVWriter::WAVWriter(const std::string& fileName, const AudioFormat format, const unsigned int sampleRate, const unsigned int channels,
+                     const unsigned int bufferDuration) :
+    file(nullptr), format(format), frameSize(getAudioFormatSize(format) * channels), bytesPerSecond(frameSize * sampleRate), dataSizeOffset(0),
+    ringBuffer(std::max(bytesPerSecond / 1000 * bufferDuration, MINIMUM_BUFFER_SIZE)), writeBuffer(MAXIMUM_WRITE_SIZE), writtenBytes(0),
+    droppedBytes(0), preallocatedBytes(0), threadRunning(false), writeThread()
+{
+    file = fopen(fileName.c_str(), "wb");
+    if(file == nullptr)
+    {
+        std::cerr << "[WAV-Writer-Error]Failed to open file: " << fileName << std::endl;
+        return;
+    }
+    //the samples are already collected into large blocks, so the stdio-buffer would only add another copy
+    setvbuf(file, nullptr, _IONBF, 0);
+    if(!writeHeader(sampleRate, channels))
+    {
+        std::cerr << "[WAV-Writer-Error]Failed to write header: " << fileName << std::endl;
+        fclose(file);
+        file = nullptr;
+        return;
+    }
+    threadRunning = true;
+    writeThread = std::thread(&WAVWriter::runThread, this);
+}
+
+WAVWriter::~WAVWriter()
+{
+    close();
+}
+
+bool WAVWriter::isOpen() const
+{
+    return file != nullptr;
+}
+
+bool WAVWriter::write(const void* samples, const unsigned int size)
+{
+    if(!threadRunning.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+    if(!ringBuffer.write(samples, size))
+    {
+        //the writing thread can't keep up with the audio, drop the samples instead of blocking the audio-thread
+        droppedBytes.fetch_add(size, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool WAVWriter::writeSilence(const unsigned int numberOfFrames)
+{
+    //signed zero for all formats, 8 bit samples are converted to unsigned by the writing thread
+    static const char zeroes[SILENCE_BLOCK_SIZE] = {0};
+    if(!threadRunning.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+    const unsigned int size = numberOfFrames * frameSize;
+    //only this thread writes into the ring-buffer, so the writable size can only grow until the silence is queued
+    if(ringBuffer.getWritableSize() < size)
+    {
+        droppedBytes.fetch_add(size, std::memory_order_relaxed);
+        return false;
+    }
+    for(unsigned int offset = 0; offset < size; offset += SILENCE_BLOCK_SIZE)
+    {
+        ringBuffer.write(zeroes, std::min(size - offset, SILENCE_BLOCK_SIZE));
+    }
+    return true;
+}
+
+void WAVWriter::close()
+{
+    if(writeThread.joinable())
+    {
+        threadRunning = false;
+        writeThread.join();
+    }
+    if(file != nullptr)
+    {
+        updateHeader();
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+uint64_t WAVWriter::getWrittenBytes() const
+{
+    return writtenBytes.load();
+}
+
+uint64_t WAVWriter::getDroppedBytes() const
+{
+    return droppedBytes.load();
+}
+
+bool WAVWriter::writeHeader(const unsigned int sampleRate, const unsigned int channels)
+{
+    const unsigned int bitsPerSample = getAudioFormatSize(format) * 8;
+    const bool isFloat = format == AudioFormat::FLOAT_32 || format == AudioFormat::FLOAT_64;
+    //WAVE_FORMAT_EXTENSIBLE is required for more than 16 bit or more than two channels
+    const bool isExtensible = bitsPerSample > 16 || channels > 2;
+    const uint16_t formatTag = isFloat ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM;
+
+    std::vector<uint8_t> header;
+    putTag(header, "RIFF");
+    //the sizes are set by #updateHeader()
+    putLittleEndian(header, 0, 4);
+    putTag(header, "WAVE");
+    putTag(header, "fmt ");
+    putLittleEndian(header, isExtensible ? 40 : 16, 4);
+    putLittleEndian(header, isExtensible ? WAVE_FORMAT_EXTENSIBLE : formatTag, 2);
+    putLittleEndian(header, channels, 2);
+    putLittleEndian(header, sampleRate, 4);
+    putLittleEndian(header, bytesPerSecond, 4);
+    putLittleEndian(header, frameSize, 2);
+    putLittleEndian(header, bitsPerSample, 2);
+    if(isExtensible)
+    {
+        //the size of the extension, the valid bits per sample and the speaker-positions (front left/right for stereo, front center for mono, unassigned otherwise)
+        putLittleEndian(header, 22, 2);
+        putLittleEndian(header, bitsPerSample, 2);
+        putLittleEndian(header, channels == 1 ? 0x4 : (channels == 2 ? 0x3 : 0), 4);
+        //the sub-format GUID, the format-tag followed by the fixed part 00000000-0010-8000-00AA00389B71
+        putLittleEndian(header, formatTag, 4);
+        const uint8_t guid[] = {0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+        header.insert(header.end(), guid, guid + sizeof(guid));
+    }
+    putTag(header, "data");
+    dataSizeOffset = header.size();
+    putLittleEndian(header, 0, 4);
+    return fwrite(header.data(), 1, header.size(), file) == header.size();
+}
+
+void WAVWriter::updateHeader()
+{
+    const uint64_t dataSize = writtenBytes.load();
+    std::vector<uint8_t> riffSize, chunkSize;
+    putLittleEndian(riffSize, (uint32_t)(dataSizeOffset + 4 + dataSize - RIFF_HEADER_SIZE), 4);
+    putLittleEndian(chunkSize, (uint32_t)dataSize, 4);
+    bool success = fseek(file, 4, SEEK_SET) == 0 && fwrite(riffSize.data(), 1, 4, file) == 4;
+    success = success && fseek(file, dataSizeOffset, SEEK_SET) == 0 && fwrite(chunkSize.data(), 1, 4, file) == 4;
+    success = success && fseek(file, 0, SEEK_END) == 0;
+    if(!success)
+    {
+        std::cerr << "[WAV-Writer-Error]Failed to update header!" << std::endl;
+    }
+}
+
+void WAVWriter::writeBufferedSamples()
+{
+    bool hasWritten = false;
+    //only write whole audio-frames, so the header always describes complete frames
+    const unsigned int maximumSize = MAXIMUM_WRITE_SIZE / frameSize * frameSize;
+    unsigned int size;
+    while((size = std::min(ringBuffer.getReadableSize() / frameSize * frameSize, maximumSize)) > 0)
+    {
+        ringBuffer.read(writeBuffer.data(), size);
+        if(dataSizeOffset + 4 + writtenBytes.load() + size > MAXIMUM_FILE_SIZE)
+        {
+            droppedBytes.fetch_add(size);
+            continue;
+        }
+        if(format == AudioFormat::SIGNED_INT_8)
+        {
+            //8 bit WAV-samples are unsigned
+            for(unsigned int i = 0; i < size; i++)
+            {
+                writeBuffer[i] ^= (char)0x80;
+            }
+        }
+#if defined(__linux__) && defined(FALLOC_FL_KEEP_SIZE)
+        if(writtenBytes.load() + size > preallocatedBytes)
+        {
+            //allocate the blocks without changing the file-size, so the file never contains garbage after the data-chunk
+            const uint64_t preallocationSize = std::max((uint64_t)PREALLOCATION_DURATION * bytesPerSecond, (uint64_t)size);
+            fallocate(fileno(file), FALLOC_FL_KEEP_SIZE, dataSizeOffset + 4 + preallocatedBytes, preallocationSize);
+            preallocatedBytes += preallocationSize;
+        }
+#endif
+        if(fwrite(writeBuffer.data(), 1, size, file) != size)
+        {
+            std::cerr << "[WAV-Writer-Error]Failed to write audio-data!" << std::endl;
+            droppedBytes.fetch_add(size);
+            break;
+        }
+        writtenBytes.fetch_add(size);
+        hasWritten = true;
+    }
+    if(hasWritten)
+    {
+        updateHeader();
+    }
+}
+
+void WAVWriter::runThread()
+{
+    while(threadRunning)
+    {
+        writeBufferedSamples();
+        std::this_thread::sleep_for(std::chrono::milliseconds((long)WRITE_INTERVAL));
+    }
+    //write the samples queued before the writer was closed
+    writeBufferedSamples();
+}
@@ -0,0 +1,390 @@
+#include "TestAudioInterface.h"
+
+#include <vector>
+#include <atomic>
+#include <thread>
+
+/*!
+ * AudioInterface without an audio-device, the audio-callbacks are triggered manually
+ */
+class ManualAudioInterface : public AudioInterface
+{
+public:
+    void runInput(void* buffer, unsigned int size)
+    {
+        handleAudioInput(buffer, size);
+    }
+
+    void runOutput(void* buffer, unsigned int size)
+    {
+        handleAudioOutput(buffer, size);
+    }
+
+    unsigned int getMaximumInputSize() const
+    {
+        return maxSizeWorkingBufferInput;
+    }
+
+    unsigned int getMaximumOutputSize() const
+    {
+        return maxSizeWorkingBufferOutput;
+    }
+
+    const void* getWorkingBuffer(bool input) const
+    {
+        return input ? workingBufferInput : workingBufferOutput;
+    }
+
+    const void* getAlternateBuffer(bool input) const
+    {
+        return input ? alternateBufferInput : alternateBufferOutput;
+    }
+
+protected:
+    auto vStartRecordingMode() -> void { }
+    auto vStartPlaybackMode() -> void { }
+    auto vStartDuplexMode() -> void { }
+    auto vSetConfiguration(AudioConfiguration audioConfiguration) -> void { }
+    auto vSuspend() -> void { }
+    auto vResume() -> void { }
+    auto vStop() -> void { }
+    auto vReset() -> void { }
+    auto vSetDefaultAudioConfig() -> void { }
+    auto vPrepareForExecution() -> bool { return true; }
+    auto vGetBufferSize() -> unsigned int { return static_cast<unsigned int>(audioConfiguration.bufferSize); }
+};
+
+/*!
+ * Processor recording the sizes and samples it is called with, the output is numbered consecutively
+ */
+class RecordingProcessor : public AudioProcessor
+{
+public:
+    RecordingProcessor() : AudioProcessor("Recorder"), nextOutputSample(0), inputCalls(0)
+    { }
+
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData)
+    {
+        if(userData != nullptr)
+        {
+            inputFrames.push_back(userData->nBufferFrames);
+            inputSilent.push_back(userData->isSilentPackage);
+        }
+        inputSizes.push_back(inputBufferByteSize);
+        const int16_t* samples = (const int16_t*)inputBuffer;
+        inputSamples.insert(inputSamples.end(), samples, samples + inputBufferByteSize / sizeof(int16_t));
+        inputCalls++;
+        return inputBufferByteSize;
+    }
+
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData)
+    {
+        outputSizes.push_back(outputBufferByteSize);
+        int16_t* samples = (int16_t*)outputBuffer;
+        for(unsigned int i = 0; i < outputBufferByteSize / sizeof(int16_t); i++)
+        {
+            samples[i] = nextOutputSample++;
+        }
+        return outputBufferByteSize;
+    }
+
+    std::vector<unsigned int> inputSizes;
+    //the number of frames passed in the StreamData
+    std::vector<unsigned int> inputFrames;
+    //whether the buffer was marked as silent by a previous processor
+    std::vector<bool> inputSilent;
+    std::vector<unsigned int> outputSizes;
+    std::vector<int16_t> inputSamples;
+    int16_t nextOutputSample;
+    //the input may be processed by the processing-thread
+    std::atomic<unsigned int> inputCalls;
+};
+
+/*!
+ * Out-of-place processor repeating every 32 bit sample twice, recording the buffers it is called with
+ */
+class DuplicatingProcessor : public AudioProcessor
+{
+public:
+    DuplicatingProcessor(const std::string name) : AudioProcessor(name)
+    { }
+
+    unsigned int getMaximumInputSize(const AudioConfiguration& audioConfig, const unsigned int inputBufferByteSize) const
+    {
+        return 2 * inputBufferByteSize;
+    }
+
+    unsigned int getMaximumOutputSize(const AudioConfiguration& audioConfig, const unsigned int outputBufferByteSize) const
+    {
+        return 2 * outputBufferByteSize;
+    }
+
+    bool isProcessingInPlace() const
+    {
+        return false;
+    }
+
+    unsigned int processInputDataOutOfPlace(const void *sourceBuffer, const unsigned int inputBufferByteSize, void *targetBuffer, StreamData *userData)
+    {
+        inputBuffers.push_back(std::make_pair(sourceBuffer, targetBuffer));
+        return duplicate(sourceBuffer, inputBufferByteSize, targetBuffer);
+    }
+
+    unsigned int processOutputDataOutOfPlace(const void *sourceBuffer, const unsigned int outputBufferByteSize, void *targetBuffer, StreamData *userData)
+    {
+        outputBuffers.push_back(std::make_pair(sourceBuffer, targetBuffer));
+        return duplicate(sourceBuffer, outputBufferByteSize, targetBuffer);
+    }
+
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData)
+    {
+        //never called for out-of-place processors
+        return 0;
+    }
+
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData)
+    {
+        return 0;
+    }
+
+    //the source- and target-buffers of every call
+    std::vector<std::pair<const void*, const void*>> inputBuffers;
+    std::vector<std::pair<const void*, const void*>> outputBuffers;
+
+private:
+    static unsigned int duplicate(const void* source, const unsigned int size, void* target)
+    {
+        const uint32_t* sourceSamples = (const uint32_t*)source;
+        uint32_t* targetSamples = (uint32_t*)target;
+        for(unsigned int i = 0; i < size / sizeof(uint32_t); i++)
+        {
+            targetSamples[2 * i] = sourceSamples[i];
+            targetSamples[2 * i + 1] = sourceSamples[i];
+        }
+        return 2 * size;
+    }
+};
+
+/*!
+ * Processor marking input-buffers starting with a zero-sample as silent, like the processors accessing the StreamData do
+ */
+class SilenceMarkingProcessor : public AudioProcessor
+{
+public:
+    SilenceMarkingProcessor() : AudioProcessor("SilenceMarker")
+    { }
+
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData)
+    {
+        if(((const int16_t*)inputBuffer)[0] == 0)
+        {
+            userData->isSilentPackage = true;
+        }
+        return inputBufferByteSize;
+    }
+
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData)
+    {
+        return outputBufferByteSize;
+    }
+};
+
+static AudioConfiguration createConfiguration()
+{
+    AudioConfiguration audioConfig = {0};
+    audioConfig.inputDeviceChannels = 1;
+    audioConfig.outputDeviceChannels = 1;
+    audioConfig.sampleRate = 48000;
+    audioConfig.bufferSize = BufferSizes::BUFFER_256;
+    audioConfig.audioFormat = AudioFormat::SIGNED_INT_16;
+    return audioConfig;
+}
+
+TestAudioInterface::TestAudioInterface()
+{
+    TEST_ADD(TestAudioInterface::testWithoutReblocking);
+    TEST_ADD(TestAudioInterface::testReblockingInput);
+    TEST_ADD(TestAudioInterface::testReblockingOutput);
+    TEST_ADD(TestAudioInterface::testPipelinedStreamData);
+    TEST_ADD(TestAudioInterface::testOutOfPlaceBuffers);
+    TEST_ADD(TestAudioInterface::testStreamDataWithoutPipeline);
+}
+
+void TestAudioInterface::testWithoutReblocking()
+{
+    ManualAudioInterface audioInterface;
+    RecordingProcessor* processor = new RecordingProcessor();
+    audioInterface.addProcessor(processor);
+    audioInterface.setConfiguration(createConfiguration());
+    TEST_ASSERT(audioInterface.prepareForExecution());
+
+    std::vector<int16_t> buffer(256);
+    audioInterface.runInput(buffer.data(), 256 * sizeof(int16_t));
+    audioInterface.runOutput(buffer.data(), 256 * sizeof(int16_t));
+    TEST_ASSERT_EQUALS(1u, processor->inputSizes.size());
+    TEST_ASSERT_EQUALS(256 * sizeof(int16_t), processor->inputSizes[0]);
+    TEST_ASSERT_EQUALS(1u, processor->outputSizes.size());
+}
+
+void TestAudioInterface::testReblockingInput()
+{
+    ManualAudioInterface audioInterface;
+    RecordingProcessor* processor = new RecordingProcessor();
+    audioInterface.addProcessor(processor);
+    audioInterface.setConfiguration(createConfiguration());
+    //20 ms at 48 kHz
+    audioInterface.setProcessingFrames(960);
+    TEST_ASSERT(audioInterface.prepareForExecution());
+
+    std::vector<int16_t> buffer(256);
+    int16_t sample = 0;
+    for(unsigned int i = 0; i < 15; i++)
+    {
+        for(int16_t& s : buffer)
+        {
+            s = sample++;
+        }
+        audioInterface.runInput(buffer.data(), 256 * sizeof(int16_t));
+    }
+    //15 * 256 = 4 * 960 frames
+    TEST_ASSERT_EQUALS(4u, processor->inputSizes.size());
+    for(const unsigned int size : processor->inputSizes)
+    {
+        TEST_ASSERT_EQUALS(960 * sizeof(int16_t), size);
+    }
+    //the samples are passed in order without gaps
+    TEST_ASSERT_EQUALS(4u * 960, processor->inputSamples.size());
+    for(unsigned int i = 0; i < processor->inputSamples.size(); i++)
+    {
+        TEST_ASSERT_EQUALS((int16_t)i, processor->inputSamples[i]);
+    }
+}
+
+void TestAudioInterface::testReblockingOutput()
+{
+    ManualAudioInterface audioInterface;
+    RecordingProcessor* processor = new RecordingProcessor();
+    audioInterface.addProcessor(processor);
+    audioInterface.setConfiguration(createConfiguration());
+    audioInterface.setProcessingFrames(960);
+    TEST_ASSERT(audioInterface.prepareForExecution());
+
+    std::vector<int16_t> buffer(256);
+    std::vector<int16_t> played;
+    for(unsigned int i = 0; i < 15; i++)
+    {
+        audioInterface.runOutput(buffer.data(), 256 * sizeof(int16_t));
+        played.insert(played.end(), buffer.begin(), buffer.end());
+        //a block is only processed, if the FIFO does not hold enough samples for the device
+        TEST_ASSERT_EQUALS(((i + 1) * 256 + 959) / 960, processor->outputSizes.size());
+    }
+    for(unsigned int i = 0; i < played.size(); i++)
+    {
+        TEST_ASSERT_EQUALS((int16_t)i, played[i]);
+    }
+}
+
+void TestAudioInterface::testPipelinedStreamData()
+{
+    ManualAudioInterface audioInterface;
+    RecordingProcessor* processor = new RecordingProcessor();
+    audioInterface.addProcessor(processor);
+    audioInterface.setConfiguration(createConfiguration());
+    audioInterface.setProcessingFrames(960);
+    audioInterface.setPipelinedProcessing(true);
+    audioInterface.startRecordingMode();
+
+    std::vector<int16_t> buffer(256);
+    for(unsigned int i = 0; i < 15; i++)
+    {
+        audioInterface.runInput(buffer.data(), 256 * sizeof(int16_t));
+    }
+    //wait for the processing-thread to process all 4 blocks
+    for(unsigned int i = 0; i < 1000 && processor->inputCalls < 4; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    audioInterface.stop();
+    //the processing-thread passes the size of the blocks to the processors
+    TEST_ASSERT_EQUALS(4u, processor->inputFrames.size());
+    for(const unsigned int frames : processor->inputFrames)
+    {
+        TEST_ASSERT_EQUALS(960u, frames);
+    }
+}
+
+void TestAudioInterface::testOutOfPlaceBuffers()
+{
+    ManualAudioInterface audioInterface;
+    DuplicatingProcessor* first = new DuplicatingProcessor("First");
+    DuplicatingProcessor* second = new DuplicatingProcessor("Second");
+    RecordingProcessor* recorder = new RecordingProcessor();
+    audioInterface.addProcessor(first);
+    audioInterface.addProcessor(second);
+    audioInterface.addProcessor(recorder);
+    AudioConfiguration audioConfig = createConfiguration();
+    //the size of a sample differs from the value of the enum
+    audioConfig.audioFormat = AudioFormat::FLOAT_32;
+    audioInterface.setConfiguration(audioConfig);
+    TEST_ASSERT(audioInterface.prepareForExecution());
+
+    //256 frames of 4 bytes, enlarged twice by factor 2
+    TEST_ASSERT_EQUALS(256u * 4 * 4, audioInterface.getMaximumInputSize());
+    TEST_ASSERT_EQUALS(256u * 4 * 4, audioInterface.getMaximumOutputSize());
+    for(const bool input : {true, false})
+    {
+        TEST_ASSERT(audioInterface.getWorkingBuffer(input) != nullptr);
+        TEST_ASSERT(audioInterface.getAlternateBuffer(input) != nullptr);
+        TEST_ASSERT(audioInterface.getWorkingBuffer(input) != audioInterface.getAlternateBuffer(input));
+    }
+
+    std::vector<uint32_t> buffer(256);
+    for(unsigned int i = 0; i < buffer.size(); i++)
+    {
+        buffer[i] = i;
+    }
+    audioInterface.runInput(buffer.data(), 256 * 4);
+    //the processors alternate between the working-buffer and the alternate buffer
+    const void* workingBuffer = audioInterface.getWorkingBuffer(true);
+    const void* alternateBuffer = audioInterface.getAlternateBuffer(true);
+    TEST_ASSERT_EQUALS(1u, first->inputBuffers.size());
+    TEST_ASSERT(first->inputBuffers[0] == std::make_pair(workingBuffer, alternateBuffer));
+    TEST_ASSERT(second->inputBuffers[0] == std::make_pair(alternateBuffer, workingBuffer));
+    //the in-place processor gets the result of the out-of-place processors
+    TEST_ASSERT_EQUALS(256u * 4 * 4, recorder->inputSizes[0]);
+    const uint32_t* processedSamples = (const uint32_t*)workingBuffer;
+    for(unsigned int i = 0; i < 4 * buffer.size(); i++)
+    {
+        TEST_ASSERT_EQUALS(i / 4, processedSamples[i]);
+    }
+
+    //the output is processed in reverse order
+    audioInterface.runOutput(buffer.data(), 256 * 4);
+    workingBuffer = audioInterface.getWorkingBuffer(false);
+    alternateBuffer = audioInterface.getAlternateBuffer(false);
+    TEST_ASSERT_EQUALS(256u * 4, recorder->outputSizes[0]);
+    TEST_ASSERT(second->outputBuffers[0] == std::make_pair(workingBuffer, alternateBuffer));
+    TEST_ASSERT(first->outputBuffers[0] == std::make_pair(alternateBuffer, workingBuffer));
+}
+
+void TestAudioInterface::testStreamDataWithoutPipeline()
+{
+    ManualAudioInterface audioInterface;
+    RecordingProcessor* recorder = new RecordingProcessor();
+    audioInterface.addProcessor(new SilenceMarkingProcessor());
+    audioInterface.addProcessor(recorder);
+    audioInterface.setConfiguration(createConfiguration());
+    TEST_ASSERT(audioInterface.prepareForExecution());
+
+    std::vector<int16_t> buffer(256, 0);
+    audioInterface.runInput(buffer.data(), 256 * sizeof(int16_t));
+    buffer[0] = 1;
+    audioInterface.runInput(buffer.data(), 256 * sizeof(int16_t));
+    //the audio-callback passes its own StreamData to the processors
+    TEST_ASSERT_EQUALS(2u, recorder->inputFrames.size());
+    TEST_ASSERT_EQUALS(256u, recorder->inputFrames[0]);
+    TEST_ASSERT_EQUALS(256u, recorder->inputFrames[1]);
+    //the silence-flag is reset for every buffer
+    TEST_ASSERT(recorder->inputSilent[0]);
+    TEST_ASSERT(!recorder->inputSilent[1]);
+}
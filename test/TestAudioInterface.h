@@ -0,0 +1,20 @@
+#ifndef TESTAUDIOINTERFACE_H
+#define TESTAUDIOINTERFACE_H
+
+#include "cpptest.h"
+#include "AudioInterface.h"
+
+class TestAudioInterface : public Test::Suite
+{
+public:
+    TestAudioInterface();
+
+    void testWithoutReblocking();
+    void testReblockingInput();
+    void testReblockingOutput();
+    void testPipelinedStreamData();
+    void testOutOfPlaceBuffers();
+    void testStreamDataWithoutPipeline();
+};
+
+#endif // TESTAUDIOINTERFACE_H
@@ -0,0 +1,83 @@
+#include "TestAudioRingBuffer.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+TestAudioRingBuffer::TestAudioRingBuffer()
+{
+    TEST_ADD(TestAudioRingBuffer::testCapacity);
+    TEST_ADD(TestAudioRingBuffer::testWrapAround);
+    TEST_ADD(TestAudioRingBuffer::testConcurrentReadWrite);
+}
+
+void TestAudioRingBuffer::testCapacity()
+{
+    AudioRingBuffer ring(1000);
+    TEST_ASSERT_EQUALS(1024u, ring.getCapacity());
+    std::vector<char> data(1024, 'a');
+    TEST_ASSERT(ring.write(data.data(), 1000));
+    //no partial writes
+    TEST_ASSERT(!ring.write(data.data(), 25));
+    TEST_ASSERT(ring.write(data.data(), 24));
+    TEST_ASSERT_EQUALS(0u, ring.getWritableSize());
+    //no partial reads
+    TEST_ASSERT(!ring.read(data.data(), 1025));
+    TEST_ASSERT(ring.read(data.data(), 1024));
+    TEST_ASSERT_EQUALS(0u, ring.getReadableSize());
+}
+
+void TestAudioRingBuffer::testWrapAround()
+{
+    AudioRingBuffer ring(64);
+    char input[48];
+    char output[48];
+    for(unsigned int round = 0; round < 10; round++)
+    {
+        for(unsigned int i = 0; i < sizeof(input); i++)
+        {
+            input[i] = (char)(round * sizeof(input) + i);
+        }
+        //every second write wraps around the end of the buffer
+        TEST_ASSERT(ring.write(input, sizeof(input)));
+        TEST_ASSERT(ring.read(output, sizeof(output)));
+        TEST_ASSERT(memcmp(input, output, sizeof(input)) == 0);
+    }
+}
+
+void TestAudioRingBuffer::testConcurrentReadWrite()
+{
+    AudioRingBuffer ring(256);
+    const unsigned int blockSize = 40;
+    const unsigned int numberOfBlocks = 10000;
+    std::thread writer([&ring, blockSize, numberOfBlocks]()
+    {
+        uint32_t block[blockSize / sizeof(uint32_t)];
+        for(uint32_t i = 0; i < numberOfBlocks; i++)
+        {
+            for(uint32_t& value : block)
+            {
+                value = i;
+            }
+            while(!ring.write(block, blockSize))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint32_t block[blockSize / sizeof(uint32_t)];
+    bool inOrder = true;
+    for(uint32_t i = 0; i < numberOfBlocks; i++)
+    {
+        while(!ring.read(block, blockSize))
+        {
+            std::this_thread::yield();
+        }
+        for(const uint32_t value : block)
+        {
+            inOrder = inOrder && value == i;
+        }
+    }
+    writer.join();
+    TEST_ASSERT_MSG(inOrder, "Data was corrupted or reordered!");
+}
@@ -0,0 +1,17 @@
+#ifndef TESTAUDIORINGBUFFER_H
+#define TESTAUDIORINGBUFFER_H
+
+#include "cpptest.h"
+#include "AudioRingBuffer.h"
+
+class TestAudioRingBuffer : public Test::Suite
+{
+public:
+    TestAudioRingBuffer();
+
+    void testCapacity();
+    void testWrapAround();
+    void testConcurrentReadWrite();
+};
+
+#endif // TESTAUDIORINGBUFFER_H
@@ -0,0 +1,58 @@
+#include "TestComfortNoise.h"
+
+#include <vector>
+
+TestComfortNoise::TestComfortNoise()
+{
+    TEST_ADD(TestComfortNoise::testNoiseLevelReference);
+    TEST_ADD(TestComfortNoise::testNoiseLevelSilence);
+    TEST_ADD(TestComfortNoise::testGeneratedNoiseLevel);
+}
+
+void TestComfortNoise::testNoiseLevelReference()
+{
+    //a full-scale square-wave is 0 dBov
+    std::vector<int16_t> samples(480);
+    for(unsigned int i = 0; i < samples.size(); i++)
+    {
+        samples[i] = (i / 20) % 2 == 0 ? 32767 : -32767;
+    }
+    TEST_ASSERT_EQUALS(0, ComfortNoise::calculateNoiseLevel(samples.data(), samples.size()));
+
+    //halving the amplitude reduces the level by 6 dB
+    for(unsigned int i = 0; i < samples.size(); i++)
+    {
+        samples[i] /= 2;
+    }
+    TEST_ASSERT_EQUALS(6, ComfortNoise::calculateNoiseLevel(samples.data(), samples.size()));
+
+    std::vector<float> floatSamples(480, 0.1f);
+    TEST_ASSERT_EQUALS(20, ComfortNoise::calculateNoiseLevel(floatSamples.data(), floatSamples.size()));
+}
+
+void TestComfortNoise::testNoiseLevelSilence()
+{
+    std::vector<int16_t> samples(480, 0);
+    TEST_ASSERT_EQUALS(127, ComfortNoise::calculateNoiseLevel(samples.data(), samples.size()));
+    TEST_ASSERT_EQUALS(127, ComfortNoise::calculateNoiseLevel(samples.data(), 0));
+}
+
+void TestComfortNoise::testGeneratedNoiseLevel()
+{
+    ComfortNoise noise;
+    std::vector<int16_t> samples(4800);
+    std::vector<float> floatSamples(4800);
+    for(const uint8_t level : {10, 30, 50, 70})
+    {
+        //the first buffer fades from the previous level
+        noise.generate(samples.data(), samples.size(), level);
+        noise.generate(samples.data(), samples.size(), level);
+        const int difference = (int)ComfortNoise::calculateNoiseLevel(samples.data(), samples.size()) - level;
+        TEST_ASSERT_MSG(difference >= -1 && difference <= 1, "Generated noise has wrong level!");
+
+        noise.generate(floatSamples.data(), floatSamples.size(), level);
+        noise.generate(floatSamples.data(), floatSamples.size(), level);
+        const int floatDifference = (int)ComfortNoise::calculateNoiseLevel(floatSamples.data(), floatSamples.size()) - level;
+        TEST_ASSERT_MSG(floatDifference >= -1 && floatDifference <= 1, "Generated noise has wrong level!");
+    }
+}
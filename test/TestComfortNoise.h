@@ -0,0 +1,17 @@
+#ifndef TESTCOMFORTNOISE_H
+#define TESTCOMFORTNOISE_H
+
+#include "cpptest.h"
+#include "ComfortNoise.h"
+
+class TestComfortNoise : public Test::Suite
+{
+public:
+    TestComfortNoise();
+
+    void testNoiseLevelReference();
+    void testNoiseLevelSilence();
+    void testGeneratedNoiseLevel();
+};
+
+#endif // TESTCOMFORTNOISE_H
@@ -0,0 +1,154 @@
+#include "TestFileAudioWrapper.h"
+
+#include <cstdio>
+#include <chrono>
+#include <vector>
+
+static const char* INPUT_FILE_NAME = "TestFileAudioInput.wav";
+static const char* OUTPUT_FILE_NAME = "TestFileAudioOutput.wav";
+
+/*!
+ * Processor playing back the samples it recorded
+ */
+class LoopbackProcessor : public AudioProcessor
+{
+public:
+    LoopbackProcessor() : AudioProcessor("Loopback")
+    { }
+
+    unsigned int processInputData(void *inputBuffer, const unsigned int inputBufferByteSize, StreamData *userData)
+    {
+        const int16_t* samples = (const int16_t*)inputBuffer;
+        inputSamples.insert(inputSamples.end(), samples, samples + inputBufferByteSize / sizeof(int16_t));
+        return inputBufferByteSize;
+    }
+
+    unsigned int processOutputData(void *outputBuffer, const unsigned int outputBufferByteSize, StreamData *userData)
+    {
+        int16_t* samples = (int16_t*)outputBuffer;
+        for(unsigned int i = 0; i < outputBufferByteSize / sizeof(int16_t); i++)
+        {
+            samples[i] = outputPosition < inputSamples.size() ? inputSamples[outputPosition] : 0;
+            outputPosition++;
+        }
+        return outputBufferByteSize;
+    }
+
+    std::vector<int16_t> inputSamples;
+    size_t outputPosition = 0;
+};
+
+static AudioConfiguration createConfiguration(const unsigned int channels)
+{
+    AudioConfiguration audioConfig = {0};
+    audioConfig.inputDeviceChannels = channels;
+    audioConfig.outputDeviceChannels = channels;
+    audioConfig.sampleRate = 48000;
+    audioConfig.bufferSize = BufferSizes::BUFFER_256;
+    audioConfig.audioFormat = AudioFormat::SIGNED_INT_16;
+    return audioConfig;
+}
+
+static std::vector<int16_t> writeInputFile(const unsigned int numberOfSamples)
+{
+    std::vector<int16_t> samples(numberOfSamples);
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        samples[i] = (int16_t)(i * 31);
+    }
+    WAVWriter writer(INPUT_FILE_NAME, AudioFormat::SIGNED_INT_16, 48000, 1);
+    writer.write(samples.data(), samples.size() * sizeof(int16_t));
+    return samples;
+}
+
+TestFileAudioWrapper::TestFileAudioWrapper()
+{
+    TEST_ADD(TestFileAudioWrapper::testWAVReader);
+    TEST_ADD(TestFileAudioWrapper::testAsFastAsPossible);
+    TEST_ADD(TestFileAudioWrapper::testRealTime);
+    TEST_ADD(TestFileAudioWrapper::testMismatchingFile);
+}
+
+void TestFileAudioWrapper::testWAVReader()
+{
+    std::vector<uint8_t> samples(3 * 2 * 100);
+    for(unsigned int i = 0; i < samples.size(); i++)
+    {
+        samples[i] = (uint8_t)(i * 7);
+    }
+    {
+        //with the WAVE_FORMAT_EXTENSIBLE header
+        WAVWriter writer(INPUT_FILE_NAME, AudioFormat::SIGNED_INT_24, 96000, 2);
+        writer.write(samples.data(), samples.size());
+    }
+    WAVReader reader(INPUT_FILE_NAME);
+    TEST_ASSERT(reader.isOpen());
+    TEST_ASSERT(AudioFormat::SIGNED_INT_24 == reader.getAudioFormat());
+    TEST_ASSERT_EQUALS(96000u, reader.getSampleRate());
+    TEST_ASSERT_EQUALS(2u, reader.getChannels());
+    TEST_ASSERT_EQUALS(100u, reader.getNumberOfFrames());
+    TEST_ASSERT_EQUALS(samples.size(), reader.getDataSize());
+    TEST_ASSERT(std::equal(samples.begin(), samples.end(), reader.getData()));
+    remove(INPUT_FILE_NAME);
+
+    WAVReader missingFile(INPUT_FILE_NAME);
+    TEST_ASSERT(!missingFile.isOpen());
+}
+
+void TestFileAudioWrapper::testAsFastAsPossible()
+{
+    //4 buffers, the last one only partially
+    const std::vector<int16_t> samples = writeInputFile(1000);
+    {
+        FileAudioWrapper audioInterface(INPUT_FILE_NAME, OUTPUT_FILE_NAME, FileAudioWrapper::Pacing::AS_FAST_AS_POSSIBLE);
+        LoopbackProcessor* processor = new LoopbackProcessor();
+        audioInterface.addProcessor(processor);
+        audioInterface.setConfiguration(createConfiguration(1));
+        audioInterface.startDuplexMode();
+        audioInterface.waitForEnd();
+        TEST_ASSERT_EQUALS(1024u, audioInterface.getProcessedFrames());
+        TEST_ASSERT_EQUALS(1024u, processor->inputSamples.size());
+        TEST_ASSERT(std::equal(samples.begin(), samples.end(), processor->inputSamples.begin()));
+        audioInterface.stop();
+    }
+    WAVReader output(OUTPUT_FILE_NAME);
+    TEST_ASSERT(output.isOpen());
+    TEST_ASSERT_EQUALS(1024u, output.getNumberOfFrames());
+    const int16_t* outputSamples = (const int16_t*)output.getData();
+    TEST_ASSERT(std::equal(samples.begin(), samples.end(), outputSamples));
+    //the last buffer is filled up with silence
+    TEST_ASSERT_EQUALS(0, outputSamples[1023]);
+    remove(INPUT_FILE_NAME);
+    remove(OUTPUT_FILE_NAME);
+}
+
+void TestFileAudioWrapper::testRealTime()
+{
+    //10 buffers of 256 frames at 48 kHz take 53 ms
+    writeInputFile(2560);
+    FileAudioWrapper audioInterface(INPUT_FILE_NAME, "", FileAudioWrapper::Pacing::REAL_TIME);
+    audioInterface.setConfiguration(createConfiguration(1));
+    const auto start = std::chrono::steady_clock::now();
+    audioInterface.startRecordingMode();
+    audioInterface.waitForEnd();
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    audioInterface.stop();
+    TEST_ASSERT_EQUALS(2560u, audioInterface.getProcessedFrames());
+    //the first buffer is processed immediately
+    TEST_ASSERT(duration >= 45);
+    remove(INPUT_FILE_NAME);
+}
+
+void TestFileAudioWrapper::testMismatchingFile()
+{
+    writeInputFile(1000);
+    FileAudioWrapper audioInterface(INPUT_FILE_NAME, "", FileAudioWrapper::Pacing::AS_FAST_AS_POSSIBLE);
+    //the file has only one channel
+    audioInterface.setConfiguration(createConfiguration(2));
+    audioInterface.startRecordingMode();
+    //does not block, since the processing was not started
+    audioInterface.waitForEnd();
+    TEST_ASSERT_EQUALS(0u, audioInterface.getProcessedFrames());
+    audioInterface.stop();
+    remove(INPUT_FILE_NAME);
+}
@@ -0,0 +1,18 @@
+#ifndef TESTFILEAUDIOWRAPPER_H
+#define TESTFILEAUDIOWRAPPER_H
+
+#include "cpptest.h"
+#include "FileAudioWrapper.h"
+
+class TestFileAudioWrapper : public Test::Suite
+{
+public:
+    TestFileAudioWrapper();
+
+    void testWAVReader();
+    void testAsFastAsPossible();
+    void testRealTime();
+    void testMismatchingFile();
+};
+
+#endif // TESTFILEAUDIOWRAPPER_H
@@ -0,0 +1,146 @@
+#include "TestFormatConverter.h"
+
+#include <vector>
+#include <cmath>
+#include <string.h>
+
+TestFormatConverter::TestFormatConverter()
+{
+    TEST_ADD(TestFormatConverter::testInvalidConversion);
+    TEST_ADD(TestFormatConverter::testScalarConversion);
+    TEST_ADD(TestFormatConverter::testInt24Conversion);
+    TEST_ADD(TestFormatConverter::testVectorizedConversion);
+    TEST_ADD(TestFormatConverter::testDitheredConversion);
+}
+
+void TestFormatConverter::testInvalidConversion()
+{
+    TEST_ASSERT(FormatConverter(AudioFormat::SIGNED_INT_16, AudioFormat::FLOAT_32).isValid());
+    TEST_ASSERT(FormatConverter(AudioFormat::SIGNED_INT_8, AudioFormat::SIGNED_INT_8).isValid());
+    TEST_ASSERT(!FormatConverter(AudioFormat::SIGNED_INT_8, AudioFormat::FLOAT_32).isValid());
+    TEST_ASSERT(!FormatConverter(AudioFormat::SIGNED_INT_16, AudioFormat::FLOAT_64).isValid());
+}
+
+void TestFormatConverter::testScalarConversion()
+{
+    const int16_t samples[] = {0, 16384, -16384, 32767, -32768};
+    float floatSamples[5];
+    FormatConverter toFloat(AudioFormat::SIGNED_INT_16, AudioFormat::FLOAT_32, FormatConverter::InstructionSet::SCALAR);
+    toFloat.convert(samples, floatSamples, 5);
+    TEST_ASSERT_EQUALS(0.0f, floatSamples[0]);
+    TEST_ASSERT_EQUALS(0.5f, floatSamples[1]);
+    TEST_ASSERT_EQUALS(-0.5f, floatSamples[2]);
+    TEST_ASSERT_EQUALS(-1.0f, floatSamples[4]);
+
+    //values out of range are saturated
+    const float clipped[] = {1.5f, -1.5f, 0.25f, 1.0f, -1.0f};
+    int16_t intSamples[5];
+    FormatConverter toInt16(AudioFormat::FLOAT_32, AudioFormat::SIGNED_INT_16, FormatConverter::InstructionSet::SCALAR);
+    toInt16.convert(clipped, intSamples, 5);
+    TEST_ASSERT_EQUALS(32767, intSamples[0]);
+    TEST_ASSERT_EQUALS(-32768, intSamples[1]);
+    TEST_ASSERT_EQUALS(8192, intSamples[2]);
+    TEST_ASSERT_EQUALS(32767, intSamples[3]);
+    TEST_ASSERT_EQUALS(-32768, intSamples[4]);
+
+    int32_t int32Samples[5];
+    FormatConverter toInt32(AudioFormat::FLOAT_32, AudioFormat::SIGNED_INT_32, FormatConverter::InstructionSet::SCALAR);
+    toInt32.convert(clipped, int32Samples, 5);
+    TEST_ASSERT_EQUALS(2147483520, int32Samples[0]);
+    TEST_ASSERT_EQUALS(INT32_MIN, int32Samples[1]);
+    TEST_ASSERT_EQUALS(1 << 29, int32Samples[2]);
+}
+
+void TestFormatConverter::testInt24Conversion()
+{
+    //0x123456 and -2 (0xFFFFFE), little endian
+    const uint8_t samples[] = {0x56, 0x34, 0x12, 0xFE, 0xFF, 0xFF};
+    int32_t intSamples[2];
+    FormatConverter toInt32(AudioFormat::SIGNED_INT_24, AudioFormat::SIGNED_INT_32, FormatConverter::InstructionSet::SCALAR);
+    toInt32.convert(samples, intSamples, 2);
+    TEST_ASSERT_EQUALS(0x12345600, intSamples[0]);
+    TEST_ASSERT_EQUALS(-2 * 256, intSamples[1]);
+
+    uint8_t packed[6];
+    FormatConverter toInt24(AudioFormat::SIGNED_INT_32, AudioFormat::SIGNED_INT_24, FormatConverter::InstructionSet::SCALAR);
+    toInt24.convert(intSamples, packed, 2);
+    TEST_ASSERT_EQUALS(0, memcmp(samples, packed, sizeof(samples)));
+
+    const float floatSamples[] = {0.5f, -1.0f};
+    FormatConverter floatToInt24(AudioFormat::FLOAT_32, AudioFormat::SIGNED_INT_24, FormatConverter::InstructionSet::SCALAR);
+    floatToInt24.convert(floatSamples, packed, 2);
+    const uint8_t expected[] = {0x00, 0x00, 0x40, 0x00, 0x00, 0x80};
+    TEST_ASSERT_EQUALS(0, memcmp(expected, packed, sizeof(expected)));
+}
+
+//the vectorized conversions must yield the same results as the scalar ones
+template<typename Source>
+static bool compareInstructionSets(const AudioFormat sourceFormat, const AudioFormat targetFormat, const std::vector<Source>& samples, const unsigned int numberOfSamples)
+{
+    const unsigned int targetSize = numberOfSamples * getAudioFormatSize(targetFormat);
+    std::vector<uint8_t> expected(targetSize);
+    FormatConverter(sourceFormat, targetFormat, FormatConverter::InstructionSet::SCALAR).convert(samples.data(), expected.data(), numberOfSamples);
+    for(const FormatConverter::InstructionSet set : {FormatConverter::InstructionSet::SSE2, FormatConverter::InstructionSet::AVX2, FormatConverter::InstructionSet::NEON})
+    {
+        std::vector<uint8_t> result(targetSize);
+        FormatConverter converter(sourceFormat, targetFormat, set);
+        converter.convert(samples.data(), result.data(), numberOfSamples);
+        if(expected != result)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TestFormatConverter::testVectorizedConversion()
+{
+    //odd number of samples to also test the remainders
+    const unsigned int numberOfSamples = 1003;
+    std::vector<int16_t> int16Samples(numberOfSamples);
+    std::vector<int32_t> int32Samples(numberOfSamples);
+    std::vector<float> floatSamples(numberOfSamples);
+    std::vector<uint8_t> int24Samples(numberOfSamples * 3);
+    uint32_t random = 12345;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        random = random * 1664525 + 1013904223;
+        int32Samples[i] = (int32_t)random;
+        int16Samples[i] = (int16_t)(random >> 16);
+        //includes values out of range
+        floatSamples[i] = (int32_t)random / 1073741824.0f;
+        int24Samples[3 * i] = (uint8_t)random;
+        int24Samples[3 * i + 1] = (uint8_t)(random >> 8);
+        int24Samples[3 * i + 2] = (uint8_t)(random >> 16);
+    }
+    TEST_ASSERT(compareInstructionSets(AudioFormat::SIGNED_INT_16, AudioFormat::FLOAT_32, int16Samples, numberOfSamples));
+    TEST_ASSERT(compareInstructionSets(AudioFormat::FLOAT_32, AudioFormat::SIGNED_INT_16, floatSamples, numberOfSamples));
+    TEST_ASSERT(compareInstructionSets(AudioFormat::SIGNED_INT_32, AudioFormat::FLOAT_32, int32Samples, numberOfSamples));
+    TEST_ASSERT(compareInstructionSets(AudioFormat::FLOAT_32, AudioFormat::SIGNED_INT_32, floatSamples, numberOfSamples));
+    TEST_ASSERT(compareInstructionSets(AudioFormat::SIGNED_INT_24, AudioFormat::SIGNED_INT_32, int24Samples, numberOfSamples));
+    TEST_ASSERT(compareInstructionSets(AudioFormat::SIGNED_INT_32, AudioFormat::SIGNED_INT_24, int32Samples, numberOfSamples));
+    TEST_ASSERT(compareInstructionSets(AudioFormat::SIGNED_INT_24, AudioFormat::FLOAT_32, int24Samples, numberOfSamples));
+    TEST_ASSERT(compareInstructionSets(AudioFormat::FLOAT_32, AudioFormat::SIGNED_INT_24, floatSamples, numberOfSamples));
+    TEST_ASSERT(compareInstructionSets(AudioFormat::FLOAT_32, AudioFormat::FLOAT_64, floatSamples, numberOfSamples));
+}
+
+void TestFormatConverter::testDitheredConversion()
+{
+    const unsigned int numberOfSamples = 1003;
+    std::vector<double> samples(numberOfSamples, 0.25);
+    std::vector<float> result(numberOfSamples);
+    FormatConverter converter(AudioFormat::FLOAT_64, AudioFormat::FLOAT_32);
+    converter.convert(samples.data(), result.data(), numberOfSamples);
+    double sum = 0;
+    bool isDithered = false;
+    for(unsigned int i = 0; i < numberOfSamples; i++)
+    {
+        //the dither must not exceed one LSB of 24 bit audio
+        TEST_ASSERT(std::fabs(result[i] - 0.25) <= 1.0 / 8388608.0);
+        isDithered |= result[i] != 0.25f;
+        sum += result[i];
+    }
+    TEST_ASSERT(isDithered);
+    //the dither has no DC-offset
+    TEST_ASSERT(std::fabs(sum / numberOfSamples - 0.25) < 1.0 / 8388608.0 / 10);
+}
@@ -0,0 +1,19 @@
+#ifndef TESTFORMATCONVERTER_H
+#define TESTFORMATCONVERTER_H
+
+#include "cpptest.h"
+#include "FormatConverter.h"
+
+class TestFormatConverter : public Test::Suite
+{
+public:
+    TestFormatConverter();
+
+    void testInvalidConversion();
+    void testScalarConversion();
+    void testInt24Conversion();
+    void testVectorizedConversion();
+    void testDitheredConversion();
+};
+
+#endif // TESTFORMATCONVERTER_H
@@ -0,0 +1,119 @@
+#include "TestG711.h"
+
+#include <vector>
+#include <cstdlib>
+
+TestG711::TestG711()
+{
+    TEST_ADD(TestG711::testReferenceValues);
+    TEST_ADD(TestG711::testVectorizedEncoding);
+    TEST_ADD(TestG711::testRoundTrip);
+    TEST_ADD(TestG711::testInPlace);
+}
+
+//all 65536 possible samples
+static std::vector<int16_t> createAllSamples()
+{
+    std::vector<int16_t> samples(65536);
+    for(unsigned int i = 0; i < samples.size(); i++)
+    {
+        samples[i] = (int16_t)(i - 32768);
+    }
+    return samples;
+}
+
+void TestG711::testReferenceValues()
+{
+    //values of the ITU-T G.191 reference implementation
+    TEST_ASSERT_EQUALS(0xFF, G711::encodeMuLaw(0));
+    TEST_ASSERT_EQUALS(0x7F, G711::encodeMuLaw(-1));
+    TEST_ASSERT_EQUALS(0x80, G711::encodeMuLaw(32767));
+    TEST_ASSERT_EQUALS(0x00, G711::encodeMuLaw(-32768));
+    TEST_ASSERT_EQUALS(0xD5, G711::encodeALaw(0));
+    TEST_ASSERT_EQUALS(0x55, G711::encodeALaw(-1));
+    TEST_ASSERT_EQUALS(0xAA, G711::encodeALaw(32767));
+    TEST_ASSERT_EQUALS(0x2A, G711::encodeALaw(-32768));
+
+    const G711 muLaw(G711::Law::MU_LAW, FormatConverter::InstructionSet::SCALAR);
+    const G711 aLaw(G711::Law::A_LAW, FormatConverter::InstructionSet::SCALAR);
+    const uint8_t codes[4] = {0xFF, 0x80, 0xD5, 0xAA};
+    int16_t samples[4];
+    muLaw.decode(codes, samples, 2);
+    aLaw.decode(codes + 2, samples + 2, 2);
+    TEST_ASSERT_EQUALS(0, samples[0]);
+    TEST_ASSERT_EQUALS(32124, samples[1]);
+    TEST_ASSERT_EQUALS(8, samples[2]);
+    TEST_ASSERT_EQUALS(32256, samples[3]);
+}
+
+void TestG711::testVectorizedEncoding()
+{
+    const std::vector<int16_t> samples = createAllSamples();
+    for(const G711::Law law : {G711::Law::MU_LAW, G711::Law::A_LAW})
+    {
+        const G711 scalar(law, FormatConverter::InstructionSet::SCALAR);
+        std::vector<uint8_t> expected(samples.size());
+        scalar.encode(samples.data(), expected.data(), samples.size());
+        for(unsigned int i = 0; i < samples.size(); i++)
+        {
+            const uint8_t code = law == G711::Law::MU_LAW ? G711::encodeMuLaw(samples[i]) : G711::encodeALaw(samples[i]);
+            TEST_ASSERT_EQUALS(code, expected[i]);
+        }
+
+        for(const FormatConverter::InstructionSet instructionSet : {FormatConverter::InstructionSet::SSE2, FormatConverter::InstructionSet::AVX2, FormatConverter::InstructionSet::NEON})
+        {
+            const G711 vectorized(law, instructionSet);
+            std::vector<uint8_t> encoded(samples.size());
+            //an odd number of samples, to also test the remainder
+            vectorized.encode(samples.data(), encoded.data(), samples.size() - 3);
+            vectorized.encode(samples.data() + samples.size() - 3, encoded.data() + samples.size() - 3, 3);
+            TEST_ASSERT(expected == encoded);
+        }
+    }
+}
+
+void TestG711::testRoundTrip()
+{
+    const std::vector<int16_t> samples = createAllSamples();
+    for(const G711::Law law : {G711::Law::MU_LAW, G711::Law::A_LAW})
+    {
+        const G711 codec(law);
+        std::vector<uint8_t> encoded(samples.size());
+        std::vector<int16_t> decoded(samples.size());
+        codec.encode(samples.data(), encoded.data(), samples.size());
+        codec.decode(encoded.data(), decoded.data(), samples.size());
+        for(unsigned int i = 0; i < samples.size(); i++)
+        {
+            //half of the widest step (1024) plus the clipping of the μ-law above 32124
+            const int maximumError = law == G711::Law::MU_LAW ? 644 : 512;
+            const int error = std::abs(samples[i] - decoded[i]);
+            TEST_ASSERT(error <= maximumError);
+            if(error > maximumError)
+            {
+                break;
+            }
+        }
+        //encoding the decoded samples again is lossless
+        std::vector<uint8_t> reencoded(samples.size());
+        std::vector<int16_t> redecoded(samples.size());
+        codec.encode(decoded.data(), reencoded.data(), samples.size());
+        codec.decode(reencoded.data(), redecoded.data(), samples.size());
+        TEST_ASSERT(redecoded == decoded);
+    }
+}
+
+void TestG711::testInPlace()
+{
+    const std::vector<int16_t> samples = createAllSamples();
+    const G711 codec(G711::Law::A_LAW);
+    std::vector<uint8_t> expected(samples.size());
+    std::vector<int16_t> expectedSamples(samples.size());
+    codec.encode(samples.data(), expected.data(), samples.size());
+    codec.decode(expected.data(), expectedSamples.data(), samples.size());
+
+    std::vector<int16_t> buffer(samples);
+    codec.encode(buffer.data(), (uint8_t*)buffer.data(), buffer.size());
+    TEST_ASSERT(std::equal(expected.begin(), expected.end(), (const uint8_t*)buffer.data()));
+    codec.decode((const uint8_t*)buffer.data(), buffer.data(), buffer.size());
+    TEST_ASSERT(buffer == expectedSamples);
+}
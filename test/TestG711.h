@@ -0,0 +1,18 @@
+#ifndef TESTG711_H
+#define TESTG711_H
+
+#include "cpptest.h"
+#include "G711.h"
+
+class TestG711 : public Test::Suite
+{
+public:
+    TestG711();
+
+    void testReferenceValues();
+    void testVectorizedEncoding();
+    void testRoundTrip();
+    void testInPlace();
+};
+
+#endif // TESTG711_H
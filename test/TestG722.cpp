@@ -0,0 +1,174 @@
+#include "TestG722.h"
+
+#include <cmath>
+#include <algorithm>
+
+static const double PI = 3.14159265358979323846;
+//one second at 16 kHz
+static const unsigned int SAMPLES = 16000;
+
+TestG722::TestG722()
+{
+    TEST_ADD(TestG722::testKnownAnswers);
+    TEST_ADD(TestG722::testVectorizedFilters);
+    TEST_ADD(TestG722::testQuality);
+    TEST_ADD(TestG722::testBlockSizes);
+    TEST_ADD(TestG722::testInPlace);
+}
+
+//a sine-tone with the given frequency and amplitude relative to full-scale
+static std::vector<int16_t> createTone(const double frequency, const double amplitude)
+{
+    std::vector<int16_t> samples(SAMPLES);
+    for(unsigned int i = 0; i < SAMPLES; i++)
+    {
+        samples[i] = (int16_t)(32767 * amplitude * sin(2 * PI * frequency * i / G722Codec::SAMPLE_RATE));
+    }
+    return samples;
+}
+
+//white noise at full-scale, to also reach the limits of the quantizers
+static std::vector<int16_t> createNoise()
+{
+    std::vector<int16_t> samples(SAMPLES);
+    uint32_t randomState = 1;
+    for(int16_t& sample : samples)
+    {
+        randomState = randomState * 1664525 + 1013904223;
+        sample = (int16_t)(randomState >> 16);
+    }
+    return samples;
+}
+
+//the signal-to-noise ratio in dB of the decoded signal, compensating the delay of the QMF filter banks
+static double calculateSNR(const std::vector<int16_t>& original, const std::vector<int16_t>& decoded)
+{
+    double bestSNR = -1000;
+    for(unsigned int delay = 0; delay < 48; delay++)
+    {
+        double signal = 0;
+        double noise = 0;
+        //skip the adaption of the ADPCM
+        for(unsigned int i = 1600; i + delay < decoded.size(); i++)
+        {
+            const double difference = decoded[i + delay] - original[i];
+            signal += original[i] * (double)original[i];
+            noise += difference * difference;
+        }
+        bestSNR = std::max(bestSNR, 10 * log10(signal / noise));
+    }
+    return bestSNR;
+}
+
+static std::vector<int16_t> encodeAndDecode(G722Codec& codec, const std::vector<int16_t>& samples)
+{
+    std::vector<uint8_t> encoded(samples.size() / 2);
+    std::vector<int16_t> decoded(samples.size());
+    codec.encode(samples.data(), encoded.data(), samples.size());
+    codec.decode(encoded.data(), decoded.data(), encoded.size());
+    return decoded;
+}
+
+void TestG722::testKnownAnswers()
+{
+    //the encoded and decoded values of the G.722 reference algorithm (64 kbit/s mode) for the first samples of the noise,
+    //starting from the reset-state of encoder and decoder
+    const std::vector<uint8_t> expectedBytes = {
+        0x92, 0x20, 0x84, 0x20, 0x84, 0x20, 0x87, 0x0A, 0xAD, 0x04, 0x31, 0xB5, 0x12, 0xB1, 0x93, 0x09
+    };
+    const std::vector<int16_t> expectedSamples = {
+        -1, 0, 0, -1, -1, 1, 0, -6, -2, 19, -1, -71, -7, 205, 3, -484,
+        45, 932, -114, -1619, -146, 2364, 2405, -1161, -9372, -15183, -4857, 10716, 1752, -23719, -24670, 412
+    };
+    const std::vector<int16_t> noise = createNoise();
+    G722Codec codec;
+    std::vector<uint8_t> bytes(expectedBytes.size());
+    std::vector<int16_t> samples(expectedSamples.size());
+    codec.encode(noise.data(), bytes.data(), samples.size());
+    codec.decode(bytes.data(), samples.data(), bytes.size());
+    TEST_ASSERT(bytes == expectedBytes);
+    TEST_ASSERT(samples == expectedSamples);
+
+    //digital silence is quantized into the first positive interval of both sub-bands: (3 << 6) | 58
+    G722Codec silence;
+    const std::vector<int16_t> zeroes(expectedSamples.size(), 0);
+    silence.encode(zeroes.data(), bytes.data(), zeroes.size());
+    TEST_ASSERT(bytes == std::vector<uint8_t>(bytes.size(), 0xFA));
+}
+
+void TestG722::testVectorizedFilters()
+{
+    const std::vector<int16_t> noise = createNoise();
+    G722Codec scalar(FormatConverter::InstructionSet::SCALAR);
+    std::vector<uint8_t> expectedBytes(SAMPLES / 2);
+    std::vector<int16_t> expectedSamples(SAMPLES);
+    TEST_ASSERT_EQUALS(SAMPLES / 2, scalar.encode(noise.data(), expectedBytes.data(), SAMPLES));
+    TEST_ASSERT_EQUALS(SAMPLES, scalar.decode(expectedBytes.data(), expectedSamples.data(), SAMPLES / 2));
+
+    for(const FormatConverter::InstructionSet instructionSet : {FormatConverter::InstructionSet::SSE2, FormatConverter::InstructionSet::AVX2, FormatConverter::InstructionSet::NEON})
+    {
+        G722Codec vectorized(instructionSet);
+        std::vector<uint8_t> bytes(SAMPLES / 2);
+        std::vector<int16_t> samples(SAMPLES);
+        vectorized.encode(noise.data(), bytes.data(), SAMPLES);
+        vectorized.decode(bytes.data(), samples.data(), SAMPLES / 2);
+        TEST_ASSERT(bytes == expectedBytes);
+        TEST_ASSERT(samples == expectedSamples);
+    }
+}
+
+void TestG722::testQuality()
+{
+    G722Codec codec;
+    //a tone in the low and in the high band
+    const std::vector<int16_t> low = createTone(1000, 0.5);
+    TEST_ASSERT(calculateSNR(low, encodeAndDecode(codec, low)) > 40);
+    codec.reset();
+    const std::vector<int16_t> high = createTone(5000, 0.5);
+    TEST_ASSERT(calculateSNR(high, encodeAndDecode(codec, high)) > 18);
+    codec.reset();
+    const std::vector<int16_t> quiet = createTone(440, 0.01);
+    TEST_ASSERT(calculateSNR(quiet, encodeAndDecode(codec, quiet)) > 30);
+}
+
+void TestG722::testBlockSizes()
+{
+    const std::vector<int16_t> tone = createTone(1000, 0.5);
+    G722Codec whole;
+    std::vector<uint8_t> expected(SAMPLES / 2);
+    whole.encode(tone.data(), expected.data(), SAMPLES);
+
+    //the state is kept across calls, so the block-size does not matter
+    G722Codec blocks;
+    std::vector<uint8_t> encoded(SAMPLES / 2);
+    unsigned int position = 0;
+    for(unsigned int blockSize = 2; position < SAMPLES; blockSize += 2)
+    {
+        const unsigned int size = std::min(blockSize, SAMPLES - position);
+        blocks.encode(tone.data() + position, encoded.data() + position / 2, size);
+        position += size;
+    }
+    TEST_ASSERT(encoded == expected);
+
+    std::vector<int16_t> expectedSamples(SAMPLES);
+    whole.decode(expected.data(), expectedSamples.data(), SAMPLES / 2);
+    std::vector<int16_t> decoded(SAMPLES);
+    for(unsigned int offset = 0; offset < SAMPLES / 2; offset += 160)
+    {
+        blocks.decode(encoded.data() + offset, decoded.data() + 2 * offset, 160);
+    }
+    TEST_ASSERT(decoded == expectedSamples);
+}
+
+void TestG722::testInPlace()
+{
+    const std::vector<int16_t> tone = createTone(1000, 0.5);
+    G722Codec outOfPlace;
+    const std::vector<int16_t> expected = encodeAndDecode(outOfPlace, tone);
+
+    G722Codec inPlace;
+    std::vector<int16_t> buffer(tone);
+    TEST_ASSERT_EQUALS(SAMPLES / 2, inPlace.encode(buffer.data(), (uint8_t*)buffer.data(), SAMPLES));
+    TEST_ASSERT_EQUALS(SAMPLES, inPlace.decode((const uint8_t*)buffer.data(), buffer.data(), SAMPLES / 2));
+    TEST_ASSERT(buffer == expected);
+}
@@ -0,0 +1,19 @@
+#ifndef TESTG722_H
+#define TESTG722_H
+
+#include "cpptest.h"
+#include "G722Codec.h"
+
+class TestG722 : public Test::Suite
+{
+public:
+    TestG722();
+
+    void testKnownAnswers();
+    void testVectorizedFilters();
+    void testQuality();
+    void testBlockSizes();
+    void testInPlace();
+};
+
+#endif // TESTG722_H
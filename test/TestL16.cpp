@@ -0,0 +1,47 @@
+#include "TestL16.h"
+
+#include <vector>
+
+TestL16::TestL16()
+{
+    TEST_ADD(TestL16::testNetworkByteOrder);
+    TEST_ADD(TestL16::testVectorizedSwap);
+}
+
+void TestL16::testNetworkByteOrder()
+{
+    uint16_t sample = 0x1234;
+    //big-endian hosts already use the network byte-order
+    const bool isLittleEndian = ((const uint8_t*)&sample)[0] == 0x34;
+    if(isLittleEndian)
+    {
+        ProcessorL16::swapByteOrder(&sample, 1, FormatConverter::InstructionSet::SCALAR);
+    }
+    TEST_ASSERT_EQUALS(0x12, ((const uint8_t*)&sample)[0]);
+    TEST_ASSERT_EQUALS(0x34, ((const uint8_t*)&sample)[1]);
+}
+
+void TestL16::testVectorizedSwap()
+{
+    //all lengths up to several vectors, starting at an unaligned address
+    for(unsigned int numberOfSamples = 0; numberOfSamples < 100; numberOfSamples++)
+    {
+        std::vector<uint16_t> samples(numberOfSamples + 1);
+        for(unsigned int i = 0; i < samples.size(); i++)
+        {
+            samples[i] = (uint16_t)(i * 0x0101 + 0x1200);
+        }
+        std::vector<uint16_t> expected(samples);
+        ProcessorL16::swapByteOrder(expected.data() + 1, numberOfSamples, FormatConverter::InstructionSet::SCALAR);
+        TEST_ASSERT_EQUALS(samples[0], expected[0]);
+        for(const FormatConverter::InstructionSet instructionSet : {FormatConverter::InstructionSet::SSE2, FormatConverter::InstructionSet::AVX2, FormatConverter::InstructionSet::NEON})
+        {
+            std::vector<uint16_t> swapped(samples);
+            ProcessorL16::swapByteOrder(swapped.data() + 1, numberOfSamples, instructionSet);
+            TEST_ASSERT(swapped == expected);
+            //swapping twice restores the samples
+            ProcessorL16::swapByteOrder(swapped.data() + 1, numberOfSamples, instructionSet);
+            TEST_ASSERT(swapped == samples);
+        }
+    }
+}
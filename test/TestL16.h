@@ -0,0 +1,16 @@
+#ifndef TESTL16_H
+#define TESTL16_H
+
+#include "cpptest.h"
+#include "ProcessorL16.h"
+
+class TestL16 : public Test::Suite
+{
+public:
+    TestL16();
+
+    void testNetworkByteOrder();
+    void testVectorizedSwap();
+};
+
+#endif // TESTL16_H
@@ -0,0 +1,76 @@
+#include "TestLatencyHistogram.h"
+
+TestLatencyHistogram::TestLatencyHistogram()
+{
+    TEST_ADD(TestLatencyHistogram::testExactValues);
+    TEST_ADD(TestLatencyHistogram::testPercentiles);
+    TEST_ADD(TestLatencyHistogram::testLargeValues);
+    TEST_ADD(TestLatencyHistogram::testReset);
+}
+
+void TestLatencyHistogram::testExactValues()
+{
+    LatencyHistogram histogram;
+    TEST_ASSERT_EQUALS(0u, histogram.getPercentile(50));
+    //values below 64 ns are counted exactly
+    for(uint64_t value = 1; value <= 60; value++)
+    {
+        histogram.record(value);
+    }
+    TEST_ASSERT_EQUALS(60u, histogram.getCount());
+    TEST_ASSERT_EQUALS(1830u, histogram.getTotal());
+    TEST_ASSERT_EQUALS(60u, histogram.getMaximum());
+    TEST_ASSERT_EQUALS(30u, histogram.getPercentile(50));
+    TEST_ASSERT_EQUALS(1u, histogram.getPercentile(0));
+    TEST_ASSERT_EQUALS(60u, histogram.getPercentile(100));
+}
+
+void TestLatencyHistogram::testPercentiles()
+{
+    LatencyHistogram histogram;
+    //1 to 100 microseconds, with an outlier of 5 ms every 500 calls
+    for(uint64_t i = 0; i < 100000; i++)
+    {
+        histogram.record(i % 500 == 499 ? 5000000 : (i % 100 + 1) * 1000);
+    }
+    const uint64_t p50 = histogram.getPercentile(50);
+    const uint64_t p99 = histogram.getPercentile(99);
+    const uint64_t p999 = histogram.getPercentile(99.9);
+    //the relative error is at most 1/32
+    TEST_ASSERT(p50 >= 50000 && p50 <= 50000 + 50000 / 32);
+    TEST_ASSERT(p99 >= 99000 && p99 <= 100000 + 100000 / 32);
+    TEST_ASSERT_EQUALS(5000000u, p999);
+    TEST_ASSERT_EQUALS(5000000u, histogram.getMaximum());
+}
+
+void TestLatencyHistogram::testLargeValues()
+{
+    LatencyHistogram histogram;
+    //every power of two is mapped to a bucket with a limit of at most 1/32 above the value
+    for(unsigned int exponent = 6; exponent < 40; exponent++)
+    {
+        LatencyHistogram single;
+        const uint64_t value = (1ull << exponent) + 1;
+        single.record(value);
+        single.record(0);
+        const uint64_t limit = single.getPercentile(100);
+        TEST_ASSERT(limit >= value && limit - value <= value / 32);
+    }
+    //values beyond the last bucket are reported as the maximum
+    histogram.record(1ull << 50);
+    TEST_ASSERT_EQUALS(1ull << 50, histogram.getPercentile(50));
+}
+
+void TestLatencyHistogram::testReset()
+{
+    LatencyHistogram histogram;
+    histogram.record(1000);
+    histogram.record(2000);
+    histogram.reset();
+    TEST_ASSERT_EQUALS(0u, histogram.getCount());
+    TEST_ASSERT_EQUALS(0u, histogram.getTotal());
+    TEST_ASSERT_EQUALS(0u, histogram.getMaximum());
+    TEST_ASSERT_EQUALS(0u, histogram.getPercentile(99));
+    histogram.record(40);
+    TEST_ASSERT_EQUALS(40u, histogram.getPercentile(50));
+}
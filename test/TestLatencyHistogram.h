@@ -0,0 +1,18 @@
+#ifndef TESTLATENCYHISTOGRAM_H
+#define TESTLATENCYHISTOGRAM_H
+
+#include "cpptest.h"
+#include "LatencyHistogram.h"
+
+class TestLatencyHistogram : public Test::Suite
+{
+public:
+    TestLatencyHistogram();
+
+    void testExactValues();
+    void testPercentiles();
+    void testLargeValues();
+    void testReset();
+};
+
+#endif // TESTLATENCYHISTOGRAM_H
@@ -0,0 +1,144 @@
+#include "TestLosslessCodec.h"
+
+#include <cmath>
+
+static const double PI = 3.14159265358979323846;
+static const unsigned int SAMPLE_RATE = 48000;
+//the frames of a BUFFER_128 package
+static const unsigned int FRAMES = 128;
+
+TestLosslessCodec::TestLosslessCodec()
+{
+    TEST_ADD(TestLosslessCodec::testVectorizedResidual);
+    TEST_ADD(TestLosslessCodec::testRoundTrip);
+    TEST_ADD(TestLosslessCodec::testCompressionRatio);
+    TEST_ADD(TestLosslessCodec::testInvalidFrames);
+}
+
+//interleaved tones with a different pitch per channel at half full-scale, plus noise at the level of the 16 bit quantization noise
+static std::vector<int32_t> createMusic(const unsigned int channels, const unsigned int frames, const unsigned int bitsPerSample)
+{
+    const double fullScale = (1 << (bitsPerSample - 1)) - 1;
+    const int32_t noiseRange = bitsPerSample > 16 ? 1 << (bitsPerSample - 17) : 2;
+    std::vector<int32_t> samples(channels * frames);
+    uint32_t randomState = 1;
+    for(unsigned int i = 0; i < frames; i++)
+    {
+        for(unsigned int channel = 0; channel < channels; channel++)
+        {
+            const double frequency = 220.0 * (channel + 1);
+            const double value = 0.3 * sin(2 * PI * frequency * i / SAMPLE_RATE) + 0.15 * sin(2 * PI * 2.5 * frequency * i / SAMPLE_RATE) +
+                0.05 * sin(2 * PI * 7.1 * frequency * i / SAMPLE_RATE);
+            randomState = randomState * 1664525 + 1013904223;
+            samples[i * channels + channel] = (int32_t)(fullScale * value) + (int32_t)(randomState >> 16) % noiseRange;
+        }
+    }
+    return samples;
+}
+
+//white noise at full-scale, which can't be predicted
+static std::vector<int32_t> createNoise(const unsigned int channels, const unsigned int frames, const unsigned int bitsPerSample)
+{
+    std::vector<int32_t> samples(channels * frames);
+    uint32_t randomState = 1;
+    for(int32_t& sample : samples)
+    {
+        randomState = randomState * 1664525 + 1013904223;
+        sample = (int32_t)randomState >> (32 - bitsPerSample);
+    }
+    return samples;
+}
+
+//alternating the minimum and maximum value, the worst case for the predictors
+static std::vector<int32_t> createExtremes(const unsigned int channels, const unsigned int frames, const unsigned int bitsPerSample)
+{
+    std::vector<int32_t> samples(channels * frames);
+    for(unsigned int i = 0; i < samples.size(); i++)
+    {
+        samples[i] = (i / channels) % 2 ? (1 << (bitsPerSample - 1)) - 1 : -(1 << (bitsPerSample - 1));
+    }
+    return samples;
+}
+
+static bool isRestored(LosslessCodec& codec, const std::vector<int32_t>& samples, const unsigned int channels)
+{
+    const unsigned int frames = samples.size() / channels;
+    std::vector<uint8_t> encoded(codec.getMaximumEncodedSize(frames));
+    const unsigned int size = codec.encode(samples.data(), frames, encoded.data(), encoded.size());
+    std::vector<int32_t> decoded(samples.size());
+    return size > 0 && codec.decode(encoded.data(), size, decoded.data(), frames) == frames && decoded == samples;
+}
+
+void TestLosslessCodec::testVectorizedResidual()
+{
+    const std::vector<int32_t> music = createMusic(6, FRAMES * 10, 24);
+    LosslessCodec scalar(6, 24, FormatConverter::InstructionSet::SCALAR);
+    std::vector<uint8_t> expected(scalar.getMaximumEncodedSize(FRAMES));
+    std::vector<uint8_t> encoded(expected.size());
+    for(const FormatConverter::InstructionSet instructionSet : {FormatConverter::InstructionSet::SSE2, FormatConverter::InstructionSet::AVX2, FormatConverter::InstructionSet::NEON})
+    {
+        LosslessCodec vectorized(6, 24, instructionSet);
+        //the odd sizes also exercise the scalar tails of the vectorized kernels
+        for(unsigned int offset = 0, frames = 1; offset + frames <= music.size() / 6; offset += frames, frames += 13)
+        {
+            const unsigned int expectedSize = scalar.encode(music.data() + offset * 6, frames, expected.data(), expected.size());
+            const unsigned int size = vectorized.encode(music.data() + offset * 6, frames, encoded.data(), encoded.size());
+            TEST_ASSERT_EQUALS(expectedSize, size);
+            TEST_ASSERT(std::equal(expected.begin(), expected.begin() + size, encoded.begin()));
+        }
+    }
+}
+
+void TestLosslessCodec::testRoundTrip()
+{
+    for(const unsigned int bitsPerSample : {16u, 24u})
+    {
+        for(const unsigned int channels : {1u, 2u, 6u})
+        {
+            LosslessCodec codec(channels, bitsPerSample);
+            for(const unsigned int frames : {1u, 2u, 7u, FRAMES, 1024u})
+            {
+                TEST_ASSERT(isRestored(codec, createMusic(channels, frames, bitsPerSample), channels));
+                TEST_ASSERT(isRestored(codec, createNoise(channels, frames, bitsPerSample), channels));
+                TEST_ASSERT(isRestored(codec, createExtremes(channels, frames, bitsPerSample), channels));
+                TEST_ASSERT(isRestored(codec, std::vector<int32_t>(channels * frames, -5), channels));
+            }
+        }
+    }
+}
+
+void TestLosslessCodec::testCompressionRatio()
+{
+    //multichannel 24 bit audio at 48 kHz should be reduced to about half of its size
+    const unsigned int channels = 6;
+    const std::vector<int32_t> music = createMusic(channels, SAMPLE_RATE, 24);
+    LosslessCodec codec(channels, 24);
+    std::vector<uint8_t> encoded(codec.getMaximumEncodedSize(FRAMES));
+    unsigned int totalSize = 0;
+    for(unsigned int offset = 0; offset + FRAMES <= SAMPLE_RATE; offset += FRAMES)
+    {
+        totalSize += codec.encode(music.data() + offset * channels, FRAMES, encoded.data(), encoded.size());
+    }
+    const double ratio = totalSize / (SAMPLE_RATE / FRAMES * FRAMES * channels * 3.0);
+    TEST_ASSERT(ratio < 0.6);
+
+    //the verbatim fallback limits the size of unpredictable signals
+    const std::vector<int32_t> noise = createNoise(channels, FRAMES, 24);
+    TEST_ASSERT(codec.encode(noise.data(), FRAMES, encoded.data(), encoded.size()) <= codec.getMaximumEncodedSize(FRAMES));
+}
+
+void TestLosslessCodec::testInvalidFrames()
+{
+    const std::vector<int32_t> music = createMusic(2, FRAMES, 16);
+    LosslessCodec codec(2, 16);
+    std::vector<uint8_t> encoded(codec.getMaximumEncodedSize(FRAMES));
+    const unsigned int size = codec.encode(music.data(), FRAMES, encoded.data(), encoded.size());
+    TEST_ASSERT(size > 0);
+    //too small buffers are rejected
+    TEST_ASSERT_EQUALS(0u, codec.encode(music.data(), FRAMES, encoded.data(), size - 1));
+    std::vector<int32_t> decoded(music.size());
+    TEST_ASSERT_EQUALS(0u, codec.decode(encoded.data(), size, decoded.data(), FRAMES - 1));
+    //truncated frames are detected
+    TEST_ASSERT_EQUALS(0u, codec.decode(encoded.data(), size / 2, decoded.data(), FRAMES));
+    TEST_ASSERT_EQUALS(FRAMES, codec.decode(encoded.data(), size, decoded.data(), FRAMES));
+}
@@ -0,0 +1,18 @@
+#ifndef TESTLOSSLESSCODEC_H
+#define TESTLOSSLESSCODEC_H
+
+#include "cpptest.h"
+#include "LosslessCodec.h"
+
+class TestLosslessCodec : public Test::Suite
+{
+public:
+    TestLosslessCodec();
+
+    void testVectorizedResidual();
+    void testRoundTrip();
+    void testCompressionRatio();
+    void testInvalidFrames();
+};
+
+#endif // TESTLOSSLESSCODEC_H
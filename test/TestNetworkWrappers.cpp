@@ -4,6 +4,8 @@ TestNetworkWrappers::TestNetworkWrappers() : bufferSize(511), sendBuffer(new cha
 {
     TEST_ADD(TestNetworkWrappers::testUDPWrapperIPv4);
     TEST_ADD(TestNetworkWrappers::testUDPWrapperIPv6);
+    TEST_ADD(TestNetworkWrappers::testUDPWrapperMulticast);
+    TEST_ADD(TestNetworkWrappers::testUDPWrapperInvalidMulticastSource);
 }
 
 TestNetworkWrappers::~TestNetworkWrappers()
@@ -24,6 +26,19 @@ void TestNetworkWrappers::testUDPWrapperIPv6()
     testUDPWrapper(wrapper);
 }
 
+void TestNetworkWrappers::testUDPWrapperMulticast()
+{
+    //administratively scoped group, with loopback enabled to receive our own packages
+    UDPWrapper wrapper(DEFAULT_NETWORK_PORT, "239.255.12.34", DEFAULT_NETWORK_PORT, 1, true);
+    testUDPWrapper(wrapper);
+}
+
+void TestNetworkWrappers::testUDPWrapperInvalidMulticastSource()
+{
+    //the group can't be joined without a valid source-address
+    TEST_THROWS(UDPWrapper(DEFAULT_NETWORK_PORT, "239.255.12.34", DEFAULT_NETWORK_PORT, 1, true, "no.address"), std::runtime_error);
+}
+
 void TestNetworkWrappers::testUDPWrapper(UDPWrapper& wrapper)
 {
     const char* text = "This is a test, Lorem ipsum! We fill this buffer with some random stuff ..... And send a arbitrary amount of bytes and compare them to this original string...";
@@ -14,6 +14,8 @@ public:
 
     void testUDPWrapperIPv4();
     void testUDPWrapperIPv6();
+    void testUDPWrapperMulticast();
+    void testUDPWrapperInvalidMulticastSource();
 private:
     const unsigned int bufferSize;
     char* sendBuffer;
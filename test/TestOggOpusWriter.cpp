@@ -0,0 +1,244 @@
+#include "TestOggOpusWriter.h"
+
+#include <cstdio>
+#include <cmath>
+
+#include "opus.h"
+#include "opus_multistream.h"
+
+static const char* FILE_NAME = "TestOggOpusWriter.opus";
+
+/*!
+ * A page of the Ogg-file with the packets completed on it
+ */
+struct OggPage
+{
+    uint8_t headerType;
+    uint64_t granulePosition;
+    uint32_t sequenceNumber;
+    bool isChecksumValid;
+    std::vector<std::vector<uint8_t>> packets;
+};
+
+static uint64_t readLittleEndian(const std::vector<uint8_t>& contents, const size_t offset, const unsigned int numberOfBytes)
+{
+    uint64_t value = 0;
+    for(unsigned int i = 0; i < numberOfBytes && offset + i < contents.size(); i++)
+    {
+        value |= (uint64_t)contents[offset + i] << (8 * i);
+    }
+    return value;
+}
+
+static uint32_t calculateCRC(const std::vector<uint8_t>& data)
+{
+    uint32_t crc = 0;
+    for(const uint8_t byte : data)
+    {
+        crc ^= (uint32_t)byte << 24;
+        for(unsigned int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80000000u) ? (crc << 1) ^ 0x04C11DB7u : crc << 1;
+        }
+    }
+    return crc;
+}
+
+/*!
+ * Reads the pages of the file, none of the packets written by the OggOpusWriter span several pages
+ */
+static std::vector<OggPage> readPages()
+{
+    std::vector<uint8_t> contents;
+    FILE* file = fopen(FILE_NAME, "rb");
+    if(file != nullptr)
+    {
+        int byte;
+        while((byte = fgetc(file)) != EOF)
+        {
+            contents.push_back((uint8_t)byte);
+        }
+        fclose(file);
+    }
+    std::vector<OggPage> pages;
+    size_t position = 0;
+    while(position + 27 <= contents.size() && std::string(contents.begin() + position, contents.begin() + position + 4) == "OggS")
+    {
+        OggPage page;
+        page.headerType = contents[position + 5];
+        page.granulePosition = readLittleEndian(contents, position + 6, 8);
+        page.sequenceNumber = (uint32_t)readLittleEndian(contents, position + 18, 4);
+        const unsigned int numberOfSegments = contents[position + 26];
+        size_t bodyPosition = position + 27 + numberOfSegments;
+        std::vector<uint8_t> packet;
+        for(unsigned int i = 0; i < numberOfSegments; i++)
+        {
+            const unsigned int segmentSize = contents[position + 27 + i];
+            packet.insert(packet.end(), contents.begin() + bodyPosition, contents.begin() + bodyPosition + segmentSize);
+            bodyPosition += segmentSize;
+            if(segmentSize < 255)
+            {
+                page.packets.push_back(packet);
+                packet.clear();
+            }
+        }
+        std::vector<uint8_t> pageContents(contents.begin() + position, contents.begin() + bodyPosition);
+        const uint32_t checksum = (uint32_t)readLittleEndian(pageContents, 22, 4);
+        std::fill(pageContents.begin() + 22, pageContents.begin() + 26, 0);
+        page.isChecksumValid = checksum == calculateCRC(pageContents);
+        pages.push_back(page);
+        position = bodyPosition;
+    }
+    return pages;
+}
+
+static std::vector<std::vector<uint8_t>> encodePackets(const unsigned int numberOfPackets, const unsigned int frameSize)
+{
+    int error;
+    OpusEncoder* encoder = opus_encoder_create(48000, 2, OPUS_APPLICATION_AUDIO, &error);
+    std::vector<int16_t> samples(frameSize * 2);
+    std::vector<std::vector<uint8_t>> packets;
+    for(unsigned int p = 0; p < numberOfPackets; p++)
+    {
+        for(unsigned int i = 0; i < frameSize; i++)
+        {
+            samples[2 * i] = samples[2 * i + 1] = (int16_t)(8000 * sin((p * frameSize + i) * 0.05));
+        }
+        std::vector<uint8_t> packet(1500);
+        packet.resize(opus_encode(encoder, samples.data(), frameSize, packet.data(), packet.size()));
+        packets.push_back(packet);
+    }
+    opus_encoder_destroy(encoder);
+    return packets;
+}
+
+TestOggOpusWriter::TestOggOpusWriter()
+{
+    TEST_ADD(TestOggOpusWriter::testPages);
+    TEST_ADD(TestOggOpusWriter::testSilence);
+    TEST_ADD(TestOggOpusWriter::testMultistream);
+    TEST_ADD(TestOggOpusWriter::testPreSkip);
+}
+
+void TestOggOpusWriter::testPages()
+{
+    //3 s of 20 ms packets
+    const std::vector<std::vector<uint8_t>> packets = encodePackets(150, 960);
+    {
+        OggOpusWriter writer(FILE_NAME, 2, 44100);
+        TEST_ASSERT(writer.isOpen());
+        for(const std::vector<uint8_t>& packet : packets)
+        {
+            TEST_ASSERT(writer.write(packet.data(), packet.size()));
+        }
+        writer.close();
+        TEST_ASSERT_EQUALS(150u, writer.getWrittenPackets());
+        TEST_ASSERT_EQUALS(0u, writer.getDroppedPackets());
+        TEST_ASSERT_EQUALS(150u * 960, writer.getGranulePosition());
+    }
+    const std::vector<OggPage> pages = readPages();
+    //the two header-pages and a page per second of audio
+    TEST_ASSERT_EQUALS(5u, pages.size());
+    for(unsigned int i = 0; i < pages.size(); i++)
+    {
+        TEST_ASSERT(pages[i].isChecksumValid);
+        TEST_ASSERT_EQUALS(i, pages[i].sequenceNumber);
+    }
+    TEST_ASSERT_EQUALS(0x02, pages[0].headerType);
+    TEST_ASSERT_EQUALS(1u, pages[0].packets.size());
+    const std::vector<uint8_t>& head = pages[0].packets[0];
+    TEST_ASSERT_EQUALS(19u, head.size());
+    TEST_ASSERT_EQUALS(std::string("OpusHead"), std::string(head.begin(), head.begin() + 8));
+    TEST_ASSERT_EQUALS(2u, readLittleEndian(head, 9, 1));
+    TEST_ASSERT_EQUALS(44100u, readLittleEndian(head, 12, 4));
+    TEST_ASSERT_EQUALS(std::string("OpusTags"), std::string(pages[1].packets[0].begin(), pages[1].packets[0].begin() + 8));
+    TEST_ASSERT_EQUALS(0u, pages[1].granulePosition);
+
+    //the granule-position is the number of samples at the end of the last packet on the page
+    std::vector<std::vector<uint8_t>> recordedPackets;
+    uint64_t position = 0;
+    for(unsigned int i = 2; i < pages.size(); i++)
+    {
+        recordedPackets.insert(recordedPackets.end(), pages[i].packets.begin(), pages[i].packets.end());
+        position += 960 * pages[i].packets.size();
+        TEST_ASSERT_EQUALS(position, pages[i].granulePosition);
+    }
+    TEST_ASSERT_EQUALS(0x04, pages.back().headerType);
+    TEST_ASSERT(packets == recordedPackets);
+    remove(FILE_NAME);
+}
+
+void TestOggOpusWriter::testSilence()
+{
+    const std::vector<std::vector<uint8_t>> packets = encodePackets(2, 480);
+    {
+        OggOpusWriter writer(FILE_NAME, 2, 48000);
+        //silence before the first packet has no duration to record with
+        TEST_ASSERT(writer.writeSilence());
+        TEST_ASSERT(writer.write(packets[0].data(), packets[0].size()));
+        TEST_ASSERT(writer.writeSilence());
+        TEST_ASSERT(writer.writeSilence());
+        TEST_ASSERT(writer.write(packets[1].data(), packets[1].size()));
+        //an invalid packet
+        const uint8_t invalidPacket[] = {0x03};
+        TEST_ASSERT(writer.write(invalidPacket, sizeof(invalidPacket)));
+        writer.close();
+        TEST_ASSERT_EQUALS(4u, writer.getWrittenPackets());
+        TEST_ASSERT_EQUALS(1u, writer.getDroppedPackets());
+    }
+    const std::vector<OggPage> pages = readPages();
+    TEST_ASSERT_EQUALS(3u, pages.size());
+    TEST_ASSERT_EQUALS(4u * 480, pages[2].granulePosition);
+    TEST_ASSERT_EQUALS(4u, pages[2].packets.size());
+
+    //the silence is decoded as concealed audio of the duration of the previous packet
+    int error;
+    OpusDecoder* decoder = opus_decoder_create(48000, 2, &error);
+    std::vector<int16_t> samples(5760 * 2);
+    for(const std::vector<uint8_t>& packet : pages[2].packets)
+    {
+        TEST_ASSERT_EQUALS(480, opus_decode(decoder, packet.data(), packet.size(), samples.data(), 5760, 0));
+    }
+    opus_decoder_destroy(decoder);
+    remove(FILE_NAME);
+}
+
+void TestOggOpusWriter::testMultistream()
+{
+    {
+        OggOpusWriter writer(FILE_NAME, 6, 48000);
+        writer.close();
+    }
+    const std::vector<OggPage> pages = readPages();
+    //the end of the stream is marked even without any packets
+    TEST_ASSERT_EQUALS(3u, pages.size());
+    TEST_ASSERT_EQUALS(0x04, pages[2].headerType);
+    TEST_ASSERT_EQUALS(0u, pages[2].packets.size());
+    const std::vector<uint8_t>& head = pages[0].packets[0];
+    //the 5.1 Vorbis channel-mapping with 4 streams, 2 of them coupled
+    TEST_ASSERT_EQUALS(21u + 6, head.size());
+    TEST_ASSERT_EQUALS(6u, readLittleEndian(head, 9, 1));
+    TEST_ASSERT_EQUALS(1u, readLittleEndian(head, 18, 1));
+    TEST_ASSERT_EQUALS(4u, readLittleEndian(head, 19, 1));
+    TEST_ASSERT_EQUALS(2u, readLittleEndian(head, 20, 1));
+    remove(FILE_NAME);
+}
+
+void TestOggOpusWriter::testPreSkip()
+{
+    //the look-ahead of 2.5 ms plus the delay-compensation of 4 ms, independent of the sample-rate
+    TEST_ASSERT_EQUALS(312u, OggOpusWriter::getPreSkip(48000, 2, OPUS_APPLICATION_VOIP));
+    TEST_ASSERT_EQUALS(312u, OggOpusWriter::getPreSkip(16000, 1, OPUS_APPLICATION_AUDIO));
+    TEST_ASSERT_EQUALS(312u, OggOpusWriter::getPreSkip(48000, 6, OPUS_APPLICATION_VOIP));
+    //without the delay-compensation
+    TEST_ASSERT_EQUALS(120u, OggOpusWriter::getPreSkip(48000, 2, OPUS_APPLICATION_RESTRICTED_LOWDELAY));
+    TEST_ASSERT_EQUALS(0u, OggOpusWriter::getPreSkip(44100, 2, OPUS_APPLICATION_VOIP));
+    {
+        OggOpusWriter writer(FILE_NAME, 2, 48000, 312);
+        TEST_ASSERT(writer.isOpen());
+    }
+    const std::vector<OggPage> pages = readPages();
+    TEST_ASSERT_EQUALS(3u, pages.size());
+    TEST_ASSERT_EQUALS(312u, readLittleEndian(pages[0].packets[0], 10, 2));
+    remove(FILE_NAME);
+}
@@ -0,0 +1,18 @@
+#ifndef TESTOGGOPUSWRITER_H
+#define TESTOGGOPUSWRITER_H
+
+#include "cpptest.h"
+#include "OggOpusWriter.h"
+
+class TestOggOpusWriter : public Test::Suite
+{
+public:
+    TestOggOpusWriter();
+
+    void testPages();
+    void testSilence();
+    void testMultistream();
+    void testPreSkip();
+};
+
+#endif // TESTOGGOPUSWRITER_H
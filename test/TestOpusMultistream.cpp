@@ -0,0 +1,150 @@
+#include "TestOpusMultistream.h"
+#include "opus_multistream.h"
+
+#include <cmath>
+
+static const double PI = 3.14159265358979323846;
+static const unsigned int SAMPLE_RATE = 48000;
+//20 ms
+static const unsigned int FRAME_SIZE = 960;
+static const unsigned int MAXIMUM_PACKET_SIZE = 16000;
+
+TestOpusMultistream::TestOpusMultistream()
+{
+    TEST_ADD(TestOpusMultistream::testChannelMapping);
+    TEST_ADD(TestOpusMultistream::testSelfDelimited);
+    TEST_ADD(TestOpusMultistream::testDecoding);
+    TEST_ADD(TestOpusMultistream::testThreadedEncoding);
+}
+
+//a sine-tone of a different frequency per channel
+static void fillChannels(std::vector<float>& samples, const unsigned int channels, const unsigned int offset)
+{
+    for(unsigned int i = 0; i < samples.size() / channels; i++)
+    {
+        for(unsigned int c = 0; c < channels; c++)
+        {
+            samples[i * channels + c] = (float)(0.3 * sin(2 * PI * (200 + 150 * c) * (offset + i) / SAMPLE_RATE));
+        }
+    }
+}
+
+void TestOpusMultistream::testChannelMapping()
+{
+    unsigned int streams = 0;
+    unsigned int coupledStreams = 0;
+    std::vector<unsigned char> mapping;
+    //5.1 surround: L, C, R, RL, RR, LFE
+    OpusMultistreamEncoder::getChannelMapping(6, streams, coupledStreams, mapping);
+    TEST_ASSERT_EQUALS(4u, streams);
+    TEST_ASSERT_EQUALS(2u, coupledStreams);
+    const unsigned char surroundMapping[] = {0, 4, 1, 2, 3, 5};
+    TEST_ASSERT(std::vector<unsigned char>(surroundMapping, surroundMapping + 6) == mapping);
+
+    OpusMultistreamEncoder::getChannelMapping(12, streams, coupledStreams, mapping);
+    TEST_ASSERT_EQUALS(12u, streams);
+    TEST_ASSERT_EQUALS(0u, coupledStreams);
+    TEST_ASSERT_EQUALS(11, mapping[11]);
+}
+
+void TestOpusMultistream::testSelfDelimited()
+{
+    //code 0 packet with a frame of 300 bytes
+    std::vector<unsigned char> packet(301, 0x55);
+    packet[0] = 0xF8;
+    std::vector<unsigned char> converted(400);
+    TEST_ASSERT_EQUALS(303, OpusMultistreamEncoder::toSelfDelimited(packet.data(), packet.size(), converted.data(), converted.size()));
+    TEST_ASSERT_EQUALS(0xF8, converted[0]);
+    //300 = 252 + 0 + 4 * 12
+    TEST_ASSERT_EQUALS(252, converted[1]);
+    TEST_ASSERT_EQUALS(12, converted[2]);
+    TEST_ASSERT_EQUALS(0x55, converted[302]);
+    TEST_ASSERT_EQUALS(OPUS_BUFFER_TOO_SMALL, OpusMultistreamEncoder::toSelfDelimited(packet.data(), packet.size(), converted.data(), 300));
+
+    //code 1 packet with two frames of 10 bytes is converted to code 3
+    packet.resize(21);
+    packet[0] = 0xF9;
+    TEST_ASSERT_EQUALS(24, OpusMultistreamEncoder::toSelfDelimited(packet.data(), packet.size(), converted.data(), converted.size()));
+    TEST_ASSERT_EQUALS(0xFB, converted[0]);
+    TEST_ASSERT_EQUALS(0x82, converted[1]);
+    TEST_ASSERT_EQUALS(10, converted[2]);
+    TEST_ASSERT_EQUALS(10, converted[3]);
+}
+
+void TestOpusMultistream::testDecoding()
+{
+    for(const unsigned int channels : {3u, 6u, 8u, 10u})
+    {
+        OpusMultistreamEncoder encoder(SAMPLE_RATE, channels, OPUS_APPLICATION_AUDIO, 2);
+        TEST_ASSERT_EQUALS(OPUS_OK, encoder.getErrorCode());
+        int error = OPUS_OK;
+        OpusMSDecoder* decoder = opus_multistream_decoder_create(SAMPLE_RATE, channels, encoder.getNumberOfStreams(),
+                                                                 encoder.getNumberOfCoupledStreams(), encoder.getMapping(), &error);
+        TEST_ASSERT_EQUALS(OPUS_OK, error);
+
+        std::vector<float> input(FRAME_SIZE * channels);
+        std::vector<float> output(FRAME_SIZE * channels);
+        std::vector<unsigned char> packet(MAXIMUM_PACKET_SIZE);
+        std::vector<double> signalPower(channels, 0), errorPower(channels, 0);
+        for(unsigned int frame = 0; frame < 50; frame++)
+        {
+            fillChannels(input, channels, frame * FRAME_SIZE);
+            const int size = encoder.encode(input.data(), FRAME_SIZE, packet.data(), packet.size());
+            TEST_ASSERT(size > 0);
+            TEST_ASSERT_EQUALS((int)FRAME_SIZE, opus_multistream_decode_float(decoder, packet.data(), size, output.data(), FRAME_SIZE, 0));
+            //skip the algorithmic delay of the codec (6.5 ms)
+            if(frame < 5)
+            {
+                continue;
+            }
+            //compare the decoded signal with the input of the previous frame, delayed by 312 samples
+            for(unsigned int i = 0; i < FRAME_SIZE; i++)
+            {
+                for(unsigned int c = 0; c < channels; c++)
+                {
+                    const double expected = 0.3 * sin(2 * PI * (200 + 150 * c) * (frame * FRAME_SIZE + i - 312.0) / SAMPLE_RATE);
+                    signalPower[c] += expected * expected;
+                    errorPower[c] += (output[i * channels + c] - expected) * (output[i * channels + c] - expected);
+                }
+            }
+        }
+        //every channel is decoded into the channel it was encoded from
+        for(unsigned int c = 0; c < channels; c++)
+        {
+            TEST_ASSERT_MSG(errorPower[c] < signalPower[c] * 0.1, "Channel not reconstructed");
+        }
+        opus_multistream_decoder_destroy(decoder);
+    }
+}
+
+void TestOpusMultistream::testThreadedEncoding()
+{
+    const unsigned int channels = 8;
+    OpusMultistreamEncoder singleThreaded(SAMPLE_RATE, channels, OPUS_APPLICATION_VOIP, 1);
+    OpusMultistreamEncoder multiThreaded(SAMPLE_RATE, channels, OPUS_APPLICATION_VOIP, 4);
+    TEST_ASSERT_EQUALS(1u, singleThreaded.getNumberOfThreads());
+    TEST_ASSERT_EQUALS(4u, multiThreaded.getNumberOfThreads());
+    //the 5 streams of 7.1 surround are encoded by the calling thread, if the number of threads is chosen automatically
+    OpusMultistreamEncoder automatic(SAMPLE_RATE, channels, OPUS_APPLICATION_VOIP, 0);
+    TEST_ASSERT_EQUALS(1u, automatic.getNumberOfThreads());
+
+    std::vector<float> floatInput(FRAME_SIZE * channels);
+    std::vector<opus_int16> input(FRAME_SIZE * channels);
+    std::vector<unsigned char> expected(MAXIMUM_PACKET_SIZE);
+    std::vector<unsigned char> packet(MAXIMUM_PACKET_SIZE);
+    for(unsigned int frame = 0; frame < 20; frame++)
+    {
+        fillChannels(floatInput, channels, frame * FRAME_SIZE);
+        for(unsigned int i = 0; i < input.size(); i++)
+        {
+            input[i] = (opus_int16)(floatInput[i] * 32767);
+        }
+        //the encoders are deterministic, so the distribution to the threads must not change the packets
+        const int expectedSize = singleThreaded.encode(input.data(), FRAME_SIZE, expected.data(), expected.size());
+        const int size = multiThreaded.encode(input.data(), FRAME_SIZE, packet.data(), packet.size());
+        TEST_ASSERT(expectedSize > 0);
+        TEST_ASSERT_EQUALS(expectedSize, size);
+        TEST_ASSERT(std::equal(expected.begin(), expected.begin() + expectedSize, packet.begin()));
+    }
+    TEST_ASSERT_EQUALS(OPUS_BUFFER_TOO_SMALL, multiThreaded.encode(input.data(), FRAME_SIZE, packet.data(), 10));
+}
@@ -0,0 +1,18 @@
+#ifndef TESTOPUSMULTISTREAM_H
+#define TESTOPUSMULTISTREAM_H
+
+#include "cpptest.h"
+#include "OpusMultistreamEncoder.h"
+
+class TestOpusMultistream : public Test::Suite
+{
+public:
+    TestOpusMultistream();
+
+    void testChannelMapping();
+    void testSelfDelimited();
+    void testDecoding();
+    void testThreadedEncoding();
+};
+
+#endif // TESTOPUSMULTISTREAM_H
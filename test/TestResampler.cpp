@@ -0,0 +1,115 @@
+#include "TestResampler.h"
+
+#include <vector>
+#include <cmath>
+
+static const double PI = 3.14159265358979323846;
+
+TestResampler::TestResampler()
+{
+    TEST_ADD(TestResampler::testInvalidRatio);
+    TEST_ADD(TestResampler::testNumberOfFrames);
+    TEST_ADD(TestResampler::testSineAccuracy);
+    TEST_ADD(TestResampler::testVectorizedResampling);
+    TEST_ADD(TestResampler::testStereo);
+}
+
+static std::vector<float> createSine(const double frequency, const unsigned int sampleRate, const unsigned int numberOfFrames)
+{
+    std::vector<float> samples(numberOfFrames);
+    for(unsigned int i = 0; i < numberOfFrames; i++)
+    {
+        samples[i] = (float)(0.5 * sin(2 * PI * frequency * i / sampleRate));
+    }
+    return samples;
+}
+
+void TestResampler::testInvalidRatio()
+{
+    TEST_ASSERT(Resampler(44100, 48000, 1, Resampler::Quality::LOW, 512).isValid());
+    TEST_ASSERT(!Resampler(0, 48000, 1, Resampler::Quality::LOW, 512).isValid());
+    //48000 / 47999 would require 47999 phases
+    TEST_ASSERT(!Resampler(47999, 48000, 1, Resampler::Quality::LOW, 512).isValid());
+}
+
+void TestResampler::testNumberOfFrames()
+{
+    //44100 Hz to 48000 Hz is 160 / 147
+    Resampler resampler(44100, 48000, 1, Resampler::Quality::MEDIUM, 441);
+    const std::vector<float> input(441, 0.0f);
+    std::vector<float> output(resampler.getMaximumOutputFrames(441));
+    unsigned int totalFrames = 0;
+    for(unsigned int i = 0; i < 100; i++)
+    {
+        const unsigned int frames = resampler.process(input.data(), 441, output.data());
+        TEST_ASSERT(frames <= output.size());
+        totalFrames += frames;
+    }
+    //one second of input yields one second of output, the filter-delay is filled with silence
+    TEST_ASSERT_EQUALS(48000u, totalFrames);
+}
+
+//resamples a sine and returns the largest deviation from the ideal sine, skipping the settling of the filter
+static double measureError(const unsigned int inputRate, const unsigned int outputRate, const Resampler::Quality quality, const FormatConverter::InstructionSet instructionSet)
+{
+    const double frequency = 1000;
+    const unsigned int bufferFrames = inputRate / 100;
+    Resampler resampler(inputRate, outputRate, 1, quality, bufferFrames, instructionSet);
+    const std::vector<float> input = createSine(frequency, inputRate, inputRate / 2);
+    std::vector<float> output(resampler.getMaximumOutputFrames(input.size()));
+    unsigned int outputFrames = 0;
+    for(unsigned int offset = 0; offset < input.size(); offset += bufferFrames)
+    {
+        outputFrames += resampler.process(input.data() + offset, bufferFrames, output.data() + outputFrames);
+    }
+    //the output-frame n is the input at the time n / outputRate - delay / inputRate
+    const double delay = (double)resampler.getDelay() / inputRate;
+    double maximumError = 0;
+    for(unsigned int n = outputFrames / 4; n < outputFrames; n++)
+    {
+        const double expected = 0.5 * sin(2 * PI * frequency * ((double)n / outputRate - delay));
+        maximumError = std::max(maximumError, fabs(output[n] - expected));
+    }
+    return maximumError;
+}
+
+void TestResampler::testSineAccuracy()
+{
+    TEST_ASSERT(measureError(44100, 48000, Resampler::Quality::LOW, FormatConverter::InstructionSet::SCALAR) < 5e-3);
+    TEST_ASSERT(measureError(44100, 48000, Resampler::Quality::MEDIUM, FormatConverter::InstructionSet::SCALAR) < 5e-4);
+    TEST_ASSERT(measureError(44100, 48000, Resampler::Quality::HIGH, FormatConverter::InstructionSet::SCALAR) < 5e-5);
+    TEST_ASSERT(measureError(48000, 44100, Resampler::Quality::HIGH, FormatConverter::InstructionSet::SCALAR) < 5e-5);
+    TEST_ASSERT(measureError(48000, 16000, Resampler::Quality::HIGH, FormatConverter::InstructionSet::SCALAR) < 5e-5);
+    TEST_ASSERT(measureError(8000, 48000, Resampler::Quality::BEST, FormatConverter::InstructionSet::SCALAR) < 5e-5);
+}
+
+void TestResampler::testVectorizedResampling()
+{
+    const FormatConverter::InstructionSet supportedSet = FormatConverter::getSupportedInstructionSet();
+    TEST_ASSERT(measureError(44100, 48000, Resampler::Quality::HIGH, supportedSet) < 5e-5);
+    TEST_ASSERT(measureError(48000, 16000, Resampler::Quality::BEST, supportedSet) < 5e-5);
+    TEST_ASSERT(measureError(44100, 48000, Resampler::Quality::HIGH, FormatConverter::InstructionSet::SSE2) < 5e-5);
+}
+
+void TestResampler::testStereo()
+{
+    //both channels must be resampled independently
+    const std::vector<float> left = createSine(1000, 48000, 960);
+    const std::vector<float> right = createSine(3000, 48000, 960);
+    std::vector<float> interleaved(2 * 960);
+    for(unsigned int i = 0; i < 960; i++)
+    {
+        interleaved[2 * i] = left[i];
+        interleaved[2 * i + 1] = right[i];
+    }
+    Resampler stereo(48000, 24000, 2, Resampler::Quality::MEDIUM, 960);
+    Resampler mono(48000, 24000, 1, Resampler::Quality::MEDIUM, 960);
+    std::vector<float> stereoOutput(2 * stereo.getMaximumOutputFrames(960));
+    std::vector<float> monoOutput(mono.getMaximumOutputFrames(960));
+    const unsigned int frames = stereo.process(interleaved.data(), 960, stereoOutput.data());
+    TEST_ASSERT_EQUALS(frames, mono.process(right.data(), 960, monoOutput.data()));
+    for(unsigned int i = 0; i < frames; i++)
+    {
+        TEST_ASSERT_EQUALS(monoOutput[i], stereoOutput[2 * i + 1]);
+    }
+}
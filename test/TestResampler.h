@@ -0,0 +1,19 @@
+#ifndef TESTRESAMPLER_H
+#define TESTRESAMPLER_H
+
+#include "cpptest.h"
+#include "Resampler.h"
+
+class TestResampler : public Test::Suite
+{
+public:
+    TestResampler();
+
+    void testInvalidRatio();
+    void testNumberOfFrames();
+    void testSineAccuracy();
+    void testVectorizedResampling();
+    void testStereo();
+};
+
+#endif // TESTRESAMPLER_H
@@ -0,0 +1,109 @@
+#include "TestStatistics.h"
+
+#include <thread>
+
+TestStatistics::TestStatistics()
+{
+    TEST_ADD(TestStatistics::testConcurrentIncrements);
+    TEST_ADD(TestStatistics::testSetAndMaximum);
+    TEST_ADD(TestStatistics::testSnapshot);
+    TEST_ADD(TestStatistics::testLatencies);
+}
+
+void TestStatistics::testConcurrentIncrements()
+{
+    Statistics::resetCounters();
+    //more threads than shards, so some threads share a shard
+    std::vector<std::thread> threads;
+    for(unsigned int t = 0; t < 12; t++)
+    {
+        threads.push_back(std::thread([]()
+        {
+            for(unsigned int i = 0; i < 100000; i++)
+            {
+                Statistics::incrementCounter(Statistics::COUNTER_PACKAGES_SENT);
+                Statistics::incrementCounter(Statistics::COUNTER_PAYLOAD_BYTES_SENT, 3);
+            }
+        }));
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    //no increment is lost
+    TEST_ASSERT_EQUALS(1200000, Statistics::readCounter(Statistics::COUNTER_PACKAGES_SENT));
+    TEST_ASSERT_EQUALS(3600000, Statistics::readCounter(Statistics::COUNTER_PAYLOAD_BYTES_SENT));
+    Statistics::resetCounters();
+    TEST_ASSERT_EQUALS(0, Statistics::readCounter(Statistics::COUNTER_PACKAGES_SENT));
+}
+
+void TestStatistics::testSetAndMaximum()
+{
+    Statistics::resetCounters();
+    //increments of another thread are overwritten by the new value
+    std::thread([]() { Statistics::incrementCounter(Statistics::RTP_BUFFER_LIMIT, 5); }).join();
+    Statistics::setCounter(Statistics::RTP_BUFFER_LIMIT, 64);
+    TEST_ASSERT_EQUALS(64, Statistics::readCounter(Statistics::RTP_BUFFER_LIMIT));
+
+    std::vector<std::thread> threads;
+    for(long t = 0; t < 4; t++)
+    {
+        threads.push_back(std::thread([t]()
+        {
+            for(long i = 0; i < 10000; i++)
+            {
+                Statistics::maxCounter(Statistics::RTP_BUFFER_MAXIMUM_USAGE, i * 4 + t);
+            }
+        }));
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    TEST_ASSERT_EQUALS(39999, Statistics::readCounter(Statistics::RTP_BUFFER_MAXIMUM_USAGE));
+    Statistics::maxCounter(Statistics::RTP_BUFFER_MAXIMUM_USAGE, 17);
+    TEST_ASSERT_EQUALS(39999, Statistics::readCounter(Statistics::RTP_BUFFER_MAXIMUM_USAGE));
+    Statistics::resetCounters();
+}
+
+void TestStatistics::testSnapshot()
+{
+    Statistics::resetCounters();
+    Statistics::incrementCounter(Statistics::COUNTER_FRAMES_RECORDED, 256);
+    std::thread([]() { Statistics::incrementCounter(Statistics::COUNTER_FRAMES_RECORDED, 512); }).join();
+    Statistics::setCounter(Statistics::TOTAL_ELAPSED_MILLISECONDS, 1000);
+
+    const Statistics::CounterSnapshot snapshot = Statistics::takeSnapshot();
+    TEST_ASSERT_EQUALS(768, snapshot[Statistics::COUNTER_FRAMES_RECORDED]);
+    TEST_ASSERT_EQUALS(1000, snapshot[Statistics::TOTAL_ELAPSED_MILLISECONDS]);
+    TEST_ASSERT_EQUALS(0, snapshot[Statistics::COUNTER_PACKAGES_LOST]);
+
+    //the snapshot is not changed by later updates
+    Statistics::incrementCounter(Statistics::COUNTER_FRAMES_RECORDED, 256);
+    TEST_ASSERT_EQUALS(768, snapshot[Statistics::COUNTER_FRAMES_RECORDED]);
+    TEST_ASSERT_EQUALS(1024, Statistics::takeSnapshot()[Statistics::COUNTER_FRAMES_RECORDED]);
+    Statistics::resetCounters();
+}
+
+void TestStatistics::testLatencies()
+{
+    Statistics::resetCounters();
+    //the components are recorded from different threads
+    std::thread([]()
+    {
+        Statistics::recordLatency(Statistics::LATENCY_NETWORK, 30000000);
+        Statistics::recordLatency(Statistics::LATENCY_NETWORK, 50000000);
+    }).join();
+    Statistics::recordLatency(Statistics::LATENCY_JITTER_BUFFER, 40000000);
+    Statistics::recordLatency(Statistics::LATENCY_MOUTH_TO_EAR, 100000000);
+
+    TEST_ASSERT_EQUALS(2u, Statistics::getLatency(Statistics::LATENCY_NETWORK).getCount());
+    TEST_ASSERT_EQUALS(80000000u, Statistics::getLatency(Statistics::LATENCY_NETWORK).getTotal());
+    TEST_ASSERT_EQUALS(50000000u, Statistics::getLatency(Statistics::LATENCY_NETWORK).getMaximum());
+    TEST_ASSERT_EQUALS(1u, Statistics::getLatency(Statistics::LATENCY_JITTER_BUFFER).getCount());
+    TEST_ASSERT_EQUALS(0u, Statistics::getLatency(Statistics::LATENCY_OUTPUT).getCount());
+
+    Statistics::resetCounters();
+    TEST_ASSERT_EQUALS(0u, Statistics::getLatency(Statistics::LATENCY_NETWORK).getCount());
+    TEST_ASSERT_EQUALS(0u, Statistics::getLatency(Statistics::LATENCY_MOUTH_TO_EAR).getCount());
+}
@@ -0,0 +1,18 @@
+#ifndef TESTSTATISTICS_H
+#define TESTSTATISTICS_H
+
+#include "cpptest.h"
+#include "Statistics.h"
+
+class TestStatistics : public Test::Suite
+{
+public:
+    TestStatistics();
+
+    void testConcurrentIncrements();
+    void testSetAndMaximum();
+    void testSnapshot();
+    void testLatencies();
+};
+
+#endif // TESTSTATISTICS_H
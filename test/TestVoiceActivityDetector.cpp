@@ -0,0 +1,150 @@
+#include "TestVoiceActivityDetector.h"
+
+#include <vector>
+#include <cmath>
+
+static const double PI = 3.14159265358979323846;
+//20 ms at 48 kHz
+static const unsigned int FRAMES = 960;
+
+TestVoiceActivityDetector::TestVoiceActivityDetector()
+{
+    TEST_ADD(TestVoiceActivityDetector::testFeatures);
+    TEST_ADD(TestVoiceActivityDetector::testVectorizedFeatures);
+    TEST_ADD(TestVoiceActivityDetector::testSilenceAndNoise);
+    TEST_ADD(TestVoiceActivityDetector::testSpeechAndHangover);
+}
+
+//white noise with the given amplitude relative to full-scale
+static void fillNoise(std::vector<float>& samples, const float amplitude, uint32_t& randomState)
+{
+    for(float& sample : samples)
+    {
+        randomState = randomState * 1664525 + 1013904223;
+        sample = ((int32_t)randomState / 2147483648.0f) * amplitude;
+    }
+}
+
+//a vowel-like signal: a 150 Hz fundamental with decaying harmonics
+static void fillVoiced(std::vector<float>& samples, const float amplitude, const unsigned int offset)
+{
+    for(unsigned int i = 0; i < samples.size(); i++)
+    {
+        double sample = 0;
+        for(unsigned int harmonic = 1; harmonic <= 5; harmonic++)
+        {
+            sample += sin(2 * PI * 150 * harmonic * (offset + i) / 48000.0) / harmonic;
+        }
+        samples[i] = (float)(sample * amplitude / 2);
+    }
+}
+
+void TestVoiceActivityDetector::testFeatures()
+{
+    VoiceActivityDetector detector(48000, 1, 9, FormatConverter::InstructionSet::SCALAR);
+    //a square-wave at full-scale
+    std::vector<int16_t> square(FRAMES);
+    for(unsigned int i = 0; i < FRAMES; i++)
+    {
+        square[i] = (i / 48) % 2 == 0 ? -32768 : 32767;
+    }
+    const VoiceActivityDetector::Features features = detector.calculateFeatures(square.data(), FRAMES);
+    TEST_ASSERT(fabs(features.power - 1.0f) < 1e-3f);
+    //every 48th pair of samples changes its sign
+    TEST_ASSERT(fabs(features.zeroCrossingRate - 19.0f / 959) < 1e-4f);
+    TEST_ASSERT(features.correlation > 0.85f);
+
+    std::vector<float> noise(FRAMES);
+    uint32_t randomState = 1;
+    fillNoise(noise, 0.5f, randomState);
+    const VoiceActivityDetector::Features noiseFeatures = detector.calculateFeatures(noise.data(), FRAMES);
+    //uniform noise has a power of amplitude^2 / 3
+    TEST_ASSERT(fabs(noiseFeatures.power - 0.25f / 3) < 0.01f);
+    TEST_ASSERT(fabs(noiseFeatures.correlation) < 0.1f);
+    TEST_ASSERT(fabs(noiseFeatures.zeroCrossingRate - 0.5f) < 0.05f);
+}
+
+void TestVoiceActivityDetector::testVectorizedFeatures()
+{
+    //odd number of frames and stereo to test the remainders and the lag
+    const unsigned int frames = 1001;
+    std::vector<float> samples(frames * 2);
+    uint32_t randomState = 7;
+    fillNoise(samples, 0.8f, randomState);
+    std::vector<int16_t> intSamples(samples.size());
+    for(unsigned int i = 0; i < samples.size(); i++)
+    {
+        intSamples[i] = (int16_t)(samples[i] * 32767);
+    }
+    VoiceActivityDetector scalar(48000, 2, 9, FormatConverter::InstructionSet::SCALAR);
+    const VoiceActivityDetector::Features expected = scalar.calculateFeatures(samples.data(), frames);
+    const VoiceActivityDetector::Features expectedInt = scalar.calculateFeatures(intSamples.data(), frames);
+    for(const FormatConverter::InstructionSet set : {FormatConverter::InstructionSet::SSE2, FormatConverter::InstructionSet::AVX2, FormatConverter::InstructionSet::NEON})
+    {
+        VoiceActivityDetector detector(48000, 2, 9, set);
+        const VoiceActivityDetector::Features features = detector.calculateFeatures(samples.data(), frames);
+        TEST_ASSERT(fabs(features.power - expected.power) < 1e-5f);
+        TEST_ASSERT(fabs(features.correlation - expected.correlation) < 1e-4f);
+        TEST_ASSERT_EQUALS(expected.zeroCrossingRate, features.zeroCrossingRate);
+        const VoiceActivityDetector::Features intFeatures = detector.calculateFeatures(intSamples.data(), frames);
+        TEST_ASSERT(fabs(intFeatures.power - expectedInt.power) < 1e-5f);
+        TEST_ASSERT(fabs(intFeatures.correlation - expectedInt.correlation) < 1e-4f);
+        TEST_ASSERT_EQUALS(expectedInt.zeroCrossingRate, intFeatures.zeroCrossingRate);
+    }
+}
+
+void TestVoiceActivityDetector::testSilenceAndNoise()
+{
+    VoiceActivityDetector detector(48000, 1, 9);
+    std::vector<float> samples(FRAMES, 0.0f);
+    TEST_ASSERT(!detector.isSpeech(samples.data(), FRAMES));
+
+    //constant background noise at -40 dB is detected as speech at first, until the noise-floor has adapted
+    uint32_t randomState = 3;
+    unsigned int speechBuffers = 0;
+    for(unsigned int i = 0; i < 500; i++)
+    {
+        fillNoise(samples, 0.0173f, randomState);
+        speechBuffers += detector.isSpeech(samples.data(), FRAMES);
+    }
+    TEST_ASSERT(detector.getNoiseFloor() > -45 && detector.getNoiseFloor() < -35);
+    for(unsigned int i = 0; i < 100; i++)
+    {
+        fillNoise(samples, 0.0173f, randomState);
+        TEST_ASSERT(!detector.isSpeech(samples.data(), FRAMES));
+    }
+}
+
+void TestVoiceActivityDetector::testSpeechAndHangover()
+{
+    VoiceActivityDetector detector(48000, 1, 9);
+    std::vector<float> samples(FRAMES);
+    uint32_t randomState = 5;
+    //adapt to background noise at -50 dB
+    for(unsigned int i = 0; i < 500; i++)
+    {
+        fillNoise(samples, 0.0055f, randomState);
+        detector.isSpeech(samples.data(), FRAMES);
+    }
+    //voiced speech at -20 dB
+    for(unsigned int i = 0; i < 50; i++)
+    {
+        fillVoiced(samples, 0.1f, i * FRAMES);
+        TEST_ASSERT(detector.isSpeech(samples.data(), FRAMES));
+    }
+    //the hangover of 200 ms keeps the 10 following buffers active
+    for(unsigned int i = 0; i < 10; i++)
+    {
+        fillNoise(samples, 0.0055f, randomState);
+        TEST_ASSERT(detector.isSpeech(samples.data(), FRAMES));
+    }
+    fillNoise(samples, 0.0055f, randomState);
+    TEST_ASSERT(!detector.isSpeech(samples.data(), FRAMES));
+
+    //quiet voiced speech below the threshold (~8.5 dB above the noise) is still detected
+    for(unsigned int i = 0; i < 10; i++)
+    {
+        fillVoiced(samples, 0.02f, i * FRAMES);
+        TEST_ASSERT(detector.isSpeech(samples.data(), FRAMES));
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef TESTVOICEACTIVITYDETECTOR_H
+#define TESTVOICEACTIVITYDETECTOR_H
+
+#include "cpptest.h"
+#include "VoiceActivityDetector.h"
+
+class TestVoiceActivityDetector : public Test::Suite
+{
+public:
+    TestVoiceActivityDetector();
+
+    void testFeatures();
+    void testVectorizedFeatures();
+    void testSilenceAndNoise();
+    void testSpeechAndHangover();
+};
+
+#endif // TESTVOICEACTIVITYDETECTOR_H
@@ -0,0 +1,177 @@
+#include "TestWAVWriter.h"
+
+#include <cstdio>
+#include <chrono>
+#include <algorithm>
+
+static const char* FILE_NAME = "TestWAVWriter.wav";
+
+TestWAVWriter::TestWAVWriter()
+{
+    TEST_ADD(TestWAVWriter::testHeader);
+    TEST_ADD(TestWAVWriter::testFormats);
+    TEST_ADD(TestWAVWriter::testHeaderUpdatedWhileWriting);
+    TEST_ADD(TestWAVWriter::testFullBuffer);
+    TEST_ADD(TestWAVWriter::testSilence);
+}
+
+static std::vector<uint8_t> readFile()
+{
+    std::vector<uint8_t> contents;
+    FILE* file = fopen(FILE_NAME, "rb");
+    if(file != nullptr)
+    {
+        int byte;
+        while((byte = fgetc(file)) != EOF)
+        {
+            contents.push_back((uint8_t)byte);
+        }
+        fclose(file);
+    }
+    return contents;
+}
+
+static uint32_t readLittleEndian(const std::vector<uint8_t>& contents, const unsigned int offset, const unsigned int numberOfBytes)
+{
+    uint32_t value = 0;
+    for(unsigned int i = 0; i < numberOfBytes && offset + i < contents.size(); i++)
+    {
+        value |= (uint32_t)contents[offset + i] << (8 * i);
+    }
+    return value;
+}
+
+static std::vector<uint8_t> createSamples(const unsigned int size)
+{
+    std::vector<uint8_t> samples(size);
+    for(unsigned int i = 0; i < size; i++)
+    {
+        samples[i] = (uint8_t)(i * 7);
+    }
+    return samples;
+}
+
+void TestWAVWriter::testHeader()
+{
+    const std::vector<uint8_t> samples = createSamples(4 * 441);
+    {
+        WAVWriter writer(FILE_NAME, AudioFormat::SIGNED_INT_16, 44100, 2);
+        TEST_ASSERT(writer.isOpen());
+        //several audio-buffers
+        for(unsigned int i = 0; i < 10; i++)
+        {
+            TEST_ASSERT(writer.write(samples.data(), samples.size()));
+        }
+    }
+    const std::vector<uint8_t> contents = readFile();
+    //the canonical 44 byte header
+    TEST_ASSERT_EQUALS(44 + 10 * samples.size(), contents.size());
+    TEST_ASSERT_EQUALS(std::string("RIFF"), std::string(contents.begin(), contents.begin() + 4));
+    TEST_ASSERT_EQUALS(contents.size() - 8, readLittleEndian(contents, 4, 4));
+    TEST_ASSERT_EQUALS(std::string("WAVEfmt "), std::string(contents.begin() + 8, contents.begin() + 16));
+    TEST_ASSERT_EQUALS(1u, readLittleEndian(contents, 20, 2));
+    TEST_ASSERT_EQUALS(2u, readLittleEndian(contents, 22, 2));
+    TEST_ASSERT_EQUALS(44100u, readLittleEndian(contents, 24, 4));
+    TEST_ASSERT_EQUALS(44100u * 4, readLittleEndian(contents, 28, 4));
+    TEST_ASSERT_EQUALS(4u, readLittleEndian(contents, 32, 2));
+    TEST_ASSERT_EQUALS(16u, readLittleEndian(contents, 34, 2));
+    TEST_ASSERT_EQUALS(std::string("data"), std::string(contents.begin() + 36, contents.begin() + 40));
+    TEST_ASSERT_EQUALS(10 * samples.size(), readLittleEndian(contents, 40, 4));
+    TEST_ASSERT(std::equal(samples.begin(), samples.end(), contents.begin() + 44 + 9 * samples.size()));
+    remove(FILE_NAME);
+}
+
+void TestWAVWriter::testFormats()
+{
+    //8 bit is unsigned, more than 16 bit uses WAVE_FORMAT_EXTENSIBLE with the PCM or IEEE float sub-format
+    {
+        WAVWriter writer(FILE_NAME, AudioFormat::SIGNED_INT_8, 8000, 1);
+        const int8_t samples[] = {-128, -1, 0, 127};
+        writer.write(samples, sizeof(samples));
+    }
+    std::vector<uint8_t> contents = readFile();
+    TEST_ASSERT_EQUALS(44u + 4, contents.size());
+    TEST_ASSERT_EQUALS(8u, readLittleEndian(contents, 34, 2));
+    TEST_ASSERT_EQUALS(0xFF807F00u, readLittleEndian(contents, 44, 4));
+
+    for(const AudioFormat format : {AudioFormat::SIGNED_INT_24, AudioFormat::SIGNED_INT_32, AudioFormat::FLOAT_32, AudioFormat::FLOAT_64})
+    {
+        const unsigned int frameSize = getAudioFormatSize(format) * 6;
+        const std::vector<uint8_t> samples = createSamples(frameSize * 128);
+        {
+            WAVWriter writer(FILE_NAME, format, 96000, 6);
+            writer.write(samples.data(), samples.size());
+        }
+        contents = readFile();
+        TEST_ASSERT_EQUALS(68 + samples.size(), contents.size());
+        TEST_ASSERT_EQUALS(contents.size() - 8, readLittleEndian(contents, 4, 4));
+        TEST_ASSERT_EQUALS(40u, readLittleEndian(contents, 16, 4));
+        TEST_ASSERT_EQUALS(0xFFFEu, readLittleEndian(contents, 20, 2));
+        TEST_ASSERT_EQUALS(6u, readLittleEndian(contents, 22, 2));
+        TEST_ASSERT_EQUALS(96000u, readLittleEndian(contents, 24, 4));
+        TEST_ASSERT_EQUALS(96000 * frameSize, readLittleEndian(contents, 28, 4));
+        TEST_ASSERT_EQUALS(frameSize, readLittleEndian(contents, 32, 2));
+        TEST_ASSERT_EQUALS(getAudioFormatSize(format) * 8, readLittleEndian(contents, 34, 2));
+        const unsigned int formatTag = format == AudioFormat::FLOAT_32 || format == AudioFormat::FLOAT_64 ? 3 : 1;
+        TEST_ASSERT_EQUALS(formatTag, readLittleEndian(contents, 44, 4));
+        TEST_ASSERT_EQUALS(samples.size(), readLittleEndian(contents, 64, 4));
+        TEST_ASSERT(std::equal(samples.begin(), samples.end(), contents.begin() + 68));
+    }
+    remove(FILE_NAME);
+}
+
+void TestWAVWriter::testHeaderUpdatedWhileWriting()
+{
+    const std::vector<uint8_t> samples = createSamples(4 * 480);
+    WAVWriter writer(FILE_NAME, AudioFormat::SIGNED_INT_16, 48000, 2);
+    TEST_ASSERT(writer.write(samples.data(), samples.size()));
+    //the file is valid without being closed, e.g. after a crash
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> contents = readFile();
+    while(readLittleEndian(contents, 40, 4) != samples.size() && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        contents = readFile();
+    }
+    TEST_ASSERT_EQUALS(samples.size(), writer.getWrittenBytes());
+    TEST_ASSERT_EQUALS(44 + samples.size(), contents.size());
+    TEST_ASSERT_EQUALS(samples.size(), readLittleEndian(contents, 40, 4));
+    TEST_ASSERT_EQUALS(contents.size() - 8, readLittleEndian(contents, 4, 4));
+    writer.close();
+    remove(FILE_NAME);
+}
+
+void TestWAVWriter::testFullBuffer()
+{
+    //the minimum capacity of the ring-buffer is 64 KB
+    const std::vector<uint8_t> samples = createSamples(128 * 1024);
+    WAVWriter writer(FILE_NAME, AudioFormat::SIGNED_INT_16, 8000, 1, 100);
+    TEST_ASSERT(!writer.write(samples.data(), samples.size()));
+    TEST_ASSERT_EQUALS(samples.size(), writer.getDroppedBytes());
+    writer.close();
+    TEST_ASSERT_EQUALS(0u, writer.getWrittenBytes());
+    TEST_ASSERT(!writer.write(samples.data(), 2));
+    remove(FILE_NAME);
+}
+
+void TestWAVWriter::testSilence()
+{
+    const std::vector<uint8_t> samples = createSamples(4 * 480);
+    {
+        WAVWriter writer(FILE_NAME, AudioFormat::SIGNED_INT_16, 48000, 2);
+        TEST_ASSERT(writer.write(samples.data(), samples.size()));
+        //more than the block of zeroes the silence is written from
+        TEST_ASSERT(writer.writeSilence(4800));
+        TEST_ASSERT(writer.write(samples.data(), samples.size()));
+        //more than the ring-buffer can hold
+        TEST_ASSERT(!writer.writeSilence(48000 * 10));
+        TEST_ASSERT_EQUALS(4u * 48000 * 10, writer.getDroppedBytes());
+    }
+    const std::vector<uint8_t> contents = readFile();
+    TEST_ASSERT_EQUALS(44 + 2 * samples.size() + 4 * 4800, contents.size());
+    TEST_ASSERT(std::equal(samples.begin(), samples.end(), contents.begin() + 44));
+    const auto silenceStart = contents.begin() + 44 + samples.size();
+    TEST_ASSERT(std::all_of(silenceStart, silenceStart + 4 * 4800, [](uint8_t byte) { return byte == 0; }));
+    TEST_ASSERT(std::equal(samples.begin(), samples.end(), silenceStart + 4 * 4800));
+    remove(FILE_NAME);
+}
@@ -0,0 +1,19 @@
+#ifndef TESTWAVWRITER_H
+#define TESTWAVWRITER_H
+
+#include "cpptest.h"
+#include "WAVWriter.h"
+
+class TestWAVWriter : public Test::Suite
+{
+public:
+    TestWAVWriter();
+
+    void testHeader();
+    void testFormats();
+    void testHeaderUpdatedWhileWriting();
+    void testFullBuffer();
+    void testSilence();
+};
+
+#endif // TESTWAVWRITER_H
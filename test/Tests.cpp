@@ -3,6 +3,7 @@
 TestAudioIO::TestAudioIO() {
 	TEST_ADD(TestAudioIO::testAudioHandlerInstances);
 	TEST_ADD(TestAudioIO::testAudioProcessorInterface);
+	TEST_ADD(TestAudioIO::testAudioFormats);
 }
 
 void TestAudioIO::testAudioHandlerInstances()
@@ -34,6 +35,21 @@ void TestAudioIO::testAudioProcessorInterface()
 
 }
 
+void TestAudioIO::testAudioFormats()
+{
+	//the formats are told apart by their value, e.g. when selecting a conversion
+	const AudioFormat formats[] = {AudioFormat::SIGNED_INT_8, AudioFormat::SIGNED_INT_16, AudioFormat::SIGNED_INT_24,
+		AudioFormat::SIGNED_INT_32, AudioFormat::FLOAT_32, AudioFormat::FLOAT_64};
+	const unsigned int numberOfFormats = sizeof(formats) / sizeof(formats[0]);
+	for(unsigned int i = 0; i < numberOfFormats; i++)
+	{
+		for(unsigned int k = i + 1; k < numberOfFormats; k++)
+		{
+			TEST_ASSERT_MSG(formats[i] != formats[k], "Audio-formats share a value.");
+		}
+	}
+}
+
 int main(int argc, char** argv)
 {
     #if TEST_OUTPUT_CONSOLE == 1
@@ -68,6 +84,60 @@ int main(int argc, char** argv)
 
     TestRTPBuffer testBuffer;
     testBuffer.run(output);
+
+    TestFEC testFEC;
+    testFEC.run(output);
+
+    TestSRTP testSRTP;
+    testSRTP.run(output);
+
+    TestComfortNoise testComfortNoise;
+    testComfortNoise.run(output);
+
+    TestAudioRingBuffer testRingBuffer;
+    testRingBuffer.run(output);
+
+    TestFormatConverter testFormatConverter;
+    testFormatConverter.run(output);
+
+    TestResampler testResampler;
+    testResampler.run(output);
+
+    TestAudioInterface testAudioInterface;
+    testAudioInterface.run(output);
+
+    TestVoiceActivityDetector testVoiceActivityDetector;
+    testVoiceActivityDetector.run(output);
+
+    TestOpusMultistream testOpusMultistream;
+    testOpusMultistream.run(output);
+
+    TestG711 testG711;
+    testG711.run(output);
+
+    TestG722 testG722;
+    testG722.run(output);
+
+    TestL16 testL16;
+    testL16.run(output);
+
+    TestLosslessCodec testLosslessCodec;
+    testLosslessCodec.run(output);
+
+    TestWAVWriter testWAVWriter;
+    testWAVWriter.run(output);
+
+    TestFileAudioWrapper testFileAudioWrapper;
+    testFileAudioWrapper.run(output);
+
+    TestOggOpusWriter testOggOpusWriter;
+    testOggOpusWriter.run(output);
+
+    TestStatistics testStatistics;
+    testStatistics.run(output);
+
+    TestLatencyHistogram testLatencyHistogram;
+    testLatencyHistogram.run(output);
     
     TestAudioProcessors testProcessors;
     testProcessors.run(output);
@@ -8,9 +8,27 @@
 #include "TestParameters.h"
 #include "TestConfigurationModes.h"
 #include "TestNetworkWrappers.h"
+#include "TestComfortNoise.h"
+#include "TestAudioRingBuffer.h"
+#include "TestFormatConverter.h"
+#include "TestResampler.h"
+#include "TestAudioInterface.h"
+#include "TestVoiceActivityDetector.h"
+#include "TestOpusMultistream.h"
+#include "TestG711.h"
+#include "TestG722.h"
+#include "TestL16.h"
+#include "TestLosslessCodec.h"
+#include "TestWAVWriter.h"
+#include "TestFileAudioWrapper.h"
+#include "TestOggOpusWriter.h"
+#include "TestStatistics.h"
+#include "TestLatencyHistogram.h"
 #include "rtp/TestRTP.h"
 #include "rtp/TestRTCP.h"
 #include "rtp/TestRTPBuffer.h"
+#include "rtp/TestFEC.h"
+#include "rtp/TestSRTP.h"
 
 #include <iostream>
 #include <fstream>
@@ -18,6 +36,7 @@
 class TestAudioIO : public Test::Suite {
     void testAudioHandlerInstances(); // getNewAudioIO(..)
     void testAudioProcessorInterface(); // add, remove, reset
+    void testAudioFormats(); // distinct values
 public:
     TestAudioIO();
 };
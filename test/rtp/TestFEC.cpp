@@ -0,0 +1,137 @@
+#include "TestFEC.h"
+
+#include <string>
+#include <vector>
+
+TestFEC::TestFEC() : payloadSize(64), groupSize(4)
+{
+    TEST_ADD(TestFEC::testXORBuffers);
+    TEST_ADD(TestFEC::testRecoverLostPackage);
+    TEST_ADD(TestFEC::testDoubleLossNotRecovered);
+    TEST_ADD(TestFEC::testRecoverAggregatedPackage);
+}
+
+void TestFEC::testXORBuffers()
+{
+    //use an odd size to test the non-vectorized remainder
+    char a[37];
+    char b[37];
+    for(unsigned int i = 0; i < 37; i++)
+    {
+        a[i] = (char)i;
+        b[i] = (char)(3 * i + 1);
+    }
+    ParityFEC::xorBuffers(a, b, 37);
+    for(unsigned int i = 0; i < 37; i++)
+    {
+        TEST_ASSERT_EQUALS((char)(i ^ (3 * i + 1)), a[i]);
+    }
+}
+
+void TestFEC::testRecoverLostPackage()
+{
+    RTPPackageHandler package(payloadSize);
+    RTPPackageHandler fecPackage(FEC_HEADER_SIZE + payloadSize, PayloadType::FEC);
+    ParityFEC fec(groupSize, payloadSize);
+    RTPBuffer buffer(16, 1000);
+    const std::vector<std::string> payloads = {"First payload", "Second, longer payload", "Third", "Fourth payload"};
+
+    for(unsigned int i = 0; i < payloads.size(); i++)
+    {
+        package.createNewRTPPackage(payloads[i].c_str(), payloads[i].size());
+        const bool groupComplete = fec.addPackage(package.getRTPPackageHeader(), payloads[i].c_str(), payloads[i].size());
+        const bool lastPackage = i == payloads.size() - 1;
+        TEST_ASSERT_EQUALS(lastPackage, groupComplete);
+        //the second package is lost
+        if(i != 1)
+        {
+            TEST_ASSERT_EQUALS(RTPBufferStatus::RTP_BUFFER_ALL_OKAY, buffer.addPackage(package, payloads[i].size()));
+        }
+    }
+    TEST_ASSERT_EQUALS(3, buffer.getSize());
+    fecPackage.createNewRTPPackage(fec.getFECPayload(), fec.getFECPayloadSize());
+    TEST_ASSERT_EQUALS(RTPBufferStatus::RTP_BUFFER_ALL_OKAY, buffer.addFECPackage(fecPackage, fec.getFECPayloadSize()));
+    TEST_ASSERT_EQUALS(4, buffer.getSize());
+
+    for(unsigned int i = 0; i < payloads.size(); i++)
+    {
+        TEST_ASSERT_EQUALS(RTPBufferStatus::RTP_BUFFER_ALL_OKAY, buffer.readPackage(package));
+        TEST_ASSERT_EQUALS(payloads[i].size(), package.getActualPayloadSize());
+        TEST_ASSERT_EQUALS(payloads[i], std::string((const char*)package.getRTPPackageData(), package.getActualPayloadSize()));
+        TEST_ASSERT_EQUALS(package.getSSRC(), package.getRTPPackageHeader()->getSSRC());
+    }
+}
+
+void TestFEC::testDoubleLossNotRecovered()
+{
+    RTPPackageHandler package(payloadSize);
+    RTPPackageHandler fecPackage(FEC_HEADER_SIZE + payloadSize, PayloadType::FEC);
+    ParityFEC fec(groupSize, payloadSize);
+    RTPBuffer buffer(16, 1000);
+    const std::string payload("Some payload");
+
+    for(unsigned int i = 0; i < groupSize; i++)
+    {
+        package.createNewRTPPackage(payload.c_str(), payload.size());
+        fec.addPackage(package.getRTPPackageHeader(), payload.c_str(), payload.size());
+        //the second and third packages are lost
+        if(i != 1 && i != 2)
+        {
+            buffer.addPackage(package, payload.size());
+        }
+    }
+    fecPackage.createNewRTPPackage(fec.getFECPayload(), fec.getFECPayloadSize());
+    buffer.addFECPackage(fecPackage, fec.getFECPayloadSize());
+    //a single parity-package can't recover two lost packages
+    TEST_ASSERT_EQUALS(2, buffer.getSize());
+}
+
+void TestFEC::testRecoverAggregatedPackage()
+{
+    const uint8_t framesPerPackage = 3;
+    const unsigned int maximumPayloadSize = FrameAggregator::getMaximumPayloadSize(framesPerPackage, payloadSize);
+    RTPPackageHandler package(maximumPayloadSize);
+    FrameAggregator aggregator(framesPerPackage, payloadSize);
+    ParityFEC fec(groupSize, maximumPayloadSize);
+    ParityFECRecovery recovery(maximumPayloadSize);
+    std::vector<std::string> frames;
+    std::vector<std::string> lostPayload;
+
+    for(unsigned int i = 0; i < groupSize * framesPerPackage; i++)
+    {
+        frames.push_back("Frame number " + std::to_string(i) + std::string(i % 5, 'x'));
+        if(!aggregator.addFrame(frames[i].c_str(), frames[i].size()))
+        {
+            continue;
+        }
+        const unsigned int packageIndex = i / framesPerPackage;
+        package.createNewRTPPackage(aggregator.getPayload(), aggregator.getPayloadSize());
+        fec.addPackage(package.getRTPPackageHeader(), aggregator.getPayload(), aggregator.getPayloadSize());
+        //the third package is lost
+        if(packageIndex == 2)
+        {
+            lostPayload.push_back(std::string((const char*)aggregator.getPayload(), aggregator.getPayloadSize()));
+            continue;
+        }
+        TEST_ASSERT(recovery.addPackage(package.getRTPPackageHeader(), aggregator.getPayload(), aggregator.getPayloadSize()));
+    }
+    //the FEC-package is not applied to the frames, but to the aggregated packages
+    TEST_ASSERT(recovery.recoverPackage(fec.getFECPayload(), fec.getFECPayloadSize()));
+    TEST_ASSERT_EQUALS((uint16_t)(package.getRTPPackageHeader()->getSequenceNumber() - 1), recovery.getRecoveredHeader().getSequenceNumber());
+    TEST_ASSERT_EQUALS(package.getRTPPackageHeader()->getSSRC(), recovery.getRecoveredHeader().getSSRC());
+    TEST_ASSERT_EQUALS(lostPayload[0], std::string((const char*)recovery.getRecoveredPayload(), recovery.getRecoveredPayloadSize()));
+
+    //the recovered package is split into its original frames
+    const uint8_t numberOfFrames = FrameAggregator::getNumberOfFrames(recovery.getRecoveredPayload(), recovery.getRecoveredPayloadSize());
+    TEST_ASSERT_EQUALS(framesPerPackage, numberOfFrames);
+    for(uint8_t i = 0; i < numberOfFrames; i++)
+    {
+        unsigned int frameSize = 0;
+        const void* frame = FrameAggregator::getFrame(recovery.getRecoveredPayload(), recovery.getRecoveredPayloadSize(), i, frameSize);
+        TEST_ASSERT(frame != nullptr);
+        TEST_ASSERT_EQUALS(frames[2 * framesPerPackage + i], std::string((const char*)frame, frameSize));
+    }
+    //a late arrival of the recovered package is a duplicate, the group can't be recovered again
+    TEST_ASSERT(!recovery.addPackage(&recovery.getRecoveredHeader(), recovery.getRecoveredPayload(), recovery.getRecoveredPayloadSize()));
+    TEST_ASSERT(!recovery.recoverPackage(fec.getFECPayload(), fec.getFECPayloadSize()));
+}
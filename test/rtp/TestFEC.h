@@ -0,0 +1,24 @@
+#ifndef TESTFEC_H
+#define TESTFEC_H
+
+#include "cpptest.h"
+#include "rtp/ParityFEC.h"
+#include "rtp/RTPBuffer.h"
+#include "rtp/FrameAggregator.h"
+
+class TestFEC : public Test::Suite
+{
+public:
+    TestFEC();
+
+    void testXORBuffers();
+    void testRecoverLostPackage();
+    void testDoubleLossNotRecovered();
+    void testRecoverAggregatedPackage();
+
+private:
+    const unsigned int payloadSize;
+    const uint8_t groupSize;
+};
+
+#endif // TESTFEC_H
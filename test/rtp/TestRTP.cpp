@@ -10,6 +10,11 @@
 TestRTP::TestRTP() : Test::Suite()
 {
     TEST_ADD(TestRTP::testRTPPackage);
+    TEST_ADD(TestRTP::testFrameAggregation);
+    TEST_ADD(TestRTP::testCaptureTimeExtension);
+    TEST_ADD(TestRTP::testTruncatedExtension);
+    TEST_ADD(TestRTP::testBufferedCaptureTime);
+    TEST_ADD(TestRTP::testHeaderWithCSRCs);
 }
 
 void TestRTP::testRTPPackage()
@@ -30,3 +35,124 @@ void TestRTP::testRTPPackage()
     TEST_ASSERT(pack.getActualPayloadSize() <= pack.getMaximumPayloadSize());
     TEST_ASSERT(RTPPackageHandler::isRTPPackage(pack.getWorkBuffer(), pack.getActualPayloadSize()));
 }
+
+void TestRTP::testFrameAggregation()
+{
+    const std::string frames[3] = {"First frame", "Second frame", "3rd"};
+    FrameAggregator aggregator(3, 32);
+
+    TEST_ASSERT_MSG(!aggregator.addFrame(frames[0].c_str(), frames[0].size()), "Package completed too early! 01");
+    TEST_ASSERT_MSG(!aggregator.addFrame(frames[1].c_str(), frames[1].size()), "Package completed too early! 02");
+    TEST_ASSERT_MSG(aggregator.addFrame(frames[2].c_str(), frames[2].size()), "Package not completed! 03");
+    TEST_ASSERT(aggregator.getPayloadSize() <= FrameAggregator::getMaximumPayloadSize(3, 32));
+
+    const void* payload = aggregator.getPayload();
+    TEST_ASSERT_EQUALS(3, FrameAggregator::getNumberOfFrames(payload, aggregator.getPayloadSize()));
+    for(uint8_t i = 0; i < 3; i++)
+    {
+        unsigned int frameSize = 0;
+        const void* frame = FrameAggregator::getFrame(payload, aggregator.getPayloadSize(), i, frameSize);
+        TEST_ASSERT(frame != nullptr);
+        TEST_ASSERT_EQUALS(frames[i], std::string((const char*)frame, frameSize));
+    }
+    unsigned int frameSize = 0;
+    TEST_ASSERT_MSG(FrameAggregator::getFrame(payload, aggregator.getPayloadSize(), 3, frameSize) == nullptr, "Non-existing frame returned! 04");
+    //truncated payload
+    TEST_ASSERT_MSG(FrameAggregator::getFrame(payload, aggregator.getPayloadSize() - 1, 2, frameSize) == nullptr, "Truncated frame returned! 05");
+}
+
+void TestRTP::testCaptureTimeExtension()
+{
+    std::string payload("This is a dummy payload");
+    RTPPackageHandler pack(100, PayloadType::OPUS);
+
+    pack.createNewRTPPackage(payload.c_str(), payload.size());
+    TEST_ASSERT_MSG(!pack.getRTPPackageHeader()->hasExtension(), "Extension without capture-time! 01");
+    TEST_ASSERT_EQUALS(0u, pack.getRTPHeaderExtensionSize());
+    TEST_ASSERT_EQUALS(0u, pack.getPackageTiming().captureTime);
+
+    //captured 5 ms ago
+    const uint64_t captureTime = RTPPackageHandler::getWallClockTime() - 5000000;
+    pack.createNewRTPPackage(payload.c_str(), payload.size(), PayloadType::OPUS, captureTime);
+    TEST_ASSERT_MSG(pack.getRTPPackageHeader()->hasExtension(), "No extension written! 02");
+    //profile and length, one element of 12 bytes with its element-header padded to 16 bytes
+    TEST_ASSERT_EQUALS(20u, pack.getRTPHeaderExtensionSize());
+    const RTPHeaderExtension extension = pack.getRTPHeaderExtension();
+    TEST_ASSERT_EQUALS(RTP_HEADER_EXTENSION_ONE_BYTE_PROFILE, extension.getProfile());
+    TEST_ASSERT_EQUALS(4, extension.getLength());
+    TEST_ASSERT_EQUALS_MSG(memcmp(payload.c_str(), pack.getRTPPackageData(), payload.size()), 0, "Payloads don't match! 03");
+
+    const PackageTiming timing = pack.getPackageTiming();
+    TEST_ASSERT_EQUALS_MSG(captureTime, timing.captureTime, "Capture-time not restored from the NTP-format! 04");
+    TEST_ASSERT(timing.sendDelay >= 5000);
+    TEST_ASSERT(timing.sendDelay < 1000000);
+    const unsigned int packageSize = pack.getRTPHeaderSize() + pack.getRTPHeaderExtensionSize() + payload.size();
+    TEST_ASSERT(RTPPackageHandler::isRTPPackage(pack.getWorkBuffer(), packageSize));
+
+    //the next package without capture-time must not keep the extension
+    pack.createNewRTPPackage(payload.c_str(), payload.size());
+    TEST_ASSERT_MSG(!pack.getRTPPackageHeader()->hasExtension(), "Extension of previous package kept! 05");
+    TEST_ASSERT_EQUALS_MSG(memcmp(payload.c_str(), pack.getRTPPackageData(), payload.size()), 0, "Payloads don't match! 06");
+}
+
+void TestRTP::testTruncatedExtension()
+{
+    std::string payload("Payload");
+    RTPPackageHandler pack(100, PayloadType::OPUS);
+    pack.createNewRTPPackage(payload.c_str(), payload.size(), PayloadType::OPUS, RTPPackageHandler::getWallClockTime());
+
+    //the header-extension ends within the package
+    TEST_ASSERT(RTPPackageHandler::isRTPPackage(pack.getWorkBuffer(), RTP_HEADER_MIN_SIZE + 20));
+    //the header-extension is cut off
+    TEST_ASSERT_MSG(!RTPPackageHandler::isRTPPackage(pack.getWorkBuffer(), RTP_HEADER_MIN_SIZE + 19), "Truncated extension accepted! 01");
+    TEST_ASSERT_MSG(!RTPPackageHandler::isRTPPackage(pack.getWorkBuffer(), RTP_HEADER_MIN_SIZE + 2), "Truncated extension accepted! 02");
+
+    //elements of other IDs are skipped
+    uint8_t* element = (uint8_t*)pack.getWorkBuffer() + RTP_HEADER_MIN_SIZE + RTP_HEADER_EXTENSION_MIN_SIZE;
+    element[0] = (2 << 4) | (element[0] & 0x0F);
+    TEST_ASSERT_EQUALS(0u, pack.getPackageTiming().captureTime);
+}
+
+void TestRTP::testBufferedCaptureTime()
+{
+    const std::string frames[2] = {"First frame", "Second frame"};
+    RTPPackageHandler sendPackage(64, PayloadType::OPUS);
+    RTPPackageHandler receivePackage(64, PayloadType::OPUS);
+    RTPBuffer buffer(8, 1000, 1);
+
+    const uint64_t captureTime = RTPPackageHandler::getWallClockTime();
+    sendPackage.createNewRTPPackage(frames[0].c_str(), frames[0].size(), PayloadType::OPUS, captureTime);
+    TEST_ASSERT_EQUALS(RTPBufferStatus::RTP_BUFFER_ALL_OKAY, buffer.addPackage(sendPackage, frames[0].size()));
+    sendPackage.createNewRTPPackage(frames[1].c_str(), frames[1].size());
+    TEST_ASSERT_EQUALS(RTPBufferStatus::RTP_BUFFER_ALL_OKAY, buffer.addPackage(sendPackage, frames[1].size()));
+
+    //the buffer restores the header-extension of the first package
+    TEST_ASSERT_EQUALS(RTPBufferStatus::RTP_BUFFER_ALL_OKAY, buffer.readPackage(receivePackage));
+    TEST_ASSERT_EQUALS(captureTime, receivePackage.getPackageTiming().captureTime);
+    TEST_ASSERT_EQUALS(frames[0], std::string((const char*)receivePackage.getRTPPackageData(), receivePackage.getActualPayloadSize()));
+
+    TEST_ASSERT_EQUALS(RTPBufferStatus::RTP_BUFFER_ALL_OKAY, buffer.readPackage(receivePackage));
+    TEST_ASSERT_MSG(!receivePackage.getRTPPackageHeader()->hasExtension(), "Extension of previous package kept! 01");
+    TEST_ASSERT_EQUALS(frames[1], std::string((const char*)receivePackage.getRTPPackageData(), receivePackage.getActualPayloadSize()));
+}
+
+void TestRTP::testHeaderWithCSRCs()
+{
+    const std::string payload("Mixed payload");
+    RTPPackageHandler pack(100, PayloadType::OPUS);
+    //the header of a received package from a mixer, without its CSRC-list
+    RTPHeader header;
+    header.setPayloadType(PayloadType::OPUS);
+    header.setCSRCCount(15);
+    TEST_ASSERT_EQUALS(15, header.getCSRCCount());
+
+    const uint64_t captureTime = RTPPackageHandler::getWallClockTime();
+    void* payloadBuffer = pack.writeRTPPackageHeader(header, {captureTime, 0});
+    memcpy(payloadBuffer, payload.c_str(), payload.size());
+    TEST_ASSERT_EQUALS(0, pack.getRTPPackageHeader()->getCSRCCount());
+    TEST_ASSERT_EQUALS(RTP_HEADER_MIN_SIZE, pack.getRTPHeaderSize());
+    TEST_ASSERT_EQUALS(captureTime, pack.getPackageTiming().captureTime);
+    TEST_ASSERT(pack.getRTPPackageData() == payloadBuffer);
+    const unsigned int packageSize = pack.getRTPHeaderSize() + pack.getRTPHeaderExtensionSize() + payload.size();
+    TEST_ASSERT(RTPPackageHandler::isRTPPackage(pack.getWorkBuffer(), packageSize));
+}
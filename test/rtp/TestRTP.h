@@ -10,6 +10,8 @@
 
 #include "cpptest.h"
 #include "rtp/RTPPackageHandler.h"
+#include "rtp/RTPBuffer.h"
+#include "FrameAggregator.h"
 
 class TestRTP: public Test::Suite
 {
@@ -17,6 +19,16 @@ public:
     TestRTP();
 
     void testRTPPackage();
+
+    void testFrameAggregation();
+
+    void testCaptureTimeExtension();
+
+    void testTruncatedExtension();
+
+    void testBufferedCaptureTime();
+
+    void testHeaderWithCSRCs();
 };
 
 #endif	/* TESTRTP_H */
@@ -0,0 +1,145 @@
+#include "TestSRTP.h"
+
+#include <string>
+
+static const uint8_t testKey[SRTP_MASTER_KEY_SIZE] = {
+    0x07, 0x7c, 0x61, 0x43, 0xcb, 0x22, 0x1b, 0xc3, 0x55, 0xff, 0x23, 0xd5, 0xf9, 0x84, 0xa1, 0x6e
+};
+static const uint8_t testSalt[SRTP_MASTER_SALT_SIZE] = {
+    0x9a, 0xf3, 0xe9, 0x53, 0x64, 0xeb, 0xac, 0x9c, 0x99, 0xc5, 0xa7, 0xc4
+};
+
+TestSRTP::TestSRTP() : payloadSize(64)
+{
+    TEST_ADD(TestSRTP::testAESGCMVector);
+    TEST_ADD(TestSRTP::testKeyDerivationVector);
+    TEST_ADD(TestSRTP::testPackageVector);
+    TEST_ADD(TestSRTP::testProtectUnprotect);
+    TEST_ADD(TestSRTP::testTamperedPackageRejected);
+    TEST_ADD(TestSRTP::testPackageIndexEstimation);
+}
+
+void TestSRTP::testAESGCMVector()
+{
+    //test case 3 of "The Galois/Counter Mode of Operation" (McGrew, Viega), truncated to two blocks
+    const uint8_t key[16] = {0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c, 0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08};
+    const uint8_t iv[12] = {0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88};
+    const uint8_t plainText[32] = {
+        0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5, 0xa5, 0x59, 0x09, 0xc5, 0xaf, 0xf5, 0x26, 0x9a,
+        0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda, 0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72
+    };
+    const uint8_t cipherText[32] = {
+        0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24, 0x4b, 0x72, 0x21, 0xb7, 0x84, 0xd0, 0xd4, 0x9c,
+        0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0, 0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e
+    };
+    //test both, the hardware accelerated (if supported) and the portable implementation
+    for(unsigned int hardware = 0; hardware < 2; hardware++)
+    {
+        AESGCM cipher(key, hardware == 1);
+        uint8_t data[32];
+        uint8_t tag[AESGCM::TAG_SIZE];
+        memcpy(data, plainText, 32);
+        cipher.encrypt(iv, nullptr, 0, data, 32, tag);
+        TEST_ASSERT_EQUALS(0, memcmp(cipherText, data, 32));
+        TEST_ASSERT(cipher.decrypt(iv, nullptr, 0, data, 32, tag));
+        TEST_ASSERT_EQUALS(0, memcmp(plainText, data, 32));
+    }
+}
+
+void TestSRTP::testKeyDerivationVector()
+{
+    //RFC 3711 appendix B.3, RFC 7714 uses the same key-derivation with a 96 bit salt
+    const uint8_t masterKey[16] = {0xE1, 0xF9, 0x7A, 0x0D, 0x3E, 0x01, 0x8B, 0xE0, 0xD6, 0x4F, 0xA3, 0x2C, 0x06, 0xDE, 0x41, 0x39};
+    const uint8_t masterSalt[14] = {0x0E, 0xC6, 0x75, 0xAD, 0x49, 0x8A, 0xFE, 0xEB, 0xB6, 0x96, 0x0B, 0x3A, 0xAB, 0xE6};
+    const uint8_t cipherKey[16] = {0xC6, 0x1E, 0x7A, 0x93, 0x74, 0x4F, 0x39, 0xEE, 0x10, 0x73, 0x4A, 0xFE, 0x3F, 0xF7, 0xA0, 0x87};
+    const uint8_t cipherSalt[14] = {0x30, 0xCB, 0xBC, 0x08, 0x86, 0x3D, 0x8C, 0x85, 0xD4, 0x9D, 0xB3, 0x4A, 0x9A, 0xE1};
+
+    uint8_t key[16];
+    SRTPContext::deriveKey(masterKey, masterSalt, sizeof(masterSalt), 0x00, key, sizeof(key));
+    TEST_ASSERT_EQUALS(0, memcmp(cipherKey, key, sizeof(key)));
+    uint8_t salt[14];
+    SRTPContext::deriveKey(masterKey, masterSalt, sizeof(masterSalt), 0x02, salt, sizeof(salt));
+    TEST_ASSERT_EQUALS(0, memcmp(cipherSalt, salt, sizeof(salt)));
+}
+
+void TestSRTP::testPackageVector()
+{
+    //RFC 7714 section 16.1.1, the RTP-header is the additional authenticated data
+    const uint8_t key[16] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+    //"Quid pro quo"
+    const uint8_t salt[12] = {0x51, 0x75, 0x69, 0x64, 0x20, 0x70, 0x72, 0x6f, 0x20, 0x71, 0x75, 0x6f};
+    const uint8_t header[12] = {0x80, 0x40, 0xf1, 0x7b, 0x80, 0x41, 0xf8, 0xd3, 0x55, 0x01, 0xa0, 0xb2};
+    const std::string plainText("Gallia est omnis divisa in partes tres");
+    const uint8_t protectedPayload[38 + SRTP_AUTH_TAG_SIZE] = {
+        0xf2, 0x4d, 0xe3, 0xa3, 0xfb, 0x34, 0xde, 0x6c, 0xac, 0xba, 0x86, 0x1c, 0x9d, 0x7e, 0x4b, 0xca,
+        0xbe, 0x63, 0x3b, 0xd5, 0x0d, 0x29, 0x4e, 0x6f, 0x42, 0xa5, 0xf4, 0x7a, 0x51, 0xc7, 0xd1, 0x9b,
+        0x36, 0xde, 0x3a, 0xdf, 0x88, 0x33,
+        //authentication-tag
+        0x89, 0x9d, 0x7f, 0x27, 0xbe, 0xb1, 0x6a, 0x91, 0x52, 0xcf, 0x76, 0x5e, 0xe4, 0x39, 0x0c, 0xce
+    };
+    for(unsigned int hardware = 0; hardware < 2; hardware++)
+    {
+        const SRTPContext context = SRTPContext::fromSessionKeys(key, salt, hardware == 1);
+        uint8_t package[sizeof(header) + sizeof(protectedPayload)];
+        memcpy(package, header, sizeof(header));
+        memcpy(package + sizeof(header), plainText.c_str(), plainText.size());
+        unsigned int packageSize = sizeof(header) + plainText.size();
+        TEST_ASSERT(context.protect(package, packageSize, sizeof(package), 0));
+        TEST_ASSERT_EQUALS(sizeof(package), packageSize);
+        TEST_ASSERT_EQUALS(0, memcmp(header, package, sizeof(header)));
+        TEST_ASSERT_EQUALS(0, memcmp(protectedPayload, package + sizeof(header), sizeof(protectedPayload)));
+
+        TEST_ASSERT(context.unprotect(package, packageSize, 0));
+        TEST_ASSERT_EQUALS(sizeof(header) + plainText.size(), packageSize);
+        TEST_ASSERT_EQUALS(0, memcmp(plainText.c_str(), package + sizeof(header), plainText.size()));
+    }
+}
+
+void TestSRTP::testProtectUnprotect()
+{
+    SRTPContext sender(testKey, testSalt);
+    SRTPContext receiver(testKey, testSalt);
+    RTPPackageHandler package(payloadSize);
+    const std::string payload("Some secret payload");
+    package.createNewRTPPackage(payload.c_str(), payload.size());
+
+    unsigned int packageSize = RTP_HEADER_MIN_SIZE + payload.size();
+    TEST_ASSERT(sender.protect(package, packageSize, 1));
+    TEST_ASSERT_EQUALS(RTP_HEADER_MIN_SIZE + payload.size() + SRTP_AUTH_TAG_SIZE, packageSize);
+    TEST_ASSERT(memcmp(payload.c_str(), package.getRTPPackageData(), payload.size()) != 0);
+
+    TEST_ASSERT(receiver.unprotect(package, packageSize, 1));
+    TEST_ASSERT_EQUALS(RTP_HEADER_MIN_SIZE + payload.size(), packageSize);
+    TEST_ASSERT_EQUALS(0, memcmp(payload.c_str(), package.getRTPPackageData(), payload.size()));
+}
+
+void TestSRTP::testTamperedPackageRejected()
+{
+    SRTPContext context(testKey, testSalt);
+    RTPPackageHandler package(payloadSize);
+    const std::string payload("Some secret payload");
+    package.createNewRTPPackage(payload.c_str(), payload.size());
+    unsigned int packageSize = RTP_HEADER_MIN_SIZE + payload.size();
+    TEST_ASSERT(context.protect(package, packageSize, 0));
+
+    //a wrong rollover-counter results in a different IV
+    unsigned int size = packageSize;
+    TEST_ASSERT(!context.unprotect(package, size, 1));
+    //the authenticated header must not be modified
+    ((char*)package.getWorkBuffer())[4] ^= 0x01;
+    TEST_ASSERT(!context.unprotect(package, size, 0));
+    ((char*)package.getWorkBuffer())[4] ^= 0x01;
+    TEST_ASSERT(context.unprotect(package, size, 0));
+}
+
+void TestSRTP::testPackageIndexEstimation()
+{
+    //same roll-over
+    TEST_ASSERT_EQUALS(0x00011235u, SRTPContext::estimatePackageIndex(0x00011234, 0x1235));
+    //roll-over after the highest index
+    TEST_ASSERT_EQUALS(0x00020002u, SRTPContext::estimatePackageIndex(0x0001FFF0, 0x0002));
+    //delayed package from before the roll-over
+    TEST_ASSERT_EQUALS(0x0001FFF0u, SRTPContext::estimatePackageIndex(0x00020002, 0xFFF0));
+    //there is no roll-over before the first one
+    TEST_ASSERT_EQUALS(0x0000FFF0u, SRTPContext::estimatePackageIndex(0x00000002, 0xFFF0));
+}
@@ -0,0 +1,23 @@
+#ifndef TESTSRTP_H
+#define TESTSRTP_H
+
+#include "cpptest.h"
+#include "rtp/SRTPContext.h"
+
+class TestSRTP : public Test::Suite
+{
+public:
+    TestSRTP();
+
+    void testAESGCMVector();
+    void testKeyDerivationVector();
+    void testPackageVector();
+    void testProtectUnprotect();
+    void testTamperedPackageRejected();
+    void testPackageIndexEstimation();
+
+private:
+    const unsigned int payloadSize;
+};
+
+#endif // TESTSRTP_H